@@ -90,6 +90,10 @@ inline uint8_t *pgm_read_bitmap_ptr(const GFXfont *gfxFont) {
 #define min(a, b) (((a) < (b)) ? (a) : (b))
 #endif
 
+#ifndef max
+#define max(a, b) (((a) > (b)) ? (a) : (b))
+#endif
+
 #ifndef _swap_int16_t
 #define _swap_int16_t(a, b)                                                    \
   {                                                                            \
@@ -1146,30 +1150,29 @@ void Adafruit_GFX::drawChar(int16_t x, int16_t y, unsigned char c,
     if (!_cp437 && (c >= 176))
       c++; // Handle 'classic' charset behavior
 
+    // Draw each column as vertical runs of same-colored pixels, the
+    // background runs too if opaque, rather than pixel by pixel
     startWrite();
-    for (int8_t i = 0; i < 5; i++) { // Char bitmap = 5 columns
-      uint8_t line = pgm_read_byte(&font[c * 5 + i]);
-      for (int8_t j = 0; j < 8; j++, line >>= 1) {
-        if (line & 1) {
-          if (size_x == 1 && size_y == 1)
-            writePixel(x + i, y + j, color);
+    for (int8_t i = 0; i < 6; i++) { // Char bitmap = 5 columns + space
+      uint8_t line = (i < 5) ? pgm_read_byte(&font[c * 5 + i]) : 0;
+      int8_t j0 = 0; // First row of the current run
+      for (int8_t j = 0; j < 8; j++) {
+        bool set = line & (1 << j);
+        if ((j < 7) && (set == !!(line & (2 << j))))
+          continue; // Run goes on
+        if (set || (bg != color)) {
+          uint16_t rc = set ? color : bg;
+          if (size_x == 1 && size_y == 1 && j == j0)
+            writePixel(x + i, y + j, rc); // Cheaper than a line of one
+          else if (size_x == 1 && size_y == 1)
+            writeFastVLine(x + i, y + j0, j - j0 + 1, rc);
           else
-            writeFillRect(x + i * size_x, y + j * size_y, size_x, size_y,
-                          color);
-        } else if (bg != color) {
-          if (size_x == 1 && size_y == 1)
-            writePixel(x + i, y + j, bg);
-          else
-            writeFillRect(x + i * size_x, y + j * size_y, size_x, size_y, bg);
+            writeFillRect(x + i * size_x, y + j0 * size_y, size_x,
+                          (j - j0 + 1) * size_y, rc);
         }
+        j0 = j + 1;
       }
     }
-    if (bg != color) { // If opaque, draw vertical line for last column
-      if (size_x == 1 && size_y == 1)
-        writeFastVLine(x + 5, y, 8, bg);
-      else
-        writeFillRect(x + 5 * size_x, y, size_x, 8 * size_y, bg);
-    }
     endWrite();
 
   } else { // Custom font
@@ -1186,7 +1189,7 @@ void Adafruit_GFX::drawChar(int16_t x, int16_t y, unsigned char c,
     uint8_t w = pgm_read_byte(&glyph->width), h = pgm_read_byte(&glyph->height);
     int8_t xo = pgm_read_byte(&glyph->xOffset),
            yo = pgm_read_byte(&glyph->yOffset);
-    uint8_t xx, yy, bits = 0, bit = 0;
+    uint8_t xx, yy, bits = 0, bit = 0, run;
     int16_t xo16 = 0, yo16 = 0;
 
     if (size_x > 1 || size_y > 1) {
@@ -1212,27 +1215,50 @@ void Adafruit_GFX::drawChar(int16_t x, int16_t y, unsigned char c,
     // displays supporting setAddrWindow() and pushColors()), but haven't
     // implemented this yet.
 
+    // Each row is drawn as horizontal spans of set pixels rather than
+    // pixel by pixel, one window write per span on most displays.
     startWrite();
     for (yy = 0; yy < h; yy++) {
-      for (xx = 0; xx < w; xx++) {
+      for (xx = 0, run = 0; xx < w; xx++) {
         if (!(bit++ & 7)) {
           bits = pgm_read_byte(&bitmap[bo++]);
         }
-        if (bits & 0x80) {
+        bool set = bits & 0x80;
+        bits <<= 1;
+        if (set)
+          run++;
+        if (run && (!set || (xx == w - 1))) { // End of a span
+          int16_t x0 = xx + set - run;
           if (size_x == 1 && size_y == 1) {
-            writePixel(x + xo + xx, y + yo + yy, color);
+            writeFastHLine(x + xo + x0, y + yo + yy, run, color);
           } else {
-            writeFillRect(x + (xo16 + xx) * size_x, y + (yo16 + yy) * size_y,
-                          size_x, size_y, color);
+            writeFillRect(x + (xo16 + x0) * size_x, y + (yo16 + yy) * size_y,
+                          run * size_x, size_y, color);
           }
+          run = 0;
         }
-        bits <<= 1;
       }
     }
     endWrite();
 
   } // End classic vs custom font
 }
+
+/**************************************************************************/
+/*!
+   @brief   Get the bitmap of a 'classic' font character, for subclasses
+            drawing it their own way
+    @param    c        The 8-bit font-indexed character (likely ascii)
+    @param    columns  The 5 columns, bit 0 is the top row
+*/
+/**************************************************************************/
+void Adafruit_GFX::getClassicChar(unsigned char c, uint8_t columns[5]) const {
+  if (!_cp437 && (c >= 176))
+    c++; // Handle 'classic' charset behavior
+  for (int8_t i = 0; i < 5; i++)
+    columns[i] = pgm_read_byte(&font[c * 5 + i]);
+}
+
 /**************************************************************************/
 /*!
     @brief  Print one byte/character of data, used to support print()
@@ -2115,6 +2141,103 @@ void GFXcanvas1::drawFastRawHLine(int16_t x, int16_t y, int16_t w,
   }
 }
 
+/**************************************************************************/
+/*!
+   @brief    Count the unchanged pixels sent if two areas were sent as one
+   @param    a   First area
+   @param    b   Second area
+   @returns  Pixels of the bounding box in neither area, negative if the
+             areas overlap by more than that
+*/
+/**************************************************************************/
+int32_t GFXdirtyRects::waste(const Rect &a, const Rect &b) {
+  int32_t w = max(a.x2, b.x2) - min(a.x1, b.x1) + 1,
+          h = max(a.y2, b.y2) - min(a.y1, b.y1) + 1;
+  return w * h - (int32_t)(a.x2 - a.x1 + 1) * (a.y2 - a.y1 + 1) -
+         (int32_t)(b.x2 - b.x1 + 1) * (b.y2 - b.y1 + 1);
+}
+
+/**************************************************************************/
+/*!
+   @brief    Drop an area, the last one takes its place
+   @param    i   Index of the area
+*/
+/**************************************************************************/
+void GFXdirtyRects::remove(uint8_t i) { rect[i] = rect[--count]; }
+
+/**************************************************************************/
+/*!
+   @brief    Add a changed area
+   @param    x   Left edge
+   @param    y   Top edge
+   @param    w   Width, nothing is added if not positive
+   @param    h   Height, nothing is added if not positive
+*/
+/**************************************************************************/
+void GFXdirtyRects::add(int16_t x, int16_t y, int16_t w, int16_t h) {
+  if ((w <= 0) || (h <= 0))
+    return;
+  Rect r = {x, y, (int16_t)(x + w - 1), (int16_t)(y + h - 1)};
+
+  uint8_t i;
+  for (i = 0; i < count; i++) { // Already changed? (e.g. text pixels)
+    if ((r.x1 >= rect[i].x1) && (r.x2 <= rect[i].x2) && (r.y1 >= rect[i].y1) &&
+        (r.y2 <= rect[i].y2))
+      return;
+  }
+
+  if (count < GFX_DIRTY_RECTS) {
+    rect[count++] = r;
+  } else { // Merge into the area growing least
+    int32_t best = 0x7FFFFFFF;
+    for (uint8_t j = 0; j < count; j++) {
+      int32_t wst = waste(rect[j], r);
+      if (wst < best) {
+        best = wst;
+        i = j;
+      }
+    }
+    rect[i].x1 = min(rect[i].x1, r.x1);
+    rect[i].y1 = min(rect[i].y1, r.y1);
+    rect[i].x2 = max(rect[i].x2, r.x2);
+    rect[i].y2 = max(rect[i].y2, r.y2);
+  }
+
+  // Merge any areas close enough to each other, the new or grown one may
+  // have made them overlap or touch
+  bool merged;
+  do {
+    merged = false;
+    for (i = 0; (i < count) && !merged; i++) {
+      for (uint8_t j = i + 1; j < count; j++) {
+        if (waste(rect[i], rect[j]) <= GFX_DIRTY_SLACK) {
+          rect[i].x1 = min(rect[i].x1, rect[j].x1);
+          rect[i].y1 = min(rect[i].y1, rect[j].y1);
+          rect[i].x2 = max(rect[i].x2, rect[j].x2);
+          rect[i].y2 = max(rect[i].y2, rect[j].y2);
+          remove(j);
+          merged = true; // Start over with the grown area
+          break;
+        }
+      }
+    }
+  } while (merged);
+}
+
+/**************************************************************************/
+/*!
+   @brief    Add the bounding box of the pixels drawn one at a time as a
+             changed area
+*/
+/**************************************************************************/
+void GFXdirtyRects::flush(void) {
+  if (pixels.x1 <= pixels.x2) {
+    add(pixels.x1, pixels.y1, pixels.x2 - pixels.x1 + 1,
+        pixels.y2 - pixels.y1 + 1);
+    clearPixels();
+  }
+}
+
 /**************************************************************************/
 /*!
    @brief    Instatiate a GFX 8-bit canvas context for graphics
@@ -2135,6 +2258,7 @@ GFXcanvas8::GFXcanvas8(uint16_t w, uint16_t h, bool allocate_buffer)
     }
   } else
     buffer = nullptr;
+  markDirty(); // Not sent yet
 }
 
 /**************************************************************************/
@@ -2179,6 +2303,9 @@ void GFXcanvas8::drawPixel(int16_t x, int16_t y, uint16_t color) {
     }
 
     buffer[x + y * WIDTH] = color;
+#ifdef GFX_DIRTY_TRACKING
+    dirty.addPixel(x, y);
+#endif
   }
 }
 
@@ -2239,6 +2366,7 @@ uint8_t GFXcanvas8::getRawPixel(int16_t x, int16_t y) const {
 void GFXcanvas8::fillScreen(uint16_t color) {
   if (buffer) {
     memset(buffer, color, WIDTH * HEIGHT);
+    markDirty();
   }
 }
 
@@ -2373,6 +2501,9 @@ void GFXcanvas8::drawFastRawVLine(int16_t x, int16_t y, int16_t h,
     (*buffer_ptr) = color;
     buffer_ptr += WIDTH;
   }
+#ifdef GFX_DIRTY_TRACKING
+  dirty.add(x, y, 1, h);
+#endif
 }
 
 /**************************************************************************/
@@ -2389,6 +2520,9 @@ void GFXcanvas8::drawFastRawHLine(int16_t x, int16_t y, int16_t w,
                                   uint16_t color) {
   // x & y already in raw (rotation 0) coordinates, no need to transform.
   memset(buffer + y * WIDTH + x, color, w);
+#ifdef GFX_DIRTY_TRACKING
+  dirty.add(x, y, w, 1);
+#endif
 }
 
 /**************************************************************************/
@@ -2412,6 +2546,7 @@ GFXcanvas16::GFXcanvas16(uint16_t w, uint16_t h, bool allocate_buffer)
   } else {
     buffer = nullptr;
   }
+  markDirty(); // Not sent yet
 }
 
 /**************************************************************************/
@@ -2456,6 +2591,9 @@ void GFXcanvas16::drawPixel(int16_t x, int16_t y, uint16_t color) {
     }
 
     buffer[x + y * WIDTH] = color;
+#ifdef GFX_DIRTY_TRACKING
+    dirty.addPixel(x, y);
+#endif
   }
 }
 
@@ -2523,6 +2661,7 @@ void GFXcanvas16::fillScreen(uint16_t color) {
       for (i = 0; i < pixels; i++)
         buffer[i] = color;
     }
+    markDirty();
   }
 }
 
@@ -2544,6 +2683,7 @@ void GFXcanvas16::byteSwap(void) {
     uint32_t i, pixels = WIDTH * HEIGHT;
     for (i = 0; i < pixels; i++)
       buffer[i] = __builtin_bswap16(buffer[i]);
+    markDirty();
   }
 }
 
@@ -2674,6 +2814,9 @@ void GFXcanvas16::drawFastRawVLine(int16_t x, int16_t y, int16_t h,
     (*buffer_ptr) = color;
     buffer_ptr += WIDTH;
   }
+#ifdef GFX_DIRTY_TRACKING
+  dirty.add(x, y, 1, h);
+#endif
 }
 
 /**************************************************************************/
@@ -2692,4 +2835,7 @@ void GFXcanvas16::drawFastRawHLine(int16_t x, int16_t y, int16_t w,
   for (uint32_t i = buffer_index; i < buffer_index + w; i++) {
     buffer[i] = color;
   }
+#ifdef GFX_DIRTY_TRACKING
+  dirty.add(x, y, w, 1);
+#endif
 }
@@ -232,6 +232,7 @@ public:
 protected:
   void charBounds(unsigned char c, int16_t *x, int16_t *y, int16_t *minx,
                   int16_t *miny, int16_t *maxx, int16_t *maxy);
+  void getClassicChar(unsigned char c, uint8_t columns[5]) const;
   int16_t WIDTH;        ///< This is the 'raw' display width - never changes
   int16_t HEIGHT;       ///< This is the 'raw' display height - never changes
   int16_t _width;       ///< Display width as modified by current rotation
@@ -306,6 +307,82 @@ private:
   bool currstate, laststate;
 };
 
+// Define GFX_DIRTY_TRACKING to keep the areas of GFXcanvas8 and GFXcanvas16
+// changed by drawing, so blitTo() sends only those. Without it drawing costs
+// no more than before and the whole canvas is always reported as changed.
+#ifndef GFX_DIRTY_RECTS
+#define GFX_DIRTY_RECTS 4 ///< Max separate changed areas tracked per canvas
+#endif
+#ifndef GFX_DIRTY_SLACK
+#define GFX_DIRTY_SLACK 16 ///< Unchanged pixels worth sending to save a rect
+#endif
+// Define GFX_DIRTY_PIXELS to add each pixel drawn on its own (drawPixel())
+// as a changed area. Without it they only grow one bounding box, which is
+// added when the areas are read: a few compares per pixel instead of a
+// scan of the areas, but scattered pixels make one large area.
+
+class Adafruit_SPITFT;
+
+/// Bounding rectangles of the changed areas of a canvas, in unrotated
+/// canvas coordinates. Areas close to each other are merged, when there
+/// are too many the two which grow least are.
+class GFXdirtyRects {
+public:
+  GFXdirtyRects(void) : count(0) { clearPixels(); }
+  void add(int16_t x, int16_t y, int16_t w, int16_t h);
+  /**********************************************************************/
+  /*!
+    @brief  Add a changed pixel
+    @param  x   Column
+    @param  y   Row
+  */
+  /**********************************************************************/
+  void addPixel(int16_t x, int16_t y) {
+#ifdef GFX_DIRTY_PIXELS
+    add(x, y, 1, 1);
+#else
+    if (x < pixels.x1)
+      pixels.x1 = x;
+    if (x > pixels.x2)
+      pixels.x2 = x;
+    if (y < pixels.y1)
+      pixels.y1 = y;
+    if (y > pixels.y2)
+      pixels.y2 = y;
+#endif
+  }
+  void flush(void);
+  /**********************************************************************/
+  /*!
+    @brief  Forget all the changed areas
+  */
+  /**********************************************************************/
+  void clear(void) {
+    count = 0;
+    clearPixels();
+  }
+
+  /// A changed area, corners included
+  struct Rect {
+    int16_t x1; ///< Left edge
+    int16_t y1; ///< Top edge
+    int16_t x2; ///< Right edge
+    int16_t y2; ///< Bottom edge
+  } rect[GFX_DIRTY_RECTS]; ///< The changed areas, count of them are used
+  uint8_t count;           ///< Number of changed areas
+
+protected:
+  static int32_t waste(const Rect &a, const Rect &b);
+  void remove(uint8_t i);
+
+private:
+  Rect pixels; ///< Bounding box of the pixels not added yet, empty if x1 > x2
+  void clearPixels(void) {
+    pixels.x1 = pixels.y1 = INT16_MAX;
+    pixels.x2 = pixels.y2 = INT16_MIN;
+  }
+};
+
 /// A GFX 1-bit canvas context for graphics
 class GFXcanvas1 : public Adafruit_GFX {
 public:
@@ -356,6 +433,39 @@ public:
   */
   /**********************************************************************/
   uint8_t *getBuffer(void) const { return buffer; }
+  /**********************************************************************/
+  /*!
+    @brief    Get the areas changed by drawing since the last blitTo() or
+              clearDirty(). Call markDirty() after writing to the buffer
+              directly. Without GFX_DIRTY_TRACKING this is the whole canvas.
+    @returns  The changed areas, in unrotated canvas coordinates
+  */
+  /**********************************************************************/
+  const GFXdirtyRects &getDirtyRects(void) {
+    dirty.flush();
+    return dirty;
+  }
+  /**********************************************************************/
+  /*!
+    @brief  Mark the whole canvas as changed
+  */
+  /**********************************************************************/
+  void markDirty(void) {
+    dirty.clear();
+    dirty.add(0, 0, WIDTH, HEIGHT);
+  }
+  /**********************************************************************/
+  /*!
+    @brief  Mark the whole canvas as unchanged, only with GFX_DIRTY_TRACKING
+  */
+  /**********************************************************************/
+  void clearDirty(void) {
+#ifdef GFX_DIRTY_TRACKING
+    dirty.clear();
+#endif
+  }
+  void blitTo(Adafruit_SPITFT &tft, int16_t x, int16_t y,
+              const uint16_t *palette);
 
 protected:
   uint8_t getRawPixel(int16_t x, int16_t y) const;
@@ -364,6 +474,7 @@ protected:
   uint8_t *buffer;   ///< Raster data: no longer private, allow subclass access
   bool buffer_owned; ///< If true, destructor will free buffer, else it will do
                      ///< nothing
+  GFXdirtyRects dirty; ///< Areas changed since the last blitTo()
 };
 
 ///  A GFX 16-bit canvas context for graphics
@@ -384,6 +495,38 @@ public:
   */
   /**********************************************************************/
   uint16_t *getBuffer(void) const { return buffer; }
+  /**********************************************************************/
+  /*!
+    @brief    Get the areas changed by drawing since the last blitTo() or
+              clearDirty(). Call markDirty() after writing to the buffer
+              directly. Without GFX_DIRTY_TRACKING this is the whole canvas.
+    @returns  The changed areas, in unrotated canvas coordinates
+  */
+  /**********************************************************************/
+  const GFXdirtyRects &getDirtyRects(void) {
+    dirty.flush();
+    return dirty;
+  }
+  /**********************************************************************/
+  /*!
+    @brief  Mark the whole canvas as changed
+  */
+  /**********************************************************************/
+  void markDirty(void) {
+    dirty.clear();
+    dirty.add(0, 0, WIDTH, HEIGHT);
+  }
+  /**********************************************************************/
+  /*!
+    @brief  Mark the whole canvas as unchanged, only with GFX_DIRTY_TRACKING
+  */
+  /**********************************************************************/
+  void clearDirty(void) {
+#ifdef GFX_DIRTY_TRACKING
+    dirty.clear();
+#endif
+  }
+  void blitTo(Adafruit_SPITFT &tft, int16_t x, int16_t y);
 
 protected:
   uint16_t getRawPixel(int16_t x, int16_t y) const;
@@ -392,6 +535,7 @@ protected:
   uint16_t *buffer;  ///< Raster data: no longer private, allow subclass access
   bool buffer_owned; ///< If true, destructor will free buffer, else it will do
                      ///< nothing
+  GFXdirtyRects dirty; ///< Areas changed since the last blitTo()
 };
 
 #endif // _ADAFRUIT_GFX_H
@@ -98,6 +98,16 @@ static const struct {
 #define NUM_TIMERS (sizeof tcList / sizeof tcList[0]) ///< # timer/counters
 #endif                                                // end __SAMD51__
 
+#elif defined(USE_SPI_DMA) && defined(ESP32)
+#include "hal/spi_ll.h" // To hand the SPI registers back to Arduino SPI
+#if defined(CONFIG_IDF_TARGET_ESP32)
+#define SPITFT_DMA_HOST SPI3_HOST // VSPI, the default SPI bus
+#define SPITFT_DMA_CHANNEL 1
+#else
+#define SPITFT_DMA_HOST SPI2_HOST // FSPI, the default SPI bus
+#define SPITFT_DMA_CHANNEL SPI_DMA_CH_AUTO
+#endif
+#define SPITFT_DMA_MAX_PIXELS 16384 ///< Max pixels per big-endian transfer
 #endif // end USE_SPI_DMA
 
 // Possible values for Adafruit_SPITFT.connection:
@@ -512,6 +522,17 @@ Adafruit_SPITFT::Adafruit_SPITFT(uint16_t w, uint16_t h, tftBusWidth busWidth,
 
 // end constructors -------
 
+/*!
+    @brief  Adafruit_SPITFT destructor. With ESP32 DMA, waits for the
+            transfers and frees the working buffers.
+*/
+Adafruit_SPITFT::~Adafruit_SPITFT() {
+#if defined(USE_SPI_DMA) && defined(ESP32)
+  dmaWait();
+  heap_caps_free(pixelBuf[0]);
+#endif
+}
+
 // CLASS MEMBER FUNCTIONS --------------------------------------------------
 
 // begin() and setAddrWindow() MUST be declared by any subclass.
@@ -896,9 +917,143 @@ void Adafruit_SPITFT::initSPI(uint32_t freq, uint8_t spiMode) {
     } // end addDescriptor()
     dma.free(); // Deallocate DMA channel
   }
+#elif defined(USE_SPI_DMA) && defined(ESP32)
+  if ((connection == TFT_HARD_SPI) && (hwspi._spi == &SPI)) {
+    // Alloc 2 scanlines worth of pixels on display's major axis in
+    // DMA-capable RAM. writePixels() fills one while the other is sent.
+    int major = (WIDTH > HEIGHT) ? WIDTH : HEIGHT;
+    major += (major & 1);   // -> next 2-pixel bound, if needed.
+    maxFillLen = major * 2; // 2 scanlines
+    if ((pixelBuf[0] = (uint16_t *)heap_caps_malloc(
+             maxFillLen * sizeof(uint16_t), MALLOC_CAP_DMA))) {
+      pixelBuf[1] = &pixelBuf[0][major];
+      dma = dmaCustom ? dmaCustom : &dmaDriver;
+      if (!dma->begin(freq, spiMode)) {
+        dma = NULL;
+        heap_caps_free(pixelBuf[0]);
+        pixelBuf[0] = pixelBuf[1] = NULL;
+      }
+    }
+  }
 #endif // end USE_SPI_DMA
 }
 
+#if defined(USE_SPI_DMA) && defined(ESP32)
+/*!
+    @brief  Free the SPI master device, waiting for its transfers first.
+*/
+Adafruit_SPITFT_ESP32DMA::~Adafruit_SPITFT_ESP32DMA() {
+  if (dev) {
+    wait();
+    spi_bus_remove_device(dev);
+  }
+}
+
+/*!
+    @brief  Add the display as a device of the SPI master driver, or add it
+            again with a new clock frequency.
+    @param  freq     SPI clock frequency.
+    @param  spiMode  SPI_MODEn.
+    @return true on success, false if the bus or device could not be set up.
+*/
+bool Adafruit_SPITFT_ESP32DMA::begin(uint32_t freq, uint8_t spiMode) {
+  if (dev) { // The SPI master driver has its own copy of the clock
+    wait();
+    spi_bus_remove_device(dev);
+    dev = NULL;
+  } else {
+    // The pins were routed to the SPI peripheral by the Arduino SPI
+    // begin(), the SPI master driver is given none and only sends the
+    // pixel data. CS and DC are still set by Adafruit_SPITFT.
+    spi_bus_config_t buscfg = {};
+    buscfg.mosi_io_num = -1;
+    buscfg.miso_io_num = -1;
+    buscfg.sclk_io_num = -1;
+    buscfg.quadwp_io_num = -1;
+    buscfg.quadhd_io_num = -1;
+    buscfg.max_transfer_sz = SPITFT_DMA_MAX_PIXELS * 2;
+    esp_err_t err =
+        spi_bus_initialize(SPITFT_DMA_HOST, &buscfg, SPITFT_DMA_CHANNEL);
+    // ESP_ERR_INVALID_STATE: already initialized for another display
+    if ((err != ESP_OK) && (err != ESP_ERR_INVALID_STATE))
+      return false;
+  }
+  spi_device_interface_config_t devcfg = {};
+  devcfg.mode = spiMode;
+  devcfg.clock_speed_hz = freq;
+  devcfg.spics_io_num = -1; // CS is set by startWrite()
+  devcfg.flags = SPI_DEVICE_NO_DUMMY;
+  devcfg.queue_size = 2;
+  if (spi_bus_add_device(SPITFT_DMA_HOST, &devcfg, &dev) != ESP_OK)
+    dev = NULL;
+  return dev != NULL;
+}
+
+/*!
+    @brief  Wait until trans[next] is free.
+*/
+void Adafruit_SPITFT_ESP32DMA::reserve(void) {
+  spi_transaction_t *t;
+  // Transactions complete in order, alternating between the two
+  if (queued == 2) {
+    spi_device_get_trans_result(dev, &t, portMAX_DELAY);
+    queued--;
+  }
+}
+
+/*!
+    @brief  Start sending data from memory, returns immediately unless two
+            transfers are already in progress.
+    @param  data  Data to send. It's not copied, must stay unchanged until
+                  the transfer is complete.
+    @param  len   Number of bytes.
+*/
+void Adafruit_SPITFT_ESP32DMA::queue(const void *data, uint32_t len) {
+  reserve();
+  spi_transaction_t *t = &trans[next];
+  memset(t, 0, sizeof(spi_transaction_t));
+  t->tx_buffer = data;
+  t->length = len * 8; // In bits
+  spi_device_queue_trans(dev, t, portMAX_DELAY);
+  queued++;
+  next = 1 - next;
+  used = true;
+}
+
+/*!
+    @brief  Collect the completed transfers without waiting.
+    @return true if any transfer is still in progress.
+*/
+bool Adafruit_SPITFT_ESP32DMA::busy(void) {
+  spi_transaction_t *t;
+  while (queued && (spi_device_get_trans_result(dev, &t, 0) == ESP_OK))
+    queued--;
+  return queued > 0;
+}
+
+/*!
+    @brief  Wait for all transfers, then set the SPI peripheral back for
+            the Arduino SPI functions.
+*/
+void Adafruit_SPITFT_ESP32DMA::wait(void) {
+  spi_transaction_t *t;
+  while (queued) {
+    spi_device_get_trans_result(dev, &t, portMAX_DELAY);
+    queued--;
+  }
+  if (used) {
+    // The SPI master driver leaves the peripheral set up for its DMA
+    // transfers, set it back for the Arduino SPI functions
+    spi_dev_t *hw = SPI_LL_GET_HW(SPITFT_DMA_HOST);
+#if !defined(CONFIG_IDF_TARGET_ESP32)
+    spi_ll_dma_tx_enable(hw, false);
+#endif
+    hw->user.usr_miso = 1; // Full duplex as set by Arduino SPI begin()
+    used = false;
+  }
+}
+#endif // end USE_SPI_DMA
+
 /*!
     @brief  Allow changing the SPI clock speed after initialization
     @param  freq Desired frequency of SPI clock, may not be the
@@ -910,6 +1065,10 @@ void Adafruit_SPITFT::setSPISpeed(uint32_t freq) {
 #else
   hwspi._freq = freq; // Save freq value for later
 #endif
+#if defined(USE_SPI_DMA) && defined(ESP32)
+  if (dma && !dma->begin(freq, hwspi._mode)) // Has its own copy of the clock
+    dma = NULL;
+#endif
 }
 
 /*!
@@ -931,6 +1090,9 @@ void Adafruit_SPITFT::startWrite(void) {
             for all display types; not an SPI-specific function.
 */
 void Adafruit_SPITFT::endWrite(void) {
+#if defined(USE_SPI_DMA) && defined(ESP32)
+  dmaWait(); // Keep CS low until the last pixels are sent
+#endif
   if (_cs >= 0)
     SPI_CS_HIGH();
   SPI_END_TRANSACTION();
@@ -1013,6 +1175,37 @@ void Adafruit_SPITFT::writePixels(uint16_t *colors, uint32_t len, bool block,
 
 #if defined(ESP32)
   if (connection == TFT_HARD_SPI) {
+#if defined(USE_SPI_DMA)
+    if (dma) {
+      if (!bigEndian) { // Normal little-endian situation...
+        uint32_t maxSpan = maxFillLen / 2; // One scanline max
+        while (len) {
+          uint32_t count = (len < maxSpan) ? len : maxSpan;
+          // Swap bytes into a DMA working buffer while the prior
+          // transfer from the other one is in progress
+          dma->reserve();
+          swapBytes(colors, count, pixelBuf[dmaNext]);
+          dma->queue(pixelBuf[dmaNext], count * 2);
+          dmaNext = 1 - dmaNext;
+          colors += count;
+          len -= count;
+        }
+        lastFillColor = 0x0000; // pixelBuf has been sullied
+        lastFillLen = 0;
+      } else { // bigEndian == true, send straight from 'colors'
+        while (len) {
+          uint32_t count =
+              (len < SPITFT_DMA_MAX_PIXELS) ? len : SPITFT_DMA_MAX_PIXELS;
+          dma->queue(colors, count * 2);
+          colors += count;
+          len -= count;
+        }
+      }
+      if (block)
+        dmaWait();
+      return;
+    }
+#endif // end USE_SPI_DMA
     if (!bigEndian) {
       hwspi._spi->writePixels(colors, len * 2); // Inbuilt endian-swap
     } else {
@@ -1175,6 +1368,10 @@ void Adafruit_SPITFT::writePixels(uint16_t *colors, uint32_t len, bool block,
             was used (as is the default case).
 */
 void Adafruit_SPITFT::dmaWait(void) {
+#if defined(USE_SPI_DMA) && defined(ESP32)
+  if (dma)
+    dma->wait();
+#endif
 #if defined(USE_SPI_DMA) && (defined(__SAMD51__) || defined(ARDUINO_SAMD_ZERO))
   while (dma_busy)
     ;
@@ -1197,6 +1394,8 @@ void Adafruit_SPITFT::dmaWait(void) {
 bool Adafruit_SPITFT::dmaBusy(void) const {
 #if defined(USE_SPI_DMA) && (defined(__SAMD51__) || defined(ARDUINO_SAMD_ZERO))
   return dma_busy;
+#elif defined(USE_SPI_DMA) && defined(ESP32)
+  return dma && dma->busy();
 #else
   return false;
 #endif
@@ -1217,6 +1416,32 @@ void Adafruit_SPITFT::writeColor(uint16_t color, uint32_t len) {
 
 #if defined(ESP32) // ESP32 has a special SPI pixel-writing function...
   if (connection == TFT_HARD_SPI) {
+#if defined(USE_SPI_DMA)
+    if (dma && (len >= 16)) { // Don't bother with DMA on short pixel runs
+      dmaWait(); // pixelBuf may be in use by a non-blocking writePixels()
+      // Fill the buffer with the color (swapped for the display), only
+      // the additional pixels if the color is the same as last time.
+      uint32_t *pixelPtr = (uint32_t *)pixelBuf[0],
+               twoPixels = __builtin_bswap16(color) * 0x00010001;
+      uint32_t fillStart = (color == lastFillColor) ? lastFillLen / 2 : 0,
+               fillEnd = (((len < maxFillLen) ? len : maxFillLen) + 1) / 2;
+      if (fillEnd * 2 > lastFillLen || color != lastFillColor) {
+        for (uint32_t i = fillStart; i < fillEnd; i++)
+          pixelPtr[i] = twoPixels;
+        lastFillLen = fillEnd * 2;
+        lastFillColor = color;
+      }
+      // The same buffer is sent over and over, the next transfer is
+      // queued while the prior one is in progress so the bus never idles
+      while (len) {
+        uint32_t count = (len < maxFillLen) ? len : maxFillLen;
+        dma->queue(pixelBuf[0], count * 2);
+        len -= count;
+      }
+      dmaWait();
+      return;
+    }
+#endif // end USE_SPI_DMA
 #define SPI_MAX_PIXELS_AT_ONCE 32
 #define TMPBUF_LONGWORDS (SPI_MAX_PIXELS_AT_ONCE + 1) / 2
 #define TMPBUF_PIXELS (TMPBUF_LONGWORDS * 2)
@@ -1918,6 +2143,211 @@ void Adafruit_SPITFT::drawRGBBitmap(int16_t x, int16_t y, uint16_t *pcolors,
   endWrite();
 }
 
+/*!
+    @brief  Draw a single character. An opaque 'classic' font character
+            that is entirely on the display is composed into a line
+            buffer, as many scanlines at a time as fit, and sent in one
+            address window. Others are drawn by Adafruit_GFX.
+    @param  x      Top left corner horizontal coordinate.
+    @param  y      Top left corner vertical coordinate.
+    @param  c      The 8-bit font-indexed character (likely ascii).
+    @param  color  16-bit 5-6-5 color to draw the character with.
+    @param  bg     16-bit 5-6-5 color to fill the background with (if same
+                   as color, no background).
+    @param  size   Font magnification level, 1 is 'original' size.
+*/
+void Adafruit_SPITFT::drawChar(int16_t x, int16_t y, unsigned char c,
+                               uint16_t color, uint16_t bg, uint8_t size) {
+  drawChar(x, y, c, color, bg, size, size);
+}
+
+/*!
+    @brief  Draw a single character, see above.
+    @param  x       Top left corner horizontal coordinate.
+    @param  y       Top left corner vertical coordinate.
+    @param  c       The 8-bit font-indexed character (likely ascii).
+    @param  color   16-bit 5-6-5 color to draw the character with.
+    @param  bg      16-bit 5-6-5 color to fill the background with (if same
+                    as color, no background).
+    @param  size_x  Font magnification level in X-axis, 1 is 'original' size.
+    @param  size_y  Font magnification level in Y-axis, 1 is 'original' size.
+*/
+void Adafruit_SPITFT::drawChar(int16_t x, int16_t y, unsigned char c,
+                               uint16_t color, uint16_t bg, uint8_t size_x,
+                               uint8_t size_y) {
+  int16_t w = 6 * size_x, h = 8 * size_y;
+  if (gfxFont || (bg == color) || (size_x > 8) || (x < 0) || (y < 0) ||
+      (x + w > _width) || (y + h > _height)) {
+    Adafruit_GFX::drawChar(x, y, c, color, bg, size_x, size_y);
+    return;
+  }
+
+  uint16_t buf[6 * 8]; // The whole character box at size 1
+  int16_t rows = (6 * 8) / w, n = 0;
+  uint8_t columns[5];
+  getClassicChar(c, columns);
+
+  startWrite();
+  setAddrWindow(x, y, w, h);
+  for (int8_t j = 0; j < 8; j++) {
+    for (uint8_t s = 0; s < size_y; s++) {
+      uint16_t *p = &buf[n * w];
+      if (s && n) { // Repeat the previous scanline
+        memcpy(p, p - w, w * sizeof(uint16_t));
+      } else {
+        for (int8_t i = 0; i < 6; i++) {
+          uint16_t pc = ((i < 5) && (columns[i] & (1 << j))) ? color : bg;
+          for (uint8_t k = 0; k < size_x; k++)
+            p[i * size_x + k] = pc;
+        }
+      }
+      if (++n == rows) { // Buffer full
+        writePixels(buf, n * w);
+        n = 0;
+      }
+    }
+  }
+  if (n)
+    writePixels(buf, n * w);
+  endWrite();
+}
+
+/*!
+    @brief  Print one byte/character of data, used to support print().
+            Same as Adafruit_GFX::write(), but opaque 'classic' font
+            characters are drawn by drawChar() above.
+    @param  c  The 8-bit ascii character to write.
+*/
+size_t Adafruit_SPITFT::write(uint8_t c) {
+  if (gfxFont || (textbgcolor == textcolor) || (c == '\n') || (c == '\r'))
+    return Adafruit_GFX::write(c);
+
+  if (wrap && ((cursor_x + textsize_x * 6) > _width)) { // Off right?
+    cursor_x = 0;                                       // Reset x to zero,
+    cursor_y += textsize_y * 8; // advance y one line
+  }
+  drawChar(cursor_x, cursor_y, c, textcolor, textbgcolor, textsize_x,
+           textsize_y);
+  cursor_x += textsize_x * 6; // Advance x one char
+  return 1;
+}
+
+
+// Whether blitTo() waits for each row. Only the ESP32 DMA code alternates
+// its buffers across writePixels() calls, the others restart from the first
+#if defined(ESP32) && defined(USE_SPI_DMA)
+#define BLIT_ROW_BLOCK false
+#else
+#define BLIT_ROW_BLOCK true
+#endif
+
+/*!
+    @brief  Clip a changed area of a canvas drawn at (x,y) to the display,
+            in the display's current rotation.
+    @param  tft  Display the canvas is drawn to.
+    @param  r    Changed area in canvas coordinates, clipped in place to
+                 the part which is on screen.
+    @param  x    Display column of the canvas's left edge.
+    @param  y    Display row of the canvas's top edge.
+    @return true if some of the area is on screen.
+*/
+static bool clipDirtyRect(Adafruit_SPITFT &tft, GFXdirtyRects::Rect &r,
+                          int16_t x, int16_t y) {
+  if (r.x1 < -x)
+    r.x1 = -x;
+  if (r.y1 < -y)
+    r.y1 = -y;
+  if (r.x2 >= tft.width() - x)
+    r.x2 = tft.width() - x - 1;
+  if (r.y2 >= tft.height() - y)
+    r.y2 = tft.height() - y - 1;
+  return (r.x1 <= r.x2) && (r.y1 <= r.y2);
+}
+
+/*!
+    @brief  Send the areas of the canvas changed since the last blitTo()
+            to a display, as drawRGBBitmap(x, y, getBuffer(), WIDTH,
+            HEIGHT) would but leaving the rest of the screen alone (the
+            whole canvas is sent without GFX_DIRTY_TRACKING). Each
+            area is one address window, its rows are queued without
+            waiting where the ESP32 DMA code is used.
+    @note   The canvas's rotation only changes how drawing maps to the
+            buffer, it is not applied here: the buffer is sent as it is
+            laid out, WIDTH by HEIGHT, at (x,y) in the display's current
+            rotation and clipped to that.
+    @param  tft  Display to draw to, in the same state as for drawing
+                 (not inside a startWrite()).
+    @param  x    Display column of the canvas's left edge, in the
+                 display's current rotation.
+    @param  y    Display row of the canvas's top edge.
+*/
+void GFXcanvas16::blitTo(Adafruit_SPITFT &tft, int16_t x, int16_t y) {
+  if (!buffer)
+    return;
+  dirty.flush();
+  tft.startWrite();
+  for (uint8_t i = 0; i < dirty.count; i++) {
+    GFXdirtyRects::Rect r = dirty.rect[i];
+    if (!clipDirtyRect(tft, r, x, y))
+      continue;
+    int16_t w = r.x2 - r.x1 + 1, h = r.y2 - r.y1 + 1;
+    uint16_t *pcolors = &buffer[r.y1 * WIDTH + r.x1];
+    tft.setAddrWindow(x + r.x1, y + r.y1, w, h);
+    if (w == WIDTH) { // Whole rows are contiguous in the buffer
+      tft.writePixels(pcolors, (uint32_t)w * h, false);
+    } else {
+      while (h--) {
+        tft.writePixels(pcolors, w, BLIT_ROW_BLOCK);
+        pcolors += WIDTH;
+      }
+    }
+    tft.dmaWait(); // Before the next address window
+  }
+  tft.endWrite();
+  clearDirty();
+}
+
+/*!
+    @brief  Send the areas of the canvas changed since the last blitTo()
+            to a display, converting each pixel's byte through a palette
+            of 16-bit colors. See GFXcanvas16::blitTo(), the canvas's
+            rotation is not applied either.
+    @param  tft      Display to draw to.
+    @param  x        Display column of the canvas's left edge.
+    @param  y        Display row of the canvas's top edge.
+    @param  palette  256 colors in '565' RGB format, one for each value of
+                     a canvas pixel.
+*/
+void GFXcanvas8::blitTo(Adafruit_SPITFT &tft, int16_t x, int16_t y,
+                        const uint16_t *palette) {
+  if (!buffer)
+    return;
+  dirty.flush();
+  uint16_t line[64]; // Converted pixels, sent while the next are converted
+  tft.startWrite();
+  for (uint8_t i = 0; i < dirty.count; i++) {
+    GFXdirtyRects::Rect r = dirty.rect[i];
+    if (!clipDirtyRect(tft, r, x, y))
+      continue;
+    int16_t w = r.x2 - r.x1 + 1, h = r.y2 - r.y1 + 1;
+    const uint8_t *row = &buffer[r.y1 * WIDTH + r.x1];
+    tft.setAddrWindow(x + r.x1, y + r.y1, w, h);
+    while (h--) {
+      for (int16_t col = 0; col < w;) {
+        int16_t n = min(w - col, (int)(sizeof line / sizeof line[0]));
+        for (int16_t j = 0; j < n; j++)
+          line[j] = palette[row[col + j]];
+        tft.writePixels(line, n, BLIT_ROW_BLOCK);
+        col += n;
+      }
+      row += WIDTH;
+    }
+    tft.dmaWait(); // Before the next address window
+  }
+  tft.endWrite();
+  clearDirty();
+}
+
 // -------------------------------------------------------------------------
 // Miscellaneous class member functions that don't draw anything.
 
@@ -87,9 +87,77 @@ typedef volatile ADAGFX_PORT_t *PORTreg_t; ///< PORT register type
 // Estimated RAM usage:
 // 4 bytes/pixel on display major axis + 8 bytes/pixel on minor axis,
 // e.g. 320x240 pixels = 320 * 4 + 240 * 8 = 3,200 bytes.
+// On ESP32 (all variants) DMA is used for the default SPI bus through the
+// ESP-IDF SPI master driver, hardware SPI only. Estimated RAM usage:
+// 4 bytes/pixel on display major axis, e.g. 320x240 pixels = 1,280 bytes.
 
 #if defined(USE_SPI_DMA) && (defined(__SAMD51__) || defined(ARDUINO_SAMD_ZERO))
 #include <Adafruit_ZeroDMA.h>
+#elif defined(USE_SPI_DMA) && defined(ESP32)
+#include <driver/spi_master.h>
+
+/*!
+  @brief  Sends the pixel data of Adafruit_SPITFT with DMA on ESP32, up to
+          two transfers at a time, completing in the order they were queued.
+          Adafruit_SPITFT_ESP32DMA is used unless another is given to
+          Adafruit_SPITFT::setDMAQueue(), e.g. to check the transfers.
+*/
+class Adafruit_SPITFT_DMAQueue {
+public:
+  virtual ~Adafruit_SPITFT_DMAQueue() {}
+  /*!
+      @brief  Get ready to send, or change the clock of a queue in use.
+      @param  freq     SPI clock frequency.
+      @param  spiMode  SPI_MODEn.
+      @return true on success, false if DMA can't be used.
+  */
+  virtual bool begin(uint32_t freq, uint8_t spiMode) = 0;
+  /*!
+      @brief  Wait until fewer than two transfers are in progress.
+  */
+  virtual void reserve(void) = 0;
+  /*!
+      @brief  Start sending data, waits first if two transfers are in
+              progress.
+      @param  data  Data to send. It's not copied, must stay unchanged until
+                    the transfer is complete.
+      @param  len   Number of bytes.
+  */
+  virtual void queue(const void *data, uint32_t len) = 0;
+  /*!
+      @brief  Check for transfers in progress without waiting.
+      @return true if any transfer is in progress.
+  */
+  virtual bool busy(void) = 0;
+  /*!
+      @brief  Wait until all transfers are complete, and leave the SPI
+              peripheral ready for the Arduino SPI functions.
+  */
+  virtual void wait(void) = 0;
+};
+
+/*!
+  @brief  Adafruit_SPITFT_DMAQueue of the default SPI bus using the ESP-IDF
+          SPI master driver. The pins stay routed by the Arduino SPI
+          begin(), CS and DC stay with Adafruit_SPITFT, only the pixel data
+          goes through the driver.
+*/
+class Adafruit_SPITFT_ESP32DMA : public Adafruit_SPITFT_DMAQueue {
+public:
+  ~Adafruit_SPITFT_ESP32DMA();
+  bool begin(uint32_t freq, uint8_t spiMode) override;
+  void reserve(void) override;
+  void queue(const void *data, uint32_t len) override;
+  bool busy(void) override;
+  void wait(void) override;
+
+private:
+  spi_device_handle_t dev = NULL; ///< SPI master device, NULL until begin()
+  spi_transaction_t trans[2];     ///< Transactions, up to 2 in progress
+  uint8_t queued = 0;             ///< # of transactions in progress
+  uint8_t next = 0;               ///< Index of next trans[] to use
+  bool used = false; ///< SPI registers need restoring by wait()
+};
 #endif
 
 // This is kind of a kludge. Needed a way to disambiguate the software SPI
@@ -158,7 +226,7 @@ public:
 
   // DESTRUCTOR ----------------------------------------------------------
 
-  ~Adafruit_SPITFT(){};
+  ~Adafruit_SPITFT();
 
   // CLASS MEMBER FUNCTIONS ----------------------------------------------
 
@@ -236,6 +304,10 @@ public:
   // Used by writePixels() in some situations, but might have rare need in
   // user code, so it's public...
   bool dmaBusy(void) const; // true if DMA is used and busy, false otherwise
+#if defined(USE_SPI_DMA) && defined(ESP32)
+  // Send the pixels through another DMA queue, call before begin()
+  void setDMAQueue(Adafruit_SPITFT_DMAQueue *queue) { dmaCustom = queue; }
+#endif
   void swapBytes(uint16_t *src, uint32_t len, uint16_t *dest = NULL);
 
   // These functions are similar to the 'write' functions above, but with
@@ -255,6 +327,19 @@ public:
   void drawRGBBitmap(int16_t x, int16_t y, uint16_t *pcolors, int16_t w,
                      int16_t h);
 
+  // Opaque 'classic' font characters are sent as one window of pixels,
+  // write() is overridden so print() draws them the same way:
+  void drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color,
+                uint16_t bg, uint8_t size);
+  void drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color,
+                uint16_t bg, uint8_t size_x, uint8_t size_y);
+  using Adafruit_GFX::write;
+#if ARDUINO >= 100
+  size_t write(uint8_t c);
+#else
+  void write(uint8_t c);
+#endif
+
   void invertDisplay(bool i);
   uint16_t color565(uint8_t r, uint8_t g, uint8_t b);
 
@@ -381,7 +466,6 @@ protected:
   inline void TFT_WR_STROBE(void); // Parallel interface write strobe
   inline void TFT_RD_HIGH(void);   // Parallel interface read high
   inline void TFT_RD_LOW(void);    // Parallel interface read low
-
   // CLASS INSTANCE VARIABLES --------------------------------------------
 
   // Here be dragons! There's a big union of three structures here --
@@ -500,6 +584,15 @@ protected:
   uint16_t lastFillColor = 0;        ///< Last color used w/fill
   uint32_t lastFillLen = 0;          ///< # of pixels w/last fill
   uint8_t onePixelBuf;               ///< For hi==lo fill
+#elif defined(USE_SPI_DMA) && defined(ESP32) // Used by hardware SPI
+  Adafruit_SPITFT_ESP32DMA dmaDriver;          ///< Default DMA queue
+  Adafruit_SPITFT_DMAQueue *dmaCustom = NULL;  ///< From setDMAQueue()
+  Adafruit_SPITFT_DMAQueue *dma = NULL;        ///< DMA queue, NULL if no DMA
+  uint16_t *pixelBuf[2] = {NULL};              ///< Working buffers
+  uint16_t maxFillLen;                         ///< Max pixels per DMA xfer
+  uint16_t lastFillColor = 0;                  ///< Last color used w/fill
+  uint32_t lastFillLen = 0;                    ///< # of pixels w/last fill
+  uint8_t dmaNext = 0; ///< Index of next pixelBuf[] to fill
 #endif
 #if defined(USE_FAST_PINIO)
 #if defined(HAS_PORT_SET_CLR)
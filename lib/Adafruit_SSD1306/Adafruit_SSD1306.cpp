@@ -498,6 +498,8 @@ bool Adafruit_SSD1306::begin(uint8_t vcs, uint8_t addr, bool reset,
   if ((!buffer) && !(buffer = (uint8_t *)malloc(WIDTH * ((HEIGHT + 7) / 8))))
     return false;
 
+  memset(dirtyX1, 0xFF, sizeof(dirtyX1)); // No changes to send yet
+  memset(dirtyX2, 0, sizeof(dirtyX2));
   clearDisplay();
 
 #ifndef SSD1306_NO_SPLASH
@@ -658,6 +660,7 @@ void Adafruit_SSD1306::drawPixel(int16_t x, int16_t y, uint16_t color) {
       y = HEIGHT - y - 1;
       break;
     }
+    markDirty(x, x, y / 8, y / 8);
     switch (color) {
     case SSD1306_WHITE:
       buffer[x + (y / 8) * WIDTH] |= (1 << (y & 7));
@@ -681,6 +684,7 @@ void Adafruit_SSD1306::drawPixel(int16_t x, int16_t y, uint16_t color) {
 */
 void Adafruit_SSD1306::clearDisplay(void) {
   memset(buffer, 0, WIDTH * ((HEIGHT + 7) / 8));
+  markDirty();
 }
 
 /*!
@@ -760,6 +764,7 @@ void Adafruit_SSD1306::drawFastHLineInternal(int16_t x, int16_t y, int16_t w,
       w = (WIDTH - x);
     }
     if (w > 0) { // Proceed only if width is positive
+      markDirty(x, x + w - 1, y / 8, y / 8);
       uint8_t *pBuf = &buffer[(y / 8) * WIDTH + x], mask = 1 << (y & 7);
       switch (color) {
       case SSD1306_WHITE:
@@ -863,6 +868,7 @@ void Adafruit_SSD1306::drawFastVLineInternal(int16_t x, int16_t __y,
       // use local byte registers for faster juggling
       uint8_t y = __y, h = __h;
       uint8_t *pBuf = &buffer[(y / 8) * WIDTH + x];
+      markDirty(x, x, y / 8, (y + h - 1) / 8);
 
       // do the first partial byte, if necessary - this requires some masking
       uint8_t mod = (y & 7);
@@ -981,26 +987,65 @@ bool Adafruit_SSD1306::getPixel(int16_t x, int16_t y) {
     @return Pointer to an unsigned 8-bit array, column-major, columns padded
             to full byte boundary if needed.
 */
-uint8_t *Adafruit_SSD1306::getBuffer(void) { return buffer; }
+uint8_t *Adafruit_SSD1306::getBuffer(void) {
+  markDirty(); // The caller may change any part of it
+  return buffer;
+}
+
+/*!
+    @brief  Mark the whole display buffer to be sent by the next display().
+    @return None (void).
+    @note   The drawing functions mark the parts they change. Call this
+            after changing the buffer directly through a pointer kept from
+            an earlier getBuffer() call.
+*/
+void Adafruit_SSD1306::markDirty(void) {
+  markDirty(0, WIDTH - 1, 0, (HEIGHT - 1) / 8);
+}
 
 // REFRESH DISPLAY ---------------------------------------------------------
 
+/*!
+    @brief  Set the pages and columns of the display RAM written by the
+            following data. This is a protected function, not exposed.
+    @param  page1
+            First page.
+    @param  page2
+            Last page.
+    @param  col1
+            First column.
+    @param  col2
+            Last column.
+    @return None (void).
+*/
+void Adafruit_SSD1306::ssd1306_window(uint8_t page1, uint8_t page2,
+                                      uint8_t col1, uint8_t col2) {
+  uint8_t cmd[] = {SSD1306_PAGEADDR, page1, page2,
+                   SSD1306_COLUMNADDR, col1, col2};
+  if (wire) { // I2C, all in one transmission
+    wire->beginTransmission(i2caddr);
+    WIRE_WRITE((uint8_t)0x00); // Co = 0, D/C = 0
+    for (uint8_t i = 0; i < sizeof(cmd); i++)
+      WIRE_WRITE(cmd[i]);
+    wire->endTransmission();
+  } else { // SPI -- transaction started in calling function
+    SSD1306_MODE_COMMAND
+    for (uint8_t i = 0; i < sizeof(cmd); i++)
+      SPIwrite(cmd[i]);
+  }
+}
+
 /*!
     @brief  Push data currently in RAM to SSD1306 display.
     @return None (void).
     @note   Drawing operations are not visible until this function is
             called. Call after each graphics command, or after a whole set
             of graphics commands, as best needed by one's own application.
+            Only the columns of the pages changed since the last call are
+            sent, consecutive pages with the same columns in one window.
 */
 void Adafruit_SSD1306::display(void) {
   TRANSACTION_START
-  static const uint8_t PROGMEM dlist1[] = {
-      SSD1306_PAGEADDR,
-      0,                      // Page start address
-      0xFF,                   // Page end (not really, but works here)
-      SSD1306_COLUMNADDR, 0}; // Column start address
-  ssd1306_commandList(dlist1, sizeof(dlist1));
-  ssd1306_command1(WIDTH - 1); // Column end address
 
 #if defined(ESP8266)
   // ESP8266 needs a periodic yield() call to avoid watchdog reset.
@@ -1011,27 +1056,55 @@ void Adafruit_SSD1306::display(void) {
   // 32-byte transfer condition below.
   yield();
 #endif
-  uint16_t count = WIDTH * ((HEIGHT + 7) / 8);
-  uint8_t *ptr = buffer;
-  if (wire) { // I2C
-    wire->beginTransmission(i2caddr);
-    WIRE_WRITE((uint8_t)0x40);
-    uint16_t bytesOut = 1;
-    while (count--) {
-      if (bytesOut >= WIRE_MAX) {
-        wire->endTransmission();
-        wire->beginTransmission(i2caddr);
-        WIRE_WRITE((uint8_t)0x40);
-        bytesOut = 1;
+  uint8_t pages = (HEIGHT + 7) / 8;
+  if (pages > SSD1306_MAX_PAGES)
+    pages = SSD1306_MAX_PAGES;
+  for (uint8_t page = 0; page < pages;) {
+    uint8_t x1 = dirtyX1[page], x2 = dirtyX2[page];
+    if (x1 > x2) { // Unchanged
+      page++;
+      continue;
+    }
+    uint8_t last = page;
+    while ((last + 1 < pages) && (dirtyX1[last + 1] == x1) &&
+           (dirtyX2[last + 1] == x2))
+      last++;
+
+    ssd1306_window(page, last, x1, x2);
+
+    if (wire) { // I2C
+      wire->beginTransmission(i2caddr);
+      WIRE_WRITE((uint8_t)0x40);
+      uint16_t bytesOut = 1;
+      for (uint8_t p = page; p <= last; p++) {
+        uint8_t *ptr = &buffer[p * WIDTH + x1];
+        uint8_t count = x2 - x1 + 1;
+        while (count--) {
+          if (bytesOut >= WIRE_MAX) {
+            wire->endTransmission();
+            wire->beginTransmission(i2caddr);
+            WIRE_WRITE((uint8_t)0x40);
+            bytesOut = 1;
+          }
+          WIRE_WRITE(*ptr++);
+          bytesOut++;
+        }
+      }
+      wire->endTransmission();
+    } else { // SPI
+      SSD1306_MODE_DATA
+      for (uint8_t p = page; p <= last; p++) {
+        uint8_t *ptr = &buffer[p * WIDTH + x1];
+        uint8_t count = x2 - x1 + 1;
+        while (count--)
+          SPIwrite(*ptr++);
       }
-      WIRE_WRITE(*ptr++);
-      bytesOut++;
     }
-    wire->endTransmission();
-  } else { // SPI
-    SSD1306_MODE_DATA
-    while (count--)
-      SPIwrite(*ptr++);
+
+    for (; page <= last; page++) {
+      dirtyX1[page] = 0xFF;
+      dirtyX2[page] = 0;
+    }
   }
   TRANSACTION_END
 #if defined(ESP8266)
@@ -1147,6 +1220,7 @@ void Adafruit_SSD1306::stopscroll(void) {
   TRANSACTION_START
   ssd1306_command1(SSD1306_DEACTIVATE_SCROLL);
   TRANSACTION_END
+  markDirty(); // The display RAM must be rewritten after a scroll
 }
 
 // OTHER HARDWARE SETTINGS -------------------------------------------------
@@ -110,6 +110,8 @@ typedef uint32_t PortMask;
 #define SSD1306_ACTIVATE_SCROLL 0x2F                      ///< Start scroll
 #define SSD1306_SET_VERTICAL_SCROLL_AREA 0xA3             ///< Set scroll range
 
+#define SSD1306_MAX_PAGES 8 ///< Pages of 8 rows of the tallest (64 row) display
+
 // Deprecated size stuff for backwards compatibility with old sketches
 #if defined SSD1306_128_64
 #define SSD1306_LCDWIDTH 128 ///< DEPRECATED: width w/SSD1306_128_64 defined
@@ -164,6 +166,7 @@ public:
   void ssd1306_command(uint8_t c);
   bool getPixel(int16_t x, int16_t y);
   uint8_t *getBuffer(void);
+  void markDirty(void);
 
 protected:
   inline void SPIwrite(uint8_t d) __attribute__((always_inline));
@@ -171,6 +174,22 @@ protected:
   void drawFastVLineInternal(int16_t x, int16_t y, int16_t h, uint16_t color);
   void ssd1306_command1(uint8_t c);
   void ssd1306_commandList(const uint8_t *c, uint8_t n);
+  void ssd1306_window(uint8_t page1, uint8_t page2, uint8_t col1, uint8_t col2);
+  /*!
+      @brief  Mark columns of pages to be sent by the next display().
+      @param  x1  First column.
+      @param  x2  Last column.
+      @param  p1  First page.
+      @param  p2  Last page.
+  */
+  inline void markDirty(uint8_t x1, uint8_t x2, uint8_t p1, uint8_t p2) {
+    for (; p1 <= p2 && p1 < SSD1306_MAX_PAGES; p1++) {
+      if (x1 < dirtyX1[p1])
+        dirtyX1[p1] = x1;
+      if (x2 > dirtyX2[p1])
+        dirtyX2[p1] = x2;
+    }
+  }
 
   SPIClass *spi;   ///< Initialized during construction when using SPI. See
                    ///< SPI.cpp, SPI.h
@@ -198,6 +217,9 @@ protected:
   uint32_t restoreClk; ///< Wire speed following SSD1306 transfers
 #endif
   uint8_t contrast; ///< normal contrast setting for this device
+  uint8_t dirtyX1[SSD1306_MAX_PAGES]; ///< First changed column of each page,
+                                      ///< 0xFF if the page is unchanged
+  uint8_t dirtyX2[SSD1306_MAX_PAGES]; ///< Last changed column of each page
 #if defined(SPI_HAS_TRANSACTION)
 protected:
   // Allow sub-class to change
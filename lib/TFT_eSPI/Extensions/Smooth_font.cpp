@@ -245,6 +245,57 @@ void TFT_eSPI::loadMetrics(void)
   gFont.yAdvance = gFont.maxAscent + gFont.maxDescent;
 
   gFont.spaceWidth = (gFont.ascent + gFont.descent) * 2/7;  // Guess at space width
+
+  // The Processing sketch creates fonts with the glyphs in code order, so normally
+  // the codes can be binary searched directly. If not then create a sorted index.
+  gSorted = true;
+  for (gNum = 1; gNum < gFont.gCount; gNum++)
+  {
+    if (gUnicode[gNum] < gUnicode[gNum - 1])
+    {
+      sortUnicodeIndex();
+      break;
+    }
+  }
+}
+
+
+/***************************************************************************************
+** Function name:           sortUnicodeIndex
+** Description:             Create an index of glyph numbers in Unicode order
+*************************************************************************************x*/
+void TFT_eSPI::sortUnicodeIndex(void)
+{
+  gSortedIndex = (uint16_t*)malloc( gFont.gCount * 2);
+
+  // Linear search is used if there is not enough memory
+  if (gSortedIndex == NULL) { gSorted = false; return; }
+
+  for (uint16_t i = 0; i < gFont.gCount; i++) gSortedIndex[i] = i;
+
+  // Shell sort, fonts can have thousands of glyphs. Equal codes are kept in file order
+  // so the first one is found, as with a linear search.
+  uint16_t gap = 1;
+  while (gap < gFont.gCount / 3) gap = gap * 3 + 1;
+
+  while (gap > 0)
+  {
+    for (uint16_t i = gap; i < gFont.gCount; i++)
+    {
+      uint16_t gNum = gSortedIndex[i];
+      uint16_t j = i;
+      while (j >= gap)
+      {
+        uint16_t prev = gSortedIndex[j - gap];
+        if (gUnicode[prev] < gUnicode[gNum] || (gUnicode[prev] == gUnicode[gNum] && prev < gNum)) break;
+        gSortedIndex[j] = prev;
+        j -= gap;
+      }
+      gSortedIndex[j] = gNum;
+    }
+    gap /= 3;
+    yield();
+  }
 }
 
 
@@ -296,6 +347,23 @@ void TFT_eSPI::unloadFont( void )
     gBitmap = NULL;
   }
 
+  if (gSortedIndex)
+  {
+    free(gSortedIndex);
+    gSortedIndex = NULL;
+  }
+
+  if (gGlyphBuf)
+  {
+    free(gGlyphBuf);
+    gGlyphBuf = NULL;
+  }
+
+  gGlyphBufSize = 0;
+  gSorted = false;
+
+  freeGlyphCache();
+
   gFont.gArray = nullptr;
 
 #ifdef FONT_FS_AVAILABLE
@@ -340,15 +408,292 @@ uint32_t TFT_eSPI::readInt32(void)
 *************************************************************************************x*/
 bool TFT_eSPI::getUnicodeIndex(uint16_t unicode, uint16_t *index)
 {
-  for (uint16_t i = 0; i < gFont.gCount; i++)
+  if (!gSorted)
+  {
+    for (uint16_t i = 0; i < gFont.gCount; i++)
+    {
+      if (gUnicode[i] == unicode)
+      {
+        *index = i;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // Binary search for the first glyph with a code >= unicode
+  uint16_t lo = 0;
+  uint16_t hi = gFont.gCount;
+  while (lo < hi)
+  {
+    uint16_t mid = (lo + hi) >> 1;
+    uint16_t gNum = gSortedIndex ? gSortedIndex[mid] : mid;
+    if (gUnicode[gNum] < unicode) lo = mid + 1;
+    else hi = mid;
+  }
+
+  if (lo == gFont.gCount) return false;
+
+  uint16_t gNum = gSortedIndex ? gSortedIndex[lo] : lo;
+  if (gUnicode[gNum] != unicode) return false;
+
+  *index = gNum;
+  return true;
+}
+
+
+/***************************************************************************************
+** Function name:           setGlyphReadback
+** Description:             Blend anti-aliased glyphs with the pixels read from the TFT
+*************************************************************************************x*/
+void TFT_eSPI::setGlyphReadback(bool readback)
+{
+  gReadback = readback;
+}
+
+
+/***************************************************************************************
+** Function name:           setGlyphCache
+** Description:             Set the RAM budget for caching glyph bitmaps from font files
+*************************************************************************************x*/
+void TFT_eSPI::setGlyphCache(uint32_t size, bool psram)
+{
+  freeGlyphCache();
+  gCacheSize  = size;
+  gCachePsram = psram;
+}
+
+
+/***************************************************************************************
+** Function name:           freeGlyphCache
+** Description:             Delete all cached glyph bitmaps
+*************************************************************************************x*/
+void TFT_eSPI::freeGlyphCache(void)
+{
+  while (gCache)
+  {
+    glyphCacheEntry* next = gCache->next;
+    free(gCache);
+    gCache = next;
+  }
+  gCacheUsed = 0;
+}
+
+
+/***************************************************************************************
+** Function name:           cacheGlyph
+** Description:             Find a glyph in the cache, load it from the font file if absent
+*************************************************************************************x*/
+// Returns nullptr if the glyph cannot be cached
+TFT_eSPI::glyphCacheEntry* TFT_eSPI::cacheGlyph(uint16_t gNum)
+{
+  glyphCacheEntry* prev  = nullptr;
+  glyphCacheEntry* entry = gCache;
+
+  while (entry)
+  {
+    if (entry->gNum == gNum)
+    {
+      // Move to the front of the list as most recently used
+      if (prev)
+      {
+        prev->next  = entry->next;
+        entry->next = gCache;
+        gCache = entry;
+      }
+      return entry;
+    }
+    prev  = entry;
+    entry = entry->next;
+  }
+
+#ifdef FONT_FS_AVAILABLE
+  if (!fs_font) return nullptr;
+
+  uint32_t bitmapSize = gWidth[gNum] * gHeight[gNum];
+  uint32_t size = sizeof(glyphCacheEntry) + bitmapSize;
+
+  if (size > gCacheSize) return nullptr;
+
+  // Discard least recently used glyphs (end of the list) until the new one fits
+  while (gCache && gCacheUsed + size > gCacheSize)
+  {
+    glyphCacheEntry** last = &gCache;
+    while ((*last)->next) last = &(*last)->next;
+    gCacheUsed -= sizeof(glyphCacheEntry) + gWidth[(*last)->gNum] * gHeight[(*last)->gNum];
+    free(*last);
+    *last = nullptr;
+  }
+
+#if defined (ESP32) && defined (CONFIG_SPIRAM_SUPPORT)
+  if ( gCachePsram && psramFound() ) entry = (glyphCacheEntry*)ps_malloc(size);
+  else
+#endif
+  entry = (glyphCacheEntry*)malloc(size);
+
+  if (entry == nullptr) return nullptr;
+
+  fontFile.seek(gBitmap[gNum], fs::SeekSet);
+  if (fontFile.read((uint8_t*)(entry + 1), bitmapSize) != bitmapSize)
+  {
+    free(entry);
+    return nullptr;
+  }
+
+  entry->gNum = gNum;
+  entry->next = gCache;
+  gCache = entry;
+  gCacheUsed += size;
+
+  return entry;
+#else
+  return nullptr;
+#endif
+}
+
+
+/***************************************************************************************
+** Function name:           getGlyphBitmap
+** Description:             Get a pointer to the 8-bit alpha bitmap of a glyph
+*************************************************************************************x*/
+// Array fonts are in FLASH (use pgm_read_byte), cached bitmaps are in RAM.
+// Returns nullptr if the bitmap must be read from the font file.
+const uint8_t* TFT_eSPI::getGlyphBitmap(uint16_t gNum)
+{
+#ifdef FONT_FS_AVAILABLE
+  if (fs_font)
+  {
+    glyphCacheEntry* entry = gCacheSize ? cacheGlyph(gNum) : nullptr;
+    return entry ? (const uint8_t*)(entry + 1) : nullptr;
+  }
+#endif
+  return gFont.gArray + gBitmap[gNum];
+}
+
+
+/***************************************************************************************
+** Function name:           prefetchGlyphs
+** Description:             Load the glyphs for a string into the glyph cache
+*************************************************************************************x*/
+void TFT_eSPI::prefetchGlyphs(const String& string)
+{
+  prefetchGlyphs(string.c_str());
+}
+
+void TFT_eSPI::prefetchGlyphs(const char *string)
+{
+#ifdef FONT_FS_AVAILABLE
+  if (!fontLoaded || !fs_font || gCacheSize == 0) return;
+
+  uint16_t len = strlen(string);
+  uint16_t* gList = (uint16_t*)malloc(len * 2);
+  if (gList == nullptr) return;
+
+  // Find the glyphs used, without duplicates
+  uint16_t count = 0;
+  uint16_t n = 0;
+  while (n < len)
   {
-    if (gUnicode[i] == unicode)
+    uint16_t gNum;
+    uint16_t unicode = decodeUTF8((uint8_t*)string, &n, len - n);
+    if (unicode < 0x21 || !getUnicodeIndex(unicode, &gNum)) continue;
+
+    uint16_t i = 0;
+    while (i < count && gList[i] != gNum) i++;
+    if (i == count) gList[count++] = gNum;
+  }
+
+  // Sort in file order so the file is read in one pass without seeking back
+  for (uint16_t i = 1; i < count; i++)
+  {
+    uint16_t gNum = gList[i];
+    uint16_t j = i;
+    while (j > 0 && gBitmap[gList[j - 1]] > gBitmap[gNum]) { gList[j] = gList[j - 1]; j--; }
+    gList[j] = gNum;
+  }
+
+  for (uint16_t i = 0; i < count; i++) cacheGlyph(gList[i]);
+
+  free(gList);
+#else
+  string = string; // Avoid unused variable warning
+#endif
+}
+
+
+/***************************************************************************************
+** Function name:           drawGlyphBuffered
+** Description:             Render a glyph bitmap to a buffer and push it in one window
+*************************************************************************************x*/
+// Returns false if the glyph has not been drawn and must be plotted pixel by pixel
+bool TFT_eSPI::drawGlyphBuffered(uint16_t gNum, int32_t cx, int32_t cy, int32_t bx, uint16_t fg, uint16_t bg, const uint8_t* gPtr, uint8_t* pbuffer)
+{
+  // The colour callback is called for every pixel
+  if (getColor) return false;
+
+  // Without a background fill the pixels under the glyph must be read from the TFT.
+  // With a fill, pixels left of bx overlap the previous character so must not be drawn.
+  if (_fillbg) { if (bx > 0) return false; }
+  else if (!gReadback) return false;
+
+  int32_t w = gWidth[gNum];
+  int32_t h = gHeight[gNum];
+  uint32_t size = w * h;
+
+  if (size == 0) return true;
+
+  if (size > gGlyphBufSize)
+  {
+    uint16_t* buf = (uint16_t*)realloc(gGlyphBuf, size * 2);
+    if (buf == NULL) return false;
+    gGlyphBuf = buf;
+    gGlyphBufSize = size;
+  }
+
+  // Pixels are read with swapped byte order for compatibility with pushRect()
+  if (!_fillbg) readRect(cx, cy, w, h, gGlyphBuf);
+
+  uint16_t* p = gGlyphBuf;
+
+  for (int32_t y = 0; y < h; y++)
+  {
+#ifdef FONT_FS_AVAILABLE
+    if (pbuffer) {
+      if (spiffs) fontFile.read(pbuffer, w);
+      else
+      {
+        endWrite();    // Release SPI for SD card transaction
+        fontFile.read(pbuffer, w);
+        startWrite();  // Re-start SPI for TFT transaction
+      }
+    }
+#endif
+
+    for (int32_t x = 0; x < w; x++, p++)
     {
-      *index = i;
-      return true;
+      uint8_t pixel;
+#ifdef FONT_FS_AVAILABLE
+      if (pbuffer) pixel = pbuffer[x];
+      else
+#endif
+      pixel = pgm_read_byte(gPtr + x + w * y);
+
+      if (pixel == 0xFF) *p = fg;
+      else if (_fillbg) *p = pixel ? alphaBlend(pixel, fg, bg) : bg;
+      else
+      {
+        uint16_t tftColor = (*p >> 8) | (*p << 8);
+        *p = pixel ? alphaBlend(pixel, fg, tftColor) : tftColor;
+      }
     }
   }
-  return false;
+
+  // Buffer holds colours in native byte order
+  bool swap = _swapBytes; _swapBytes = true;
+  pushImage(cx, cy, w, h, gGlyphBuf);
+  _swapBytes = swap;
+
+  return true;
 }
 
 
@@ -405,10 +750,10 @@ void TFT_eSPI::drawGlyph(uint16_t code)
     if (cursor_x == 0) cursor_x -= gdX[gNum];
 
     uint8_t* pbuffer = nullptr;
-    const uint8_t* gPtr = (const uint8_t*) gFont.gArray;
+    const uint8_t* gPtr = getGlyphBitmap(gNum);
 
 #ifdef FONT_FS_AVAILABLE
-    if (fs_font)
+    if (gPtr == nullptr) // Not in the glyph cache so read from file line by line
     {
       fontFile.seek(gBitmap[gNum], fs::SeekSet);
       pbuffer =  (uint8_t*)malloc(gWidth[gNum]);
@@ -458,10 +803,13 @@ void TFT_eSPI::drawGlyph(uint16_t code)
       }
     }
 
-    for (int32_t y = 0; y < gHeight[gNum]; y++)
+    // Glyph is pushed in one window if the background is known, else plot it pixel by pixel
+    bool drawn = drawGlyphBuffered(gNum, cx, cy, bx, fg, bg, gPtr, pbuffer);
+
+    for (int32_t y = 0; !drawn && y < gHeight[gNum]; y++)
     {
 #ifdef FONT_FS_AVAILABLE
-      if (fs_font) {
+      if (pbuffer) {
         if (spiffs)
         {
           fontFile.read(pbuffer, gWidth[gNum]);
@@ -480,10 +828,10 @@ void TFT_eSPI::drawGlyph(uint16_t code)
       for (int32_t x = 0; x < gWidth[gNum]; x++)
       {
 #ifdef FONT_FS_AVAILABLE
-        if (fs_font) pixel = pbuffer[x];
+        if (pbuffer) pixel = pbuffer[x];
         else
 #endif
-        pixel = pgm_read_byte(gPtr + gBitmap[gNum] + x + gWidth[gNum] * y);
+        pixel = pgm_read_byte(gPtr + x + gWidth[gNum] * y);
 
         if (pixel)
         {
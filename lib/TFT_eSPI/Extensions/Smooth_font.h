@@ -14,6 +14,19 @@
 
   virtual void drawGlyph(uint16_t code);
 
+           // Read the screen under each glyph so anti-aliased edges are blended with it
+           // when the background is not filled (TFT must support reading graphics RAM)
+  void     setGlyphReadback(bool readback);
+
+           // Keep up to size bytes of glyph bitmaps from font files in RAM, least recently
+           // used glyphs are discarded first. Set psram true to prefer PSRAM (ESP32 only).
+  void     setGlyphCache(uint32_t size, bool psram = false);
+           // Load the glyphs of a string into the cache in file order
+  void     prefetchGlyphs(const char *string);
+  void     prefetchGlyphs(const String& string);
+           // Pointer to a glyph bitmap in FLASH or cache, nullptr if it must be read from file
+  const uint8_t* getGlyphBitmap(uint16_t gNum);
+
   void     showFont(uint32_t td);
 
  // This is for the whole font
@@ -33,6 +46,7 @@ fontMetrics gFont = { nullptr, 0, 0, 0, 0, 0, 0, 0 };
 
   // These are for the metrics for each individual glyph (so we don't need to seek this in file and waste time)
   uint16_t* gUnicode = NULL;  //UTF-16 code, the codes are searched so do not need to be sequential
+  uint16_t* gSortedIndex = NULL; // Glyph numbers in code order, only created if gUnicode is not sorted
   uint8_t*  gHeight = NULL;   //cheight
   uint8_t*  gWidth = NULL;    //cwidth
   uint8_t*  gxAdvance = NULL; //setWidth
@@ -41,6 +55,23 @@ fontMetrics gFont = { nullptr, 0, 0, 0, 0, 0, 0, 0 };
   uint32_t* gBitmap = NULL;   //file pointer to greyscale bitmap
 
   bool     fontLoaded = false; // Flags when a anti-aliased font is loaded
+  bool     gSorted    = false; // Flags when getUnicodeIndex() can use a binary search
+  bool     gReadback  = false; // Flags when glyph background is read from the TFT
+
+  uint16_t* gGlyphBuf = NULL;  // Buffer for rendering a glyph before pushing it to the TFT
+  uint32_t  gGlyphBufSize = 0; // Size of buffer in pixels
+
+  // Glyph bitmap cache entry, the bitmap follows the header
+  typedef struct glyphCacheEntry
+  {
+    struct glyphCacheEntry* next; // Next entry, list is in order of use
+    uint16_t gNum;                // Glyph number
+  } glyphCacheEntry;
+
+  glyphCacheEntry* gCache = NULL; // Most recently used entry first
+  uint32_t gCacheSize  = 0;       // RAM budget for the cache in bytes, 0 = no cache
+  uint32_t gCacheUsed  = 0;       // Bytes used by the cached entries
+  bool     gCachePsram = false;   // Allocate entries in PSRAM if available
 
 #ifdef FONT_FS_AVAILABLE
   fs::File fontFile;
@@ -55,7 +86,11 @@ fontMetrics gFont = { nullptr, 0, 0, 0, 0, 0, 0, 0 };
   private:
 
   void     loadMetrics(void);
+  void     sortUnicodeIndex(void);
+  bool     drawGlyphBuffered(uint16_t gNum, int32_t cx, int32_t cy, int32_t bx, uint16_t fg, uint16_t bg, const uint8_t* gPtr, uint8_t* pbuffer);
   uint32_t readInt32(void);
+  glyphCacheEntry* cacheGlyph(uint16_t gNum);
+  void     freeGlyphCache(void);
 
   uint8_t* fontPtr = nullptr;
 
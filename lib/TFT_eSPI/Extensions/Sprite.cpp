@@ -10,6 +10,9 @@
 // there is a nett performance gain by using swapped bytes.
 ***************************************************************************************/
 
+// Height of the bands of lines used to track the changed areas of a Sprite
+#define DIRTY_BAND_HEIGHT 8
+
 /***************************************************************************************
 ** Function name:           TFT_eSprite
 ** Description:             Class constructor
@@ -100,6 +103,7 @@ void* TFT_eSprite::createSprite(int16_t w, int16_t h, uint8_t frames)
   {
     _created = true;
     if ( (_bpp == 4) && (_colorMap == nullptr)) createPalette(default_4bit_palette);
+    if (_dirtyTrack) setDirtyTracking(true);
 
     rotation = 0;
     setViewport(0, 0, _dwidth, _dheight);
@@ -242,6 +246,8 @@ void TFT_eSprite::createPalette(uint16_t colorMap[], uint8_t colors)
   {
     _colorMap[i] = colorMap[i];
   }
+
+  markDirty(0, 0, _dwidth, _dheight);
 }
 
 
@@ -269,6 +275,8 @@ void TFT_eSprite::createPalette(const uint16_t colorMap[], uint8_t colors)
   {
     _colorMap[i] = pgm_read_word(colorMap++);
   }
+
+  markDirty(0, 0, _dwidth, _dheight);
 }
 
 
@@ -290,6 +298,8 @@ void* TFT_eSprite::frameBuffer(int8_t f)
 
   if (_bpp == 4) _img4 = _img8;
 
+  markDirty(0, 0, _dwidth, _dheight);
+
   return _img8;
 }
 
@@ -351,6 +361,8 @@ void TFT_eSprite::setPaletteColor(uint8_t index, uint16_t color)
   if (_colorMap == nullptr || index > 15) return; // out of bounds
 
   _colorMap[index] = color;
+
+  markDirty(0, 0, _dwidth, _dheight);
 }
 
 
@@ -378,6 +390,12 @@ void TFT_eSprite::deleteSprite(void)
     _colorMap = nullptr;
   }
 
+  if (_dirty != nullptr)
+  {
+    free(_dirty);
+    _dirty = nullptr;
+  }
+
   if (_created)
   {
     free(_img8_1);
@@ -660,6 +678,35 @@ void TFT_eSprite::pushSprite(int32_t x, int32_t y)
 {
   if (!_created) return;
 
+  if (_dirty)
+  {
+    // Only the changed areas are needed if the TFT already shows the Sprite at x, y
+    if (x == _dirtyX && y == _dirtyY)
+    {
+      int32_t bands = (_dheight + DIRTY_BAND_HEIGHT - 1) / DIRTY_BAND_HEIGHT;
+      _tft->startWrite();
+      for (int32_t b = 0; b < bands; b++)
+      {
+        int32_t x0 = _dirty[2 * b], x1 = _dirty[2 * b + 1];
+        if (x0 >= x1) continue;
+
+        // Merge the following bands with the same changed columns
+        int32_t n = 1;
+        while (b + n < bands && _dirty[2 * (b + n)] == x0 && _dirty[2 * (b + n) + 1] == x1) n++;
+
+        int32_t sy = b * DIRTY_BAND_HEIGHT;
+        pushSprite(x + x0, y + sy, x0, sy, x1 - x0, n * DIRTY_BAND_HEIGHT);
+        b += n - 1;
+      }
+      _tft->endWrite();
+      markClean();
+      return;
+    }
+    _dirtyX = x;
+    _dirtyY = y;
+    markClean();
+  }
+
   if (_bpp == 16)
   {
     bool oldSwapBytes = _tft->getSwapBytes();
@@ -891,6 +938,77 @@ bool TFT_eSprite::pushSprite(int32_t tx, int32_t ty, int32_t sx, int32_t sy, int
 }
 
 
+/***************************************************************************************
+** Function name:           setDirtyTracking
+** Description:             Track the changed areas so pushSprite(x, y) only sends those
+***************************************************************************************/
+// The Sprite is divided into bands of DIRTY_BAND_HEIGHT lines and the changed area of
+// each band is held as a start and end x coordinate. 1bpp Sprites are not tracked.
+void TFT_eSprite::setDirtyTracking(bool enable)
+{
+  _dirtyTrack = enable;
+
+  if (_dirty != nullptr)
+  {
+    free(_dirty);
+    _dirty = nullptr;
+  }
+
+  if (!enable || !_created || _bpp == 1) return;
+
+  int32_t bands = (_dheight + DIRTY_BAND_HEIGHT - 1) / DIRTY_BAND_HEIGHT;
+  _dirty = (int16_t *)malloc(bands * 2 * sizeof(int16_t));
+
+  // Unknown TFT contents, so the next push sends the whole Sprite
+  _dirtyX = INT32_MIN;
+  _dirtyY = INT32_MIN;
+  markClean();
+}
+
+
+/***************************************************************************************
+** Function name:           markDirty
+** Description:             Add an area to the changed areas of the Sprite
+***************************************************************************************/
+void TFT_eSprite::markDirty(int32_t x, int32_t y, int32_t w, int32_t h)
+{
+  if (_dirty == nullptr) return;
+
+  if (x < 0) { w += x; x = 0; }
+  if (y < 0) { h += y; y = 0; }
+  if ((x + w) > _dwidth)  w = _dwidth  - x;
+  if ((y + h) > _dheight) h = _dheight - y;
+  if ((w < 1) || (h < 1)) return;
+
+  int16_t *band = _dirty + 2 * (y / DIRTY_BAND_HEIGHT);
+  int16_t *last = _dirty + 2 * ((y + h - 1) / DIRTY_BAND_HEIGHT);
+
+  while (band <= last)
+  {
+    if (x < band[0]) band[0] = x;
+    if (x + w > band[1]) band[1] = x + w;
+    band += 2;
+  }
+}
+
+
+/***************************************************************************************
+** Function name:           markClean
+** Description:             Clear the changed areas of the Sprite
+***************************************************************************************/
+void TFT_eSprite::markClean(void)
+{
+  if (_dirty == nullptr) return;
+
+  int32_t bands = (_dheight + DIRTY_BAND_HEIGHT - 1) / DIRTY_BAND_HEIGHT;
+  for (int32_t b = 0; b < bands; b++)
+  {
+    _dirty[2 * b]     = _dwidth;
+    _dirty[2 * b + 1] = 0;
+  }
+}
+
+
 /***************************************************************************************
 ** Function name:           readPixelValue
 ** Description:             Read the color map index of a pixel at defined coordinates
@@ -1034,6 +1152,8 @@ void  TFT_eSprite::pushImage(int32_t x, int32_t y, int32_t w, int32_t h, uint16_
 
   PI_CLIP;
 
+  markDirty(x, y, dw, dh);
+
   if (_bpp == 16) // Plot a 16 bpp image into a 16 bpp Sprite
   {
     // Pointer within original image
@@ -1045,13 +1165,7 @@ void  TFT_eSprite::pushImage(int32_t x, int32_t y, int32_t w, int32_t h, uint16_
     {
       while (dh--)
       {
-        // Fast copy with a 1 byte shift
-        memcpy(ptrs+1, ptro, (dw<<1) - 1);
-        // Now correct just the even numbered bytes
-        for (int32_t xp = 0; xp < (dw<<1); xp+=2)
-        {
-          ptrs[xp] = ptro[xp+1];;
-        }
+        swap565((uint16_t*)ptrs, (uint16_t*)ptro, dw);
         ptro += w<<1;
         ptrs += _iwidth<<1;
       }
@@ -1177,6 +1291,8 @@ void  TFT_eSprite::pushImage(int32_t x, int32_t y, int32_t w, int32_t h, const u
 
   PI_CLIP;
 
+  markDirty(x, y, dw, dh);
+
   if (_bpp == 16) // Plot a 16 bpp image into a 16 bpp Sprite
   {
     for (int32_t yp = dy; yp < dy + dh; yp++)
@@ -1291,6 +1407,8 @@ void TFT_eSprite::pushColor(uint16_t color)
 {
   if (!_created ) return;
 
+  if (_dirty) markDirty(_xptr, _yptr, 1, 1);
+
   // Write the colour to RAM in set window
   if (_bpp == 16)
     _img [_xptr + _yptr * _iwidth] = (uint16_t) (color >> 8) | (color << 8);
@@ -1355,6 +1473,8 @@ void TFT_eSprite::writeColor(uint16_t color)
 {
   if (!_created ) return;
 
+  if (_dirty) markDirty(_xptr, _yptr, 1, 1);
+
   // Write 16-bit RGB 565 encoded colour to RAM
   if (_bpp == 16) _img [_xptr + _yptr * _iwidth] = color;
 
@@ -1417,6 +1537,8 @@ void TFT_eSprite::setScrollRect(int32_t x, int32_t y, int32_t w, int32_t h, uint
 ***************************************************************************************/
 void TFT_eSprite::scroll(int16_t dx, int16_t dy)
 {
+  markDirty(_sx, _sy, _sw, _sh);
+
   if (abs(dx) >= _sw || abs(dy) >= _sh)
   {
     fillRect (_sx, _sy, _sw, _sh, _scolor);
@@ -1520,6 +1642,8 @@ void TFT_eSprite::fillSprite(uint32_t color)
   // Use memset if possible as it is super fast
   if(_xDatum == 0 && _yDatum == 0  &&  _xWidth == width())
   {
+    markDirty(0, 0, _dwidth, _yHeight);
+
     if(_bpp == 16) {
       if ( (uint8_t)color == (uint8_t)(color>>8) ) {
         memset(_img,  (uint8_t)color, _iwidth * _yHeight * 2);
@@ -1637,6 +1761,8 @@ void TFT_eSprite::drawPixel(int32_t x, int32_t y, uint32_t color)
   // Range checking
   if ((x < _vpX) || (y < _vpY) ||(x >= _vpW) || (y >= _vpH)) return;
 
+  if (_dirty) markDirty(x, y, 1, 1);
+
   if (_bpp == 16)
   {
     color = (color >> 8) | (color << 8);
@@ -1761,6 +1887,8 @@ void TFT_eSprite::drawFastVLine(int32_t x, int32_t y, int32_t h, uint32_t color)
 
   if (h < 1) return;
 
+  if (_dirty) markDirty(x, y, 1, h);
+
   if (_bpp == 16)
   {
     color = (color >> 8) | (color << 8);
@@ -1822,6 +1950,8 @@ void TFT_eSprite::drawFastHLine(int32_t x, int32_t y, int32_t w, uint32_t color)
 
   if (w < 1) return;
 
+  if (_dirty) markDirty(x, y, w, 1);
+
   if (_bpp == 16)
   {
     color = (color >> 8) | (color << 8);
@@ -1887,6 +2017,8 @@ void TFT_eSprite::fillRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t
 
   if ((w < 1) || (h < 1)) return;
 
+  if (_dirty) markDirty(x, y, w, h);
+
   int32_t yp = _iwidth * y + x;
 
   if (_bpp == 16)
@@ -2476,10 +2608,10 @@ void TFT_eSprite::drawGlyph(uint16_t code)
     }
 
     uint8_t* pbuffer = nullptr;
-    const uint8_t* gPtr = (const uint8_t*) gFont.gArray;
+    const uint8_t* gPtr = getGlyphBitmap(gNum);
 
 #ifdef FONT_FS_AVAILABLE
-    if (fs_font) {
+    if (gPtr == nullptr) { // Not in the glyph cache so read from file line by line
       fontFile.seek(gBitmap[gNum], fs::SeekSet); // This is slow for a significant position shift!
       pbuffer =  (uint8_t*)malloc(gWidth[gNum]);
     }
@@ -2528,7 +2660,7 @@ void TFT_eSprite::drawGlyph(uint16_t code)
     for (int32_t y = 0; y < gHeight[gNum]; y++)
     {
 #ifdef FONT_FS_AVAILABLE
-      if (fs_font) {
+      if (pbuffer) {
         fontFile.read(pbuffer, gWidth[gNum]);
       }
 #endif
@@ -2536,10 +2668,10 @@ void TFT_eSprite::drawGlyph(uint16_t code)
       for (int32_t x = 0; x < gWidth[gNum]; x++)
       {
 #ifdef FONT_FS_AVAILABLE
-        if (fs_font) pixel = pbuffer[x];
+        if (pbuffer) pixel = pbuffer[x];
         else
 #endif
-        pixel = pgm_read_byte(gPtr + gBitmap[gNum] + x + gWidth[gNum] * y);
+        pixel = pgm_read_byte(gPtr + x + gWidth[gNum] * y);
 
         if (pixel)
         {
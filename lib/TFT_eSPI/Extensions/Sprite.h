@@ -126,6 +126,13 @@ class TFT_eSprite : public TFT_eSPI {
            // Push a windowed area of the sprite to the TFT at tx, ty
   bool     pushSprite(int32_t tx, int32_t ty, int32_t sx, int32_t sy, int32_t sw, int32_t sh);
 
+           // Track the areas of a 4, 8 or 16 bit Sprite changed by the graphics functions. Then
+           // pushSprite(x, y) only sends the changed areas if the Sprite is pushed to the same
+           // position as last time, and the whole Sprite otherwise.
+  void     setDirtyTracking(bool enable);
+           // Mark an area as changed, e.g. after writing to the Sprite memory directly
+  void     markDirty(int32_t x, int32_t y, int32_t w, int32_t h);
+
            // Push the sprite to another sprite at x,y. This fn calls pushImage() in the destination sprite (dspr) class.
   bool     pushToSprite(TFT_eSprite *dspr, int32_t x, int32_t y);
   bool     pushToSprite(TFT_eSprite *dspr, int32_t x, int32_t y, uint16_t transparent);
@@ -155,6 +162,9 @@ class TFT_eSprite : public TFT_eSPI {
            // Reserve memory for the Sprite and return a pointer
   void*    callocSprite(int16_t width, int16_t height, uint8_t frames = 1);
 
+           // Clear the changed areas after a push to the TFT
+  void     markClean(void);
+
            // Override the non-inlined TFT_eSPI functions
   void     begin_nin_write(void) { ; }
   void     end_nin_write(void) { ; }
@@ -177,6 +187,10 @@ class TFT_eSprite : public TFT_eSPI {
   bool     _gFont = false; 
 
   int32_t  _xs, _ys, _xe, _ye, _xptr, _yptr; // for setWindow
+
+  bool     _dirtyTrack = false;     // Changed area tracking enabled
+  int16_t  *_dirty = nullptr;       // x start and end + 1 of the changed area in each band of lines
+  int32_t  _dirtyX, _dirtyY;        // Position of the last push to the TFT
   int32_t  _sx, _sy; // x,y for scroll zone
   uint32_t _sw, _sh; // w,h for scroll zone
   uint32_t _scolor;  // gap fill colour for scroll zone
@@ -287,17 +287,24 @@ void TFT_eSPI::pushSwapBytePixels(const void* data_in, uint32_t len){
   uint8_t* data = (uint8_t*)data_in;
   uint32_t color[16];
 
+  // Pixels at an even address are swapped 2 at a time with 32-bit operations
+  bool odd = (uintptr_t)data & 1;
+
   if (len > 31)
   {
     WRITE_PERI_REG(SPI_MOSI_DLEN_REG(SPI_PORT), 511);
     while(len>31)
     {
       uint32_t i = 0;
-      while(i<16)
+      if (odd) while(i<16)
       {
         color[i++] = DAT8TO32(data);
         data+=4;
       }
+      else {
+        swap565((uint16_t*)color, (uint16_t*)data, 32);
+        data+=64;
+      }
       while (READ_PERI_REG(SPI_CMD_REG(SPI_PORT))&SPI_USR);
       WRITE_PERI_REG(SPI_W0_REG(SPI_PORT),  color[0]);
       WRITE_PERI_REG(SPI_W1_REG(SPI_PORT),  color[1]);
@@ -327,11 +334,15 @@ void TFT_eSPI::pushSwapBytePixels(const void* data_in, uint32_t len){
   if (len > 15)
   {
     uint32_t i = 0;
-    while(i<8)
+    if (odd) while(i<8)
     {
       color[i++] = DAT8TO32(data);
       data+=4;
     }
+    else {
+      swap565((uint16_t*)color, (uint16_t*)data, 16);
+      data+=32;
+    }
     while (READ_PERI_REG(SPI_CMD_REG(SPI_PORT))&SPI_USR);
     WRITE_PERI_REG(SPI_MOSI_DLEN_REG(SPI_PORT), 255);
     WRITE_PERI_REG(SPI_W0_REG(SPI_PORT),  color[0]);
@@ -584,6 +595,36 @@ void TFT_eSPI::pushPixels(const void* data_in, uint32_t len){
 #if defined (ESP32_DMA) && !defined (TFT_PARALLEL_8_BIT) //       DMA FUNCTIONS
 ////////////////////////////////////////////////////////////////////////////////////////
 
+// Transactions for queueImageDMA(), the slots are used in turn and the SPI driver
+// returns the results in the same order
+static spi_transaction_t dmaQueue[DMA_QUEUE_SIZE];
+static dmaCallback dmaQueueCallback[DMA_QUEUE_SIZE];
+static void*   dmaQueueArg[DMA_QUEUE_SIZE];
+static uint8_t dmaQueueNext = 0; // Next slot to use
+static uint8_t dmaQueueUsed = 0; // Number of slots in use
+
+// Transfer size limit of the SPI hardware, 32 kbytes
+#define DMA_QUEUE_PIXELS 0x4000
+
+/***************************************************************************************
+** Function name:           dmaQueueDone
+** Description:             Free the slot of a completed transaction and run its callback
+***************************************************************************************/
+static void dmaQueueDone(spi_transaction_t *rtrans)
+{
+  // pushImageDMA() and pushPixelsDMA() transactions are not in the queue
+  if ((rtrans < dmaQueue) || (rtrans >= dmaQueue + DMA_QUEUE_SIZE)) return;
+
+  dmaQueueUsed--;
+
+  uint32_t i = rtrans - dmaQueue;
+  dmaCallback callback = dmaQueueCallback[i];
+  if (callback) {
+    dmaQueueCallback[i] = nullptr;
+    callback(dmaQueueArg[i]);
+  }
+}
+
 /***************************************************************************************
 ** Function name:           dmaBusy
 ** Description:             Check if DMA is busy
@@ -598,7 +639,10 @@ bool TFT_eSPI::dmaBusy(void)
   for (int i = 0; i < checks; ++i)
   {
     ret = spi_device_get_trans_result(dmaHAL, &rtrans, 0);
-    if (ret == ESP_OK) spiBusyCheck--;
+    if (ret == ESP_OK) {
+      spiBusyCheck--;
+      dmaQueueDone(rtrans);
+    }
   }
 
   //Serial.print("spiBusyCheck=");Serial.println(spiBusyCheck);
@@ -616,12 +660,14 @@ void TFT_eSPI::dmaWait(void)
   if (!DMA_Enabled || !spiBusyCheck) return;
   spi_transaction_t *rtrans;
   esp_err_t ret;
-  for (int i = 0; i < spiBusyCheck; ++i)
+  // A callback may queue more transfers, these are waited for too
+  while (spiBusyCheck)
   {
     ret = spi_device_get_trans_result(dmaHAL, &rtrans, portMAX_DELAY);
     assert(ret == ESP_OK);
+    spiBusyCheck--;
+    dmaQueueDone(rtrans);
   }
-  spiBusyCheck = 0;
 }
 
 
@@ -636,9 +682,7 @@ void TFT_eSPI::pushPixelsDMA(uint16_t* image, uint32_t len)
 
   dmaWait();
 
-  if(_swapBytes) {
-    for (uint32_t i = 0; i < len; i++) (image[i] = image[i] << 8 | image[i] >> 8);
-  }
+  if(_swapBytes) swap565(image, image, len);
 
   // DMA byte count for transmit is 64Kbytes maximum, so to avoid this constraint
   // small transfers are performed using a blocking call until DMA capacity is reached.
@@ -746,10 +790,7 @@ void TFT_eSPI::pushImageDMA(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t
   if ( (dw != w) || (dh != h) ) {
     if(_swapBytes) {
       for (int32_t yb = 0; yb < dh; yb++) {
-        for (int32_t xb = 0; xb < dw; xb++) {
-          uint32_t src = xb + dx + w * (yb + dy);
-          (buffer[xb + yb * dw] = image[src] << 8 | image[src] >> 8);
-        }
+        swap565(buffer + yb * dw, image + dx + w * (yb + dy), dw);
       }
     }
     else {
@@ -760,9 +801,7 @@ void TFT_eSPI::pushImageDMA(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t
   }
   // else, if a buffer pointer has been provided copy whole image to the buffer
   else if (buffer != image || _swapBytes) {
-    if(_swapBytes) {
-      for (uint32_t i = 0; i < len; i++) (buffer[i] = image[i] << 8 | image[i] >> 8);
-    }
+    if(_swapBytes) swap565(buffer, image, len);
     else {
       memcpy(buffer, image, len*2);
     }
@@ -800,6 +839,154 @@ void TFT_eSPI::pushImageDMA(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t
   spiBusyCheck++;
 }
 
+
+/***************************************************************************************
+** Function name:           queueImageDMA
+** Description:             Queue an image for a window, earlier transfers may be running
+***************************************************************************************/
+// This will clip and also swap bytes if setSwapBytes(true) was called by sketch
+void TFT_eSPI::queueImageDMA(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t* image, uint16_t* buffer,
+                             dmaCallback callback, void* arg)
+{
+  int32_t dx = 0;
+  int32_t dy = 0;
+  int32_t dw = w;
+  int32_t dh = h;
+
+  if (x < _vpX) { dx = _vpX - x; dw -= dx; x = _vpX; }
+  if (y < _vpY) { dy = _vpY - y; dh -= dy; y = _vpY; }
+
+  if ((x + dw) > _vpW ) dw = _vpW - x;
+  if ((y + dh) > _vpH ) dh = _vpH - y;
+
+  if (dw < 1 || dh < 1 || !DMA_Enabled) {
+    if (callback) callback(arg);
+    return;
+  }
+
+  uint32_t len = dw*dh;
+
+  if (buffer == nullptr) buffer = image;
+
+  // If image is clipped, copy pixels into a contiguous block, rows only move down in memory
+  if ( (dw != w) || (dh != h) ) {
+    if(_swapBytes) {
+      for (int32_t yb = 0; yb < dh; yb++) {
+        swap565(buffer + yb * dw, image + dx + w * (yb + dy), dw);
+      }
+    }
+    else {
+      for (int32_t yb = 0; yb < dh; yb++) {
+        memmove((uint8_t*) (buffer + yb * dw), (uint8_t*) (image + dx + w * (yb + dy)), dw << 1);
+      }
+    }
+  }
+  // else, if a buffer pointer has been provided copy whole image to the buffer
+  else if (buffer != image || _swapBytes) {
+    if(_swapBytes) swap565(buffer, image, len);
+    else {
+      memcpy(buffer, image, len*2);
+    }
+  }
+
+  // Make room for the window commands and all the pixel blocks, callbacks of earlier
+  // images may run and queue images of their own before this one is started
+  dmaQueueReserve(5 + (len + DMA_QUEUE_PIXELS - 1) / DMA_QUEUE_PIXELS);
+
+  // The window is set by queued commands so the last window position is unknown
+  addr_row = 0xFFFF;
+  addr_col = 0xFFFF;
+
+#if defined (ILI9225_DRIVER) || defined (SSD1351_DRIVER) || defined (SSD1963_DRIVER)
+  // Window commands are not standard so they are sent when the queue is empty
+  dmaWait();
+  setAddrWindow(x, y, dw, dh);
+#else
+  #ifdef CGRAM_OFFSET
+    x+=colstart;
+    y+=rowstart;
+  #endif
+  int32_t xe = x + dw - 1;
+  int32_t ye = y + dh - 1;
+
+  uint8_t cmd[4];
+  cmd[0] = TFT_CASET;
+  dmaQueueTrans(false, cmd, 1);
+  cmd[0] = x >> 8; cmd[1] = x; cmd[2] = xe >> 8; cmd[3] = xe;
+  dmaQueueTrans(true, cmd, 4);
+  cmd[0] = TFT_PASET;
+  dmaQueueTrans(false, cmd, 1);
+  cmd[0] = y >> 8; cmd[1] = y; cmd[2] = ye >> 8; cmd[3] = ye;
+  dmaQueueTrans(true, cmd, 4);
+  cmd[0] = TFT_RAMWR;
+  dmaQueueTrans(false, cmd, 1);
+#endif
+
+  // Send the pixels in blocks, the callback is attached to the last one
+  while (len)
+  {
+    uint32_t n = (len > DMA_QUEUE_PIXELS) ? DMA_QUEUE_PIXELS : len;
+    len -= n;
+    if (len) dmaQueueTrans(true, buffer, n * 2);
+    else     dmaQueueTrans(true, buffer, n * 2, callback, arg);
+    buffer += n;
+  }
+}
+
+
+/***************************************************************************************
+** Function name:           dmaQueueReserve
+** Description:             Wait until a number of queue slots are free
+***************************************************************************************/
+void TFT_eSPI::dmaQueueReserve(uint32_t slots)
+{
+  if (slots > DMA_QUEUE_SIZE) slots = DMA_QUEUE_SIZE;
+
+  spi_transaction_t *rtrans;
+  esp_err_t ret;
+  while ((uint32_t)(DMA_QUEUE_SIZE - dmaQueueUsed) < slots)
+  {
+    ret = spi_device_get_trans_result(dmaHAL, &rtrans, portMAX_DELAY);
+    assert(ret == ESP_OK);
+    spiBusyCheck--;
+    dmaQueueDone(rtrans);
+  }
+}
+
+
+/***************************************************************************************
+** Function name:           dmaQueueTrans
+** Description:             Queue a command (data = false) or data transaction
+***************************************************************************************/
+// Up to 4 bytes are copied to the transaction, longer buffers must stay valid until sent
+void TFT_eSPI::dmaQueueTrans(bool data, const void* buf, uint32_t len, dmaCallback callback, void* arg)
+{
+  dmaQueueReserve(1);
+
+  uint8_t i = dmaQueueNext;
+  dmaQueueNext = (i + 1) % DMA_QUEUE_SIZE;
+
+  spi_transaction_t *trans = &dmaQueue[i];
+  memset(trans, 0, sizeof(spi_transaction_t));
+
+  trans->user = (void *)(uintptr_t)data; // D/C line level, set by dc_callback()
+  trans->length = len * 8;    // Data length, in bits
+  if (len <= 4) {
+    trans->flags = SPI_TRANS_USE_TXDATA;
+    memcpy(trans->tx_data, buf, len);
+  }
+  else trans->tx_buffer = buf;
+
+  dmaQueueCallback[i] = callback;
+  dmaQueueArg[i] = arg;
+
+  esp_err_t ret = spi_device_queue_trans(dmaHAL, trans, portMAX_DELAY);
+  assert(ret == ESP_OK);
+
+  dmaQueueUsed++;
+  spiBusyCheck++;
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////
 // Processor specific DMA initialisation
 ////////////////////////////////////////////////////////////////////////////////////////
@@ -807,7 +994,7 @@ void TFT_eSPI::pushImageDMA(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t
 // The DMA functions here work with SPI only (not parallel)
 /***************************************************************************************
 ** Function name:           dc_callback
-** Description:             Toggles DC line during transaction (not used)
+** Description:             Sets DC line before each transaction, from the "user" field
 ***************************************************************************************/
 extern "C" void dc_callback();
 
@@ -867,8 +1054,8 @@ bool TFT_eSPI::initDMA(bool ctrl_cs)
     .input_delay_ns = 0,
     .spics_io_num = pin,
     .flags = SPI_DEVICE_NO_DUMMY, //0,
-    .queue_size = 1,            // Not using queues
-    .pre_cb = 0, //dc_callback, //Callback to handle D/C line (not used)
+    .queue_size = DMA_QUEUE_SIZE + 1, // Queued transactions and one from pushImageDMA()
+    .pre_cb = dc_callback, //Callback to handle D/C line for queued commands
     .post_cb = dma_end_callback //Callback to end transmission
   };
   ret = spi_bus_initialize(spi_host, &buscfg, DMA_CHANNEL);
@@ -878,6 +1065,8 @@ bool TFT_eSPI::initDMA(bool ctrl_cs)
 
   DMA_Enabled = true;
   spiBusyCheck = 0;
+  dmaQueueNext = 0;
+  dmaQueueUsed = 0;
   return true;
 }
 
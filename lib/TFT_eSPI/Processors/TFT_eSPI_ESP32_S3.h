@@ -136,6 +136,12 @@ SPI3_HOST = 2
   #define ESP32_DMA
   // Code to check if DMA is busy, used by SPI DMA + transaction + endWrite functions
   #define DMA_BUSY_CHECK  dmaWait()
+  // Queued DMA transfers are supported, see queueImageDMA()
+  #define ESP32_DMA_QUEUE
+  // Number of SPI transactions that can be queued, each image uses 5 plus 1 per 32 kbytes
+  #ifndef DMA_QUEUE_SIZE
+    #define DMA_QUEUE_SIZE 32
+  #endif
 #else
   #define DMA_BUSY_CHECK
 #endif
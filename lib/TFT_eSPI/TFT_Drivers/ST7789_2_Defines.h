@@ -66,9 +66,18 @@
 #define TFT_PASET   0x2B
 #define TFT_RAMWR   0x2C
 #define TFT_RAMRD   0x2E
+#define TFT_VSCRDEF 0x33
+#define TFT_TEON    0x35
 #define TFT_MADCTL  0x36
+#define TFT_VSCRSADD 0x37
 #define TFT_COLMOD  0x3A
 
+// Rows of display memory shared by the vertical scrolling areas
+#define TFT_VSCR_ROWS 320
+
+// Frame period in microseconds, 60 Hz as set by FRCTRL2 during initialisation
+#define TFT_FRAME_PERIOD 16667
+
 // Flags for TFT_MADCTL
 #define TFT_MAD_MY  0x80
 #define TFT_MAD_MX  0x40
@@ -58,6 +58,15 @@
                                                        \
   if (dw < 1 || dh < 1) return;
 
+#if defined (TFT_TE) && defined (TFT_TEON)
+  #ifndef IRAM_ATTR
+    #define IRAM_ATTR
+  #endif
+  // Number of TE pulses, the display pulses TE at the start of the vertical blanking
+  static volatile uint32_t teCount = 0;
+  static void IRAM_ATTR teHandler(void) { teCount++; }
+#endif
+
 /***************************************************************************************
 ** Function name:           Legacy - deprecated
 ** Description:             Start/end transaction
@@ -133,6 +142,7 @@ inline void TFT_eSPI::end_nin_write(void){
 ***************************************************************************************/
 // Reads require a lower SPI clock rate than writes
 inline void TFT_eSPI::begin_tft_read(void){
+  if (_batchCount) flushBatch(); // Recorded commands must be drawn before reading
   DMA_BUSY_CHECK; // Wait for any DMA transfer to complete before changing SPI settings
 #if defined (SPI_HAS_TRANSACTION) && defined (SUPPORT_TRANSACTIONS) && !defined(TFT_PARALLEL_8_BIT) && !defined(RP2040_PIO_INTERFACE)
   if (locked) {
@@ -783,6 +793,18 @@ void TFT_eSPI::init(uint8_t tc)
 
   setRotation(rotation);
 
+#if defined (TFT_TE) && defined (TFT_TEON)
+  if (TFT_TE >= 0) {
+    begin_tft_write();
+    writecommand(TFT_TEON);
+    writedata(0x00); // Pulse in the vertical blanking only
+    end_tft_write();
+
+    pinMode(TFT_TE, INPUT);
+    attachInterrupt(digitalPinToInterrupt(TFT_TE), teHandler, RISING);
+  }
+#endif
+
 #if defined (TFT_BL) && defined (TFT_BACKLIGHT_ON)
   if (TFT_BL >= 0) {
     pinMode(TFT_BL, OUTPUT);
@@ -806,6 +828,7 @@ void TFT_eSPI::init(uint8_t tc)
 ***************************************************************************************/
 void TFT_eSPI::setRotation(uint8_t m)
 {
+  if (_batchCount) flushBatch(); // Recorded commands are in the old orientation
 
   begin_tft_write();
 
@@ -881,6 +904,12 @@ void TFT_eSPI::setRotation(uint8_t m)
 
   // Reset the viewport to the whole screen
   resetViewport();
+
+  // The scrolling area is only defined for rotation 0
+  if (_scrollH) setScrollArea(0, 0);
+
+  // The rows and columns of the display memory are addressed differently now
+  resetFrameDiff();
 }
 
 
@@ -966,6 +995,8 @@ void TFT_eSPI::commandList (const uint8_t *addr)
 ***************************************************************************************/
 void TFT_eSPI::spiwrite(uint8_t c)
 {
+  if (_batchCount) flushBatch();
+
   begin_tft_write();
   tft_Write_8(c);
   end_tft_write();
@@ -979,6 +1010,8 @@ void TFT_eSPI::spiwrite(uint8_t c)
 #ifndef RM68120_DRIVER
 void TFT_eSPI::writecommand(uint8_t c)
 {
+  if (_batchCount) flushBatch(); // Recorded commands must be sent before raw writes
+
   begin_tft_write();
 
   DC_C;
@@ -992,6 +1025,8 @@ void TFT_eSPI::writecommand(uint8_t c)
 #else
 void TFT_eSPI::writecommand(uint16_t c)
 {
+  if (_batchCount) flushBatch();
+
   begin_tft_write();
 
   DC_C;
@@ -1005,6 +1040,8 @@ void TFT_eSPI::writecommand(uint16_t c)
 }
 void TFT_eSPI::writeRegister8(uint16_t c, uint8_t d)
 {
+  if (_batchCount) flushBatch();
+
   begin_tft_write();
 
   DC_C;
@@ -1020,6 +1057,8 @@ void TFT_eSPI::writeRegister8(uint16_t c, uint8_t d)
 }
 void TFT_eSPI::writeRegister16(uint16_t c, uint16_t d)
 {
+  if (_batchCount) flushBatch();
+
   begin_tft_write();
 
   DC_C;
@@ -1042,6 +1081,8 @@ void TFT_eSPI::writeRegister16(uint16_t c, uint16_t d)
 ***************************************************************************************/
 void TFT_eSPI::writedata(uint8_t d)
 {
+  if (_batchCount) flushBatch();
+
   begin_tft_write();
 
   DC_D;        // Play safe, but should already be in data mode
@@ -1357,7 +1398,9 @@ void TFT_eSPI::readRect(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t *da
   bool wasInTransaction = inTransaction;
   if (inTransaction) { inTransaction= false; end_tft_write();}
 
+#if defined (ILI9488_DRIVER) || defined (ST7796_DRIVER) || defined (ST7735_DRIVER)
   uint16_t color = 0;
+#endif
 
   begin_tft_read();
 
@@ -1374,12 +1417,21 @@ void TFT_eSPI::readRect(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t *da
 
   // Read window pixel 24-bit RGB values
   while (dh--) {
+
+  #if !defined (ILI9488_DRIVER) && !defined (ST7796_DRIVER) && !defined (ST7735_DRIVER)
+
+    // Read the 3 RGB bytes of each pixel in the line, colour is actually only in the top
+    // 6 bits of each byte as the TFT stores colours as 18 bits. The line is converted with
+    // swapped colour byte order for compatibility with pushRect()
+    uint8_t rgb[dw * 3];
+    for (int32_t i = 0; i < dw * 3; i++) rgb[i] = tft_Read_8();
+    convert888to565(data, rgb, dw, true);
+
+  #else
     int32_t lw = dw;
     uint16_t* line = data;
     while (lw--) {
 
-  #if !defined (ILI9488_DRIVER)
-
     #if defined (ST7796_DRIVER)
       // Read the 2 bytes
       color = ((tft_Read_8()) << 8) | (tft_Read_8());
@@ -1391,27 +1443,18 @@ void TFT_eSPI::readRect(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t *da
       uint8_t b = tft_Read_8()<<1;
       color = color565(r, g, b);
     #else
-      // Read the 3 RGB bytes, colour is actually only in the top 6 bits of each byte
-      // as the TFT stores colours as 18 bits
-      uint8_t r = tft_Read_8();
-      uint8_t g = tft_Read_8();
-      uint8_t b = tft_Read_8();
-      color = color565(r, g, b);
-    #endif
-
-  #else
-
       // The 6 colour bits are in MS 6 bits of each byte but we do not include the extra clock pulse
       // so we use a trick and mask the middle 6 bits of the byte, then only shift 1 place left
       uint8_t r = (tft_Read_8()&0x7E)<<1;
       uint8_t g = (tft_Read_8()&0x7E)<<1;
       uint8_t b = (tft_Read_8()&0x7E)<<1;
       color = color565(r, g, b);
-  #endif
+    #endif
 
       // Swapped colour byte order for compatibility with pushRect()
       *line++ = color << 8 | color >> 8;
     }
+  #endif
     data += w;
   }
 
@@ -1622,6 +1665,12 @@ void TFT_eSPI::pushImage(int32_t x, int32_t y, int32_t w, int32_t h, const uint1
 ***************************************************************************************/
 void TFT_eSPI::pushImage(int32_t x, int32_t y, int32_t w, int32_t h, const uint8_t *data, bool bpp8,  uint16_t *cmap)
 {
+#ifdef ESP32
+  // FLASH can be read directly, use the faster RAM version
+  pushImage(x, y, w, h, (uint8_t*)data, bpp8, cmap);
+  return;
+#endif
+
   PI_CLIP;
 
   begin_tft_write();
@@ -1770,109 +1819,40 @@ void TFT_eSPI::pushImage(int32_t x, int32_t y, int32_t w, int32_t h, uint8_t *da
   {
     _swapBytes = false;
 
-    uint8_t  blue[] = {0, 11, 21, 31}; // blue 2 to 5-bit colour lookup table
-
-    _lastColor = -1; // Set to illegal value
-
-    // Used to store last shifted colour
-    uint8_t msbColor = 0;
-    uint8_t lsbColor = 0;
-
     data += dx + dy * w;
     while (dh--) {
-      uint32_t len = dw;
-      uint8_t* ptr = data;
-      uint8_t* linePtr = (uint8_t*)lineBuf;
-
-      while(len--) {
-        uint32_t color = *ptr++;
-
-        // Shifts are slow so check if colour has changed first
-        if (color != _lastColor) {
-          //          =====Green=====     ===============Red==============
-          msbColor = (color & 0x1C)>>2 | (color & 0xC0)>>3 | (color & 0xE0);
-          //          =====Green=====    =======Blue======
-          lsbColor = (color & 0x1C)<<3 | blue[color & 0x03];
-          _lastColor = color;
-        }
-
-       *linePtr++ = msbColor;
-       *linePtr++ = lsbColor;
-      }
-
+      convert332to565(lineBuf, data, dw, true);
       pushPixels(lineBuf, dw);
-
       data += w;
     }
-    _swapBytes = swap; // Restore old value
   }
   else if (cmap != nullptr) // Must be 4bpp
   {
     _swapBytes = true;
 
     w = (w+1) & 0xFFFE;   // if this is a sprite, w will already be even; this does no harm.
-    bool splitFirst = (dx & 0x01) != 0; // split first means we have to push a single px from the left of the sprite / image
-
-    if (splitFirst) {
-      data += ((dx - 1 + dy * w) >> 1);
-    }
-    else {
-      data += ((dx + dy * w) >> 1);
-    }
 
+    data += ((dx + dy * w) >> 1);
     while (dh--) {
-      uint32_t len = dw;
-      uint8_t * ptr = data;
-      uint16_t *linePtr = lineBuf;
-      uint8_t colors; // two colors in one byte
-      uint16_t index;
-
-      if (splitFirst) {
-        colors = *ptr;
-        index = (colors & 0x0F);
-        *linePtr++ = cmap[index];
-        len--;
-        ptr++;
-      }
-
-      while (len--)
-      {
-        colors = *ptr;
-        index = ((colors & 0xF0) >> 4) & 0x0F;
-        *linePtr++ = cmap[index];
-
-        if (len--)
-        {
-          index = colors & 0x0F;
-          *linePtr++ = cmap[index];
-        } else {
-          break;  // nothing to do here
-        }
-
-        ptr++;
-      }
-
+      // Odd dx means the first pixel is in the low nibble
+      convert4to565(lineBuf, data, dx & 0x01, dw, cmap);
       pushPixels(lineBuf, dw);
       data += (w >> 1);
     }
-    _swapBytes = swap; // Restore old value
   }
   else // Must be 1bpp
   {
     _swapBytes = false;
 
+    uint16_t fg = bitmap_fg << 8 | bitmap_fg >> 8;
+    uint16_t bg = bitmap_bg << 8 | bitmap_bg >> 8;
+
     uint32_t ww =  (w+7)>>3; // Width of source image line in bytes
-    for (int32_t yp = dy;  yp < dy + dh; yp++)
-    {
-      uint8_t* linePtr = (uint8_t*)lineBuf;
-      for (int32_t xp = dx; xp < dx + dw; xp++)
-      {
-        uint16_t col = (data[(xp>>3)] & (0x80 >> (xp & 0x7)) );
-        if (col) {*linePtr++ = bitmap_fg>>8; *linePtr++ = (uint8_t) bitmap_fg;}
-        else     {*linePtr++ = bitmap_bg>>8; *linePtr++ = (uint8_t) bitmap_bg;}
-      }
-      data += ww;
+    data += dy * ww;
+    while (dh--) {
+      convert1to565(lineBuf, data, dx, dw, fg, bg);
       pushPixels(lineBuf, dw);
+      data += ww;
     }
   }
 
@@ -3360,6 +3340,7 @@ void TFT_eSPI::setAddrWindow(int32_t x0, int32_t y0, int32_t w, int32_t h)
 void TFT_eSPI::setWindow(int32_t x0, int32_t y0, int32_t x1, int32_t y1)
 {
   //begin_tft_write(); // Must be called before setWindow
+  if (_batchCount) writeBatch(); // Recorded commands must be drawn first
   addr_row = 0xFFFF;
   addr_col = 0xFFFF;
 
@@ -3589,6 +3570,8 @@ void TFT_eSPI::drawPixel(int32_t x, int32_t y, uint32_t color)
   // Range checking
   if ((x < _vpX) || (y < _vpY) ||(x >= _vpW) || (y >= _vpH)) return;
 
+  if (_batch) { batchRect(x, y, 1, 1, color); return; }
+
 #ifdef CGRAM_OFFSET
   x+=colstart;
   y+=rowstart;
@@ -3834,6 +3817,244 @@ void TFT_eSPI::endWrite(void)
   end_tft_write();         // Release SPI bus
 }
 
+/***************************************************************************************
+** Function name:           startBatch
+** Description:             start recording drawing commands, returns false if no memory
+***************************************************************************************/
+bool TFT_eSPI::startBatch(uint16_t size)
+{
+  if (_batch) endBatch();
+  if (size == 0) return false;
+
+  // Line buffers are sized for the longest side so rotation can be changed between batches
+  _batchWidth = (_init_width > _init_height ? _init_width : _init_height);
+  _batchWidth = (_batchWidth + 1) & ~1; // Keep the line buffers 32-bit aligned
+
+  // One allocation for command list, sort order, active list, 3 line buffers and coverage
+  uint32_t listBytes = (size * (sizeof(batchCmd_t) + 4) + 3) & ~3;
+  _batch = (batchCmd_t*)malloc(listBytes + _batchWidth * 7);
+  if (_batch == nullptr) return false;
+
+  _batchSize  = size;
+  _batchCount = 0;
+  return true;
+}
+
+/***************************************************************************************
+** Function name:           endBatch
+** Description:             send the recorded commands and stop recording
+***************************************************************************************/
+void TFT_eSPI::endBatch(void)
+{
+  if (_batch == nullptr) return;
+  flushBatch();
+  free(_batch);
+  _batch = nullptr;
+  _batchSize = 0;
+}
+
+/***************************************************************************************
+** Function name:           flushBatch
+** Description:             send the recorded commands to the TFT
+***************************************************************************************/
+void TFT_eSPI::flushBatch(void)
+{
+  if (_batchCount == 0) return;
+
+  begin_tft_write();
+  inTransaction = true;
+
+  writeBatch();
+
+  inTransaction = lockTransaction;
+  end_tft_write();
+}
+
+/***************************************************************************************
+** Function name:           batchRect
+** Description:             add a filled rectangle (already clipped) to the command list
+***************************************************************************************/
+void TFT_eSPI::batchRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color)
+{
+  if (_batchCount >= _batchSize) flushBatch();
+
+  batchCmd_t* cmd = _batch + _batchCount++;
+  cmd->x = x;
+  cmd->y = y;
+  cmd->w = w;
+  cmd->h = h;
+  cmd->color = color;
+}
+
+/***************************************************************************************
+** Function name:           writeBatch
+** Description:             write the command list to the TFT, transaction must be open
+***************************************************************************************/
+// Commands are swept line by line in y order. Each line is drawn in a line buffer in the
+// order the commands were recorded, so later commands overwrite earlier ones, then each
+// run of adjacent pixels is sent in one window. Runs of one colour that repeat on the
+// following lines are merged into rectangles and sent with pushBlock().
+void TFT_eSPI::writeBatch(void)
+{
+  uint16_t count = _batchCount;
+  if (count == 0) return;
+  _batchCount = 0; // Stops setWindow() calling this function again
+
+  uint16_t* order  = (uint16_t*)(_batch + _batchSize);
+  uint16_t* active = order + _batchSize;
+  uint16_t* line   = (uint16_t*)(_batch) + (((_batchSize * (sizeof(batchCmd_t) + 4) + 3) & ~3) >> 1);
+  uint16_t* dmaBuf = line + _batchWidth;   // Two line buffers so the next line can be drawn during DMA
+  uint8_t*  cover  = (uint8_t*)(dmaBuf + 2 * _batchWidth);
+
+  // Find the x extent of the commands, and sort them by y (keeping recorded order for equal y)
+  int32_t xs = _batch[0].x, xe = _batch[0].x + _batch[0].w;
+  for (uint16_t i = 0; i < count; i++) {
+    order[i] = i;
+    if (_batch[i].x < xs) xs = _batch[i].x;
+    if (_batch[i].x + _batch[i].w > xe) xe = _batch[i].x + _batch[i].w;
+  }
+  memset(cover, 0, xe - xs);
+
+  uint16_t gap = 1;
+  while (gap < count / 3) gap = gap * 3 + 1;
+  while (gap > 0) {
+    for (uint16_t i = gap; i < count; i++) {
+      uint16_t n = order[i];
+      uint16_t j = i;
+      while (j >= gap && (_batch[order[j - gap]].y > _batch[n].y ||
+            (_batch[order[j - gap]].y == _batch[n].y && order[j - gap] > n))) {
+        order[j] = order[j - gap];
+        j -= gap;
+      }
+      order[j] = n;
+    }
+    gap /= 3;
+  }
+
+  // Rectangles of one colour waiting for more lines
+  const uint8_t maxPending = 8;
+  int32_t  px[maxPending], py[maxPending], pw[maxPending], ph[maxPending];
+  uint16_t pc[maxPending];
+  uint8_t  pending = 0;
+
+  uint8_t  dmaSel = 0;
+  uint16_t next = 0;
+  uint16_t nActive = 0;
+  int32_t  y = _batch[order[0]].y;
+
+  while (nActive || next < count)
+  {
+    if (nActive == 0) y = _batch[order[next]].y; // Skip empty lines
+
+    // Remove commands that have ended, add commands starting on this line in recorded order
+    uint16_t n = 0;
+    for (uint16_t i = 0; i < nActive; i++) {
+      if (_batch[active[i]].y + _batch[active[i]].h > y) active[n++] = active[i];
+    }
+    nActive = n;
+
+    while (next < count && _batch[order[next]].y == y) {
+      uint16_t c = order[next++];
+      uint16_t j = nActive++;
+      while (j > 0 && active[j - 1] > c) { active[j] = active[j - 1]; j--; }
+      active[j] = c;
+    }
+
+    // Draw the line
+    int32_t x0 = xe, x1 = xs;
+    for (uint16_t i = 0; i < nActive; i++) {
+      batchCmd_t* cmd = _batch + active[i];
+      uint16_t* p = line + cmd->x - xs;
+      for (int32_t w = cmd->w; w > 0; w--) *p++ = cmd->color;
+      memset(cover + cmd->x - xs, 1, cmd->w);
+      if (cmd->x < x0) x0 = cmd->x;
+      if (cmd->x + cmd->w > x1) x1 = cmd->x + cmd->w;
+    }
+
+    // Send each run of adjacent pixels
+    int32_t x = x0;
+    while (x < x1)
+    {
+      if (!cover[x - xs]) { x++; continue; }
+
+      int32_t  rs = x;
+      uint16_t color = line[x - xs];
+      bool     uniform = true;
+      while (x < x1 && cover[x - xs]) {
+        if (line[x - xs] != color) uniform = false;
+        cover[x - xs] = 0;
+        x++;
+      }
+      int32_t rw = x - rs;
+
+      if (uniform)
+      {
+        // Extend a rectangle ending on the line above, or start a new one
+        uint8_t i = 0;
+        while (i < pending && !(px[i] == rs && pw[i] == rw && pc[i] == color && py[i] + ph[i] == y)) i++;
+        if (i < pending) { ph[i]++; continue; }
+
+        if (pending == maxPending) {
+          DMA_BUSY_CHECK;
+          setWindow(px[0], py[0], px[0] + pw[0] - 1, py[0] + ph[0] - 1);
+          pushBlock(pc[0], pw[0] * ph[0]);
+          pending--;
+          for (i = 0; i < pending; i++) {
+            px[i] = px[i + 1]; py[i] = py[i + 1]; pw[i] = pw[i + 1]; ph[i] = ph[i + 1]; pc[i] = pc[i + 1];
+          }
+        }
+        px[pending] = rs; py[pending] = y; pw[pending] = rw; ph[pending] = 1; pc[pending] = color;
+        pending++;
+        continue;
+      }
+
+#if defined (ESP32_DMA) && !defined (TFT_PARALLEL_8_BIT)
+      if (DMA_Enabled) {
+        // Copy to a DMA buffer in TFT byte order, the other buffer may still be in use
+        uint16_t* buf = dmaBuf + dmaSel * _batchWidth;
+        dmaSel ^= 1;
+        for (int32_t i = 0; i < rw; i++) buf[i] = (line[rs - xs + i] << 8) | (line[rs - xs + i] >> 8);
+        dmaWait();
+        setWindow(rs, y, x - 1, y);
+        bool swap = _swapBytes; _swapBytes = false;
+        pushPixelsDMA(buf, rw);
+        _swapBytes = swap;
+        continue;
+      }
+#endif
+      setWindow(rs, y, x - 1, y);
+      bool swap = _swapBytes; _swapBytes = true;
+      pushPixels(line + rs - xs, rw);
+      _swapBytes = swap;
+    }
+
+    // Send the rectangles that have not been extended to this line
+    uint8_t kept = 0;
+    for (uint8_t i = 0; i < pending; i++) {
+      if (py[i] + ph[i] > y) {
+        px[kept] = px[i]; py[kept] = py[i]; pw[kept] = pw[i]; ph[kept] = ph[i]; pc[kept] = pc[i];
+        kept++;
+        continue;
+      }
+      DMA_BUSY_CHECK;
+      setWindow(px[i], py[i], px[i] + pw[i] - 1, py[i] + ph[i] - 1);
+      pushBlock(pc[i], pw[i] * ph[i]);
+    }
+    pending = kept;
+
+    y++;
+  }
+
+  for (uint8_t i = 0; i < pending; i++) {
+    DMA_BUSY_CHECK;
+    setWindow(px[i], py[i], px[i] + pw[i] - 1, py[i] + ph[i] - 1);
+    pushBlock(pc[i], pw[i] * ph[i]);
+  }
+
+  DMA_BUSY_CHECK;
+  (void)dmaSel;
+}
+
 /***************************************************************************************
 ** Function name:           writeColor (use startWrite() and endWrite() before & after)
 ** Description:             raw write of "len" pixels avoiding transaction check
@@ -4612,6 +4833,8 @@ void TFT_eSPI::drawFastVLine(int32_t x, int32_t y, int32_t h, uint32_t color)
 
   if (h < 1) return;
 
+  if (_batch) { batchRect(x, y, 1, h, color); return; }
+
   begin_tft_write();
 
   setWindow(x, y, x, y + h - 1);
@@ -4642,6 +4865,8 @@ void TFT_eSPI::drawFastHLine(int32_t x, int32_t y, int32_t w, uint32_t color)
 
   if (w < 1) return;
 
+  if (_batch) { batchRect(x, y, w, 1, color); return; }
+
   begin_tft_write();
 
   setWindow(x, y, x + w - 1, y);
@@ -4683,6 +4908,8 @@ void TFT_eSPI::fillRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t col
   //Serial.print(" x=");Serial.print( y);Serial.print(", y=");Serial.print( y);
   //Serial.print(", w=");Serial.print(w);Serial.print(", h=");Serial.println(h);
 
+  if (_batch) { batchRect(x, y, w, h, color); return; }
+
   begin_tft_write();
 
   setWindow(x, y, x + w - 1, y + h - 1);
@@ -4832,6 +5059,206 @@ uint32_t TFT_eSPI::color24to16(uint32_t color888)
   return (r | g | b);
 }
 
+/***************************************************************************************
+** Function name:           swap565
+** Description:             swap the bytes of 16-bit pixels, dst may be the same as src
+***************************************************************************************/
+// Two pixels are swapped at a time with 32-bit operations where possible
+void TFT_eSPI::swap565(uint16_t* dst, const uint16_t* src, uint32_t len)
+{
+  // Align the destination for 32-bit writes
+  if (len && ((uintptr_t)dst & 2)) {
+    *dst++ = *src >> 8 | *src << 8; src++; len--;
+  }
+
+  uint32_t* d = (uint32_t*)dst;
+
+  if (((uintptr_t)src & 2) == 0) {
+    const uint32_t* s = (const uint32_t*)src;
+    while (len >= 8) {
+      uint32_t c0 = s[0], c1 = s[1], c2 = s[2], c3 = s[3];
+      d[0] = ((c0 >> 8) & 0x00FF00FF) | ((c0 << 8) & 0xFF00FF00);
+      d[1] = ((c1 >> 8) & 0x00FF00FF) | ((c1 << 8) & 0xFF00FF00);
+      d[2] = ((c2 >> 8) & 0x00FF00FF) | ((c2 << 8) & 0xFF00FF00);
+      d[3] = ((c3 >> 8) & 0x00FF00FF) | ((c3 << 8) & 0xFF00FF00);
+      s += 4; d += 4; len -= 8;
+    }
+    while (len >= 2) {
+      uint32_t c = *s++;
+      *d++ = ((c >> 8) & 0x00FF00FF) | ((c << 8) & 0xFF00FF00);
+      len -= 2;
+    }
+    src = (const uint16_t*)s;
+  }
+  else {
+    while (len >= 2) {
+      uint32_t c = src[0] | (uint32_t)src[1] << 16;
+      *d++ = ((c >> 8) & 0x00FF00FF) | ((c << 8) & 0xFF00FF00);
+      src += 2; len -= 2;
+    }
+  }
+
+  if (len) *(uint16_t*)d = *src >> 8 | *src << 8;
+}
+
+
+/***************************************************************************************
+** Function name:           convert332to565
+** Description:             convert 8-bit 332 pixels to 16-bit 565 pixels
+***************************************************************************************/
+// The pixels are in TFT byte order if swap is true
+void TFT_eSPI::convert332to565(uint16_t* dst, const uint8_t* src, uint32_t len, bool swap)
+{
+  // Lookup table, filled on first use
+  static uint16_t lut[256];
+  static bool lutReady = false;
+
+  if (!lutReady) {
+    uint8_t  blue[] = {0, 11, 21, 31}; // blue 2 to 5-bit colour lookup table
+    for (uint32_t c = 0; c < 256; c++) {
+      //       =====Green=====     ===============Red==============
+      lut[c] = (c & 0x1C)<<6 | (c & 0xC0)<<5 | (c & 0xE0)<<8;
+      //       =====Green=====    =======Blue======
+      lut[c] |= (c & 0x1C)<<3 | blue[c & 0x03];
+    }
+    lutReady = true;
+  }
+
+  if (len && ((uintptr_t)dst & 2)) {
+    uint16_t c = lut[*src++];
+    *dst++ = swap ? c >> 8 | c << 8 : c;
+    len--;
+  }
+
+  uint32_t* d = (uint32_t*)dst;
+  if (swap) {
+    while (len >= 2) {
+      uint32_t c = lut[src[0]] | (uint32_t)lut[src[1]] << 16;
+      *d++ = ((c >> 8) & 0x00FF00FF) | ((c << 8) & 0xFF00FF00);
+      src += 2; len -= 2;
+    }
+  }
+  else {
+    while (len >= 2) {
+      *d++ = lut[src[0]] | (uint32_t)lut[src[1]] << 16;
+      src += 2; len -= 2;
+    }
+  }
+
+  if (len) {
+    uint16_t c = lut[*src];
+    *(uint16_t*)d = swap ? c >> 8 | c << 8 : c;
+  }
+}
+
+
+/***************************************************************************************
+** Function name:           convert4to565
+** Description:             convert 4-bit palette pixels to 16-bit pixels from the palette
+***************************************************************************************/
+// Pixels are 2 per byte, the first in the high nibble. Start at the low nibble if odd is true
+void TFT_eSPI::convert4to565(uint16_t* dst, const uint8_t* src, bool odd, uint32_t len, const uint16_t* cmap)
+{
+  if (len && odd) {
+    *dst++ = cmap[*src++ & 0x0F];
+    len--;
+  }
+
+  if (len && ((uintptr_t)dst & 2)) {
+    // Destination not aligned, pixels of a byte straddle 32-bit words
+    while (len >= 2) {
+      uint8_t c = *src++;
+      *dst++ = cmap[c >> 4];
+      *dst++ = cmap[c & 0x0F];
+      len -= 2;
+    }
+  }
+  else {
+    uint32_t* d = (uint32_t*)dst;
+    while (len >= 2) {
+      uint8_t c = *src++;
+      *d++ = cmap[c >> 4] | (uint32_t)cmap[c & 0x0F] << 16;
+      len -= 2;
+    }
+    dst = (uint16_t*)d;
+  }
+
+  if (len) *dst = cmap[*src >> 4];
+}
+
+
+/***************************************************************************************
+** Function name:           convert1to565
+** Description:             convert 1-bit pixels to fg (bit set) and bg colour pixels
+***************************************************************************************/
+// Pixels are 8 per byte, the first in the MS bit. Start at bit number "bit" (0 = MS bit)
+void TFT_eSPI::convert1to565(uint16_t* dst, const uint8_t* src, uint32_t bit, uint32_t len, uint16_t fg, uint16_t bg)
+{
+  src += bit >> 3;
+  bit &= 7;
+
+  // Single pixels until byte and destination 32-bit aligned
+  while (len && (bit || ((uintptr_t)dst & 2))) {
+    *dst++ = (*src & (0x80 >> bit)) ? fg : bg;
+    len--;
+    if (++bit == 8) { bit = 0; src++; }
+  }
+
+  if (!bit) {
+    // Pairs of pixels for 2 bits
+    uint32_t pair[4];
+    pair[0] = bg | (uint32_t)bg << 16;
+    pair[1] = bg | (uint32_t)fg << 16;
+    pair[2] = fg | (uint32_t)bg << 16;
+    pair[3] = fg | (uint32_t)fg << 16;
+
+    uint32_t* d = (uint32_t*)dst;
+    while (len >= 8) {
+      uint8_t b = *src++;
+      d[0] = pair[b >> 6];
+      d[1] = pair[(b >> 4) & 3];
+      d[2] = pair[(b >> 2) & 3];
+      d[3] = pair[b & 3];
+      d += 4; len -= 8;
+    }
+    dst = (uint16_t*)d;
+  }
+
+  while (len--) {
+    *dst++ = (*src & (0x80 >> bit)) ? fg : bg;
+    if (++bit == 8) { bit = 0; src++; }
+  }
+}
+
+
+/***************************************************************************************
+** Function name:           convert888to565
+** Description:             convert 24-bit pixels, 3 bytes red first, to 16-bit 565 pixels
+***************************************************************************************/
+// The pixels are in TFT byte order if swap is true
+void TFT_eSPI::convert888to565(uint16_t* dst, const uint8_t* src, uint32_t len, bool swap)
+{
+  if (len && ((uintptr_t)dst & 2)) {
+    uint16_t c = ((src[0] & 0xF8) << 8) | ((src[1] & 0xFC) << 3) | (src[2] >> 3);
+    *dst++ = swap ? c >> 8 | c << 8 : c;
+    src += 3; len--;
+  }
+
+  uint32_t* d = (uint32_t*)dst;
+  while (len >= 2) {
+    uint32_t c = ((src[0] & 0xF8) << 8) | ((src[1] & 0xFC) << 3) | (src[2] >> 3);
+    c |= (uint32_t)(((src[3] & 0xF8) << 8) | ((src[4] & 0xFC) << 3) | (src[5] >> 3)) << 16;
+    if (swap) c = ((c >> 8) & 0x00FF00FF) | ((c << 8) & 0xFF00FF00);
+    *d++ = c;
+    src += 6; len -= 2;
+  }
+
+  if (len) {
+    uint16_t c = ((src[0] & 0xF8) << 8) | ((src[1] & 0xFC) << 3) | (src[2] >> 3);
+    *(uint16_t*)d = swap ? c >> 8 | c << 8 : c;
+  }
+}
+
 /***************************************************************************************
 ** Function name:           invertDisplay
 ** Description:             invert the display colours i = 1 invert, i = 0 normal
@@ -4846,6 +5273,303 @@ void TFT_eSPI::invertDisplay(bool i)
 }
 
 
+/***************************************************************************************
+** Function name:           setScrollArea
+** Description:             Define a hardware vertical scrolling area of h rows from y
+***************************************************************************************/
+bool TFT_eSPI::setScrollArea(int32_t y, int32_t h)
+{
+#if defined (TFT_VSCRDEF) && defined (TFT_VSCRSADD)
+  if (h != 0 && (rotation != 0 || y < 0 || h < 0 || y + h > _height)) return false;
+
+  // The rows above and below the area are fixed, h = 0 restores the default of no fixed rows
+  int32_t top = h ? rowstart + y : 0;
+  int32_t rows = h ? h : TFT_VSCR_ROWS;
+
+  begin_tft_write();
+  writecommand(TFT_VSCRDEF);
+  writedata(top >> 8); writedata(top);
+  writedata(rows >> 8); writedata(rows);
+  writedata((TFT_VSCR_ROWS - top - rows) >> 8); writedata(TFT_VSCR_ROWS - top - rows);
+  writecommand(TFT_VSCRSADD);
+  writedata(top >> 8); writedata(top);
+  end_tft_write();
+
+  _scrollY = y;
+  _scrollH = h;
+  _scrollOffset = 0;
+  return true;
+#else
+  return h == 0;
+#endif
+}
+
+
+/***************************************************************************************
+** Function name:           scrollArea
+** Description:             Move the content of the scrolling area dy rows
+***************************************************************************************/
+void TFT_eSPI::scrollArea(int32_t dy)
+{
+#if defined (TFT_VSCRDEF) && defined (TFT_VSCRSADD)
+  if (_scrollH == 0) return;
+
+  // The area shows its rows from the offset onwards and wraps round
+  _scrollOffset = ((_scrollOffset - dy) % _scrollH + _scrollH) % _scrollH;
+  int32_t start = rowstart + _scrollY + _scrollOffset;
+
+  begin_tft_write();
+  writecommand(TFT_VSCRSADD);
+  writedata(start >> 8); writedata(start);
+  end_tft_write();
+#else
+  (void)dy;
+#endif
+}
+
+
+/***************************************************************************************
+** Function name:           getScrollRow
+** Description:             Return the memory row shown at screen row y
+***************************************************************************************/
+int32_t TFT_eSPI::getScrollRow(int32_t y, int32_t *rows)
+{
+  if (_scrollH == 0 || y < _scrollY || y >= _scrollY + _scrollH) {
+    // Outside of the area up to its top or the bottom of the screen
+    if (rows) *rows = (y < _scrollY && _scrollH) ? _scrollY - y : _height - y;
+    return y;
+  }
+
+  int32_t r = (y - _scrollY + _scrollOffset) % _scrollH;
+  // Consecutive up to the wrap round of the area or its bottom
+  if (rows) *rows = _scrollH - r < _scrollY + _scrollH - y ? _scrollH - r : _scrollY + _scrollH - y;
+  return _scrollY + r;
+}
+
+
+/***************************************************************************************
+** Function name:           waitVsync
+** Description:             Wait for the start of a new frame of the display
+***************************************************************************************/
+void TFT_eSPI::waitVsync(void)
+{
+#if defined (TFT_TE) && defined (TFT_TEON)
+  if (TFT_TE >= 0) {
+    uint32_t count = teCount;
+    uint32_t start = micros();
+    // Time out after two frames in case the TE pin is not connected, then estimate the frames
+    while (teCount == count) {
+      if (micros() - start > 2 * TFT_FRAME_PERIOD) break;
+    }
+    if (teCount != count) {
+      _vsyncTime = micros();
+      return;
+    }
+  }
+#endif
+
+  // The frame after the last wait is estimated to start a frame period later. If more time has
+  // passed the phase of the frames is not known so don't wait and start counting from now.
+  // This spaces updates by frames but is not synchronised to the panel, so it can still tear.
+  uint32_t elapsed = micros() - _vsyncTime;
+  if (elapsed < TFT_FRAME_PERIOD) {
+    delayMicroseconds(TFT_FRAME_PERIOD - elapsed);
+    _vsyncTime += TFT_FRAME_PERIOD;
+  }
+  else _vsyncTime = micros();
+}
+
+
+/***************************************************************************************
+** Function name:           setFrameDiff
+** Description:             Allocate or free the row segment hashes of pushImageDiff()
+***************************************************************************************/
+bool TFT_eSPI::setFrameDiff(bool enable)
+{
+  if (_diffHash) free(_diffHash);
+  _diffHash = nullptr;
+  _diffRows = _diffSegs = 0;
+  _diffSent = _diffSaved = 0;
+  if (!enable) return true;
+
+  // Enough rows and segments for every rotation, zeroed as nothing is known yet
+  int32_t size = _init_width > _init_height ? _init_width : _init_height;
+  int32_t segs = (size + TFT_DIFF_SEGMENT - 1) / TFT_DIFF_SEGMENT;
+  _diffHash = (uint32_t*)calloc(size * segs, sizeof(uint32_t));
+  if (!_diffHash) return false;
+
+  _diffRows = size;
+  _diffSegs = segs;
+  return true;
+}
+
+
+/***************************************************************************************
+** Function name:           resetFrameDiff
+** Description:             Forget the content of the screen, send everything next time
+***************************************************************************************/
+void TFT_eSPI::resetFrameDiff(void)
+{
+  if (_diffHash) memset(_diffHash, 0, _diffRows * _diffSegs * sizeof(uint32_t));
+}
+
+
+/***************************************************************************************
+** Function name:           diffHash (static helper)
+** Description:             FNV-1a hash of a row segment, 0 is kept for unknown segments
+***************************************************************************************/
+static inline uint32_t diffHash(const uint16_t *data, int32_t len, bool swap)
+{
+  // Pixels pushed with a different byte order are different on the screen
+  uint32_t h = swap ? 2166136261UL : 2166136261UL ^ 0xFFFF;
+  while (len--) h = (h ^ *data++) * 16777619UL;
+  return h ? h : 1;
+}
+
+
+/***************************************************************************************
+** Function name:           resetFrameDiff
+** Description:             Forget the content of an area, send it next time
+***************************************************************************************/
+void TFT_eSPI::resetFrameDiff(int32_t x, int32_t y, int32_t w, int32_t h)
+{
+  if (!_diffHash) return;
+
+  x += _xDatum;
+  y += _yDatum;
+
+  // Clip to the hashes, they cover the screen in every rotation
+  int32_t x2 = x + w, y2 = y + h;
+  if (x < 0) x = 0;
+  if (y < 0) y = 0;
+  if (x2 > _diffSegs * TFT_DIFF_SEGMENT) x2 = _diffSegs * TFT_DIFF_SEGMENT;
+  if (y2 > _diffRows) y2 = _diffRows;
+  if (x >= x2 || y >= y2) return;
+
+  int32_t first = x / TFT_DIFF_SEGMENT;
+  int32_t segs  = (x2 - 1) / TFT_DIFF_SEGMENT - first + 1;
+  for (int32_t row = y; row < y2; row++) memset(_diffHash + row * _diffSegs + first, 0, segs * sizeof(uint32_t));
+}
+
+
+/***************************************************************************************
+** Function name:           pushImageDiff
+** Description:             Push the changed segments of the rows of an image
+***************************************************************************************/
+uint32_t TFT_eSPI::pushImageDiff(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t *data, bool swap)
+{
+  // Clip to the viewport as pushImage() does, the hashes are kept for screen coordinates
+  if (_vpOoB || w <= 0 || h <= 0) return 0;
+
+  int32_t vx = x + _xDatum;
+  int32_t vy = y + _yDatum;
+
+  if ((vx >= _vpW) || (vy >= _vpH)) return 0;
+
+  int32_t dx = 0;
+  int32_t dy = 0;
+  int32_t dw = w;
+  int32_t dh = h;
+
+  if (vx < _vpX) { dx = _vpX - vx; dw -= dx; vx = _vpX; }
+  if (vy < _vpY) { dy = _vpY - vy; dh -= dy; vy = _vpY; }
+
+  if ((vx + dw) > _vpW ) dw = _vpW - vx;
+  if ((vy + dh) > _vpH ) dh = _vpH - vy;
+
+  if (dw < 1 || dh < 1) return 0;
+
+  bool swapBytes = _swapBytes;
+  if (swap) _swapBytes = true;
+
+  uint32_t sent = 0;
+
+  if (!_diffHash || vy + dh > _diffRows || vx + dw > _diffSegs * TFT_DIFF_SEGMENT) {
+    // Without hashes for the area all the pixels are sent, what was known of it is stale
+    resetFrameDiff(x, y, w, h);
+    pushImage(x, y, w, h, data);
+    sent = dw * dh;
+  }
+  else {
+    begin_tft_write();
+    inTransaction = true;
+
+    data += dx + dy * w;
+    int32_t first = vx / TFT_DIFF_SEGMENT;
+    int32_t last  = (vx + dw - 1) / TFT_DIFF_SEGMENT;
+    int32_t runY = 0, runH = 0; // Consecutive rows which changed completely, sent in one window
+
+    for (int32_t j = 0; j < dh; j++) {
+      uint16_t *row = data + j * w;
+      uint32_t *hash = _diffHash + (vy + j) * _diffSegs;
+      int32_t spanX = -1; // Start of the changed span
+
+      for (int32_t s = first; s <= last; s++) {
+        int32_t sx = s * TFT_DIFF_SEGMENT;
+        bool changed = true;
+        if (sx >= vx && sx + TFT_DIFF_SEGMENT <= vx + dw) {
+          uint32_t hv = diffHash(row + sx - vx, TFT_DIFF_SEGMENT, swap);
+          changed = hash[s] != hv;
+          hash[s] = hv;
+        }
+        else hash[s] = 0; // Partly written, the rest of the segment is not known
+
+        if (changed) {
+          if (spanX < 0) spanX = sx < vx ? vx : sx;
+        }
+        else if (spanX >= 0) {
+          setWindow(spanX, vy + j, sx - 1, vy + j);
+          pushPixels(row + spanX - vx, sx - spanX);
+          sent += sx - spanX;
+          spanX = -1;
+        }
+      }
+
+      if (spanX == vx) {
+        // The whole row changed, send it together with the changed rows before and after it
+        if (!runH) runY = j;
+        runH++;
+      }
+      else if (spanX >= 0) {
+        setWindow(spanX, vy + j, vx + dw - 1, vy + j);
+        pushPixels(row + spanX - vx, vx + dw - spanX);
+        sent += vx + dw - spanX;
+      }
+
+      // Send the run of whole rows once it ends
+      if (runH && (runY + runH <= j || j == dh - 1)) {
+        setWindow(vx, vy + runY, vx + dw - 1, vy + runY + runH - 1);
+        if (dw == w) pushPixels(data + runY * w, dw * runH);
+        else for (int32_t r = runY; r < runY + runH; r++) pushPixels(data + r * w, dw);
+        sent += dw * runH;
+        runH = 0;
+      }
+    }
+
+    inTransaction = lockTransaction;
+    end_tft_write();
+  }
+
+  _swapBytes = swapBytes;
+
+  _diffSent  += sent * 2;
+  _diffSaved += (dw * dh - sent) * 2;
+  return sent;
+}
+
+
+/***************************************************************************************
+** Function name:           getFrameDiffStats
+** Description:             Bytes of pixels sent and skipped by pushImageDiff()
+***************************************************************************************/
+void TFT_eSPI::getFrameDiffStats(uint32_t *sent, uint32_t *saved, bool reset)
+{
+  if (sent)  *sent  = _diffSent;
+  if (saved) *saved = _diffSaved;
+  if (reset) _diffSent = _diffSaved = 0;
+}
+
+
 /**************************************************************************
 ** Function name:           setAttribute
 ** Description:             Sets a control parameter of an attribute
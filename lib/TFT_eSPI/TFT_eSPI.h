@@ -145,6 +145,16 @@
   #define SPI_BUSY_CHECK
 #endif
 
+// If the frame period (in microseconds) of the display is not defined, assume 60 Hz
+#ifndef TFT_FRAME_PERIOD
+  #define TFT_FRAME_PERIOD 16667
+#endif
+
+// Width in pixels of the row segments compared by pushImageDiff(), a 32-bit hash is kept for each
+#ifndef TFT_DIFF_SEGMENT
+  #define TFT_DIFF_SEGMENT 16
+#endif
+
 // If half duplex SDA mode is defined then MISO pin should be -1
 #ifdef TFT_SDA_READ
   #ifdef TFT_MISO
@@ -423,6 +433,9 @@ int16_t tch_spi_freq;// Touch controller read/write SPI frequency
 // Callback prototype for smooth font pixel colour read
 typedef uint16_t (*getColorCallback)(uint16_t x, uint16_t y);
 
+// Callback prototype for queued DMA transfer completion
+typedef void (*dmaCallback)(void* arg);
+
 // Class functions and variables
 class TFT_eSPI : public Print { friend class TFT_eSprite; // Sprite class has access to protected members
 
@@ -471,6 +484,39 @@ class TFT_eSPI : public Print { friend class TFT_eSprite; // Sprite class has ac
 
   void     invertDisplay(bool i);  // Tell TFT to invert all displayed colours
 
+           // Hardware vertical scrolling (ST7789 in rotation 0 only, returns false otherwise)
+           // Define the h rows from screen row y as a scrolling area, h = 0 removes the area
+  bool     setScrollArea(int32_t y, int32_t h);
+           // Move the content of the area dy rows, negative values up, positive down
+           // The rows uncovered at the top or bottom keep old pixels and must be drawn again
+  void     scrollArea(int32_t dy);
+           // Return the display memory row to write for screen row y while the area is scrolled,
+           // optionally rows returns the number of consecutive rows which follow in memory
+  int32_t  getScrollRow(int32_t y, int32_t *rows = nullptr);
+
+           // Wait for the start of a new frame of the display to update it without tearing.
+           // Uses the TE signal if the TFT_TE pin is defined, otherwise the start of the frames
+           // is estimated from TFT_FRAME_PERIOD and the last wait, so updates are spaced by frames.
+           // Without TE this only paces the updates: it is not in phase with the panel's scan and
+           // does not prevent tearing.
+  void     waitVsync(void);
+
+           // Frame difference: a hash of each TFT_DIFF_SEGMENT pixels of the rows written by
+           // pushImageDiff() is kept and only the changed segments are sent again. Pixels drawn by
+           // other functions are not tracked, call resetFrameDiff() for their area after using them.
+           // setFrameDiff(true) allocates the hashes, returns false if there is not enough memory
+  bool     setFrameDiff(bool enable);
+           // Forget the hashes, the next pushImageDiff() calls send all their pixels
+  void     resetFrameDiff(void);
+           // Forget the hashes of an area, e.g. after drawing in it with other functions
+  void     resetFrameDiff(int32_t x, int32_t y, int32_t w, int32_t h);
+           // Push a w x h image of 16-bit pixels, clipped to the viewport as by pushImage(). Only
+           // the changed segments of the rows are sent, each with its own window. swap as for
+           // pushColors(). Returns the number of pixels sent
+  uint32_t pushImageDiff(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t *data, bool swap = true);
+           // Bytes of pixels sent and skipped by pushImageDiff() since the stats were last reset
+  void     getFrameDiffStats(uint32_t *sent, uint32_t *saved, bool reset = true);
+
 
   // The TFT_eSprite class inherits the following functions (not all are useful to Sprite class
   void     setAddrWindow(int32_t xs, int32_t ys, int32_t w, int32_t h); // Note: start coordinates + width and height
@@ -729,6 +775,18 @@ class TFT_eSPI : public Print { friend class TFT_eSprite; // Sprite class has ac
   uint32_t color16to24(uint16_t color565);
   uint32_t color24to16(uint32_t color888);
 
+           // Convert buffers of len pixels to 16-bit 565 pixels, two pixels per 32-bit word where possible
+           // Swap the bytes of 16-bit pixels, dst may be the same as src
+  static void swap565(uint16_t* dst, const uint16_t* src, uint32_t len);
+           // Convert 8-bit 332 pixels, in TFT byte order if swap is true
+  static void convert332to565(uint16_t* dst, const uint8_t* src, uint32_t len, bool swap = false);
+           // Convert 4-bit pixels (2 per byte, first in the high nibble, odd = start at low nibble) with a palette
+  static void convert4to565(uint16_t* dst, const uint8_t* src, bool odd, uint32_t len, const uint16_t* cmap);
+           // Convert 1-bit pixels (8 per byte, first in the MS bit) from bit number bit to fg or bg colour
+  static void convert1to565(uint16_t* dst, const uint8_t* src, uint32_t bit, uint32_t len, uint16_t fg, uint16_t bg);
+           // Convert 24-bit pixels (3 bytes, red first), in TFT byte order if swap is true
+  static void convert888to565(uint16_t* dst, const uint8_t* src, uint32_t len, bool swap = false);
+
            // Alpha blend 2 colours, see generic "alphaBlend_Test" example
            // alpha =   0 = 100% background colour
            // alpha = 255 = 100% foreground colour
@@ -791,6 +849,19 @@ class TFT_eSPI : public Print { friend class TFT_eSprite; // Sprite class has ac
            // Push a block of pixels into a window set up using setAddrWindow()
   void     pushPixelsDMA(uint16_t* image, uint32_t len);
 
+#if defined (ESP32_DMA_QUEUE)
+           // Queue an image to be sent to a window by DMA. Unlike pushImageDMA() this does not wait for
+           // earlier transfers to end, so images (for example the strips of a frame) can be queued back to
+           // back while the processor prepares the next one. Large images are split into 32 kbyte transfers.
+           // Images are clipped and byte swapped in the same way as pushImageDMA(), copied to the buffer if
+           // one is given. The image (or buffer) must not be changed until the callback has been called with
+           // arg. Callbacks run in dmaBusy(), dmaWait() or a later queueImageDMA(), not in an interrupt, and
+           // at once if nothing is sent. Use startWrite() before queueing and do not use other TFT functions
+           // until dmaBusy() returns false.
+  void     queueImageDMA(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t* image, uint16_t* buffer = nullptr,
+                         dmaCallback callback = nullptr, void* arg = nullptr);
+#endif
+
            // Check if the DMA is complete - use while(tft.dmaBusy); for a blocking wait
   bool     dmaBusy(void); // returns true if DMA is still in progress
   void     dmaWait(void); // wait until DMA is complete
@@ -803,6 +874,18 @@ class TFT_eSPI : public Print { friend class TFT_eSprite; // Sprite class has ac
   void     writeColor(uint16_t color, uint32_t len); // Deprecated, use pushBlock()
   void     endWrite(void);                           // End SPI transaction
 
+  // Batch mode, drawPixel(), drawFastHLine(), drawFastVLine() and fillRect() are recorded
+  // in a command list instead of being sent to the TFT one by one. The list is sorted into
+  // lines, overlaps resolved and adjacent pixels sent in one window, then identical lines
+  // merged into rectangles. This helps functions that plot many small items, for example
+  // the anti-aliased graphics functions. The list is flushed when full, when another
+  // function sets a window, reads the TFT or writes a command or data (including
+  // setRotation()), and by flushBatch() or endBatch().
+  // If initDMA() has been called the ESP32 uses DMA for the lines.
+  bool     startBatch(uint16_t size = 512);          // Start batch mode, list holds size commands
+  void     flushBatch(void);                         // Send the recorded commands to the TFT
+  void     endBatch(void);                           // Flush and end batch mode
+
   // Set/get an arbitrary library configuration attribute or option
   //       Use to switch ON/OFF capabilities such as UTF8 decoding - each attribute has a unique ID
   //       id = 0: reserved - may be used in future to reset all attributes to a default state
@@ -883,6 +966,17 @@ class TFT_eSPI : public Print { friend class TFT_eSprite; // Sprite class has ac
   uint8_t  tabcolor,                   // ST7735 screen protector "tab" colour (now invalid)
            colstart = 0, rowstart = 0; // Screen display area to CGRAM area coordinate offsets
 
+           // Hardware vertical scrolling area and offset of its content in screen rows
+  int32_t  _scrollY = 0, _scrollH = 0, _scrollOffset = 0;
+
+           // Estimated start of the last frame in microseconds, used by waitVsync()
+  uint32_t _vsyncTime = 0;
+
+           // Hashes of the row segments for pushImageDiff(), 0 if not known, and the statistics
+  uint32_t *_diffHash = nullptr;
+  int32_t  _diffRows = 0, _diffSegs = 0;
+  uint32_t _diffSent = 0, _diffSaved = 0;
+
            // Port and pin masks for control signals (ESP826 only) - TODO: remove need for this
   volatile uint32_t *dcport, *csport;
   uint32_t cspinmask, dcpinmask, wrpinmask, sclkpinmask;
@@ -902,6 +996,27 @@ class TFT_eSPI : public Print { friend class TFT_eSprite; // Sprite class has ac
 
   bool     locked, inTransaction, lockTransaction; // SPI transaction and mutex lock flags
 
+           // Batch mode command, a filled rectangle in TFT coordinates
+  typedef struct {
+    int16_t  x, y, w, h;
+    uint16_t color;
+  } batchCmd_t;
+
+  batchCmd_t* _batch = nullptr; // Command list, followed by the sort and line buffers
+  uint16_t _batchSize  = 0;     // Maximum number of commands
+  uint16_t _batchCount = 0;     // Number of commands recorded
+  int32_t  _batchWidth = 0;     // Line buffer width
+
+  void     batchRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color);
+  void     writeBatch(void);
+
+#if defined (ESP32_DMA_QUEUE)
+           // Wait for queued DMA transactions to end until "slots" are free
+  void     dmaQueueReserve(uint32_t slots);
+           // Queue an SPI transaction with the D/C line low (command) or high (data)
+  void     dmaQueueTrans(bool data, const void* buf, uint32_t len, dmaCallback callback = nullptr, void* arg = nullptr);
+#endif
+
  //-------------------------------------- protected ----------------------------------//
  protected:
 
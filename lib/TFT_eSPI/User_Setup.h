@@ -132,6 +132,12 @@
 // #define TFT_BL   32            // LED back-light control pin
 // #define TFT_BACKLIGHT_ON HIGH  // Level to turn ON back-light (HIGH or LOW)
 
+// If the tearing effect output of the display (ST7789 only) is connected then define the
+// TFT_TE pin. waitVsync() then waits for the start of a new frame of the display signalled
+// on this pin, otherwise it estimates the start of the frames.
+
+// #define TFT_TE   12            // Tearing effect signal of the display
+
 
 
 // We must use hardware SPI, a minimum of 3 GPIO pins is needed.
@@ -0,0 +1,76 @@
+// This sketch is for the ESP32-S3 with a SPI TFT.
+
+// The screen is drawn in strips, each strip is rendered into one of
+// a few buffers and then queued with queueImageDMA(). The processor
+// does not wait for the previous strip to be sent, it only waits if
+// all the buffers are still queued. A callback marks a buffer as
+// free once its strip has been sent.
+
+// The frame rate is printed to the Serial Monitor.
+
+#include <TFT_eSPI.h>
+
+TFT_eSPI tft = TFT_eSPI();
+
+#define STRIP_HEIGHT 20
+#define BUFFERS      3
+
+uint16_t* buffer[BUFFERS];
+volatile bool queued[BUFFERS];
+
+// Called when a strip has been sent
+void stripSent(void* arg) {
+  queued[(intptr_t)arg] = false;
+}
+
+void setup() {
+  Serial.begin(115200);
+
+  tft.init();
+  tft.setRotation(0);
+  tft.fillScreen(TFT_BLACK);
+  tft.initDMA();
+
+  for (int i = 0; i < BUFFERS; i++) {
+    buffer[i] = (uint16_t*)heap_caps_malloc(tft.width() * STRIP_HEIGHT * 2, MALLOC_CAP_DMA);
+    queued[i] = false;
+  }
+
+  // The colours are rendered in TFT byte order
+  tft.setSwapBytes(false);
+}
+
+void loop() {
+  static uint32_t frame = 0;
+  static uint32_t t = millis();
+
+  int32_t w = tft.width();
+  int b = 0;
+
+  tft.startWrite();
+  for (int32_t y = 0; y < tft.height(); y += STRIP_HEIGHT) {
+    // Wait for a free buffer, this runs the callbacks of the strips sent
+    while (queued[b]) tft.dmaBusy();
+
+    // Render a moving colour pattern
+    uint16_t* p = buffer[b];
+    for (int32_t j = 0; j < STRIP_HEIGHT; j++) {
+      for (int32_t i = 0; i < w; i++) {
+        uint16_t c = tft.color565(i + frame, y + j + frame, (i ^ (y + j)) + frame);
+        *p++ = c >> 8 | c << 8;
+      }
+    }
+
+    queued[b] = true;
+    tft.queueImageDMA(0, y, w, STRIP_HEIGHT, buffer[b], nullptr, stripSent, (void*)(intptr_t)b);
+    b = (b + 1) % BUFFERS;
+  }
+  tft.endWrite(); // Waits for the last strips
+
+  frame++;
+  if (millis() - t >= 1000) {
+    Serial.print(frame * 1000.0 / (millis() - t)); Serial.println(" fps");
+    frame = 0;
+    t = millis();
+  }
+}
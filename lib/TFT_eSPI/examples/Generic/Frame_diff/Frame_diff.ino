@@ -0,0 +1,66 @@
+/*
+  Redraw the whole screen every frame but send only the pixels which
+  changed since they were last sent.
+
+  The screen is rendered in strips of 16-bit pixels. pushImageDiff()
+  keeps a hash of each 16 pixels of the rows it sent and compares the new
+  strips with them, only the changed parts of the rows are sent, each in
+  its own window. Here a small counter changes on a static background so
+  most of the bytes are not sent.
+
+  The bytes sent and saved are printed to the Serial Monitor.
+
+  #########################################################################
+  ###### DON'T FORGET TO UPDATE THE User_Setup.h FILE IN THE LIBRARY ######
+  #########################################################################
+*/
+
+#include <TFT_eSPI.h>
+
+TFT_eSPI tft = TFT_eSPI();
+
+#define STRIP_HEIGHT 20
+
+uint16_t* strip;
+
+void setup() {
+  Serial.begin(115200);
+
+  tft.init();
+  tft.setRotation(0);
+  tft.fillScreen(TFT_BLACK);
+
+  if (!tft.setFrameDiff(true)) Serial.println("Not enough memory, every pixel is sent");
+
+  strip = (uint16_t*)malloc(tft.width() * STRIP_HEIGHT * 2);
+}
+
+void loop() {
+  static uint32_t frame = 0;
+
+  int32_t w = tft.width();
+
+  tft.startWrite();
+  for (int32_t y = 0; y < tft.height(); y += STRIP_HEIGHT) {
+    int32_t h = min(STRIP_HEIGHT, tft.height() - y);
+
+    // A static pattern with a bar which grows with the frame count
+    uint16_t* p = strip;
+    for (int32_t j = 0; j < h; j++) {
+      for (int32_t i = 0; i < w; i++) {
+        bool bar = (y + j) >= 100 && (y + j) < 110 && i < (int32_t)(frame % w);
+        *p++ = bar ? TFT_RED : tft.color565(i, y + j, 128);
+      }
+    }
+
+    tft.pushImageDiff(0, y, w, h, strip);
+  }
+  tft.endWrite();
+
+  if (++frame % 100 == 0) {
+    uint32_t sent, saved;
+    tft.getFrameDiffStats(&sent, &saved);
+    Serial.print("Sent: "); Serial.print(sent); Serial.print(" bytes, saved: ");
+    Serial.print(saved); Serial.println(" bytes");
+  }
+}
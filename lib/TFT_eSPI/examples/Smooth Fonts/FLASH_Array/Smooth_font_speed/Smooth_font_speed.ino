@@ -0,0 +1,99 @@
+/*
+  This sketch measures the time taken to render Smooth fonts stored in a FLASH
+  array with the three background options, and the time taken to look up glyphs.
+
+  1. With the background filled, tft.setTextColor(fg, bg, true), each glyph is
+     rendered to a RAM buffer and then pushed to the TFT in one block.
+
+  2. Without the background filled, tft.setTextColor(fg, bg), each anti-aliased
+     pixel is plotted separately, blended with the background colour.
+
+  3. With tft.setGlyphReadback(true) the screen area under each glyph is read,
+     the glyph is blended with the pixels read and then pushed to the TFT in one
+     block. The TFT must support reading the graphics RAM, so TFT_MISO must be
+     defined in the setup file. Results are wrong if reads are not supported.
+
+  The results are printed to the Serial Monitor.
+*/
+
+//  A processing sketch to create new fonts can be found in the Tools folder of TFT_eSPI
+//  https://github.com/Bodmer/TFT_eSPI/tree/master/Tools/Create_Smooth_Font/Create_font
+
+//  This sketch uses a font file created from the Noto family of fonts:
+//  https://www.google.com/get/noto/
+
+#include "NotoSansBold15.h"
+
+// Do not include "" around the array name!
+#define AA_FONT_SMALL NotoSansBold15
+
+#include <SPI.h>
+#include <TFT_eSPI.h>       // Hardware-specific library
+
+TFT_eSPI tft = TFT_eSPI();
+
+#define LINES 10
+
+const char* text = "The quick brown fox jumps over the lazy dog 0123456789";
+
+void setup(void) {
+  Serial.begin(115200);
+
+  tft.begin();
+
+  tft.setRotation(1);
+
+  tft.loadFont(AA_FONT_SMALL);
+}
+
+
+void loop() {
+
+  uint32_t t;
+
+  // Glyph lookup, every character in the font is searched for
+  t = micros();
+  uint16_t gNum;
+  uint32_t found = 0;
+  for (uint32_t i = 0; i < 0x10000; i++) found += tft.getUnicodeIndex(i, &gNum);
+  t = micros() - t;
+  Serial.print("Lookup of 65536 codes, found "); Serial.print(found);
+  Serial.print(" : "); Serial.print(t); Serial.println(" us");
+
+  // 1. Background filled
+  tft.fillScreen(TFT_NAVY);
+  tft.setTextColor(TFT_WHITE, TFT_NAVY, true);
+  t = drawText();
+  Serial.print("Background filled : "); Serial.print(t); Serial.println(" us");
+  delay(1000);
+
+  // 2. Background not filled
+  tft.fillScreen(TFT_NAVY);
+  tft.setTextColor(TFT_WHITE, TFT_NAVY);
+  t = drawText();
+  Serial.print("Not filled        : "); Serial.print(t); Serial.println(" us");
+  delay(1000);
+
+  // 3. Background read from the TFT
+  tft.fillScreen(TFT_DARKGREEN);
+  tft.fillRect(0, 0, tft.width(), tft.height() / 2, TFT_MAROON);
+  tft.setGlyphReadback(true);
+  t = drawText();
+  tft.setGlyphReadback(false);
+  Serial.print("Readback          : "); Serial.print(t); Serial.println(" us");
+  Serial.println();
+
+  delay(2000);
+}
+
+
+// Print the text on LINES lines, return the time taken in microseconds
+uint32_t drawText()
+{
+  uint32_t t = micros();
+  for (int i = 0; i < LINES; i++) {
+    tft.setCursor(0, i * tft.fontHeight());
+    tft.print(text);
+  }
+  return micros() - t;
+}
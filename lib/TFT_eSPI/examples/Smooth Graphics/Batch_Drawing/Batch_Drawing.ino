@@ -0,0 +1,72 @@
+// Example for batch mode, compares the time taken to draw anti-aliased graphics
+// directly and with startBatch()/endBatch().
+// In batch mode the pixels and lines plotted by the smooth graphics functions are
+// collected and sent to the TFT in as few windows as possible.
+// If DMA is available it can be enabled by uncommenting tft.initDMA() below.
+
+#include <TFT_eSPI.h>       // Include the graphics library
+TFT_eSPI tft = TFT_eSPI();  // Create object "tft"
+
+// -------------------------------------------------------------------------
+// Setup
+// -------------------------------------------------------------------------
+void setup(void) {
+  Serial.begin(115200);
+
+  tft.init();
+  tft.setRotation(1);
+  //tft.initDMA();
+  tft.fillScreen(TFT_BLACK);
+}
+
+// -------------------------------------------------------------------------
+// Main loop
+// -------------------------------------------------------------------------
+void loop()
+{
+  uint32_t t;
+
+  tft.fillScreen(TFT_BLACK);
+  t = micros();
+  drawGauge();
+  t = micros() - t;
+  Serial.print("Direct : "); Serial.print(t); Serial.println(" us");
+
+  delay(1000);
+
+  tft.fillScreen(TFT_BLACK);
+  t = micros();
+  tft.startWrite();
+  tft.startBatch();
+  drawGauge();
+  tft.endBatch();
+  tft.endWrite();
+  t = micros() - t;
+  Serial.print("Batch  : "); Serial.print(t); Serial.println(" us");
+
+  delay(1000);
+}
+
+// -------------------------------------------------------------------------
+// Draw a gauge with arcs, wide lines and a rounded rectangle
+// -------------------------------------------------------------------------
+void drawGauge()
+{
+  int32_t x = tft.width() / 2;
+  int32_t y = tft.height() / 2;
+  int32_t r = (tft.height() / 2) - 10;
+
+  tft.fillSmoothRoundRect(x - r, y - r, 2 * r, 2 * r, 20, TFT_DARKGREY, TFT_BLACK);
+
+  tft.drawSmoothArc(x, y, r - 10, r - 20, 30, 330, TFT_BLUE, TFT_DARKGREY, true);
+  tft.drawSmoothArc(x, y, r - 10, r - 20, 30, 210, TFT_GREEN, TFT_DARKGREY, true);
+
+  for (int a = 30; a <= 330; a += 30) {
+    float s = sin(a * DEG_TO_RAD);
+    float c = cos(a * DEG_TO_RAD);
+    tft.drawWideLine(x - s * (r - 25), y + c * (r - 25), x - s * (r - 35), y + c * (r - 35), 3, TFT_WHITE, TFT_DARKGREY);
+  }
+
+  tft.drawWedgeLine(x, y, x - (r - 40) * sin(150 * DEG_TO_RAD), y + (r - 40) * cos(150 * DEG_TO_RAD), 6, 1, TFT_RED, TFT_DARKGREY);
+  tft.fillSmoothCircle(x, y, 8, TFT_RED, TFT_DARKGREY);
+}
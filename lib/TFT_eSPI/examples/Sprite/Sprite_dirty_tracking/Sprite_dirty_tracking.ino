@@ -0,0 +1,85 @@
+/*
+  Move a needle over a dial drawn in a 240 x 240 Sprite and push only
+  the changed areas of the Sprite to the TFT.
+
+  With setDirtyTracking(true) the Sprite records the areas changed by the
+  graphics functions. pushSprite(x, y) then sends only those areas if the
+  Sprite is pushed to the same position as last time. Here only the area
+  around the old and the new needle is sent, a few kBytes per frame
+  instead of 115 kBytes for the whole Sprite.
+
+  The time taken for each push with and without tracking is printed to
+  the Serial Monitor.
+
+  #########################################################################
+  ###### DON'T FORGET TO UPDATE THE User_Setup.h FILE IN THE LIBRARY ######
+  #########################################################################
+*/
+
+#include <TFT_eSPI.h>
+
+TFT_eSPI    tft = TFT_eSPI();
+TFT_eSprite dial = TFT_eSprite(&tft);
+
+#define DIAL_SIZE 240
+#define CENTRE    (DIAL_SIZE / 2)
+#define NEEDLE_R  (CENTRE - 20)
+
+int16_t needleX = CENTRE, needleY = CENTRE;
+
+void setup(void) {
+  Serial.begin(115200);
+
+  tft.begin();
+  tft.setRotation(0);
+  tft.fillScreen(TFT_BLACK);
+
+  dial.createSprite(DIAL_SIZE, DIAL_SIZE);
+  drawDial();
+}
+
+void loop() {
+  uint32_t t;
+
+  dial.setDirtyTracking(false);
+  t = sweep();
+  Serial.print("Whole Sprite pushed  : "); Serial.print(t); Serial.println(" us per frame");
+
+  // The first push sends the whole Sprite, then only the changes are sent
+  dial.setDirtyTracking(true);
+  t = sweep();
+  Serial.print("Changed areas pushed : "); Serial.print(t); Serial.println(" us per frame");
+  Serial.println();
+}
+
+// Sweep the needle over the dial, return the mean time per frame in microseconds
+uint32_t sweep() {
+  uint32_t t = micros();
+  for (int angle = 0; angle < 360; angle += 2) {
+    drawNeedle(angle);
+    dial.pushSprite(0, 0);
+  }
+  return (micros() - t) / 180;
+}
+
+void drawDial() {
+  dial.fillSprite(TFT_BLACK);
+  dial.drawSmoothCircle(CENTRE, CENTRE, CENTRE - 2, TFT_SILVER, TFT_BLACK);
+
+  for (int a = 0; a < 360; a += 30) {
+    float s = sin(a * DEG_TO_RAD), c = cos(a * DEG_TO_RAD);
+    dial.drawWideLine(CENTRE + s * (CENTRE - 16), CENTRE - c * (CENTRE - 16),
+                      CENTRE + s * (CENTRE - 6),  CENTRE - c * (CENTRE - 6), 3, TFT_WHITE, TFT_BLACK);
+  }
+}
+
+void drawNeedle(int angle) {
+  // Erase the old needle, then draw the new one
+  dial.drawLine(CENTRE, CENTRE, needleX, needleY, TFT_BLACK);
+
+  needleX = CENTRE + sin(angle * DEG_TO_RAD) * NEEDLE_R;
+  needleY = CENTRE - cos(angle * DEG_TO_RAD) * NEEDLE_R;
+
+  dial.drawLine(CENTRE, CENTRE, needleX, needleY, TFT_RED);
+  dial.fillCircle(CENTRE, CENTRE, 6, TFT_RED);
+}
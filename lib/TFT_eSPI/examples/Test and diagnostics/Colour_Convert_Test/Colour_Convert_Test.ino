@@ -0,0 +1,176 @@
+/*
+  Check the pixel buffer conversion functions against the single colour
+  functions for every input value and measure their speed.
+
+  The functions are used by pushImage() for 8, 4 and 1 bit images, by
+  pushPixels() and pushColors() when bytes are swapped and by the DMA
+  functions, they can also be used by sketches:
+
+    swap565()          swap the bytes of 16-bit pixels
+    convert332to565()  8-bit RGB 332 pixels to 16-bit pixels
+    convert4to565()    4-bit pixels to 16-bit pixels using a palette
+    convert1to565()    1-bit pixels to 16-bit foreground/background pixels
+    convert888to565()  24-bit RGB pixels to 16-bit pixels
+
+  The results are printed to the Serial Monitor, no display is needed.
+*/
+
+#include <TFT_eSPI.h>
+
+TFT_eSPI tft = TFT_eSPI();
+
+#define PIXELS 4096
+
+uint16_t dst[PIXELS + 2];
+uint16_t src[PIXELS + 2];
+uint8_t  src8[PIXELS * 3 + 2];
+
+uint32_t errors = 0;
+
+void check(bool ok) {
+  if (!ok) errors++;
+}
+
+void setup() {
+  Serial.begin(115200);
+  delay(1000);
+
+  testSwap();
+  test332();
+  test4();
+  test1();
+  test888();
+
+  Serial.print("Errors: "); Serial.println(errors);
+  Serial.println();
+
+  benchmark();
+}
+
+void loop() {
+}
+
+// Every 16-bit value at both pixel alignments of the source and destination
+void testSwap() {
+  for (uint32_t so = 0; so < 2; so++) {
+    for (uint32_t dof = 0; dof < 2; dof++) {
+      for (uint32_t v = 0; v < 0x10000; v += PIXELS) {
+        for (uint32_t i = 0; i < PIXELS; i++) src[so + i] = v + i;
+        tft.swap565(dst + dof, src + so, PIXELS);
+        for (uint32_t i = 0; i < PIXELS; i++) {
+          uint16_t c = v + i;
+          check(dst[dof + i] == (uint16_t)(c >> 8 | c << 8));
+        }
+      }
+    }
+  }
+}
+
+// Every 8-bit value and lengths from 0 to 32 pixels
+void test332() {
+  for (uint32_t swap = 0; swap < 2; swap++) {
+    for (uint32_t dof = 0; dof < 2; dof++) {
+      for (uint32_t i = 0; i < 256; i++) src8[i] = i;
+      tft.convert332to565(dst + dof, src8, 256, swap);
+      for (uint32_t i = 0; i < 256; i++) {
+        uint16_t c = tft.color8to16(i);
+        if (swap) c = c >> 8 | c << 8;
+        check(dst[dof + i] == c);
+      }
+      for (uint32_t len = 0; len <= 32; len++) {
+        dst[dof + len] = 0x1234;
+        tft.convert332to565(dst + dof, src8 + len, len, swap);
+        check(dst[dof + len] == 0x1234);
+      }
+    }
+  }
+}
+
+// Every 8-bit pair of pixels from either nibble
+void test4() {
+  uint16_t cmap[16];
+  for (uint32_t i = 0; i < 16; i++) cmap[i] = random(0x10000);
+
+  for (uint32_t odd = 0; odd < 2; odd++) {
+    for (uint32_t dof = 0; dof < 2; dof++) {
+      for (uint32_t i = 0; i < 256; i++) src8[i] = i;
+      tft.convert4to565(dst + dof, src8, odd, 511 - odd, cmap);
+      for (uint32_t p = odd; p < 511; p++) {
+        uint8_t c = (p & 1) ? src8[p >> 1] & 0x0F : src8[p >> 1] >> 4;
+        check(dst[dof + p - odd] == cmap[c]);
+      }
+    }
+  }
+}
+
+// Every 8-bit value from every start bit
+void test1() {
+  for (uint32_t bit = 0; bit < 8; bit++) {
+    for (uint32_t dof = 0; dof < 2; dof++) {
+      for (uint32_t i = 0; i < 256; i++) src8[i] = i;
+      tft.convert1to565(dst + dof, src8, bit, 2048 - bit, TFT_WHITE, TFT_BLUE);
+      for (uint32_t p = bit; p < 2048; p++) {
+        bool set = src8[p >> 3] & (0x80 >> (p & 7));
+        check(dst[dof + p - bit] == (set ? TFT_WHITE : TFT_BLUE));
+      }
+    }
+  }
+}
+
+// Every 8-bit value of each colour
+void test888() {
+  for (uint32_t swap = 0; swap < 2; swap++) {
+    for (uint32_t dof = 0; dof < 2; dof++) {
+      for (uint32_t i = 0; i < 256 * 3; i++) {
+        src8[i * 3 + 0] = (i % 3 == 0) ? i / 3 : random(256);
+        src8[i * 3 + 1] = (i % 3 == 1) ? i / 3 : random(256);
+        src8[i * 3 + 2] = (i % 3 == 2) ? i / 3 : random(256);
+      }
+      tft.convert888to565(dst + dof, src8, 256 * 3, swap);
+      for (uint32_t i = 0; i < 256 * 3; i++) {
+        uint16_t c = tft.color565(src8[i * 3], src8[i * 3 + 1], src8[i * 3 + 2]);
+        if (swap) c = c >> 8 | c << 8;
+        check(dst[dof + i] == c);
+      }
+    }
+  }
+}
+
+void report(const char* name, uint32_t t) {
+  if (t == 0) t = 1;
+  Serial.print(name);
+  Serial.print(PIXELS * 1000 / t); Serial.println(" kpixels/s");
+}
+
+void benchmark() {
+  uint16_t cmap[16] = { 0 };
+  uint32_t t;
+
+  t = micros();
+  for (uint32_t i = 0; i < PIXELS; i++) dst[i] = src[i] >> 8 | src[i] << 8;
+  report("Swap, one pixel at a time : ", micros() - t);
+
+  t = micros();
+  tft.swap565(dst, src, PIXELS);
+  report("swap565()                 : ", micros() - t);
+
+  t = micros();
+  for (uint32_t i = 0; i < PIXELS; i++) dst[i] = tft.color8to16(src8[i]);
+  report("color8to16() per pixel    : ", micros() - t);
+
+  t = micros();
+  tft.convert332to565(dst, src8, PIXELS, true);
+  report("convert332to565()         : ", micros() - t);
+
+  t = micros();
+  tft.convert4to565(dst, src8, false, PIXELS, cmap);
+  report("convert4to565()           : ", micros() - t);
+
+  t = micros();
+  tft.convert1to565(dst, src8, 0, PIXELS, TFT_WHITE, TFT_BLACK);
+  report("convert1to565()           : ", micros() - t);
+
+  t = micros();
+  tft.convert888to565(dst, src8, PIXELS, true);
+  report("convert888to565()         : ", micros() - t);
+}
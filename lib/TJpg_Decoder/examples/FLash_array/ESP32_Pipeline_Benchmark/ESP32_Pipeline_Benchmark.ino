@@ -0,0 +1,99 @@
+// Example for library:
+// https://github.com/Bodmer/TJpg_Decoder
+
+// This example is for a dual core ESP32, it measures the rendering speed of a Jpeg file that is
+// stored in an array within Flash (program) memory, the panda.h of the Flash_Jpg example. The image
+// is drawn a number of times with the pipeline off, then on, and the average time and frames per
+// second are printed.
+
+// With the pipeline on, the library decodes the Jpeg in a task on the other processor core and up
+// to 8 decoded MCU blocks are queued, the callback is still called by the sketch (loop) task so
+// the TFT is written while the next blocks are decoded. Compare with ESP32_Dual_Core_Flash_Jpg
+// which does the same in the sketch.
+
+// Include the array of the Flash_Jpg example (copy panda.h to this sketch folder if the IDE
+// does not find it)
+#include "../Flash_Jpg/panda.h"
+
+// Include the jpeg decoder library
+#include <TJpg_Decoder.h>
+
+// Include the TFT library https://github.com/Bodmer/TFT_eSPI
+#include "SPI.h"
+#include <TFT_eSPI.h>              // Hardware-specific library
+TFT_eSPI tft = TFT_eSPI();         // Invoke custom library
+
+#define DRAW_COUNT 10              // Number of times the image is drawn for each test
+
+// This next function will be called during decoding of the jpeg file to
+// render each block to the TFT. It is called by the sketch task in both modes.
+bool tft_output(int16_t x, int16_t y, uint16_t w, uint16_t h, uint16_t* bitmap)
+{
+   // Stop further decoding as image is running off bottom of screen
+  if ( y >= tft.height() ) return 0;
+
+  // This function will clip the image block rendering automatically at the TFT boundaries
+  tft.pushImage(x, y, w, h, bitmap);
+
+  // Return 1 to decode next block
+  return 1;
+}
+
+// Draw the image DRAW_COUNT times and print the average time
+void benchmark(bool pipeline)
+{
+  if (!TJpgDec.setPipeline(pipeline)) {
+    Serial.println("Pipeline could not be started");
+    return;
+  }
+
+  tft.fillScreen(TFT_RED);
+
+  uint32_t t = millis();
+
+  tft.startWrite(); // Keep the TFT selected for the blocks
+  for (int i = 0; i < DRAW_COUNT; i++) TJpgDec.drawJpg(0, 0, panda, sizeof(panda));
+  tft.endWrite();
+
+  t = millis() - t;
+
+  Serial.print(pipeline ? "Pipeline on:  " : "Pipeline off: ");
+  Serial.print(t / DRAW_COUNT); Serial.print(" ms per image, ");
+  Serial.print(DRAW_COUNT * 1000.0 / t, 1); Serial.println(" fps");
+}
+
+void setup()
+{
+  Serial.begin(115200);
+  Serial.println("\n\n Testing TJpg_Decoder library");
+
+  // Initialise the TFT
+  tft.begin();
+  tft.setTextColor(0xFFFF, 0x0000);
+  tft.fillScreen(TFT_BLACK);
+
+  // The jpeg image can be scaled by a factor of 1, 2, 4, or 8
+  TJpgDec.setJpgScale(1);
+
+  // The byte order can be swapped (set true for TFT_eSPI)
+  TJpgDec.setSwapBytes(true);
+
+  // The decoder must be given the exact name of the rendering function above
+  TJpgDec.setCallback(tft_output);
+
+  // Get the width and height in pixels of the jpeg if you wish
+  uint16_t w = 0, h = 0;
+  TJpgDec.getJpgSize(&w, &h, panda, sizeof(panda));
+  Serial.print("Width = "); Serial.print(w); Serial.print(", height = "); Serial.println(h);
+}
+
+void loop()
+{
+  benchmark(false);
+  benchmark(true);
+
+  Serial.println();
+
+  // Wait before drawing again
+  delay(2000);
+}
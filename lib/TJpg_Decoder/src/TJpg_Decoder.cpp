@@ -27,6 +27,9 @@ TJpg_Decoder::TJpg_Decoder(){
 ***************************************************************************************/
 TJpg_Decoder::~TJpg_Decoder(){
   // Bye
+#ifdef TJPGD_PIPELINE
+  setPipeline(false);
+#endif
 }
 
 /***************************************************************************************
@@ -37,6 +40,14 @@ void TJpg_Decoder::setSwapBytes(bool swapBytes){
   _swap = swapBytes;
 }
 
+/***************************************************************************************
+** Function name:           setDither
+** Description:             Set true to dither the RGB565 output (reduces banding)
+***************************************************************************************/
+void TJpg_Decoder::setDither(bool dither){
+  _dither = dither;
+}
+
 /***************************************************************************************
 ** Function name:           setJpgScale
 ** Description:             Set the reduction scale factor (1, 2, 4 or 8)
@@ -71,11 +82,86 @@ void TJpg_Decoder::setCallback(SketchCallback sketchCallback)
   tft_output = sketchCallback;
 }
 
+#ifdef TJPGD_PIPELINE
+/***************************************************************************************
+** Function name:           setPipeline
+** Description:             Decode in a second task while the blocks are rendered
+***************************************************************************************/
+// The decoding runs on the other core of an ESP32 and up to "blocks" MCU blocks are
+// decoded ahead of the rendering, so the TFT is written while the next blocks are
+// decoded. The callback is still called by the task calling drawJpg(). The jpeg is
+// read by the decoding task so the input must not share the bus with the TFT (SD).
+bool TJpg_Decoder::setPipeline(bool enable, uint8_t blocks)
+{
+  if (pipeline) {
+    pipeline->end();
+    delete pipeline;
+    pipeline = nullptr;
+  }
+
+  if (!enable) return true;
+
+  pipeline = new TJpg_Pipeline;
+  if (pipeline->begin(blocks)) return true;
+
+  delete pipeline;
+  pipeline = nullptr;
+  return false;
+}
+
+/***************************************************************************************
+** Function name:           decodeTask (declared static)
+** Description:             Decode the jpeg into the pipeline, runs in its own task
+***************************************************************************************/
+void TJpg_Decoder::decodeTask(void* p)
+{
+  TJpg_Decoder *thisPtr = (TJpg_Decoder*)p;
+
+  thisPtr->pipeResult = jd_decomp(thisPtr->pipeJdec, jd_output, thisPtr->jpgScale);
+
+  // Mark the end of the image
+  TJpg_Block* block = thisPtr->pipeline->startWrite();
+  block->w = 0;
+  thisPtr->pipeline->endWrite();
+}
+#endif
+
+/***************************************************************************************
+** Function name:           decompress
+** Description:             Decode a prepared jpeg and pass the blocks to the callback
+***************************************************************************************/
+JRESULT TJpg_Decoder::decompress(JDEC* jdec)
+{
+#ifdef TJPGD_PIPELINE
+  if (pipeline) {
+    pipeJdec  = jdec;
+    pipeAbort = false;
+
+    if (pipeline->task.start(decodeTask, this)) {
+      // Render the blocks until the end marker
+      for (;;) {
+        TJpg_Block* block = pipeline->startRead();
+        if (block->w == 0) break;
+        // Blocks decoded after the callback stopped the decoding are dropped
+        if (!pipeAbort && !tft_output(block->x, block->y, block->w, block->h, block->data)) pipeAbort = true;
+        pipeline->endRead();
+      }
+      pipeline->endRead();
+      pipeline->task.join();
+      // The decoding may have ended before the callback stopped on a queued block
+      return pipeAbort ? JDR_INTR : pipeResult;
+    }
+  }
+#endif
+
+  return jd_decomp(jdec, jd_output, jpgScale);
+}
+
 /***************************************************************************************
 ** Function name:           jd_input (declared static)
 ** Description:             Called by tjpgd.c to get more data
 ***************************************************************************************/
-unsigned int TJpg_Decoder::jd_input(JDEC* jdec, uint8_t* buf, unsigned int len)
+size_t TJpg_Decoder::jd_input(JDEC* jdec, uint8_t* buf, size_t len)
 {
   TJpg_Decoder *thisPtr = TJpgDec.thisPtr;
   jdec = jdec; // Supress warning
@@ -151,6 +237,24 @@ int TJpg_Decoder::jd_output(JDEC* jdec, void* bitmap, JRECT* jrect)
   uint16_t w = jrect->right  + 1 - jrect->left;
   uint16_t h = jrect->bottom + 1 - jrect->top;
 
+#ifdef TJPGD_PIPELINE
+  // Copy the image block to the pipeline, the bitmap is overwritten by the next block
+  if (thisPtr->pipeline) {
+    TJpg_Block* block = thisPtr->pipeline->startWrite();
+    if (thisPtr->pipeAbort) {
+      thisPtr->pipeline->cancelWrite();
+      return 0;
+    }
+    block->x = x;
+    block->y = y;
+    block->w = w;
+    block->h = h;
+    memcpy(block->data, bitmap, w * h * sizeof(uint16_t));
+    thisPtr->pipeline->endWrite();
+    return 1;
+  }
+#endif
+
   // Pass the image block and rendering parameters in a callback to the sketch
   return thisPtr->tft_output(x, y, w, h, (uint16_t*)bitmap);
 }
@@ -289,14 +393,15 @@ JRESULT TJpg_Decoder::drawFsJpg(int32_t x, int32_t y, fs::File inFile) {
   jpeg_y = y;
 
   jdec.swap = _swap;
+  jdec.dither = _dither;
 
   jpgFile = inFile;
 
-  jresult = jd_prepare(&jdec, jd_input, workspace, TJPGD_WORKSPACE_SIZE, (unsigned int)0);
+  jresult = jd_prepare(&jdec, jd_input, workspace, TJPGD_WORKSPACE_SIZE, nullptr);
 
   // Extract image and render
   if (jresult == JDR_OK) {
-    jresult = jd_decomp(&jdec, jd_output, jpgScale);
+    jresult = decompress(&jdec);
   }
 
   // Close file
@@ -352,7 +457,7 @@ JRESULT TJpg_Decoder::getFsJpgSize(uint16_t *w, uint16_t *h, fs::File inFile) {
 
   jpgFile = inFile;
 
-  jresult = jd_prepare(&jdec, jd_input, workspace, TJPGD_WORKSPACE_SIZE, 0);
+  jresult = jd_prepare(&jdec, jd_input, workspace, TJPGD_WORKSPACE_SIZE, nullptr);
 
   if (jresult == JDR_OK) {
     *w = jdec.width;
@@ -416,14 +521,15 @@ JRESULT TJpg_Decoder::drawSdJpg(int32_t x, int32_t y, File inFile) {
   jpeg_y = y;
 
   jdec.swap = _swap;
+  jdec.dither = _dither;
 
   jpgSdFile = inFile;
 
-  jresult = jd_prepare(&jdec, jd_input, workspace, TJPGD_WORKSPACE_SIZE, 0);
+  jresult = jd_prepare(&jdec, jd_input, workspace, TJPGD_WORKSPACE_SIZE, nullptr);
 
   // Extract image and render
   if (jresult == JDR_OK) {
-    jresult = jd_decomp(&jdec, jd_output, jpgScale);
+    jresult = decompress(&jdec);
   }
 
   // Close file
@@ -481,7 +587,7 @@ JRESULT TJpg_Decoder::getSdJpgSize(uint16_t *w, uint16_t *h, File inFile) {
 
   jpgSdFile = inFile;
 
-  jresult = jd_prepare(&jdec, jd_input, workspace, TJPGD_WORKSPACE_SIZE, 0);
+  jresult = jd_prepare(&jdec, jd_input, workspace, TJPGD_WORKSPACE_SIZE, nullptr);
 
   if (jresult == JDR_OK) {
     *w = jdec.width;
@@ -513,13 +619,14 @@ JRESULT TJpg_Decoder::drawJpg(int32_t x, int32_t y, const uint8_t jpeg_data[], u
   jpeg_y = y;
 
   jdec.swap = _swap;
+  jdec.dither = _dither;
 
   // Analyse input data
-  jresult = jd_prepare(&jdec, jd_input, workspace, TJPGD_WORKSPACE_SIZE, 0);
+  jresult = jd_prepare(&jdec, jd_input, workspace, TJPGD_WORKSPACE_SIZE, nullptr);
 
   // Extract image and render
   if (jresult == JDR_OK) {
-    jresult = jd_decomp(&jdec, jd_output, jpgScale);
+    jresult = decompress(&jdec);
   }
 
   return jresult;
@@ -542,7 +649,7 @@ JRESULT TJpg_Decoder::getJpgSize(uint16_t *w, uint16_t *h, const uint8_t jpeg_da
   array_size  = data_size;
 
   // Analyse input data
-  jresult = jd_prepare(&jdec, jd_input, workspace, TJPGD_WORKSPACE_SIZE, 0);
+  jresult = jd_prepare(&jdec, jd_input, workspace, TJPGD_WORKSPACE_SIZE, nullptr);
 
   if (jresult == JDR_OK) {
     *w = jdec.width;
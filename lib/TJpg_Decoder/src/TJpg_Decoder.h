@@ -16,6 +16,7 @@ https://github.com/Bodmer/TJpg_Decoder
   #include "User_Config.h"
   #include "Arduino.h"
   #include "tjpgd.h"
+  #include "TJpg_Pipeline.h"
 
   #if defined (ARDUINO_ARCH_ESP8266) || defined (ESP32)
     #include <pgmspace.h>
@@ -63,11 +64,16 @@ public:
   ~TJpg_Decoder();
 
   static int jd_output(JDEC* jdec, void* bitmap, JRECT* jrect);
-  static unsigned int jd_input(JDEC* jdec, uint8_t* buf, unsigned int len);
+  static size_t jd_input(JDEC* jdec, uint8_t* buf, size_t len);
 
   void setJpgScale(uint8_t scale);
   void setCallback(SketchCallback sketchCallback);
 
+#ifdef TJPGD_PIPELINE
+  // Decode in a task on the other core while the blocks are rendered by the callback
+  bool setPipeline(bool enable, uint8_t blocks = TJPGD_PIPELINE_BLOCKS);
+#endif
+
 
 #if defined (TJPGD_LOAD_SD_LIBRARY) || defined (TJPGD_LOAD_FFS)
   JRESULT drawJpg (int32_t x, int32_t y, const char *pFilename);
@@ -101,8 +107,10 @@ public:
   JRESULT getJpgSize(uint16_t *w, uint16_t *h, const uint8_t array[], uint32_t  array_size);
 
   void setSwapBytes(bool swap);
+  void setDither(bool dither);
 
   bool _swap = false;
+  bool _dither = false;
 
   const uint8_t* array_data  = nullptr;
   uint32_t array_index = 0;
@@ -121,6 +129,18 @@ public:
   SketchCallback tft_output = nullptr;
 
   TJpg_Decoder *thisPtr = nullptr;
+
+private:
+  JRESULT decompress(JDEC* jdec);
+
+#ifdef TJPGD_PIPELINE
+  static void decodeTask(void* p);
+
+  TJpg_Pipeline* pipeline = nullptr;
+  JDEC*   pipeJdec   = nullptr;
+  JRESULT pipeResult = JDR_OK;
+  std::atomic<bool> pipeAbort{false}; // Set by the rendering task, read by the decoding task
+#endif
 };
 
 extern TJpg_Decoder TJpgDec;
@@ -0,0 +1,226 @@
+/*
+TJpg_Pipeline.cpp
+
+Bounded queue of decoded MCU blocks, see TJpg_Pipeline.h
+*/
+
+#include "TJpg_Pipeline.h"
+
+#ifdef TJPGD_PIPELINE
+
+#include <stdlib.h>
+
+/***************************************************************************************
+** Function name:           TJpg_Semaphore::begin
+** Description:             Create a counting semaphore
+***************************************************************************************/
+bool TJpg_Semaphore::begin(uint16_t max, uint16_t initial)
+{
+#ifdef TJPGD_PIPELINE_FREERTOS
+  sem = xSemaphoreCreateCounting(max, initial);
+  return sem != nullptr;
+#else
+  (void)max;
+  cnt = initial;
+  return true;
+#endif
+}
+
+/***************************************************************************************
+** Function name:           TJpg_Semaphore::end
+** Description:             Delete the semaphore
+***************************************************************************************/
+void TJpg_Semaphore::end()
+{
+#ifdef TJPGD_PIPELINE_FREERTOS
+  if (sem) vSemaphoreDelete(sem);
+  sem = nullptr;
+#endif
+}
+
+/***************************************************************************************
+** Function name:           TJpg_Semaphore::take
+** Description:             Wait until the count is not zero, then decrement it
+***************************************************************************************/
+void TJpg_Semaphore::take()
+{
+#ifdef TJPGD_PIPELINE_FREERTOS
+  xSemaphoreTake(sem, portMAX_DELAY);
+#else
+  std::unique_lock<std::mutex> lock(mutex);
+  cond.wait(lock, [this] { return cnt > 0; });
+  cnt--;
+#endif
+}
+
+/***************************************************************************************
+** Function name:           TJpg_Semaphore::give
+** Description:             Increment the count
+***************************************************************************************/
+void TJpg_Semaphore::give()
+{
+#ifdef TJPGD_PIPELINE_FREERTOS
+  xSemaphoreGive(sem);
+#else
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    cnt++;
+  }
+  cond.notify_one();
+#endif
+}
+
+/***************************************************************************************
+** Function name:           TJpg_Task::begin
+** Description:             Create the resources to start tasks
+***************************************************************************************/
+bool TJpg_Task::begin()
+{
+#ifdef TJPGD_PIPELINE_FREERTOS
+  return done.begin(1, 0);
+#else
+  return true;
+#endif
+}
+
+/***************************************************************************************
+** Function name:           TJpg_Task::end
+** Description:             Free the resources
+***************************************************************************************/
+void TJpg_Task::end()
+{
+#ifdef TJPGD_PIPELINE_FREERTOS
+  done.end();
+#endif
+}
+
+#ifdef TJPGD_PIPELINE_FREERTOS
+/***************************************************************************************
+** Function name:           TJpg_Task::run (declared static)
+** Description:             FreeRTOS task calling the function, then deleting itself
+***************************************************************************************/
+void TJpg_Task::run(void* p)
+{
+  TJpg_Task* task = (TJpg_Task*)p;
+  task->taskFunc(task->taskArg);
+  task->done.give();
+  vTaskDelete(NULL);
+}
+#endif
+
+/***************************************************************************************
+** Function name:           TJpg_Task::start
+** Description:             Call func(arg) in a new task, on the other core of an ESP32
+***************************************************************************************/
+bool TJpg_Task::start(void (*func)(void*), void* arg)
+{
+#ifdef TJPGD_PIPELINE_FREERTOS
+  taskFunc = func;
+  taskArg  = arg;
+  BaseType_t core = xPortGetCoreID() ? 0 : 1;
+  return xTaskCreatePinnedToCore(run, "TJpgDec", TJPGD_PIPELINE_STACK, this,
+                                 uxTaskPriorityGet(NULL), NULL, core) == pdPASS;
+#else
+  thread = std::thread(func, arg);
+  return true;
+#endif
+}
+
+/***************************************************************************************
+** Function name:           TJpg_Task::join
+** Description:             Wait for the end of the task
+***************************************************************************************/
+void TJpg_Task::join()
+{
+#ifdef TJPGD_PIPELINE_FREERTOS
+  done.take();
+#else
+  thread.join();
+#endif
+}
+
+/***************************************************************************************
+** Function name:           TJpg_Pipeline::begin
+** Description:             Allocate the blocks of the queue
+***************************************************************************************/
+bool TJpg_Pipeline::begin(uint8_t blockCount)
+{
+  if (blockCount == 0) return false;
+
+  blocks = (TJpg_Block*)malloc(blockCount * sizeof(TJpg_Block));
+  if (!blocks) return false;
+
+  count = blockCount;
+  head  = 0;
+  tail  = 0;
+
+  if (freeBlocks.begin(count, count) && fullBlocks.begin(count, 0) && task.begin()) return true;
+
+  end();
+  return false;
+}
+
+/***************************************************************************************
+** Function name:           TJpg_Pipeline::end
+** Description:             Free the blocks and the semaphores
+***************************************************************************************/
+void TJpg_Pipeline::end()
+{
+  task.end();
+  freeBlocks.end();
+  fullBlocks.end();
+  free(blocks);
+  blocks = nullptr;
+  count  = 0;
+}
+
+/***************************************************************************************
+** Function name:           TJpg_Pipeline::startWrite
+** Description:             Wait for a free block and return it
+***************************************************************************************/
+TJpg_Block* TJpg_Pipeline::startWrite()
+{
+  freeBlocks.take();
+  return &blocks[head];
+}
+
+/***************************************************************************************
+** Function name:           TJpg_Pipeline::endWrite
+** Description:             Pass the block returned by startWrite() to the reader
+***************************************************************************************/
+void TJpg_Pipeline::endWrite()
+{
+  if (++head == count) head = 0;
+  fullBlocks.give();
+}
+
+/***************************************************************************************
+** Function name:           TJpg_Pipeline::cancelWrite
+** Description:             Give back the block returned by startWrite() unused
+***************************************************************************************/
+void TJpg_Pipeline::cancelWrite()
+{
+  freeBlocks.give();
+}
+
+/***************************************************************************************
+** Function name:           TJpg_Pipeline::startRead
+** Description:             Wait for a filled block and return it
+***************************************************************************************/
+TJpg_Block* TJpg_Pipeline::startRead()
+{
+  fullBlocks.take();
+  return &blocks[tail];
+}
+
+/***************************************************************************************
+** Function name:           TJpg_Pipeline::endRead
+** Description:             Free the block returned by startRead()
+***************************************************************************************/
+void TJpg_Pipeline::endRead()
+{
+  if (++tail == count) tail = 0;
+  freeBlocks.give();
+}
+
+#endif // TJPGD_PIPELINE
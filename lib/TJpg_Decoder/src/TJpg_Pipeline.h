@@ -0,0 +1,123 @@
+/*
+TJpg_Pipeline.h
+
+Bounded queue of decoded MCU blocks used to decode a jpeg in one task while
+the blocks are rendered in another task (see TJpg_Decoder::setPipeline()).
+
+The task and semaphore primitives are provided by FreeRTOS on dual core
+ESP32 processors and by std::thread on Linux (or when TJPGD_PIPELINE_STD_THREAD
+is defined), so the same queue can be tested on a PC.
+*/
+
+#ifndef TJpg_Pipeline_H
+  #define TJpg_Pipeline_H
+
+  #if defined (TJPGD_PIPELINE_STD_THREAD) || (defined (__linux__) && !defined (ESP32))
+    #define TJPGD_PIPELINE
+    #include <thread>
+    #include <mutex>
+    #include <condition_variable>
+  #elif defined (ESP32) && !defined (CONFIG_FREERTOS_UNICORE)
+    #define TJPGD_PIPELINE
+    #define TJPGD_PIPELINE_FREERTOS
+    #include "freertos/FreeRTOS.h"
+    #include "freertos/task.h"
+    #include "freertos/semphr.h"
+  #endif
+
+#ifdef TJPGD_PIPELINE
+
+#include <stdint.h>
+#include <atomic>
+
+// Default number of MCU blocks which can be decoded ahead of the rendering
+#ifndef TJPGD_PIPELINE_BLOCKS
+  #define TJPGD_PIPELINE_BLOCKS 8
+#endif
+
+// Stack size of the decoding task (FreeRTOS only)
+#ifndef TJPGD_PIPELINE_STACK
+  #define TJPGD_PIPELINE_STACK 8192
+#endif
+
+//------------------------------------------------------------------------------
+
+// A decoded block, a complete or partial MCU of at most 16 x 16 pixels.
+// w == 0 marks the end of the image.
+typedef struct {
+  int16_t  x;
+  int16_t  y;
+  uint16_t w;
+  uint16_t h;
+  uint16_t data[16 * 16];
+} TJpg_Block;
+
+class TJpg_Semaphore {
+
+public:
+  bool begin(uint16_t max, uint16_t initial);
+  void end();
+  void take();
+  void give();
+
+private:
+#ifdef TJPGD_PIPELINE_FREERTOS
+  SemaphoreHandle_t sem = nullptr;
+#else
+  std::mutex mutex;
+  std::condition_variable cond;
+  uint16_t cnt = 0;
+#endif
+};
+
+// Runs a function in a new task, on the other core of an ESP32
+class TJpg_Task {
+
+public:
+  bool begin();
+  void end();
+  bool start(void (*func)(void*), void* arg);
+  void join();
+
+private:
+#ifdef TJPGD_PIPELINE_FREERTOS
+  static void run(void* p);
+  TJpg_Semaphore done;
+  void (*taskFunc)(void*) = nullptr;
+  void* taskArg = nullptr;
+#else
+  std::thread thread;
+#endif
+};
+
+// Ring of blocks with one writer and one reader
+class TJpg_Pipeline {
+
+public:
+  bool begin(uint8_t blocks);
+  void end();
+
+  // Writer: wait for a free block, then fill it and pass it to the reader
+  // or give it back unused
+  TJpg_Block* startWrite();
+  void endWrite();
+  void cancelWrite();
+
+  // Reader: wait for a filled block, then render it and free it
+  TJpg_Block* startRead();
+  void endRead();
+
+  TJpg_Task task;
+
+private:
+  TJpg_Block* blocks = nullptr;
+  uint8_t count = 0;
+  uint8_t head  = 0;
+  uint8_t tail  = 0;
+  TJpg_Semaphore freeBlocks;
+  TJpg_Semaphore fullBlocks;
+};
+
+#endif // TJPGD_PIPELINE
+
+#endif // TJpg_Pipeline_H
@@ -87,6 +87,7 @@ struct JDEC {
 	size_t (*infunc)(JDEC*, uint8_t*, size_t);	/* Pointer to jpeg stream input function */
 	void* device;				/* Pointer to I/O device identifiler for the session */
 	uint8_t swap;       /* Added by Bodmer to control byte swapping */
+	uint8_t dither;     /* Added by Bodmer to control ordered dithering of RGB565 */
 };
 
 
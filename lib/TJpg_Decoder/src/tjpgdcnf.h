@@ -34,6 +34,19 @@
 /     Workspace of 9644 bytes needed.
 */
 
+#ifndef JD_SIMD
+#define JD_SIMD		1
+#endif
+/* Use SIMD instructions for the IDCT, the output is the same as without them.
+/  0: Disable
+/  1: Enable NEON (ARM) if the compiler targets it
+/  2: + SSE2 (x86). Slower than the portable code, which x86 compilers vectorize
+/     by themselves, but it allows to test the vector IDCT on a PC.
+/  The IDCT for other instruction sets (e.g. ESP32-S3 PIE) can be linked instead
+/  by defining JD_IDCT_FUNC as the name of the function, see block_idct().
+*/
+/* #define JD_IDCT_FUNC	jd_idct_esp32s3 */
+
 // Do not change this, it is the minimum size in bytes of the workspace needed by the decoder
 #if JD_FASTDECODE == 0
  #define TJPGD_WORKSPACE_SIZE 3100
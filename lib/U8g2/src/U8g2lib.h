@@ -209,6 +209,10 @@ class U8G2
       { u8g2_UpdateDisplayArea(&u8g2, tx, ty, tw, th); }
     void updateDisplay(void)
       { u8g2_UpdateDisplay(&u8g2); }
+    void sendDirty(void)
+      { u8g2_SendDirty(&u8g2); }
+    void setBufferDirty(void)
+      { u8g2_SetBufferDirty(&u8g2); }
     void refreshDisplay(void)
       { u8x8_RefreshDisplay(u8g2_GetU8x8(&u8g2)); }
     
@@ -268,6 +272,9 @@ class U8G2
 
     void setFont(const uint8_t  *font) {u8g2_SetFont(&u8g2, font); }
     void setFontMode(uint8_t  is_transparent) {u8g2_SetFontMode(&u8g2, is_transparent); }
+#ifdef U8G2_WITH_GLYPH_CACHE
+    void clearGlyphCache(void) { u8g2_ClearGlyphCache(&u8g2); }
+#endif
     void setFontDirection(uint8_t dir) {u8g2_SetFontDirection(&u8g2, dir); }
 
     int8_t getAscent(void) { return u8g2_GetAscent(&u8g2); }
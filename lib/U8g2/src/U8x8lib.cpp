@@ -897,12 +897,21 @@ extern "C" uint8_t u8x8_byte_arduino_hw_spi(u8x8_t *u8x8, uint8_t msg, uint8_t a
 #if defined(ESP_PLATFORM)
       //T.M.L 2023-02-28: use the block transfer function on ESP, which does not overwrite the buffer.
       SPI.writeBytes((uint8_t*)arg_ptr, arg_int);  
-#else    
+#elif ARDUINO >= 10605
       // 1.6.5 offers a block transfer, but the problem is, that the
-      // buffer is overwritten with the incoming data
-      // so it can not be used...
-      // SPI.transfer((uint8_t *)arg_ptr, arg_int);
-      
+      // buffer is overwritten with the incoming data,
+      // so the data is copied to a local block first
+      data = (uint8_t *)arg_ptr;
+      while( arg_int > 0 )
+      {
+        uint8_t block[U8X8_SPI_BLOCK_SIZE];
+        uint8_t cnt = arg_int < U8X8_SPI_BLOCK_SIZE ? arg_int : U8X8_SPI_BLOCK_SIZE;
+        memcpy(block, data, cnt);
+        SPI.transfer(block, cnt);
+        data += cnt;
+        arg_int -= cnt;
+      }
+#else    
       data = (uint8_t *)arg_ptr;
       while( arg_int > 0 )
       {
@@ -1020,17 +1029,28 @@ extern "C" uint8_t u8x8_byte_arduino_2nd_hw_spi(U8X8_UNUSED u8x8_t *u8x8, U8X8_U
     case U8X8_MSG_BYTE_SEND:
       
       // 1.6.5 offers a block transfer, but the problem is, that the
-      // buffer is overwritten with the incoming data
-      // so it can not be used...
-      // SPI.transfer((uint8_t *)arg_ptr, arg_int);
+      // buffer is overwritten with the incoming data,
+      // so the data is copied to a local block first
       
       data = (uint8_t *)arg_ptr;
+#if ARDUINO >= 10605
+      while( arg_int > 0 )
+      {
+	uint8_t block[U8X8_SPI_BLOCK_SIZE];
+	uint8_t cnt = arg_int < U8X8_SPI_BLOCK_SIZE ? arg_int : U8X8_SPI_BLOCK_SIZE;
+	memcpy(block, data, cnt);
+	SPI1.transfer(block, cnt);
+	data += cnt;
+	arg_int -= cnt;
+      }
+#else
       while( arg_int > 0 )
       {
 	SPI1.transfer((uint8_t)*data);
 	data++;
 	arg_int--;
       }
+#endif
   
       break;
     case U8X8_MSG_BYTE_INIT:
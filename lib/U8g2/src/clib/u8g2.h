@@ -176,6 +176,40 @@
 #endif
 
 
+/*
+  The following macro enables the tracking of the tiles changed by the draw procedures.
+  u8g2_SendDirty() will then only send the changed tiles in full buffer mode.
+  This requires U8G2_DIRTY_TILES_MAX/8 bytes of RAM in the u8g2 structure and 
+  a few more instructions for each drawn line.
+  Displays with more than U8G2_DIRTY_TILES_MAX tiles (128x64 pixel by default)
+  will always get the complete buffer with u8g2_SendDirty().
+  Without this macro, u8g2_SendDirty() is the same as u8g2_SendBuffer().
+*/
+//#define U8G2_WITH_DIRTY_TILES
+
+#ifndef U8G2_DIRTY_TILES_MAX
+#define U8G2_DIRTY_TILES_MAX 128
+#endif
+
+/*
+  The following macro enables a cache for decoded glyphs.
+  Glyphs which are drawn again and again (like the digits of a clock) are decoded 
+  only once into runs of pixels and then drawn from RAM. The glyph data search 
+  is also skipped, digits are found directly.
+  The cache requires about U8G2_GLYPH_CACHE_SIZE + 6*U8G2_GLYPH_CACHE_ENTRIES bytes 
+  of RAM in the u8g2 structure. If the cache is full, it is cleared.
+*/
+//#define U8G2_WITH_GLYPH_CACHE
+
+#ifndef U8G2_GLYPH_CACHE_SIZE
+#define U8G2_GLYPH_CACHE_SIZE 1024
+#endif
+
+#ifndef U8G2_GLYPH_CACHE_ENTRIES
+#define U8G2_GLYPH_CACHE_ENTRIES 16
+#endif
+
+
 /*==========================================*/
 
 
@@ -289,6 +323,27 @@ struct _u8g2_font_decode_t
 };
 typedef struct _u8g2_font_decode_t u8g2_font_decode_t;
 
+#ifdef U8G2_WITH_GLYPH_CACHE
+struct _u8g2_glyph_cache_entry_t
+{
+  const uint8_t *font;
+  uint16_t encoding;
+  uint16_t pos;				/* start of the glyph in the cache data */
+};
+typedef struct _u8g2_glyph_cache_entry_t u8g2_glyph_cache_entry_t;
+
+struct _u8g2_glyph_cache_t
+{
+  u8g2_glyph_cache_entry_t entry[U8G2_GLYPH_CACHE_ENTRIES];
+  const uint8_t *digit_font;		/* font of the digit entries */
+  uint8_t digit[10];			/* entry+1 of '0'..'9' of digit_font, 0 if not cached */
+  uint8_t cnt;				/* number of used entries */
+  uint16_t used;			/* number of used bytes in data */
+  uint8_t data[U8G2_GLYPH_CACHE_SIZE];	/* glyphs: width, height, x, y, delta x, runs */
+};
+typedef struct _u8g2_glyph_cache_t u8g2_glyph_cache_t;
+#endif /* U8G2_WITH_GLYPH_CACHE */
+
 struct _u8g2_kerning_t
 {
   uint16_t first_table_cnt;
@@ -382,6 +437,14 @@ struct u8g2_struct
 					
 	// the following variable should be renamed to is_buffer_auto_clear
   uint8_t is_auto_page_clear; 		/* set to 0 to disable automatic clear of the buffer in firstPage() and nextPage() */
+
+#ifdef U8G2_WITH_GLYPH_CACHE
+  u8g2_glyph_cache_t glyph_cache;
+#endif /* U8G2_WITH_GLYPH_CACHE */
+
+#ifdef U8G2_WITH_DIRTY_TILES
+  uint8_t dirty_tiles[U8G2_DIRTY_TILES_MAX/8];	/* one bit for each tile, row by row: tile differs from the display */
+#endif /* U8G2_WITH_DIRTY_TILES */
   
 };
 
@@ -1730,6 +1793,11 @@ uint8_t u8g2_NextPage(u8g2_t *u8g2);
 
 void u8g2_UpdateDisplayArea(u8g2_t *u8g2, uint8_t  tx, uint8_t ty, uint8_t tw, uint8_t th);
 void u8g2_UpdateDisplay(u8g2_t *u8g2);
+void u8g2_SendDirty(u8g2_t *u8g2);
+void u8g2_SetBufferDirty(u8g2_t *u8g2);
+#ifdef U8G2_WITH_DIRTY_TILES
+void u8g2_mark_dirty_hvline(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len, uint8_t dir);
+#endif /* U8G2_WITH_DIRTY_TILES */
 
 void u8g2_WriteBufferPBM(u8g2_t *u8g2, void (*out)(const char *s));
 void u8g2_WriteBufferXBM(u8g2_t *u8g2, void (*out)(const char *s));
@@ -1877,6 +1945,9 @@ size_t u8g2_GetFontSize(const uint8_t *font_arg);
 
 void u8g2_SetFont(u8g2_t *u8g2, const uint8_t  *font);
 void u8g2_SetFontMode(u8g2_t *u8g2, uint8_t is_transparent);
+#ifdef U8G2_WITH_GLYPH_CACHE
+void u8g2_ClearGlyphCache(u8g2_t *u8g2);
+#endif /* U8G2_WITH_GLYPH_CACHE */
 
 uint8_t u8g2_IsGlyph(u8g2_t *u8g2, uint16_t requested_encoding);
 int8_t u8g2_GetGlyphWidth(u8g2_t *u8g2, uint16_t requested_encoding);
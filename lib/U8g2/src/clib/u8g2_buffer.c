@@ -36,10 +36,137 @@
 #include "u8g2.h"
 #include <string.h>
 
+/*============================================*/
+/* tile dirty tracking */
+
+#ifdef U8G2_WITH_DIRTY_TILES
+
+/* returns 0 if the display has more tiles than the dirty bits */
+static uint8_t u8g2_is_dirty_tracked(u8g2_t *u8g2)
+{
+  uint16_t cnt;
+  cnt = u8g2_GetU8x8(u8g2)->display_info->tile_width;
+  cnt *= u8g2_GetU8x8(u8g2)->display_info->tile_height;
+  return cnt <= U8G2_DIRTY_TILES_MAX;
+}
+
+/*
+  Called with the (clipped) hv line in pixel buffer coordinates, before the line is drawn.
+  dir 0: horizontal line, dir 1: vertical line
+*/
+void u8g2_mark_dirty_hvline(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len, uint8_t dir)
+{
+  uint16_t pos;
+  uint8_t w;
+  uint8_t step;
+  uint8_t cnt;
+  
+  if ( u8g2_is_dirty_tracked(u8g2) == 0 )
+    return;
+  
+  w = u8g2_GetU8x8(u8g2)->display_info->tile_width;
+  pos = y>>3;
+  pos += u8g2->tile_curr_row;
+  pos *= w;
+  pos += x>>3;
+  
+  len--;
+  if ( dir == 0 )
+  {
+    step = 1;
+    cnt = ((x&7) + len)>>3;
+  }
+  else
+  {
+    step = w;
+    cnt = ((y&7) + len)>>3;
+  }
+  
+  /* cnt is the number of tiles after the first one */
+  for(;;)
+  {
+    u8g2->dirty_tiles[pos>>3] |= 1<<(pos&7);
+    if ( cnt == 0 )
+      break;
+    cnt--;
+    pos += step;
+  }
+}
+
+/*
+  Mark the tiles with pixels set, the display may show them.
+  The tile in a row with 8*tile_width bytes is at byte 8*tx (vertical_top_lsb) and
+  its 8 bytes follow each other. For horizontal_right_lsb the tile is at byte tx and its 
+  bytes are tile_width apart.
+*/
+static void u8g2_mark_dirty_nonzero(u8g2_t *u8g2)
+{
+  uint8_t *ptr;
+  uint8_t *tile;
+  uint16_t pos;
+  uint8_t w;
+  uint8_t tx, ty, i;
+  uint8_t tile_step;
+  uint8_t byte_step;
+  uint8_t b;
+  
+  w = u8g2_GetU8x8(u8g2)->display_info->tile_width;
+  if ( u8g2->ll_hvline == u8g2_ll_hvline_horizontal_right_lsb )
+  {
+    tile_step = 1;
+    byte_step = w;
+  }
+  else
+  {
+    tile_step = 8;
+    byte_step = 1;
+  }
+  
+  ptr = u8g2->tile_buf_ptr;
+  pos = 0;
+  for( ty = 0; ty < u8g2->tile_buf_height; ty++ )
+  {
+    tile = ptr;
+    for( tx = 0; tx < w; tx++ )
+    {
+      b = 0;
+      for( i = 0; i < 8; i++ )
+	b |= tile[i*byte_step];
+      if ( b != 0 )
+	u8g2->dirty_tiles[pos>>3] |= 1<<(pos&7);
+      tile += tile_step;
+      pos++;
+    }
+    ptr += w*8;
+  }
+}
+
+#endif /* U8G2_WITH_DIRTY_TILES */
+
+/*
+  Mark all tiles as changed: the next u8g2_SendDirty() sends the complete buffer.
+  Use this after writing to the buffer directly or after the display memory was changed
+  by other means.
+*/
+void u8g2_SetBufferDirty(u8g2_t *u8g2)
+{
+#ifdef U8G2_WITH_DIRTY_TILES
+  memset(u8g2->dirty_tiles, 0xff, sizeof(u8g2->dirty_tiles));
+#else
+  (void)u8g2;
+#endif /* U8G2_WITH_DIRTY_TILES */
+}
+
 /*============================================*/
 void u8g2_ClearBuffer(u8g2_t *u8g2)
 {
   size_t cnt;
+#ifdef U8G2_WITH_DIRTY_TILES
+  /* in full buffer mode, tiles which are already empty are not changed */
+  if ( u8g2->tile_buf_height == u8g2_GetU8x8(u8g2)->display_info->tile_height )
+    if ( u8g2_is_dirty_tracked(u8g2) )
+      u8g2_mark_dirty_nonzero(u8g2);
+#endif /* U8G2_WITH_DIRTY_TILES */
   cnt = u8g2_GetU8x8(u8g2)->display_info->tile_width;
   cnt *= u8g2->tile_buf_height;
   cnt *= 8;
@@ -87,6 +214,12 @@ static void u8g2_send_buffer(u8g2_t *u8g2)
     src_row++;
     dest_row++;
   } while( src_row < src_max && dest_row < dest_max );
+  
+#ifdef U8G2_WITH_DIRTY_TILES
+  /* full buffer mode: the display shows the complete buffer now */
+  if ( src_max == dest_max )
+    memset(u8g2->dirty_tiles, 0, sizeof(u8g2->dirty_tiles));
+#endif /* U8G2_WITH_DIRTY_TILES */
 }
 
 /* same as u8g2_send_buffer but also send the DISPLAY_REFRESH message (used by SSD1606) */
@@ -168,6 +301,18 @@ void u8g2_UpdateDisplayArea(u8g2_t *u8g2, uint8_t  tx, uint8_t ty, uint8_t tw, u
   while( th > 0 )
   {
     u8x8_DrawTile( u8g2_GetU8x8(u8g2), tx, ty, tw, ptr );
+#ifdef U8G2_WITH_DIRTY_TILES
+    if ( u8g2_is_dirty_tracked(u8g2) )
+    {
+      uint16_t pos;
+      uint8_t i;
+      pos = ty;
+      pos *= u8g2_GetU8x8(u8g2)->display_info->tile_width;
+      pos += tx;
+      for( i = 0; i < tw; i++, pos++ )
+	u8g2->dirty_tiles[pos>>3] &= ~(1<<(pos&7));
+    }
+#endif /* U8G2_WITH_DIRTY_TILES */
     ptr += page_size;
     ty++;
     th--;
@@ -180,6 +325,83 @@ void u8g2_UpdateDisplay(u8g2_t *u8g2)
   u8g2_send_buffer(u8g2);
 }
 
+/*
+  Description:
+    Same as u8g2_SendBuffer(), but only the tiles which were changed since the
+    buffer was sent last are transmitted. Consecutive changed tiles of a tile row 
+    are sent together with one u8x8_DrawTile() call. For displays with
+    horizontal memory architecture, complete tile rows are sent.
+    The ePaper refresh message is only sent if something was transmitted.
+    
+    Tiles are marked by all u8g2 draw procedures, u8g2_ClearBuffer() marks the
+    tiles which were not empty. Call u8g2_SetBufferDirty() after
+    modifying the buffer directly.
+
+  Limitations:
+    - In page mode or without U8G2_WITH_DIRTY_TILES, this is u8g2_SendBuffer()
+    - Displays with more than U8G2_DIRTY_TILES_MAX tiles get the complete buffer
+    - Only works with displays, which support sending tiles at any position (U8x8 API)
+*/
+void u8g2_SendDirty(u8g2_t *u8g2)
+{
+#ifdef U8G2_WITH_DIRTY_TILES
+  u8x8_t *u8x8 = u8g2_GetU8x8(u8g2);
+  uint8_t *ptr;
+  uint16_t pos;
+  uint8_t w;
+  uint8_t tx, ty;
+  uint8_t cnt;
+  uint8_t is_sent;
+  
+  w = u8x8->display_info->tile_width;
+  if ( u8g2->tile_buf_height != u8x8->display_info->tile_height || u8g2_is_dirty_tracked(u8g2) == 0 )
+  {
+    u8g2_SendBuffer(u8g2);
+    return;
+  }
+  
+  ptr = u8g2->tile_buf_ptr;
+  pos = 0;
+  is_sent = 0;
+  for( ty = 0; ty < u8g2->tile_buf_height; ty++ )
+  {
+    tx = 0;
+    while( tx < w )
+    {
+      cnt = 0;
+      while( tx+cnt < w && (u8g2->dirty_tiles[(pos+cnt)>>3] & (1<<((pos+cnt)&7))) != 0 )
+	cnt++;
+      if ( cnt != 0 )
+      {
+	is_sent = 1;
+	if ( u8g2->ll_hvline == u8g2_ll_hvline_horizontal_right_lsb )
+	{
+	  /* the bytes of a tile are not next to each other, send the row */
+	  u8g2_send_tile_row(u8g2, ty, ty);
+	  pos += w-tx;
+	  break;
+	}
+	u8x8_DrawTile(u8x8, tx, ty, cnt, ptr+tx*8);
+	tx += cnt;
+	pos += cnt;
+      }
+      else
+      {
+	tx++;
+	pos++;
+      }
+    }
+    ptr += w*8;
+  }
+  
+  memset(u8g2->dirty_tiles, 0, sizeof(u8g2->dirty_tiles));
+  if ( is_sent )
+    u8x8_RefreshDisplay(u8x8);
+#else
+  u8g2_SendBuffer(u8g2);
+#endif /* U8G2_WITH_DIRTY_TILES */
+}
+
 
 /*============================================*/
 
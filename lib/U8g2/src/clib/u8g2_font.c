@@ -34,6 +34,7 @@
 */
 
 #include "u8g2.h"
+#include <string.h>
 
 /* size of the font data structure, there is no struct or class... */
 /* this is the size for the new font format */
@@ -366,6 +367,57 @@ void u8g2_add_vector(u8g2_uint_t *xp, u8g2_uint_t *yp, int8_t x, int8_t y, uint8
 
 
 
+/*
+  Description:
+    Draw a line of a glyph, which does not cross the glyph border.
+  Args:
+    lx, ly:				Local position of the line in the glyph
+    len: 					Length of the line
+    is_foreground			foreground/background?
+    dir					0: along the glyph row, 1: down the glyph column
+    u8g2->font_decode.target_x		X position
+    u8g2->font_decode.target_y		Y position
+    u8g2->font_decode.is_transparent	Transparent mode
+*/
+static void u8g2_font_decode_line(u8g2_t *u8g2, uint8_t lx, uint8_t ly, uint8_t len, uint8_t is_foreground, uint8_t dir)
+{
+  /* target position on the screen */
+  u8g2_uint_t x, y;
+  
+  u8g2_font_decode_t *decode = &(u8g2->font_decode);
+  
+  /* get target position */
+  x = decode->target_x;
+  y = decode->target_y;
+
+  /* apply rotation */
+#ifdef U8G2_WITH_FONT_ROTATION
+  
+  x = u8g2_add_vector_x(x, lx, ly, decode->dir);
+  y = u8g2_add_vector_y(y, lx, ly, decode->dir);
+  dir += decode->dir;
+  dir &= 3;
+  
+  //u8g2_add_vector(&x, &y, lx, ly, decode->dir);
+  
+#else
+  x += lx;
+  y += ly;
+#endif
+  
+  /* draw foreground and background (if required) */
+  if ( is_foreground )
+  {
+    u8g2->draw_color = decode->fg_color;			/* draw_color will be restored later */
+    u8g2_DrawHVLine(u8g2, x, y, len, dir);
+  }
+  else if ( decode->is_transparent == 0 )    
+  {
+    u8g2->draw_color = decode->bg_color;			/* draw_color will be restored later */
+    u8g2_DrawHVLine(u8g2, x, y, len, dir);
+  }
+}
+
 /*
   Description:
     Draw a run-length area of the glyph. "len" can have any size and the line
@@ -394,9 +446,6 @@ void u8g2_font_decode_len(u8g2_t *u8g2, uint8_t len, uint8_t is_foreground)
   /* local coordinates of the glyph */
   uint8_t lx,ly;
   
-  /* target position on the screen */
-  u8g2_uint_t x, y;
-  
   u8g2_font_decode_t *decode = &(u8g2->font_decode);
   
   cnt = len;
@@ -419,54 +468,7 @@ void u8g2_font_decode_len(u8g2_t *u8g2, uint8_t len, uint8_t is_foreground)
     
     
     /* now draw the line, but apply the rotation around the glyph target position */
-    //u8g2_font_decode_draw_pixel(u8g2, lx,ly,current, is_foreground);
-
-    /* get target position */
-    x = decode->target_x;
-    y = decode->target_y;
-
-    /* apply rotation */
-#ifdef U8G2_WITH_FONT_ROTATION
-    
-    x = u8g2_add_vector_x(x, lx, ly, decode->dir);
-    y = u8g2_add_vector_y(y, lx, ly, decode->dir);
-    
-    //u8g2_add_vector(&x, &y, lx, ly, decode->dir);
-    
-#else
-    x += lx;
-    y += ly;
-#endif
-    
-    /* draw foreground and background (if required) */
-    if ( is_foreground )
-    {
-      u8g2->draw_color = decode->fg_color;			/* draw_color will be restored later */
-      u8g2_DrawHVLine(u8g2, 
-	x, 
-	y, 
-	current, 
-#ifdef U8G2_WITH_FONT_ROTATION
-	/* dir */ decode->dir
-#else
-	0
-#endif
-      );
-    }
-    else if ( decode->is_transparent == 0 )    
-    {
-      u8g2->draw_color = decode->bg_color;			/* draw_color will be restored later */
-      u8g2_DrawHVLine(u8g2, 
-	x, 
-	y, 
-	current, 
-#ifdef U8G2_WITH_FONT_ROTATION
-	/* dir */ decode->dir
-#else
-	0
-#endif
-      );   
-    }
+    u8g2_font_decode_line(u8g2, lx, ly, current, is_foreground, 0);
     
     /* check, whether the end of the run length code has been reached */
     if ( cnt < rem )
@@ -597,58 +599,41 @@ static void u8g2_font_setup_decode(u8g2_t *u8g2, const uint8_t *glyph_data)
 
 /*
   Description:
-    Decode and draw a glyph.
+    Move the target position to the upper left corner of the glyph and check
+    whether the glyph is visible.
   Args:
-    glyph_data: 					Pointer to the compressed glyph data of the font
-    u8g2->font_decode.target_x		X position
-    u8g2->font_decode.target_y		Y position
-    u8g2->font_decode.is_transparent	Transparent mode
+    x, y, h:					Offset and height of the glyph
+    u8g2->font_decode.glyph_width		Width of the glyph
   Return:
-    Width (delta x advance) of the glyph.
-  Calls:
-    u8g2_font_decode_len()
+    0, if the glyph is outside of the current page (nothing to draw)
 */
-/* optimized */
-int8_t u8g2_font_decode_glyph(u8g2_t *u8g2, const uint8_t *glyph_data)
+static uint8_t u8g2_font_setup_target(u8g2_t *u8g2, int8_t x, int8_t y, int8_t h)
 {
-  uint8_t a, b;
-  int8_t x, y;
-  int8_t d;
-  int8_t h;
   u8g2_font_decode_t *decode = &(u8g2->font_decode);
-    
-  u8g2_font_setup_decode(u8g2, glyph_data);     /* set values in u8g2->font_decode data structure */
-  h = u8g2->font_decode.glyph_height;
-  
-  x = u8g2_font_decode_get_signed_bits(decode, u8g2->font_info.bits_per_char_x);
-  y = u8g2_font_decode_get_signed_bits(decode, u8g2->font_info.bits_per_char_y);
-  d = u8g2_font_decode_get_signed_bits(decode, u8g2->font_info.bits_per_delta_x);
   
-  if ( decode->glyph_width > 0 )
-  {
 #ifdef U8G2_WITH_FONT_ROTATION
-    decode->target_x = u8g2_add_vector_x(decode->target_x, x, -(h+y), decode->dir);
-    decode->target_y = u8g2_add_vector_y(decode->target_y, x, -(h+y), decode->dir);
-    
-    //u8g2_add_vector(&(decode->target_x), &(decode->target_y), x, -(h+y), decode->dir);
+  decode->target_x = u8g2_add_vector_x(decode->target_x, x, -(h+y), decode->dir);
+  decode->target_y = u8g2_add_vector_y(decode->target_y, x, -(h+y), decode->dir);
+  
+  //u8g2_add_vector(&(decode->target_x), &(decode->target_y), x, -(h+y), decode->dir);
 
 #else
-    decode->target_x += x;
-    decode->target_y -= h+y;
+  decode->target_x += x;
+  decode->target_y -= h+y;
 #endif
-    //u8g2_add_vector(&(decode->target_x), &(decode->target_y), x, -(h+y), decode->dir);
+  //u8g2_add_vector(&(decode->target_x), &(decode->target_y), x, -(h+y), decode->dir);
 
 #ifdef U8G2_WITH_INTERSECTION
-    {
-      u8g2_uint_t x0, x1, y0, y1;
-      x0 = decode->target_x;
-      y0 = decode->target_y;
-      x1 = x0;
-      y1 = y0;
-      
+  {
+    u8g2_uint_t x0, x1, y0, y1;
+    x0 = decode->target_x;
+    y0 = decode->target_y;
+    x1 = x0;
+    y1 = y0;
+    
 #ifdef U8G2_WITH_FONT_ROTATION
-      switch(decode->dir)
-      {
+    switch(decode->dir)
+    {
 	case 0:
 	    x1 += decode->glyph_width;
 	    y1 += h;
@@ -673,16 +658,53 @@ int8_t u8g2_font_decode_glyph(u8g2_t *u8g2, const uint8_t *glyph_data)
 	    y0++;	/* shift down, because of assymetric boundaries for the interseciton test */
 	    y1++;
 	    break;	  
-      }
+    }
 #else /* U8G2_WITH_FONT_ROTATION */
-      x1 += decode->glyph_width;
-      y1 += h;      
+    x1 += decode->glyph_width;
+    y1 += h;      
 #endif
-      
-      if ( u8g2_IsIntersection(u8g2, x0, y0, x1, y1) == 0 ) 
-	return d;
-    }
+    
+    if ( u8g2_IsIntersection(u8g2, x0, y0, x1, y1) == 0 ) 
+	return 0;
+  }
 #endif /* U8G2_WITH_INTERSECTION */
+  return 1;
+}
+
+
+/*
+  Description:
+    Decode and draw a glyph.
+  Args:
+    glyph_data: 					Pointer to the compressed glyph data of the font
+    u8g2->font_decode.target_x		X position
+    u8g2->font_decode.target_y		Y position
+    u8g2->font_decode.is_transparent	Transparent mode
+  Return:
+    Width (delta x advance) of the glyph.
+  Calls:
+    u8g2_font_decode_len()
+*/
+/* optimized */
+int8_t u8g2_font_decode_glyph(u8g2_t *u8g2, const uint8_t *glyph_data)
+{
+  uint8_t a, b;
+  int8_t x, y;
+  int8_t d;
+  int8_t h;
+  u8g2_font_decode_t *decode = &(u8g2->font_decode);
+    
+  u8g2_font_setup_decode(u8g2, glyph_data);     /* set values in u8g2->font_decode data structure */
+  h = u8g2->font_decode.glyph_height;
+  
+  x = u8g2_font_decode_get_signed_bits(decode, u8g2->font_info.bits_per_char_x);
+  y = u8g2_font_decode_get_signed_bits(decode, u8g2->font_info.bits_per_char_y);
+  d = u8g2_font_decode_get_signed_bits(decode, u8g2->font_info.bits_per_delta_x);
+  
+  if ( decode->glyph_width > 0 )
+  {
+    if ( u8g2_font_setup_target(u8g2, x, y, h) == 0 )
+      return d;
    
     /* reset local x/y position */
     decode->x = 0;
@@ -866,6 +888,254 @@ const uint8_t *u8g2_font_get_glyph_data(u8g2_t *u8g2, uint16_t encoding)
   return NULL;
 }
 
+/*========================================================================*/
+/* glyph cache */
+
+#ifdef U8G2_WITH_GLYPH_CACHE
+
+/*
+  Cached glyph data:
+    width, height, x offset, y offset, delta x
+    groups of equal rows: number of rows, run lengths starting with the background until the width is reached
+  Runs of a group are drawn as vertical lines, if there are less lines this way.
+*/
+
+void u8g2_ClearGlyphCache(u8g2_t *u8g2)
+{
+  u8g2->glyph_cache.cnt = 0;
+  u8g2->glyph_cache.used = 0;
+  u8g2->glyph_cache.digit_font = NULL;
+}
+
+static const uint8_t *u8g2_glyph_cache_find(u8g2_t *u8g2, uint16_t encoding)
+{
+  u8g2_glyph_cache_t *cache = &(u8g2->glyph_cache);
+  uint8_t i;
+  
+  /* fast path for the digits of the last font with cached digits */
+  if ( encoding >= '0' && encoding <= '9' && cache->digit_font == u8g2->font )
+  {
+    i = cache->digit[encoding-'0'];
+    if ( i == 0 )
+      return NULL;
+    return cache->data + cache->entry[i-1].pos;
+  }
+  
+  for( i = 0; i < cache->cnt; i++ )
+  {
+    if ( cache->entry[i].encoding == encoding && cache->entry[i].font == u8g2->font )
+      return cache->data + cache->entry[i].pos;
+  }
+  return NULL;
+}
+
+/*
+  Decode the glyph into runs of the cache data. Returns NULL if it does not fit.
+  Runs which would continue below the glyph are dropped.
+*/
+static const uint8_t *u8g2_glyph_cache_decode(u8g2_t *u8g2, const uint8_t *glyph_data)
+{
+  u8g2_glyph_cache_t *cache = &(u8g2->glyph_cache);
+  u8g2_font_decode_t *decode = &(u8g2->font_decode);
+  uint8_t *data = cache->data;
+  uint16_t pos;
+  uint16_t group;		/* position of the row count of the previous group, 0 if none */
+  uint16_t row;			/* position of the row count of the current row */
+  uint16_t run;			/* position of the current run */
+  uint8_t is_foreground;	/* color of the current run */
+  uint8_t w, h;
+  uint8_t lx, ly;
+  uint8_t len, current;
+  uint8_t ab[2];
+  uint8_t i;
+  
+  pos = cache->used;
+  if ( pos + 5 > U8G2_GLYPH_CACHE_SIZE )
+    return NULL;
+  
+  u8g2_font_setup_decode(u8g2, glyph_data);
+  w = decode->glyph_width;
+  h = decode->glyph_height;
+  data[pos++] = w;
+  data[pos++] = h;
+  data[pos++] = u8g2_font_decode_get_signed_bits(decode, u8g2->font_info.bits_per_char_x);
+  data[pos++] = u8g2_font_decode_get_signed_bits(decode, u8g2->font_info.bits_per_char_y);
+  data[pos++] = u8g2_font_decode_get_signed_bits(decode, u8g2->font_info.bits_per_delta_x);
+  
+  if ( w > 0 && h > 0 )
+  {
+    lx = 0;
+    ly = 0;
+    group = 0;
+    if ( pos + 2 > U8G2_GLYPH_CACHE_SIZE )
+      return NULL;
+    row = pos;
+    data[pos++] = 1;
+    run = pos;
+    data[pos++] = 0;
+    is_foreground = 0;
+    while( ly < h )
+    {
+      /* next pair of runs: a background, b foreground pixels, repeated */
+      ab[0] = u8g2_font_decode_get_unsigned_bits(decode, u8g2->font_info.bits_per_0);
+      ab[1] = u8g2_font_decode_get_unsigned_bits(decode, u8g2->font_info.bits_per_1);
+      do
+      {
+	for( i = 0; i < 2 && ly < h; i++ )
+	{
+	  len = ab[i];
+	  while( len > 0 )
+	  {
+	    current = w - lx;
+	    if ( len < current )
+	      current = len;
+	    if ( is_foreground != i )
+	    {
+	      if ( pos >= U8G2_GLYPH_CACHE_SIZE )
+		return NULL;
+	      run = pos;
+	      data[pos++] = 0;
+	      is_foreground = i;
+	    }
+	    data[run] += current;
+	    lx += current;
+	    len -= current;
+	    if ( lx >= w )
+	    {
+	      /* end of the row: add it to the previous group, if the runs are the same */
+	      if ( group != 0 && data[group] < 255 && row - group == pos - row && memcmp(data+group+1, data+row+1, row-group-1) == 0 )
+	      {
+		data[group]++;
+		pos = row;
+	      }
+	      else
+	      {
+		group = row;
+	      }
+	      lx = 0;
+	      ly++;
+	      if ( ly >= h )
+		break;
+	      if ( pos + 2 > U8G2_GLYPH_CACHE_SIZE )
+		return NULL;
+	      row = pos;
+	      data[pos++] = 1;
+	      run = pos;
+	      data[pos++] = 0;
+	      is_foreground = 0;
+	    }
+	  }
+	}
+      } while( ly < h && u8g2_font_decode_get_unsigned_bits(decode, 1) != 0 );
+    }
+  }
+  
+  data += cache->used;
+  cache->used = pos;
+  return data;
+}
+
+/* Decode and add a glyph of the current font, the cache is cleared if it is full. */
+static const uint8_t *u8g2_glyph_cache_add(u8g2_t *u8g2, uint16_t encoding, const uint8_t *glyph_data)
+{
+  u8g2_glyph_cache_t *cache = &(u8g2->glyph_cache);
+  const uint8_t *cached;
+  
+  if ( cache->cnt >= U8G2_GLYPH_CACHE_ENTRIES )
+    u8g2_ClearGlyphCache(u8g2);
+  cached = u8g2_glyph_cache_decode(u8g2, glyph_data);
+  if ( cached == NULL )
+  {
+    if ( cache->cnt == 0 )
+      return NULL;		/* larger than the cache */
+    u8g2_ClearGlyphCache(u8g2);
+    cached = u8g2_glyph_cache_decode(u8g2, glyph_data);
+    if ( cached == NULL )
+      return NULL;
+  }
+  
+  cache->entry[cache->cnt].font = u8g2->font;
+  cache->entry[cache->cnt].encoding = encoding;
+  cache->entry[cache->cnt].pos = cached - cache->data;
+  cache->cnt++;
+  
+  if ( encoding >= '0' && encoding <= '9' )
+  {
+    if ( cache->digit_font != u8g2->font )
+    {
+      memset(cache->digit, 0, sizeof(cache->digit));
+      cache->digit_font = u8g2->font;
+    }
+    cache->digit[encoding-'0'] = cache->cnt;
+  }
+  return cached;
+}
+
+/* same as u8g2_font_decode_glyph(), but with the glyph from the cache */
+static int8_t u8g2_font_draw_cached_glyph(u8g2_t *u8g2, const uint8_t *cached)
+{
+  u8g2_font_decode_t *decode = &(u8g2->font_decode);
+  uint8_t w;
+  uint8_t lx, ly;
+  uint8_t cnt;
+  uint8_t len;
+  uint8_t i;
+  uint8_t is_foreground;
+  int8_t d;
+  int8_t h;
+  
+  decode->glyph_width = cached[0];
+  decode->glyph_height = cached[1];
+  w = cached[0];
+  h = cached[1];
+  d = (int8_t)cached[4];
+  
+  if ( w > 0 && h > 0 )
+  {
+    if ( u8g2_font_setup_target(u8g2, (int8_t)cached[2], (int8_t)cached[3], h) == 0 )
+      return d;
+    
+    decode->fg_color = u8g2->draw_color;
+    decode->bg_color = (decode->fg_color == 0 ? 1 : 0);
+    
+    cached += 5;
+    ly = 0;
+    do
+    {
+      cnt = *cached++;
+      lx = 0;
+      is_foreground = 0;
+      do
+      {
+	len = *cached++;
+	if ( len != 0 )
+	{
+	  if ( cnt > len )
+	  {
+	    /* less vertical lines */
+	    for( i = 0; i < len; i++ )
+	      u8g2_font_decode_line(u8g2, lx+i, ly, cnt, is_foreground, 1);
+	  }
+	  else
+	  {
+	    for( i = 0; i < cnt; i++ )
+	      u8g2_font_decode_line(u8g2, lx, ly+i, len, is_foreground, 0);
+	  }
+	}
+	lx += len;
+	is_foreground ^= 1;
+      } while( lx < w );
+      ly += cnt;
+    } while( ly < (uint8_t)h );
+    
+    /* restore the u8g2 draw color, because this is modified by the decode algo */
+    u8g2->draw_color = decode->fg_color;
+  }
+  return d;
+}
+
+#endif /* U8G2_WITH_GLYPH_CACHE */
+
 static u8g2_uint_t u8g2_font_draw_glyph(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, uint16_t encoding)
 {
   u8g2_uint_t dx = 0;
@@ -873,9 +1143,19 @@ static u8g2_uint_t u8g2_font_draw_glyph(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t
   u8g2->font_decode.target_y = y;
   //u8g2->font_decode.is_transparent = is_transparent; this is already set
   //u8g2->font_decode.dir = dir;
+#ifdef U8G2_WITH_GLYPH_CACHE
+  const uint8_t *cached = u8g2_glyph_cache_find(u8g2, encoding);
+  if ( cached != NULL )
+    return u8g2_font_draw_cached_glyph(u8g2, cached);
+#endif /* U8G2_WITH_GLYPH_CACHE */
   const uint8_t *glyph_data = u8g2_font_get_glyph_data(u8g2, encoding);
   if ( glyph_data != NULL )
   {
+#ifdef U8G2_WITH_GLYPH_CACHE
+    cached = u8g2_glyph_cache_add(u8g2, encoding, glyph_data);
+    if ( cached != NULL )
+      return u8g2_font_draw_cached_glyph(u8g2, cached);
+#endif /* U8G2_WITH_GLYPH_CACHE */
     dx = u8g2_font_decode_glyph(u8g2, glyph_data);
   }
   return dx;
@@ -907,6 +1187,16 @@ uint8_t u8g2_IsGlyph(u8g2_t *u8g2, uint16_t requested_encoding)
 /* side effect: updates u8g2->font_decode and u8g2->glyph_x_offset */
 int8_t u8g2_GetGlyphWidth(u8g2_t *u8g2, uint16_t requested_encoding)
 {
+#ifdef U8G2_WITH_GLYPH_CACHE
+  const uint8_t *cached = u8g2_glyph_cache_find(u8g2, requested_encoding);
+  if ( cached != NULL )
+  {
+    u8g2->font_decode.glyph_width = cached[0];
+    u8g2->font_decode.glyph_height = cached[1];
+    u8g2->glyph_x_offset = (int8_t)cached[2];
+    return (int8_t)cached[4];
+  }
+#endif /* U8G2_WITH_GLYPH_CACHE */
   const uint8_t *glyph_data = u8g2_font_get_glyph_data(u8g2, requested_encoding);
   if ( glyph_data == NULL )
     return 0; 
@@ -137,6 +137,9 @@ void u8g2_draw_hv_line_2dir(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uin
   /* transform to pixel buffer coordinates */
   y -= u8g2->pixel_curr_row;
   
+#ifdef U8G2_WITH_DIRTY_TILES
+  u8g2_mark_dirty_hvline(u8g2, x, y, len, dir);
+#endif /* U8G2_WITH_DIRTY_TILES */
   u8g2->ll_hvline(u8g2, x, y, len, dir);
 }
 
@@ -89,6 +89,11 @@ void u8g2_SetupBuffer(u8g2_t *u8g2, uint8_t *buf, uint8_t tile_buf_height, u8g2_
   u8g2->draw_color = 1;
   u8g2->is_auto_page_clear = 1;
   
+  u8g2_SetBufferDirty(u8g2);	/* the content of the display is not known */
+#ifdef U8G2_WITH_GLYPH_CACHE
+  u8g2_ClearGlyphCache(u8g2);
+#endif /* U8G2_WITH_GLYPH_CACHE */
+  
   u8g2->cb = u8g2_cb;
   u8g2->cb->update_dimension(u8g2);
 #ifdef U8G2_WITH_CLIP_WINDOW_SUPPORT
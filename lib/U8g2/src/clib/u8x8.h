@@ -198,6 +198,32 @@ uint8_t u8x8_pgm_read_esp(const uint8_t * addr);   /* u8x8_8x8.c */
 #define U8X8_USE_PINS
 #endif
 
+/*
+  Max number of data bytes, which are sent within one I2C start/stop sequence.
+  The data is preceded by the control byte, so this must be one less than the
+  Wire buffer of the target. u8x8_cad_ssd13xx_fast_i2c() also collects commands
+  up to this size. The AVR Wire library has a 32 byte buffer, 24 is
+  the value, which was always used by u8g2. The Wire libraries of ESP32, ESP8266,
+  SAMD and RP2040 have 128 bytes or more and a tile row of a 128 pixel
+  display can be sent with two I2C transfers instead of six.
+*/
+#ifndef U8X8_I2C_MAX_DATA
+#  if defined(ESP32) || defined(ESP8266) || defined(ARDUINO_ARCH_SAMD) || defined(ARDUINO_ARCH_RP2040)
+#    define U8X8_I2C_MAX_DATA 127
+#  else
+#    define U8X8_I2C_MAX_DATA 24
+#  endif
+#endif
+
+/*
+  Number of bytes, which are copied to a local buffer and sent with the block
+  transfer of the Arduino SPI library. The block transfer overwrites the
+  buffer with the received bytes, so the tile data can not be passed directly.
+*/
+#ifndef U8X8_SPI_BLOCK_SIZE
+#  define U8X8_SPI_BLOCK_SIZE 32
+#endif
+
 #if defined(__ARM_LINUX__) || defined(unix) || defined(__unix__) || defined(__unix)
 /* https://github.com/olikraus/u8g2/pull/1666 */
 #define U8X8_USE_PINS
@@ -503,14 +503,14 @@ uint8_t u8x8_cad_ssd13xx_i2c(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *a
       /* smaller streams, 32 seems to be the limit... */
       /* I guess this is related to the size of the Wire buffers in Arduino */
       /* Unfortunately, this can not be handled in the byte level drivers, */
-      /* so this is done here. Even further, only 24 bytes will be sent, */
+      /* so this is done here. Even further, only U8X8_I2C_MAX_DATA (24) bytes will be sent, */
       /* because there will be another byte (DC) required during the transfer */
       p = arg_ptr;
-       while( arg_int > 24 )
+       while( arg_int > U8X8_I2C_MAX_DATA )
       {
-	u8x8_i2c_data_transfer(u8x8, 24, p);
-	arg_int-=24;
-	p+=24;
+	u8x8_i2c_data_transfer(u8x8, U8X8_I2C_MAX_DATA, p);
+	arg_int-=U8X8_I2C_MAX_DATA;
+	p+=U8X8_I2C_MAX_DATA;
       }
       u8x8_i2c_data_transfer(u8x8, arg_int, p);
       break;
@@ -531,37 +531,41 @@ uint8_t u8x8_cad_ssd13xx_i2c(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *a
 
 
 /* fast version with reduced data start/stops, issue 735 */
+/* 
+  Commands are collected in one transfer as long as it has room for another command 
+  with 31 args. This is the "lightning version" without its drawback: with a 
+  U8X8_I2C_MAX_DATA of 127 the init sequence and the address commands of a tile row 
+  are one transfer each, with 24 every command still gets its own transfer.
+  Data is not collected across tile rows: after the data control byte all bytes up 
+  to the stop are written to the display RAM, so the address commands of the next 
+  row always start a new transfer.
+*/
 uint8_t u8x8_cad_ssd13xx_fast_i2c(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
 {
-  static uint8_t in_transfer = 0;
+  static uint8_t in_transfer = 0;	/* bytes in the command transfer, including the control byte */
   uint8_t *p;
   switch(msg)
   {
     case U8X8_MSG_CAD_SEND_CMD:
       /* improved version, takeover from ld7032 */
       /* assumes, that the args of a command is not longer than 31 bytes */
-      /* speed improvement is about 4% compared to the classic version */
-      if ( in_transfer != 0 )
-	 u8x8_byte_EndTransfer(u8x8); 
-      
-      u8x8_byte_StartTransfer(u8x8);
-      u8x8_byte_SendByte(u8x8, 0x000);	/* cmd byte for ssd13xx controller */
+      if ( in_transfer != 0 && in_transfer + 32 > U8X8_I2C_MAX_DATA + 1 )
+      {
+	u8x8_byte_EndTransfer(u8x8); 
+	in_transfer = 0;
+      }
+      if ( in_transfer == 0 )
+      {
+	u8x8_byte_StartTransfer(u8x8);
+	u8x8_byte_SendByte(u8x8, 0x000);	/* cmd byte for ssd13xx controller */
+	in_transfer = 1;
+      }
       u8x8_byte_SendByte(u8x8, arg_int);
-      in_transfer = 1;
-      /* lightning version: can replace the improved version from above */
-      /* the drawback of the lightning version is this: The complete init sequence */
-      /* must fit into the 32 byte Arduino Wire buffer, which might not always be the case */
-      /* speed improvement is about 6% compared to the classic version */
-      // if ( in_transfer == 0 )
-	// {
-	//   u8x8_byte_StartTransfer(u8x8);
-	//   u8x8_byte_SendByte(u8x8, 0x000);	/* cmd byte for ssd13xx controller */
-	//   in_transfer = 1;
-	// }
-	//u8x8_byte_SendByte(u8x8, arg_int);
+      in_transfer++;
       break;
     case U8X8_MSG_CAD_SEND_ARG:
       u8x8_byte_SendByte(u8x8, arg_int);
+      in_transfer++;
       break;      
     case U8X8_MSG_CAD_SEND_DATA:
       if ( in_transfer != 0 )
@@ -573,14 +577,14 @@ uint8_t u8x8_cad_ssd13xx_fast_i2c(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, vo
       /* smaller streams, 32 seems to be the limit... */
       /* I guess this is related to the size of the Wire buffers in Arduino */
       /* Unfortunately, this can not be handled in the byte level drivers, */
-      /* so this is done here. Even further, only 24 bytes will be sent, */
+      /* so this is done here. Even further, only U8X8_I2C_MAX_DATA (24) bytes will be sent, */
       /* because there will be another byte (DC) required during the transfer */
       p = arg_ptr;
-       while( arg_int > 24 )
+       while( arg_int > U8X8_I2C_MAX_DATA )
       {
-	u8x8_i2c_data_transfer(u8x8, 24, p);
-	arg_int-=24;
-	p+=24;
+	u8x8_i2c_data_transfer(u8x8, U8X8_I2C_MAX_DATA, p);
+	arg_int-=U8X8_I2C_MAX_DATA;
+	p+=U8X8_I2C_MAX_DATA;
       }
       u8x8_i2c_data_transfer(u8x8, arg_int, p);
       in_transfer = 0;
@@ -628,11 +632,11 @@ uint8_t u8x8_cad_st75256_i2c(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *a
     case U8X8_MSG_CAD_SEND_DATA:
       /* see ssd13xx driver */
       p = arg_ptr;
-       while( arg_int > 24 )
+       while( arg_int > U8X8_I2C_MAX_DATA )
       {
-	u8x8_i2c_data_transfer(u8x8, 24, p);
-	arg_int-=24;
-	p+=24;
+	u8x8_i2c_data_transfer(u8x8, U8X8_I2C_MAX_DATA, p);
+	arg_int-=U8X8_I2C_MAX_DATA;
+	p+=U8X8_I2C_MAX_DATA;
       }
       u8x8_i2c_data_transfer(u8x8, arg_int, p);
       break;
@@ -765,11 +769,11 @@ uint8_t u8x8_cad_uc16xx_i2c(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *ar
       // is_data = 1;  // 20 Jun 2021: I assume that this is missing here
       
       p = arg_ptr;
-      while( arg_int > 24 )
+      while( arg_int > U8X8_I2C_MAX_DATA )
       {
-	u8x8->byte_cb(u8x8, U8X8_MSG_CAD_SEND_DATA, 24, p);
-	arg_int-=24;
-	p+=24;
+	u8x8->byte_cb(u8x8, U8X8_MSG_CAD_SEND_DATA, U8X8_I2C_MAX_DATA, p);
+	arg_int-=U8X8_I2C_MAX_DATA;
+	p+=U8X8_I2C_MAX_DATA;
 	u8x8_byte_EndTransfer(u8x8); 
 	u8x8_byte_StartTransfer(u8x8);
       }
@@ -872,11 +876,11 @@ uint8_t u8x8_cad_uc1638_i2c(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *ar
       is_data = 1;
       
       p = arg_ptr;
-      while( arg_int > 24 )
+      while( arg_int > U8X8_I2C_MAX_DATA )
       {
-	u8x8->byte_cb(u8x8, U8X8_MSG_CAD_SEND_DATA, 24, p);
-	arg_int-=24;
-	p+=24;
+	u8x8->byte_cb(u8x8, U8X8_MSG_CAD_SEND_DATA, U8X8_I2C_MAX_DATA, p);
+	arg_int-=U8X8_I2C_MAX_DATA;
+	p+=U8X8_I2C_MAX_DATA;
 	u8x8_byte_EndTransfer(u8x8); 
 	u8x8_byte_StartTransfer(u8x8);
       }
@@ -80,6 +80,11 @@
 /*Default display refresh period. LVG will redraw changed areas with this period time*/
 #define LV_DISP_DEF_REFR_PERIOD 30      /*[ms]*/
 
+/*Adapt the period of the display refresh timer to the time taken by the refreshes.
+ *It's kept between this and `LV_DISP_DEF_REFR_PERIOD` and the statistics of the refresh times
+ *are collected (see `lv_disp_get_pacing()`). 0 to keep the period fixed.*/
+#define LV_DISP_PACING_MIN_PERIOD 16    /*[ms]*/
+
 /*Input device read period in milliseconds*/
 #define LV_INDEV_DEF_READ_PERIOD 15     /*[ms]*/
 
@@ -139,12 +144,27 @@
 #define LV_LAYER_SIMPLE_BUF_SIZE          (24 * 1024)
 #define LV_LAYER_SIMPLE_FALLBACK_BUF_SIZE (3 * 1024)
 
+/*Byte budget of the buffers of the objects with `LV_OBJ_FLAG_CACHED_LAYER`.
+ *These objects are rendered with their children once and redrawn by copying the buffer
+ *until something inside them is invalidated.
+ *If the budget is used up the objects are drawn normally. 0 to ignore the flag.
+ *With `LV_COLOR_SCREEN_TRANSP 0` only the objects which fully cover their area (e.g. no radius) are cached.*/
+#define LV_LAYER_CACHE_MAX_SIZE (16 * 1024)
+
 /*Default image cache size. Image caching keeps the images opened.
  *If only the built-in image formats are used there is no real advantage of caching. (I.e. if no new image decoder is added)
  *With complex image decoders (e.g. PNG or JPG) caching can save the continuous open/decode of images.
  *However the opened images might consume additional RAM.
  *0: to disable caching*/
-#define LV_IMG_CACHE_DEF_SIZE 0
+#define LV_IMG_CACHE_DEF_SIZE 8
+#if LV_IMG_CACHE_DEF_SIZE
+    /*Byte budget for keeping images fully decoded in the cache.
+     *Images which can be read only line-by-line (e.g. from files) are decoded once into a buffer
+     *if they fit into a quarter of this budget. Drawing them again doesn't call the decoder at all.
+     *The buffers can be placed into an external RAM with `lv_img_cache_set_decoded_alloc_cb()`.
+     *0: keep only the opened images*/
+    #define LV_IMG_CACHE_DECODED_SIZE (16 * 1024)
+#endif
 
 /*Number of stops allowed per gradient. Increase this to allow more stops.
  *This adds (sizeof(lv_color_t) + 1) bytes per additional stop*/
@@ -155,7 +175,7 @@
  *LV_GRAD_CACHE_DEF_SIZE sets the size of this cache in bytes.
  *If the cache is too small the map will be allocated only while it's required for the drawing.
  *0 mean no caching.*/
-#define LV_GRAD_CACHE_DEF_SIZE 0
+#define LV_GRAD_CACHE_DEF_SIZE (2 * 1024U)
 
 /*Allow dithering the gradients (to achieve visual smooth color gradients on limited color depth display)
  *LV_DITHER_GRADIENT implies allocating one or two more lines of the object's rendering surface
@@ -279,7 +299,7 @@
  *-----------*/
 
 /*1: Show CPU usage and FPS count*/
-#define LV_USE_PERF_MONITOR 1
+#define LV_USE_PERF_MONITOR 0
 #if LV_USE_PERF_MONITOR
     #define LV_USE_PERF_MONITOR_POS LV_ALIGN_BOTTOM_RIGHT
 #endif
@@ -231,15 +231,26 @@ void lv_scr_load_anim(lv_obj_t * new_scr, lv_scr_load_anim_t anim_type, uint32_t
     /*If an other screen load animation is in progress
      *make target screen loaded immediately. */
     if(d->scr_to_load) {
-        scr_load_internal(d->scr_to_load);
-        lv_anim_del(d->scr_to_load, NULL);
-        lv_obj_set_pos(d->scr_to_load, 0, 0);
-        lv_obj_remove_local_style_prop(d->scr_to_load, LV_STYLE_OPA, 0);
-
-        if(d->del_prev) {
-            lv_obj_del(act_scr);
+        /*`scr_load_internal` clears `scr_to_load` so save it first*/
+        lv_obj_t * scr_to_load = d->scr_to_load;
+        lv_anim_del(scr_to_load, NULL);
+        lv_obj_set_pos(scr_to_load, 0, 0);
+        lv_obj_remove_local_style_prop(scr_to_load, LV_STYLE_OPA, 0);
+
+        /*The screen being left might be animated too (e.g. `LV_SCR_LOAD_ANIM_MOVE_...`)*/
+        lv_obj_t * old_scr = act_scr == scr_to_load ? d->prev_scr : act_scr;
+        if(old_scr) {
+            lv_anim_del(old_scr, NULL);
+            lv_obj_set_pos(old_scr, 0, 0);
+            lv_obj_remove_local_style_prop(old_scr, LV_STYLE_OPA, 0);
         }
-        act_scr = d->scr_to_load;
+
+        scr_load_internal(scr_to_load);
+        d->prev_scr = NULL;
+        d->draw_prev_over_act = false;
+
+        if(d->del_prev && old_scr && old_scr != new_scr) lv_obj_del(old_scr);
+        act_scr = scr_to_load;
     }
 
     d->scr_to_load = new_scr;
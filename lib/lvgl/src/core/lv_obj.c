@@ -140,6 +140,7 @@ void lv_init(void)
     _lv_obj_style_init();
     _lv_ll_init(&LV_GC_ROOT(_lv_disp_ll), sizeof(lv_disp_t));
     _lv_ll_init(&LV_GC_ROOT(_lv_indev_ll), sizeof(lv_indev_t));
+    _lv_ll_init(&LV_GC_ROOT(_lv_layer_cache_ll), sizeof(_lv_obj_layer_cache_t));
 
     /*Initialize the screen refresh system*/
     _lv_refr_init();
@@ -289,6 +290,9 @@ void lv_obj_clear_flag(lv_obj_t * obj, lv_obj_flag_t f)
         lv_obj_mark_layout_as_dirty(lv_obj_get_parent(obj));
     }
 
+    if(f & LV_OBJ_FLAG_CACHED_LAYER) {
+        _lv_obj_free_layer_cache(obj);
+    }
 }
 
 void lv_obj_add_state(lv_obj_t * obj, lv_state_t state)
@@ -465,6 +469,8 @@ static void lv_obj_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
     lv_group_t * group = lv_obj_get_group(obj);
     if(group) lv_group_remove_obj(obj);
 
+    if(lv_obj_has_flag(obj, LV_OBJ_FLAG_CACHED_LAYER)) _lv_obj_free_layer_cache(obj);
+
     if(obj->spec_attr) {
         if(obj->spec_attr->children) {
             lv_mem_free(obj->spec_attr->children);
@@ -945,6 +951,9 @@ static void lv_obj_set_state(lv_obj_t * obj, lv_state_t new_state)
     if(cmp_res == _LV_STYLE_STATE_CMP_DIFF_REDRAW) {
         lv_obj_invalidate(obj);
     }
+    else if(cmp_res == _LV_STYLE_STATE_CMP_DIFF_REDRAW_SCROLLBAR) {
+        lv_obj_scrollbar_invalidate(obj);
+    }
     else if(cmp_res == _LV_STYLE_STATE_CMP_DIFF_LAYOUT) {
         lv_obj_refresh_style(obj, LV_PART_ANY, LV_STYLE_PROP_ANY);
     }
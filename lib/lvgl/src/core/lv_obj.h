@@ -108,6 +108,8 @@ enum {
     LV_OBJ_FLAG_IGNORE_LAYOUT   = (1L << 17), /**< Make the object position-able by the layouts*/
     LV_OBJ_FLAG_FLOATING        = (1L << 18), /**< Do not scroll the object when the parent scrolls and ignore layout*/
     LV_OBJ_FLAG_OVERFLOW_VISIBLE = (1L << 19), /**< Do not clip the children's content to the parent's boundary*/
+    LV_OBJ_FLAG_CACHED_LAYER    = (1L << 20), /**< Render the object with its children into a buffer once and redraw it from there until something inside is invalidated*/
+    LV_OBJ_FLAG_HW_SCROLL       = (1L << 21), /**< Move the content with the hardware scroll of the display on vertical scroll and redraw only the uncovered rows*/
 
     LV_OBJ_FLAG_LAYOUT_1        = (1L << 23), /**< Custom flag, free to use by layouts*/
     LV_OBJ_FLAG_LAYOUT_2        = (1L << 24), /**< Custom flag, free to use by layouts*/
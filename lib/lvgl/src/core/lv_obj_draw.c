@@ -10,6 +10,7 @@
 #include "lv_obj.h"
 #include "lv_disp.h"
 #include "lv_indev.h"
+#include "../misc/lv_gc.h"
 
 /*********************
  *      DEFINES
@@ -27,6 +28,9 @@
 /**********************
  *  STATIC VARIABLES
  **********************/
+#if LV_LAYER_CACHE_MAX_SIZE
+    static uint32_t layer_cache_mem_used;
+#endif
 
 /**********************
  *      MACROS
@@ -393,6 +397,86 @@ lv_layer_type_t _lv_obj_get_layer_type(const lv_obj_t * obj)
     else return LV_LAYER_TYPE_NONE;
 }
 
+_lv_obj_layer_cache_t * _lv_obj_get_layer_cache(const lv_obj_t * obj)
+{
+    _lv_obj_layer_cache_t * cache;
+    _LV_LL_READ(&LV_GC_ROOT(_lv_layer_cache_ll), cache) {
+        if(cache->obj == obj) return cache;
+    }
+    return NULL;
+}
+
+_lv_obj_layer_cache_t * _lv_obj_alloc_layer_cache(lv_obj_t * obj, lv_coord_t w, lv_coord_t h, lv_img_cf_t cf)
+{
+#if LV_LAYER_CACHE_MAX_SIZE
+    _lv_obj_layer_cache_t * cache = _lv_obj_get_layer_cache(obj);
+    if(cache && cache->img.header.w == w && cache->img.header.h == h && cache->img.header.cf == cf) return cache;
+
+    /*The buffer of the old size is not needed anymore*/
+    _lv_obj_free_layer_cache(obj);
+
+    uint32_t buf_size = lv_img_buf_get_img_size(w, h, cf);
+    if(layer_cache_mem_used + buf_size > LV_LAYER_CACHE_MAX_SIZE) return NULL;
+
+    uint8_t * buf = lv_mem_alloc(buf_size);
+    LV_ASSERT_MALLOC(buf);
+    if(buf == NULL) return NULL;
+
+    cache = _lv_ll_ins_head(&LV_GC_ROOT(_lv_layer_cache_ll));
+    LV_ASSERT_MALLOC(cache);
+    if(cache == NULL) {
+        lv_mem_free(buf);
+        return NULL;
+    }
+
+    lv_memset_00(cache, sizeof(_lv_obj_layer_cache_t));
+    cache->obj = obj;
+    cache->img.header.w = w;
+    cache->img.header.h = h;
+    cache->img.header.cf = cf;
+    cache->img.data_size = buf_size;
+    cache->img.data = buf;
+    layer_cache_mem_used += buf_size;
+
+    return cache;
+#else
+    LV_UNUSED(obj);
+    LV_UNUSED(w);
+    LV_UNUSED(h);
+    LV_UNUSED(cf);
+    return NULL;
+#endif
+}
+
+void _lv_obj_invalidate_layer_cache(const lv_obj_t * obj)
+{
+#if LV_LAYER_CACHE_MAX_SIZE
+    while(obj) {
+        if(lv_obj_has_flag(obj, LV_OBJ_FLAG_CACHED_LAYER)) {
+            _lv_obj_layer_cache_t * cache = _lv_obj_get_layer_cache(obj);
+            if(cache) cache->valid = 0;
+        }
+        obj = obj->parent;
+    }
+#else
+    LV_UNUSED(obj);
+#endif
+}
+
+void _lv_obj_free_layer_cache(lv_obj_t * obj)
+{
+    _lv_obj_layer_cache_t * cache = _lv_obj_get_layer_cache(obj);
+    if(cache == NULL) return;
+
+    lv_img_cache_invalidate_src(&cache->img);
+#if LV_LAYER_CACHE_MAX_SIZE
+    layer_cache_mem_used -= cache->img.data_size;
+#endif
+    lv_mem_free((void *)cache->img.data);
+    _lv_ll_remove(&LV_GC_ROOT(_lv_layer_cache_ll), cache);
+    lv_mem_free(cache);
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
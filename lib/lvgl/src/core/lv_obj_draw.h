@@ -39,6 +39,13 @@ typedef enum {
     LV_LAYER_TYPE_TRANSFORM,
 } lv_layer_type_t;
 
+/** The buffer of an object with `LV_OBJ_FLAG_CACHED_LAYER`*/
+typedef struct _lv_obj_layer_cache_t {
+    const struct _lv_obj_t * obj;   /**< The cached object*/
+    lv_img_dsc_t img;       /**< The object and its children rendered as an image. `img.data` is owned by the cache*/
+    uint8_t valid : 1;      /**< Cleared when the object or one of its children is invalidated*/
+} _lv_obj_layer_cache_t;
+
 typedef struct {
     lv_draw_ctx_t * draw_ctx;           /**< Draw context*/
     const struct _lv_obj_class_t * class_p;     /**< The class that sent the event */
@@ -161,6 +168,37 @@ lv_coord_t _lv_obj_get_ext_draw_size(const struct _lv_obj_t * obj);
 
 lv_layer_type_t _lv_obj_get_layer_type(const struct _lv_obj_t * obj);
 
+/**
+ * Get the layer cache of an object
+ * @param obj       pointer to an object
+ * @return          the layer cache or NULL if the object has no layer cache
+ */
+_lv_obj_layer_cache_t * _lv_obj_get_layer_cache(const struct _lv_obj_t * obj);
+
+/**
+ * Get the layer cache of an object with a buffer for an image with the given size and color format.
+ * If the size or color format has changed a new buffer is allocated and the cache is invalid.
+ * @param obj       pointer to an object
+ * @param w         width of the image
+ * @param h         height of the image
+ * @param cf        color format of the image
+ * @return          the layer cache or NULL if the buffer doesn't fit into `LV_LAYER_CACHE_MAX_SIZE`
+ */
+_lv_obj_layer_cache_t * _lv_obj_alloc_layer_cache(struct _lv_obj_t * obj, lv_coord_t w, lv_coord_t h,
+                                                  lv_img_cf_t cf);
+
+/**
+ * Mark the layer cache of an object and its parents as invalid, as something has changed in them.
+ * @param obj       pointer to an object
+ */
+void _lv_obj_invalidate_layer_cache(const struct _lv_obj_t * obj);
+
+/**
+ * Free the layer cache of an object
+ * @param obj       pointer to an object
+ */
+void _lv_obj_free_layer_cache(struct _lv_obj_t * obj);
+
 /**********************
  *      MACROS
  **********************/
@@ -838,6 +838,9 @@ void lv_obj_invalidate_area(const lv_obj_t * obj, const lv_area_t * area)
 {
     LV_ASSERT_OBJ(obj, MY_CLASS);
 
+    /*Even if the area is not visible now, it might be when the cached layer is drawn again*/
+    _lv_obj_invalidate_layer_cache(obj);
+
     lv_disp_t * disp   = lv_obj_get_disp(obj);
     if(!lv_disp_is_invalidation_enabled(disp)) return;
 
@@ -845,7 +848,7 @@ void lv_obj_invalidate_area(const lv_obj_t * obj, const lv_area_t * area)
     lv_area_copy(&area_tmp, area);
     if(!lv_obj_area_is_visible(obj, &area_tmp)) return;
 
-    _lv_inv_area(lv_obj_get_disp(obj),  &area_tmp);
+    _lv_inv_obj_area(disp, obj, &area_tmp);
 }
 
 void lv_obj_invalidate(const lv_obj_t * obj)
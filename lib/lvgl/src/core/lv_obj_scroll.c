@@ -11,6 +11,7 @@
 #include "lv_indev.h"
 #include "lv_disp.h"
 #include "lv_indev_scroll.h"
+#include "lv_refr.h"
 
 /*********************
  *      DEFINES
@@ -36,6 +37,7 @@ static void scroll_y_anim(void * obj, int32_t v);
 static void scroll_anim_ready_cb(lv_anim_t * a);
 static void scroll_area_into_view(const lv_area_t * area, lv_obj_t * child, lv_point_t * scroll_value,
                                   lv_anim_enable_t anim_en);
+static bool hw_scroll(lv_obj_t * obj, lv_coord_t dy, const lv_area_t * hor_area, const lv_area_t * ver_area);
 
 /**********************
  *  STATIC VARIABLES
@@ -415,13 +417,18 @@ lv_res_t _lv_obj_scroll_by_raw(lv_obj_t * obj, lv_coord_t x, lv_coord_t y)
 
     lv_obj_allocate_spec_attr(obj);
 
+    /*The scrollbars are moved with the content by the display, so they are needed from before the scroll*/
+    bool hw = x == 0 && lv_obj_has_flag(obj, LV_OBJ_FLAG_HW_SCROLL);
+    lv_area_t hor_area, ver_area;
+    if(hw) lv_obj_get_scrollbar_area(obj, &hor_area, &ver_area);
+
     obj->spec_attr->scroll.x += x;
     obj->spec_attr->scroll.y += y;
 
     lv_obj_move_children_by(obj, x, y, true);
     lv_res_t res = lv_event_send(obj, LV_EVENT_SCROLL, NULL);
     if(res != LV_RES_OK) return res;
-    lv_obj_invalidate(obj);
+    if(!hw || !hw_scroll(obj, y, &hor_area, &ver_area)) lv_obj_invalidate(obj);
     return LV_RES_OK;
 }
 
@@ -798,3 +805,72 @@ static void scroll_area_into_view(const lv_area_t * area, lv_obj_t * child, lv_p
     scroll_value->y += anim_en == LV_ANIM_OFF ? 0 : y_scroll;
     lv_obj_scroll_by(parent, x_scroll, y_scroll, anim_en);
 }
+
+/**
+ * Let the display move the content of an object after a vertical scroll and invalidate only the
+ * uncovered rows
+ * @param obj pointer to an object with `LV_OBJ_FLAG_HW_SCROLL`
+ * @param dy the scroll
+ * @param hor_area the horizontal scrollbar before the scroll
+ * @param ver_area the vertical scrollbar before the scroll
+ * @return false if the object needs to be invalidated
+ */
+static bool hw_scroll(lv_obj_t * obj, lv_coord_t dy, const lv_area_t * hor_area, const lv_area_t * ver_area)
+{
+    lv_disp_t * disp = lv_obj_get_disp(obj);
+    if(disp->driver->hw_scroll_cb == NULL) return false;
+    if(lv_disp_get_scr_prev(disp)) return false;
+
+    /*Only the children are moved, so the object has to look the same everywhere behind them*/
+    if(lv_obj_has_flag(obj, LV_OBJ_FLAG_OVERFLOW_VISIBLE)) return false;
+    if(lv_obj_get_style_radius(obj, LV_PART_MAIN) != 0) return false;
+    if(lv_obj_get_style_bg_opa(obj, LV_PART_MAIN) < LV_OPA_MAX) return false;
+    if(lv_obj_get_style_bg_grad_dir(obj, LV_PART_MAIN) != LV_GRAD_DIR_NONE) return false;
+    if(lv_obj_get_style_bg_img_src(obj, LV_PART_MAIN) != NULL) return false;
+
+    /*The top and bottom border stay in place*/
+    lv_area_t area = obj->coords;
+    lv_coord_t border_w = lv_obj_get_style_border_width(obj, LV_PART_MAIN);
+    if(border_w > 0 && lv_obj_get_style_border_opa(obj, LV_PART_MAIN) > LV_OPA_MIN) {
+        lv_border_side_t side = lv_obj_get_style_border_side(obj, LV_PART_MAIN);
+        if(side & (LV_BORDER_SIDE_LEFT | LV_BORDER_SIDE_RIGHT)) return false;
+        if(side & LV_BORDER_SIDE_TOP) area.y1 += border_w;
+        if(side & LV_BORDER_SIDE_BOTTOM) area.y2 -= border_w;
+    }
+
+    lv_obj_t * scr = lv_obj_get_screen(obj);
+    if(scr != lv_disp_get_scr_act(disp) && scr != lv_disp_get_layer_top(disp) && scr != lv_disp_get_layer_sys(disp)) {
+        return false;
+    }
+
+    /*Clip to the parents. Without transformations their coordinates are the same on the display.*/
+    lv_obj_t * parent;
+    for(parent = obj; parent; parent = lv_obj_get_parent(parent)) {
+        if(lv_obj_has_flag(parent, LV_OBJ_FLAG_HIDDEN)) return false;
+        if(_lv_obj_get_layer_type(parent) != LV_LAYER_TYPE_NONE) return false;
+        if(lv_obj_has_flag(parent, LV_OBJ_FLAG_OVERFLOW_VISIBLE)) continue;
+        if(!_lv_area_intersect(&area, &area, &parent->coords)) return false;
+    }
+
+    lv_area_t scr_area;
+    lv_area_set(&scr_area, 0, 0, lv_disp_get_hor_res(disp) - 1, lv_disp_get_ver_res(disp) - 1);
+    if(!_lv_area_intersect(&area, &area, &scr_area)) return false;
+
+    if(!_lv_refr_hw_scroll(disp, &area, dy)) return false;
+
+    /*The old scrollbars are moved with the content, so remove them from there and draw the new ones*/
+    lv_area_t moved;
+    if(lv_area_get_size(hor_area) > 0) {
+        moved = *hor_area;
+        lv_area_move(&moved, 0, dy);
+        lv_obj_invalidate_area(obj, &moved);
+    }
+    if(lv_area_get_size(ver_area) > 0) {
+        moved = *ver_area;
+        lv_area_move(&moved, 0, dy);
+        lv_obj_invalidate_area(obj, &moved);
+    }
+    lv_obj_scrollbar_invalidate(obj);
+
+    return true;
+}
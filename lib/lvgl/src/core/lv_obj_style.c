@@ -170,8 +170,6 @@ void lv_obj_refresh_style(lv_obj_t * obj, lv_style_selector_t selector, lv_style
 
     if(!style_refr) return;
 
-    lv_obj_invalidate(obj);
-
     lv_part_t part = lv_obj_style_get_selector_part(selector);
 
     bool is_layout_refr = lv_style_prop_has_flag(prop, LV_STYLE_PROP_LAYOUT_REFR);
@@ -179,6 +177,14 @@ void lv_obj_refresh_style(lv_obj_t * obj, lv_style_selector_t selector, lv_style
     bool is_inheritable = lv_style_prop_has_flag(prop, LV_STYLE_PROP_INHERIT);
     bool is_layer_refr = lv_style_prop_has_flag(prop, LV_STYLE_PROP_LAYER_REFR);
 
+    /*E.g. the scrollbar fading in and out on scroll doesn't need the whole object to be redrawn*/
+    if(part == LV_PART_SCROLLBAR && prop != LV_STYLE_PROP_ANY && !is_layout_refr && !is_ext_draw) {
+        lv_obj_scrollbar_invalidate(obj);
+        return;
+    }
+
+    lv_obj_invalidate(obj);
+
     if(is_layout_refr) {
         if(part == LV_PART_ANY ||
            part == LV_PART_MAIN ||
@@ -445,7 +451,12 @@ _lv_style_state_cmp_t _lv_obj_style_state_compare(lv_obj_t * obj, lv_state_t sta
             else if(lv_style_get_prop(style, LV_STYLE_SHADOW_OFS_Y, &v)) res = _LV_STYLE_STATE_CMP_DIFF_DRAW_PAD;
             else if(lv_style_get_prop(style, LV_STYLE_SHADOW_SPREAD, &v)) res = _LV_STYLE_STATE_CMP_DIFF_DRAW_PAD;
             else if(lv_style_get_prop(style, LV_STYLE_LINE_WIDTH, &v)) res = _LV_STYLE_STATE_CMP_DIFF_DRAW_PAD;
-            else if(res == _LV_STYLE_STATE_CMP_SAME) res = _LV_STYLE_STATE_CMP_DIFF_REDRAW;
+            else if(lv_obj_style_get_selector_part(obj->styles[i].selector) == LV_PART_SCROLLBAR) {
+                if(res == _LV_STYLE_STATE_CMP_SAME) res = _LV_STYLE_STATE_CMP_DIFF_REDRAW_SCROLLBAR;
+            }
+            else if(res == _LV_STYLE_STATE_CMP_SAME || res == _LV_STYLE_STATE_CMP_DIFF_REDRAW_SCROLLBAR) {
+                res = _LV_STYLE_STATE_CMP_DIFF_REDRAW;
+            }
         }
     }
 
@@ -59,9 +59,17 @@ static void refr_area_part(lv_draw_ctx_t * draw_ctx);
 static lv_obj_t * lv_refr_get_top_obj(const lv_area_t * area_p, lv_obj_t * obj);
 static void refr_obj_and_children(lv_draw_ctx_t * draw_ctx, lv_obj_t * top_obj);
 static void refr_obj(lv_draw_ctx_t * draw_ctx, lv_obj_t * obj);
+#if LV_LAYER_CACHE_MAX_SIZE
+    static lv_res_t refr_layer_cache(lv_draw_ctx_t * draw_ctx, lv_obj_t * obj);
+#endif
 static uint32_t get_max_row(lv_disp_t * disp, lv_coord_t area_w, lv_coord_t area_h);
 static void draw_buf_flush(lv_disp_t * disp);
 static void call_flush_cb(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_t * color_p);
+static void inv_merge_flush(lv_disp_t * disp);
+static void refr_hw_scroll(void);
+#if LV_DISP_PACING_MIN_PERIOD
+    static void refr_pacing(uint32_t time);
+#endif
 
 #if LV_USE_PERF_MONITOR
     static void perf_monitor_init(perf_monitor_t * perf_monitor);
@@ -75,6 +83,9 @@ static void call_flush_cb(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_
  **********************/
 static uint32_t px_num;
 static lv_disp_t * disp_refr; /*Display being refreshed*/
+static bool layout_updating;  /*The layouts are being updated by the refresh*/
+static bool vsync_pending;    /*The next flush is the first of the refresh*/
+static uint32_t vsync_time;   /*Time spent in `vsync_wait_cb` during the refresh*/
 
 #if LV_USE_PERF_MONITOR
     static perf_monitor_t   perf_monitor;
@@ -217,6 +228,7 @@ void _lv_inv_area(lv_disp_t * disp, const lv_area_t * area_p)
     /*Clear the invalidate buffer if the parameter is NULL*/
     if(area_p == NULL) {
         disp->inv_p = 0;
+        disp->inv_merge_cnt = 0;
         return;
     }
 
@@ -260,6 +272,91 @@ void _lv_inv_area(lv_disp_t * disp, const lv_area_t * area_p)
     if(disp->refr_timer) lv_timer_resume(disp->refr_timer);
 }
 
+void _lv_inv_obj_area(lv_disp_t * disp, const void * key, const lv_area_t * area_p)
+{
+    if(!disp) disp = lv_disp_get_default();
+    if(!disp) return;
+
+    /*E.g. an object with many animated properties invalidates itself many times in a row*/
+    bool merge = _lv_anim_exec_in_progress() || layout_updating;
+    if(!merge || disp->rendering_in_progress || disp->driver->full_refresh) {
+        _lv_inv_area(disp, area_p);
+        return;
+    }
+
+    if(!lv_disp_is_invalidation_enabled(disp)) return;
+
+    uint32_t i;
+    for(i = 0; i < disp->inv_merge_cnt; i++) {
+        if(disp->inv_merge_keys[i] != key) continue;
+
+        /*Merge only if it doesn't add too much area which wasn't invalidated*/
+        lv_area_t joined;
+        _lv_area_join(&joined, &disp->inv_merge_areas[i], area_p);
+        if(lv_area_get_size(&joined) <= lv_area_get_size(&disp->inv_merge_areas[i]) + lv_area_get_size(area_p)) {
+            lv_area_copy(&disp->inv_merge_areas[i], &joined);
+        }
+        else {
+            _lv_inv_area(disp, area_p);
+        }
+        return;
+    }
+
+    if(disp->inv_merge_cnt < LV_INV_MERGE_BUF_SIZE) {
+        disp->inv_merge_keys[disp->inv_merge_cnt] = key;
+        lv_area_copy(&disp->inv_merge_areas[disp->inv_merge_cnt], area_p);
+        disp->inv_merge_cnt++;
+        if(disp->refr_timer) lv_timer_resume(disp->refr_timer);
+    }
+    else {
+        _lv_inv_area(disp, area_p);
+    }
+}
+
+bool _lv_refr_hw_scroll(lv_disp_t * disp, const lv_area_t * area, lv_coord_t dy)
+{
+    if(!disp) disp = lv_disp_get_default();
+    if(!disp || disp->driver->hw_scroll_cb == NULL) return false;
+    if(!lv_disp_is_invalidation_enabled(disp) || disp->rendering_in_progress) return false;
+    if(disp->driver->full_refresh || disp->driver->direct_mode || disp->driver->rotated != LV_DISP_ROT_NONE) return false;
+    if(area->x1 != 0 || area->x2 != lv_disp_get_hor_res(disp) - 1) return false;
+
+    lv_coord_t h = lv_area_get_height(area);
+    if(LV_ABS(dy) >= h) return false;
+
+    if(!_lv_area_is_equal(area, &disp->hw_scroll_area)) {
+        /*Only one area can be moved in a refresh*/
+        if(disp->hw_scroll_dy != 0) return false;
+
+        /*The display might reset the scroll of the previous area, so redraw both areas*/
+        if(lv_area_get_height(&disp->hw_scroll_area) > 0) _lv_inv_area(disp, &disp->hw_scroll_area);
+        _lv_inv_area(disp, area);
+        lv_area_copy(&disp->hw_scroll_area, area);
+        disp->hw_scroll_dy = dy;
+        disp->hw_scroll_new = 1;
+        return true;
+    }
+
+    /*The parts of the area which are not redrawn yet are moved with the content*/
+    inv_merge_flush(disp);
+    uint16_t inv_p = disp->inv_p;
+    uint16_t i;
+    for(i = 0; i < inv_p; i++) {
+        lv_area_t moved;
+        if(!_lv_area_intersect(&moved, &disp->inv_areas[i], area)) continue;
+        lv_area_move(&moved, 0, dy);
+        if(_lv_area_intersect(&moved, &moved, area)) _lv_inv_area(disp, &moved);
+    }
+
+    lv_area_t uncovered = *area;
+    if(dy > 0) uncovered.y2 = area->y1 + dy - 1;
+    else uncovered.y1 = area->y2 + dy + 1;
+    _lv_inv_area(disp, &uncovered);
+
+    disp->hw_scroll_dy = (disp->hw_scroll_dy + dy) % h;
+    return true;
+}
+
 /**
  * Get the display which is being refreshed
  * @return the display being refreshed
@@ -305,12 +402,16 @@ void _lv_disp_refr_timer(lv_timer_t * tmr)
         disp_refr = lv_disp_get_default();
     }
 
-    /*Refresh the screen's layout if required*/
+    /*Refresh the screen's layout if required. The areas invalidated meanwhile are merged per object*/
+    layout_updating = true;
     lv_obj_update_layout(disp_refr->act_scr);
     if(disp_refr->prev_scr) lv_obj_update_layout(disp_refr->prev_scr);
 
     lv_obj_update_layout(disp_refr->top_layer);
     lv_obj_update_layout(disp_refr->sys_layer);
+    layout_updating = false;
+
+    inv_merge_flush(disp_refr);
 
     /*Do nothing if there is no active screen*/
     if(disp_refr->act_scr == NULL) {
@@ -320,6 +421,8 @@ void _lv_disp_refr_timer(lv_timer_t * tmr)
         return;
     }
 
+    refr_hw_scroll();
+
     lv_refr_join_area();
     refr_sync_areas();
     refr_invalid_areas();
@@ -351,6 +454,10 @@ void _lv_disp_refr_timer(lv_timer_t * tmr)
         if(disp_refr->driver->monitor_cb) {
             disp_refr->driver->monitor_cb(disp_refr->driver, elaps, px_num);
         }
+
+#if LV_DISP_PACING_MIN_PERIOD
+        refr_pacing(elaps);
+#endif
     }
 
     lv_mem_buf_free_all();
@@ -608,6 +715,8 @@ static void refr_invalid_areas(void)
     disp_refr->driver->draw_buf->last_area = 0;
     disp_refr->driver->draw_buf->last_part = 0;
     disp_refr->rendering_in_progress = true;
+    vsync_pending = true;
+    vsync_time = 0;
 
     for(i = 0; i < disp_refr->inv_p; i++) {
         /*Refresh the unjoined areas*/
@@ -971,6 +1080,9 @@ void refr_obj(lv_draw_ctx_t * draw_ctx, lv_obj_t * obj)
     if(lv_obj_has_flag(obj, LV_OBJ_FLAG_HIDDEN)) return;
     lv_layer_type_t layer_type = _lv_obj_get_layer_type(obj);
     if(layer_type == LV_LAYER_TYPE_NONE) {
+#if LV_LAYER_CACHE_MAX_SIZE
+        if(lv_obj_has_flag(obj, LV_OBJ_FLAG_CACHED_LAYER) && refr_layer_cache(draw_ctx, obj) == LV_RES_OK) return;
+#endif
         lv_obj_redraw(draw_ctx, obj);
     }
     else {
@@ -1051,6 +1163,95 @@ void refr_obj(lv_draw_ctx_t * draw_ctx, lv_obj_t * obj)
 }
 
 
+#if LV_LAYER_CACHE_MAX_SIZE
+/**
+ * Draw an object with `LV_OBJ_FLAG_CACHED_LAYER` from its layer cache.
+ * The whole object is rendered into the cache first if the cache is invalid.
+ * @param draw_ctx  pointer to the draw context
+ * @param obj       pointer to the object
+ * @return          LV_RES_OK: the object is drawn; LV_RES_INV: it can't be cached, draw it normally
+ */
+static lv_res_t refr_layer_cache(lv_draw_ctx_t * draw_ctx, lv_obj_t * obj)
+{
+    /*Children out of the object couldn't be cached*/
+    if(lv_obj_has_flag(obj, LV_OBJ_FLAG_OVERFLOW_VISIBLE)) return LV_RES_INV;
+    /*The draw buffer is written directly by the layer too*/
+    if(disp_refr->driver->set_px_cb) return LV_RES_INV;
+
+    lv_area_t obj_coords_ext;
+    lv_obj_get_coords(obj, &obj_coords_ext);
+    lv_coord_t ext_draw_size = _lv_obj_get_ext_draw_size(obj);
+    lv_area_increase(&obj_coords_ext, ext_draw_size, ext_draw_size);
+
+    lv_area_t clip_coords_for_obj;
+    if(!_lv_area_intersect(&clip_coords_for_obj, draw_ctx->clip_area, &obj_coords_ext)) return LV_RES_OK;
+
+    bool has_alpha = true;
+    if(ext_draw_size == 0) {
+        lv_cover_check_info_t info;
+        info.res = LV_COVER_RES_COVER;
+        info.area = &obj_coords_ext;
+        lv_event_send(obj, LV_EVENT_COVER_CHECK, &info);
+        if(info.res == LV_COVER_RES_COVER) has_alpha = false;
+    }
+
+    if(LV_COLOR_SCREEN_TRANSP == 0 && has_alpha) return LV_RES_INV;
+
+    _lv_obj_layer_cache_t * cache = _lv_obj_alloc_layer_cache(obj, lv_area_get_width(&obj_coords_ext),
+                                                              lv_area_get_height(&obj_coords_ext),
+                                                              has_alpha ? LV_IMG_CF_TRUE_COLOR_ALPHA : LV_IMG_CF_TRUE_COLOR);
+    if(cache == NULL) return LV_RES_INV;
+
+    if(!cache->valid) {
+        /*Set it first to render again if something is invalidated while drawing*/
+        cache->valid = 1;
+
+        void * buf_ori = draw_ctx->buf;
+        const lv_area_t * buf_area_ori = draw_ctx->buf_area;
+        const lv_area_t * clip_area_ori = draw_ctx->clip_area;
+        bool screen_transp_ori = disp_refr->driver->screen_transp;
+
+#if LV_DRAW_COMPLEX
+        /*The masks of the parents are applied when the cache is blended
+         *so the cache is independent of the object's position*/
+        _lv_draw_mask_saved_arr_t masks_ori;
+        lv_memcpy(masks_ori, LV_GC_ROOT(_lv_draw_mask_list), sizeof(masks_ori));
+        lv_memset_00(LV_GC_ROOT(_lv_draw_mask_list), sizeof(masks_ori));
+#endif
+
+        if(has_alpha) lv_memset_00((void *)cache->img.data, cache->img.data_size);
+        draw_ctx->buf = (void *)cache->img.data;
+        draw_ctx->buf_area = &obj_coords_ext;
+        draw_ctx->clip_area = &obj_coords_ext;
+        disp_refr->driver->screen_transp = has_alpha ? 1 : 0;
+
+        lv_obj_redraw(draw_ctx, obj);
+        lv_draw_wait_for_finish(draw_ctx);
+
+        draw_ctx->buf = buf_ori;
+        draw_ctx->buf_area = buf_area_ori;
+        draw_ctx->clip_area = clip_area_ori;
+        disp_refr->driver->screen_transp = screen_transp_ori;
+#if LV_DRAW_COMPLEX
+        lv_memcpy(LV_GC_ROOT(_lv_draw_mask_list), masks_ori, sizeof(masks_ori));
+#endif
+
+        /*The content of the image has changed*/
+        lv_img_cache_invalidate_src(&cache->img);
+    }
+
+    const lv_area_t * clip_area_ori = draw_ctx->clip_area;
+    draw_ctx->clip_area = &clip_coords_for_obj;
+
+    lv_draw_img_dsc_t draw_dsc;
+    lv_draw_img_dsc_init(&draw_dsc);
+    lv_draw_img(draw_ctx, &draw_dsc, &obj_coords_ext, &cache->img);
+
+    draw_ctx->clip_area = clip_area_ori;
+    return LV_RES_OK;
+}
+#endif
+
 static uint32_t get_max_row(lv_disp_t * disp, lv_coord_t area_w, lv_coord_t area_h)
 {
     int32_t max_row = (uint32_t)disp->driver->draw_buf->size / area_w;
@@ -1286,6 +1487,16 @@ static void draw_buf_flush(lv_disp_t * disp)
         }
     }
 
+    /*Start the refresh on the display with a new frame*/
+    if(vsync_pending) {
+        vsync_pending = false;
+        if(disp->driver->vsync_wait_cb) {
+            uint32_t start = lv_tick_get();
+            disp->driver->vsync_wait_cb(disp->driver);
+            vsync_time = lv_tick_elaps(start);
+        }
+    }
+
     draw_buf->flushing = 1;
 
     if(disp_refr->driver->draw_buf->last_area && disp_refr->driver->draw_buf->last_part) draw_buf->flushing_last = 1;
@@ -1327,6 +1538,90 @@ static void call_flush_cb(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_
     drv->flush_cb(drv, &offset_area, color_p);
 }
 
+/**
+ * Add the merged areas of the objects to the invalidated areas
+ * @param disp pointer to a display
+ */
+static void inv_merge_flush(lv_disp_t * disp)
+{
+    uint32_t cnt = disp->inv_merge_cnt;
+    disp->inv_merge_cnt = 0;
+
+    uint32_t i;
+    for(i = 0; i < cnt; i++) {
+        _lv_inv_area(disp, &disp->inv_merge_areas[i]);
+    }
+}
+
+/**
+ * Move the scrolled area of the display before the uncovered rows are flushed
+ */
+static void refr_hw_scroll(void)
+{
+    if(disp_refr->hw_scroll_dy == 0 && !disp_refr->hw_scroll_new) return;
+
+    /*Don't move the rows of the last flush while they are sent*/
+    lv_disp_draw_buf_t * draw_buf = lv_disp_get_draw_buf(disp_refr);
+    while(draw_buf->flushing) {
+        if(disp_refr->driver->wait_cb) disp_refr->driver->wait_cb(disp_refr->driver);
+    }
+
+    lv_disp_drv_t * drv = disp_refr->driver;
+    if(drv->hw_scroll_cb == NULL || !drv->hw_scroll_cb(drv, &disp_refr->hw_scroll_area, disp_refr->hw_scroll_dy)) {
+        _lv_inv_area(disp_refr, &disp_refr->hw_scroll_area);
+    }
+
+    disp_refr->hw_scroll_dy = 0;
+    disp_refr->hw_scroll_new = 0;
+}
+
+#if LV_DISP_PACING_MIN_PERIOD
+/**
+ * Update the statistics of the refreshes and adapt the refresh period to the time taken by the refreshes
+ * @param time time of the refresh including the wait for the vsync [ms]
+ */
+static void refr_pacing(uint32_t time)
+{
+    lv_disp_pacing_t * pacing = &disp_refr->pacing;
+    uint32_t draw_time = time > vsync_time ? time - vsync_time : 0;
+
+    pacing->frame_cnt++;
+    if(draw_time > pacing->time_max) pacing->time_max = draw_time;
+
+    /*The ranges of the histogram double*/
+    uint32_t i = 0;
+    uint32_t t = draw_time >> 1;
+    while(t && i < LV_DISP_PACING_HIST_CNT - 1) {
+        t >>= 1;
+        i++;
+    }
+    pacing->time_hist[i]++;
+
+    if(pacing->frame_cnt == 1) pacing->time_avg_x16 = draw_time << 4;
+    else pacing->time_avg_x16 = (pacing->time_avg_x16 * 3 + (draw_time << 4)) >> 2;
+    pacing->time_avg = (pacing->time_avg_x16 + 15) >> 4;
+
+    pacing->fps_cnt++;
+    uint32_t fps_elaps = lv_tick_elaps(pacing->fps_start);
+    if(fps_elaps >= 1000) {
+        pacing->fps = (pacing->fps_cnt * 1000) / fps_elaps;
+        pacing->fps_cnt = 0;
+        pacing->fps_start = lv_tick_get();
+    }
+
+    lv_timer_t * tmr = disp_refr->refr_timer;
+    if(tmr == NULL) return;
+
+    /*The next refresh is late if this one took longer than the period (waiting for the vsync too)*/
+    if(time > tmr->period) pacing->missed_cnt++;
+
+    /*Refresh as often as possible but leave 1/5 of the time to the other tasks*/
+    uint32_t period = (pacing->time_avg_x16 * 5 / 4 + 15) >> 4;
+    period = LV_CLAMP(LV_DISP_PACING_MIN_PERIOD, period, LV_MAX(LV_DISP_PACING_MIN_PERIOD, LV_DISP_DEF_REFR_PERIOD));
+    lv_timer_set_period(tmr, period);
+}
+#endif
+
 #if LV_USE_PERF_MONITOR
 static void perf_monitor_init(perf_monitor_t * _perf_monitor)
 {
@@ -1348,4 +1643,3 @@ static void mem_monitor_init(mem_monitor_t * _mem_monitor)
     _mem_monitor->mem_label = NULL;
 }
 #endif
-
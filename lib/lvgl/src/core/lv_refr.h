@@ -71,6 +71,26 @@ void lv_obj_redraw(lv_draw_ctx_t * draw_ctx, lv_obj_t * obj);
  */
 void _lv_inv_area(lv_disp_t * disp, const lv_area_t * area_p);
 
+/**
+ * Invalidate an area of an object.
+ * While the animations are applied or the layouts are updated the areas of the same object are
+ * merged into one area until the next refresh. Else it's the same as `_lv_inv_area`.
+ * @param disp pointer to display where the area should be invalidated (NULL: the default display)
+ * @param key the object (or any other pointer) owning the area
+ * @param area_p pointer to area which should be invalidated
+ */
+void _lv_inv_obj_area(lv_disp_t * disp, const void * key, const lv_area_t * area_p);
+
+/**
+ * Move a full width area of the display with the `hw_scroll_cb` of the display driver at the next refresh
+ * and invalidate only the uncovered rows. The invalidated parts of the area are moved with the content.
+ * @param disp pointer to display (NULL: the default display)
+ * @param area the area to move, as wide as the display
+ * @param dy move the content `dy` rows down (negative: up)
+ * @return false if the display can't move the area, it should be invalidated then
+ */
+bool _lv_refr_hw_scroll(lv_disp_t * disp, const lv_area_t * area, lv_coord_t dy);
+
 /**
  * Get the display which is being refreshed
  * @return the display being refreshed
@@ -26,6 +26,9 @@
  * "die" from very high values*/
 #define LV_IMG_CACHE_LIFE_LIMIT 1000
 
+/*Keep an image fully decoded only if it fits into this part of the decoded budget*/
+#define LV_IMG_CACHE_DECODED_PART 4
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -35,6 +38,11 @@
  **********************/
 #if LV_IMG_CACHE_DEF_SIZE
     static bool lv_img_cache_match(const void * src1, const void * src2);
+    static int32_t entry_weight(const _lv_img_cache_entry_t * entry);
+    static void decode_to_buffer(_lv_img_cache_entry_t * entry, int32_t max_life);
+    static bool decoded_drop_weakest(const _lv_img_cache_entry_t * keep, int32_t max_life);
+    static void decoded_free(_lv_img_cache_entry_t * entry);
+    static uint32_t decoded_px_size(lv_img_cf_t cf);
 #endif
 
 /**********************
@@ -42,7 +50,13 @@
  **********************/
 #if LV_IMG_CACHE_DEF_SIZE
     static uint16_t entry_cnt;
+    static uint32_t decoded_budget = LV_IMG_CACHE_DECODED_SIZE;
+    static uint32_t decoded_used;
+    static lv_img_cache_alloc_cb_t decoded_alloc_cb;
+    static lv_img_cache_free_cb_t decoded_free_cb;
 #endif
+static uint32_t hit_cnt;
+static uint32_t miss_cnt;
 
 /**********************
  *      MACROS
@@ -89,7 +103,7 @@ _lv_img_cache_entry_t * _lv_img_cache_open(const void * src, lv_color_t color, i
              *Image difficult to open should live longer to keep avoid frequent their recaching.
              *Therefore increase `life` with `time_to_open`*/
             cached_src = &cache[i];
-            cached_src->life += cached_src->dec_dsc.time_to_open * LV_IMG_CACHE_LIFE_GAIN;
+            cached_src->life += entry_weight(cached_src);
             if(cached_src->life > LV_IMG_CACHE_LIFE_LIMIT) cached_src->life = LV_IMG_CACHE_LIFE_LIMIT;
             LV_LOG_TRACE("image source found in the cache");
             break;
@@ -97,7 +111,12 @@ _lv_img_cache_entry_t * _lv_img_cache_open(const void * src, lv_color_t color, i
     }
 
     /*The image is not cached then cache it now*/
-    if(cached_src) return cached_src;
+    if(cached_src) {
+        hit_cnt++;
+        /*The decoded buffer might have been freed for a more valuable image. Get it back if this one is more valuable now.*/
+        if(cached_src->decoded == NULL) decode_to_buffer(cached_src, cached_src->life);
+        return cached_src;
+    }
 
     /*Find an entry to reuse. Select the entry with the least life*/
     cached_src = &cache[0];
@@ -108,6 +127,7 @@ _lv_img_cache_entry_t * _lv_img_cache_open(const void * src, lv_color_t color, i
     }
 
     /*Close the decoder to reuse if it was opened (has a valid source)*/
+    decoded_free(cached_src);
     if(cached_src->dec_dsc.src) {
         lv_img_decoder_close(&cached_src->dec_dsc);
         LV_LOG_INFO("image draw: cache miss, close and reuse an entry");
@@ -118,6 +138,8 @@ _lv_img_cache_entry_t * _lv_img_cache_open(const void * src, lv_color_t color, i
 #else
     cached_src = &LV_GC_ROOT(_lv_img_cache_single);
 #endif
+    miss_cnt++;
+
     /*Open the image and measure the time to open*/
     uint32_t t_start  = lv_tick_get();
     lv_res_t open_res = lv_img_decoder_open(&cached_src->dec_dsc, src, color, frame_id);
@@ -130,6 +152,11 @@ _lv_img_cache_entry_t * _lv_img_cache_open(const void * src, lv_color_t color, i
 
     cached_src->life = 0;
 
+#if LV_IMG_CACHE_DEF_SIZE
+    /*Decoding the whole image is part of the time to open*/
+    decode_to_buffer(cached_src, INT32_MAX);
+#endif
+
     /*If `time_to_open` was not set in the open function set it here*/
     if(cached_src->dec_dsc.time_to_open == 0) {
         cached_src->dec_dsc.time_to_open = lv_tick_elaps(t_start);
@@ -169,6 +196,7 @@ void lv_img_cache_set_size(uint16_t new_entry_cnt)
 
     /*Clean the cache*/
     lv_memset_00(LV_GC_ROOT(_lv_img_cache_array), entry_cnt * sizeof(_lv_img_cache_entry_t));
+    decoded_used = 0;
 #endif
 }
 
@@ -186,6 +214,7 @@ void lv_img_cache_invalidate_src(const void * src)
     uint16_t i;
     for(i = 0; i < entry_cnt; i++) {
         if(src == NULL || lv_img_cache_match(src, cache[i].dec_dsc.src)) {
+            decoded_free(&cache[i]);
             if(cache[i].dec_dsc.src != NULL) {
                 lv_img_decoder_close(&cache[i].dec_dsc);
             }
@@ -196,6 +225,81 @@ void lv_img_cache_invalidate_src(const void * src)
 #endif
 }
 
+/**
+ * Set the byte budget of the fully decoded images.
+ * Images which can be read only line-by-line (e.g. from a file) are decoded once into a buffer
+ * if they fit into a quarter of this budget. Drawing them later doesn't call the decoder at all.
+ * Larger images are still read line-by-line.
+ * If the budget is exceeded the decoded buffer of the least valuable entry is freed.
+ * @param size the budget in bytes. 0: don't keep fully decoded images
+ */
+void lv_img_cache_set_decoded_budget(uint32_t size)
+{
+#if LV_IMG_CACHE_DEF_SIZE == 0
+    LV_UNUSED(size);
+    LV_LOG_WARN("Can't set the decoded budget because caching is disabled by LV_IMG_CACHE_DEF_SIZE = 0");
+#else
+    decoded_budget = size;
+    while(decoded_used > decoded_budget) {
+        if(!decoded_drop_weakest(NULL, INT32_MAX)) break;
+    }
+#endif
+}
+
+/**
+ * Set the functions used to allocate and free the fully decoded images.
+ * E.g. to place them into an external RAM instead of LVGL's heap.
+ * The decoded images are freed before the new functions are set.
+ * @param alloc_cb allocator function or `NULL` to use `lv_mem_alloc`
+ * @param free_cb function to free what `alloc_cb` allocated or `NULL` to use `lv_mem_free`
+ */
+void lv_img_cache_set_decoded_alloc_cb(lv_img_cache_alloc_cb_t alloc_cb, lv_img_cache_free_cb_t free_cb)
+{
+#if LV_IMG_CACHE_DEF_SIZE == 0
+    LV_UNUSED(alloc_cb);
+    LV_UNUSED(free_cb);
+    LV_LOG_WARN("Can't set the allocator because caching is disabled by LV_IMG_CACHE_DEF_SIZE = 0");
+#else
+    _lv_img_cache_entry_t * cache = LV_GC_ROOT(_lv_img_cache_array);
+    uint16_t i;
+    for(i = 0; i < entry_cnt; i++) {
+        decoded_free(&cache[i]);
+    }
+
+    decoded_alloc_cb = alloc_cb;
+    decoded_free_cb = free_cb;
+#endif
+}
+
+/**
+ * Get the hit/miss counters and the memory usage of the image cache
+ * @param stats store the result here
+ */
+void lv_img_cache_get_stats(lv_img_cache_stats_t * stats)
+{
+    lv_memset_00(stats, sizeof(lv_img_cache_stats_t));
+    stats->hit = hit_cnt;
+    stats->miss = miss_cnt;
+
+#if LV_IMG_CACHE_DEF_SIZE
+    _lv_img_cache_entry_t * cache = LV_GC_ROOT(_lv_img_cache_array);
+    uint16_t i;
+    for(i = 0; i < entry_cnt; i++) {
+        if(cache[i].decoded) stats->decoded_cnt++;
+    }
+    stats->decoded_size = decoded_used;
+#endif
+}
+
+/**
+ * Reset the hit and miss counters of the image cache
+ */
+void lv_img_cache_reset_stats(void)
+{
+    hit_cnt = 0;
+    miss_cnt = 0;
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -212,4 +316,126 @@ static bool lv_img_cache_match(const void * src1, const void * src2)
         return false;
     return strcmp(src1, src2) == 0;
 }
+
+/**
+ * Get how valuable an entry is when it's used.
+ * Images slow to decode and large decoded images are more expensive to recreate.
+ */
+static int32_t entry_weight(const _lv_img_cache_entry_t * entry)
+{
+    uint32_t weight = entry->dec_dsc.time_to_open * LV_IMG_CACHE_LIFE_GAIN;
+    if(weight > LV_IMG_CACHE_LIFE_LIMIT) return LV_IMG_CACHE_LIFE_LIMIT;
+
+    weight *= (entry->decoded_size >> 10) + 1;
+    if(weight > LV_IMG_CACHE_LIFE_LIMIT) return LV_IMG_CACHE_LIFE_LIMIT;
+
+    return (int32_t)weight;
+}
+
+/**
+ * Read all lines of an image into a buffer so the image can be drawn without calling the decoder again.
+ * @param entry an opened cache entry
+ * @param max_life free only the decoded buffers of entries with smaller life than this
+ */
+static void decode_to_buffer(_lv_img_cache_entry_t * entry, int32_t max_life)
+{
+    lv_img_decoder_dsc_t * dsc = &entry->dec_dsc;
+
+    if(decoded_budget == 0) return;
+
+    /*The decoder already gave the whole image or there is nothing to read*/
+    if(dsc->img_data || dsc->error_msg) return;
+    if(dsc->decoder == NULL || dsc->decoder->read_line_cb == NULL) return;
+
+    uint32_t px_size = decoded_px_size(dsc->header.cf);
+    if(px_size == 0) return;
+
+    uint32_t w = dsc->header.w;
+    uint32_t h = dsc->header.h;
+    uint32_t size = w * h * px_size;
+    if(size == 0 || size > decoded_budget / LV_IMG_CACHE_DECODED_PART) return;
+
+    while(decoded_used + size > decoded_budget) {
+        if(!decoded_drop_weakest(entry, max_life)) return;
+    }
+
+    uint8_t * buf = decoded_alloc_cb ? decoded_alloc_cb(size) : lv_mem_alloc(size);
+    if(buf == NULL) {
+        LV_LOG_INFO("image cache: couldn't allocate %d bytes for a decoded image", (int)size);
+        return;
+    }
+
+    uint32_t y;
+    for(y = 0; y < h; y++) {
+        lv_res_t res = lv_img_decoder_read_line(dsc, 0, (lv_coord_t)y, (lv_coord_t)w, buf + y * w * px_size);
+        if(res != LV_RES_OK) {
+            LV_LOG_WARN("image cache: couldn't read line %d of the image", (int)y);
+            if(decoded_free_cb) decoded_free_cb(buf);
+            else lv_mem_free(buf);
+            return;
+        }
+    }
+
+    entry->decoded = buf;
+    entry->decoded_size = size;
+    dsc->img_data = buf;
+    decoded_used += size;
+    LV_LOG_TRACE("image cache: image decoded into a %d bytes buffer", (int)size);
+}
+
+/**
+ * Free the decoded buffer of the entry with the smallest life.
+ * @param keep don't free the buffer of this entry
+ * @param max_life free the buffer only if the entry's life is smaller than this
+ * @return true: a buffer was freed; false: no suitable entry was found
+ */
+static bool decoded_drop_weakest(const _lv_img_cache_entry_t * keep, int32_t max_life)
+{
+    _lv_img_cache_entry_t * cache = LV_GC_ROOT(_lv_img_cache_array);
+    _lv_img_cache_entry_t * weakest = NULL;
+
+    uint16_t i;
+    for(i = 0; i < entry_cnt; i++) {
+        if(&cache[i] == keep || cache[i].decoded == NULL) continue;
+        if(weakest == NULL || cache[i].life < weakest->life) weakest = &cache[i];
+    }
+
+    if(weakest == NULL || weakest->life >= max_life) return false;
+
+    decoded_free(weakest);
+    return true;
+}
+
+/**
+ * Free the decoded buffer of an entry. The image remains opened and can be read line-by-line.
+ * @param entry pointer to a cache entry
+ */
+static void decoded_free(_lv_img_cache_entry_t * entry)
+{
+    if(entry->decoded == NULL) return;
+
+    if(entry->dec_dsc.img_data == entry->decoded) entry->dec_dsc.img_data = NULL;
+
+    if(decoded_free_cb) decoded_free_cb(entry->decoded);
+    else lv_mem_free(entry->decoded);
+
+    decoded_used -= entry->decoded_size;
+    entry->decoded = NULL;
+    entry->decoded_size = 0;
+}
+
+/**
+ * Get the size of a pixel returned by the decoders' `read_line` for a color format.
+ * @param cf the color format of the image
+ * @return size of a pixel in bytes or 0 if the format can't be kept decoded
+ */
+static uint32_t decoded_px_size(lv_img_cf_t cf)
+{
+    /*These are drawn with a different layout than what `read_line` returns*/
+    if(cf == LV_IMG_CF_ALPHA_8BIT || cf == LV_IMG_CF_RGB565A8) return 0;
+
+    if(lv_img_cf_is_chroma_keyed(cf)) return LV_COLOR_SIZE / 8;
+    if(lv_img_cf_has_alpha(cf)) return LV_IMG_PX_SIZE_ALPHA_BYTE;
+    return LV_COLOR_SIZE / 8;
+}
 #endif
@@ -13,6 +13,7 @@ extern "C" {
 /*********************
  *      INCLUDES
  *********************/
+#include <stddef.h>
 #include "lv_img_decoder.h"
 
 /*********************
@@ -35,8 +36,40 @@ typedef struct {
      * Decrement all lifes by one every in every ::lv_img_cache_open.
      * If life == 0 the entry can be reused*/
     int32_t life;
+
+#if LV_IMG_CACHE_DEF_SIZE
+    /** Fully decoded pixels of images which can be read only line-by-line.
+     * Allocated if the image fits into the decoded budget, else `NULL`.*/
+    uint8_t * decoded;
+
+    /** Size of `decoded` in bytes*/
+    uint32_t decoded_size;
+#endif
 } _lv_img_cache_entry_t;
 
+/**
+ * Allocate a buffer for a fully decoded image. Can be used to place the buffers into a secondary RAM.
+ * @param size required size in bytes
+ * @return pointer to the allocated buffer or `NULL` on failure
+ */
+typedef void * (*lv_img_cache_alloc_cb_t)(size_t size);
+
+/**
+ * Free a buffer allocated by a ::lv_img_cache_alloc_cb_t
+ * @param p pointer to the buffer
+ */
+typedef void (*lv_img_cache_free_cb_t)(void * p);
+
+/**
+ * Counters about the efficiency of the image cache
+ */
+typedef struct {
+    uint32_t hit;           /**< Number of opens served from the cache without calling the decoder*/
+    uint32_t miss;          /**< Number of opens which had to open the image with a decoder*/
+    uint32_t decoded_cnt;   /**< Number of entries holding a fully decoded image*/
+    uint32_t decoded_size;  /**< Bytes used by the fully decoded images*/
+} lv_img_cache_stats_t;
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -67,6 +100,36 @@ void lv_img_cache_set_size(uint16_t new_slot_num);
  */
 void lv_img_cache_invalidate_src(const void * src);
 
+/**
+ * Set the byte budget of the fully decoded images.
+ * Images which can be read only line-by-line (e.g. from a file) are decoded once into a buffer
+ * if they fit into a quarter of this budget. Drawing them later doesn't call the decoder at all.
+ * Larger images are still read line-by-line.
+ * If the budget is exceeded the decoded buffer of the least valuable entry is freed.
+ * @param size the budget in bytes. 0: don't keep fully decoded images
+ */
+void lv_img_cache_set_decoded_budget(uint32_t size);
+
+/**
+ * Set the functions used to allocate and free the fully decoded images.
+ * E.g. to place them into an external RAM instead of LVGL's heap.
+ * The decoded images are freed before the new functions are set.
+ * @param alloc_cb allocator function or `NULL` to use `lv_mem_alloc`
+ * @param free_cb function to free what `alloc_cb` allocated or `NULL` to use `lv_mem_free`
+ */
+void lv_img_cache_set_decoded_alloc_cb(lv_img_cache_alloc_cb_t alloc_cb, lv_img_cache_free_cb_t free_cb);
+
+/**
+ * Get the hit/miss counters and the memory usage of the image cache
+ * @param stats store the result here
+ */
+void lv_img_cache_get_stats(lv_img_cache_stats_t * stats);
+
+/**
+ * Reset the hit and miss counters of the image cache
+ */
+void lv_img_cache_reset_stats(void);
+
 /**********************
  *      MACROS
  **********************/
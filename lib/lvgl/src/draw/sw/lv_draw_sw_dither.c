@@ -40,6 +40,16 @@ static const uint8_t dither_ordered_threshold_matrix[8 * 8] = {
 }; /* Shift by 6 to normalize */
 
 
+static inline lv_color_t dither_ordered_px(lv_color32_t c, int8_t factor)
+{
+    lv_color32_t t;
+    t.ch.red   = LV_CLAMP(0, c.ch.red + factor, 255);
+    t.ch.green = LV_CLAMP(0, c.ch.green + factor, 255);
+    t.ch.blue  = LV_CLAMP(0, c.ch.blue + factor, 255);
+
+    return lv_color_hex(t.full);
+}
+
 void LV_ATTRIBUTE_FAST_MEM lv_dither_ordered_hor(lv_grad_t * grad, lv_coord_t x, lv_coord_t y, lv_coord_t w)
 {
     LV_UNUSED(x);
@@ -55,12 +65,7 @@ void LV_ATTRIBUTE_FAST_MEM lv_dither_ordered_hor(lv_grad_t * grad, lv_coord_t x,
     for(lv_coord_t j = 0; j < w; j++) {
         int8_t factor = dither_ordered_threshold_matrix[(y & 7) * 8 + ((j) & 7)] - 32;
         lv_color32_t tmp = grad->hmap[LV_CLAMP(0, j - 4, grad->size)];
-        lv_color32_t t;
-        t.ch.red   = LV_CLAMP(0, tmp.ch.red + factor, 255);
-        t.ch.green = LV_CLAMP(0, tmp.ch.green + factor, 255);
-        t.ch.blue  = LV_CLAMP(0, tmp.ch.blue + factor, 255);
-
-        grad->map[j] = lv_color_hex(t.full);
+        grad->map[j] = dither_ordered_px(tmp, factor);
     }
 }
 
@@ -80,12 +85,7 @@ void LV_ATTRIBUTE_FAST_MEM lv_dither_ordered_ver(lv_grad_t * grad, lv_coord_t x,
     /*The apply the algorithm for this patch*/
     for(lv_coord_t j = 0; j < 8; j++) {
         int8_t factor = dither_ordered_threshold_matrix[(y & 7) * 8 + ((j + x) & 7)] - 32;
-        lv_color32_t t;
-        t.ch.red   = LV_CLAMP(0, tmp.ch.red + factor, 255);
-        t.ch.green = LV_CLAMP(0, tmp.ch.green + factor, 255);
-        t.ch.blue  = LV_CLAMP(0, tmp.ch.blue + factor, 255);
-
-        grad->map[j] = lv_color_hex(t.full);
+        grad->map[j] = dither_ordered_px(tmp, factor);
     }
     /*Finally fill the line*/
     lv_coord_t j = 8;
@@ -98,6 +98,57 @@ void LV_ATTRIBUTE_FAST_MEM lv_dither_ordered_ver(lv_grad_t * grad, lv_coord_t x,
     }
 }
 
+void lv_dither_ordered_precompute(lv_grad_t * grad)
+{
+    lv_coord_t y;
+    lv_coord_t j;
+    if(grad->dsc.dir == LV_GRAD_DIR_HOR) {
+        /*The rows are the same as `lv_dither_ordered_hor` calculates them and depend only on `y & 7`*/
+        for(y = 0; y < 8; y++) {
+            lv_color_t * row = grad->dither_map + y * grad->size;
+            for(j = 0; j < grad->size; j++) {
+                int8_t factor = dither_ordered_threshold_matrix[y * 8 + (j & 7)] - 32;
+                row[j] = dither_ordered_px(grad->hmap[LV_CLAMP(0, j - 4, grad->size)], factor);
+            }
+        }
+    }
+    else {
+        /*Each row is a pattern of 8 colors selected by the x coordinate (see `lv_dither_ordered_ver`)*/
+        for(y = 0; y < grad->size; y++) {
+            lv_color32_t tmp = grad->hmap[LV_CLAMP(0, y - 4, grad->size)];
+            lv_color_t * pattern = grad->dither_map + y * 8;
+            for(j = 0; j < 8; j++) {
+                int8_t factor = dither_ordered_threshold_matrix[(y & 7) * 8 + j] - 32;
+                pattern[j] = dither_ordered_px(tmp, factor);
+            }
+        }
+    }
+}
+
+void LV_ATTRIBUTE_FAST_MEM lv_dither_ordered_hor_precomputed(lv_grad_t * grad, lv_coord_t x, lv_coord_t y,
+                                                             lv_coord_t w)
+{
+    LV_UNUSED(x);
+    lv_memcpy(grad->map, grad->dither_map + (y & 7) * grad->size, w * sizeof(lv_color_t));
+}
+
+void LV_ATTRIBUTE_FAST_MEM lv_dither_ordered_ver_precomputed(lv_grad_t * grad, lv_coord_t x, lv_coord_t y,
+                                                             lv_coord_t w)
+{
+    const lv_color_t * pattern = grad->dither_map + y * 8;
+    lv_coord_t j;
+    for(j = 0; j < 8 && j < w; j++) {
+        grad->map[j] = pattern[(j + x) & 7];
+    }
+
+    /*Double the filled part until the line is ready*/
+    while(j < w) {
+        lv_coord_t n = LV_MIN(j, w - j);
+        lv_memcpy(grad->map + j, grad->map, n * sizeof(lv_color_t));
+        j += n;
+    }
+}
+
 #if LV_DITHER_ERROR_DIFFUSION == 1
 void LV_ATTRIBUTE_FAST_MEM lv_dither_err_diff_hor(lv_grad_t * grad, lv_coord_t xs, lv_coord_t y, lv_coord_t w)
 {
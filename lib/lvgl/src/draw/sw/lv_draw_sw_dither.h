@@ -53,6 +53,19 @@ void /* LV_ATTRIBUTE_FAST_MEM */ lv_dither_ordered_hor(struct _lv_gradient_cache
 void /* LV_ATTRIBUTE_FAST_MEM */ lv_dither_ordered_ver(struct _lv_gradient_cache_t * grad, const lv_coord_t xs,
                                                        const lv_coord_t y, const lv_coord_t w);
 
+/**
+ * Precompute the ordered dithering of a gradient into its `dither_map`
+ * @param grad      pointer to a gradient with `hmap` calculated and `dither_map` allocated
+ */
+void lv_dither_ordered_precompute(struct _lv_gradient_cache_t * grad);
+
+void /* LV_ATTRIBUTE_FAST_MEM */ lv_dither_ordered_hor_precomputed(struct _lv_gradient_cache_t * grad,
+                                                                   const lv_coord_t xs,
+                                                                   const lv_coord_t y, const lv_coord_t w);
+void /* LV_ATTRIBUTE_FAST_MEM */ lv_dither_ordered_ver_precomputed(struct _lv_gradient_cache_t * grad,
+                                                                   const lv_coord_t xs,
+                                                                   const lv_coord_t y, const lv_coord_t w);
+
 #if LV_DITHER_ERROR_DIFFUSION == 1
 void /* LV_ATTRIBUTE_FAST_MEM */ lv_dither_err_diff_hor(struct _lv_gradient_cache_t * grad, const lv_coord_t xs,
                                                         const lv_coord_t y, const lv_coord_t w);
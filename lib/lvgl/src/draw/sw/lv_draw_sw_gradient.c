@@ -32,6 +32,16 @@
     #error "LV_GRAD_CACHE_DEF_SIZE is too small"
 #endif
 
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef struct {
+    const lv_grad_dsc_t * dsc;
+    lv_coord_t w;
+    lv_coord_t h;
+    uint32_t key;
+} grad_search_t;
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
@@ -45,7 +55,9 @@ static lv_res_t find_oldest_item_life(lv_grad_t * c, void * ctx);
 static lv_res_t kill_oldest_item(lv_grad_t * c, void * ctx);
 static lv_res_t find_item(lv_grad_t * c, void * ctx);
 static void free_item(lv_grad_t * c);
-static  uint32_t compute_key(const lv_grad_dsc_t * g, lv_coord_t w, lv_coord_t h);
+static uint32_t compute_key(const lv_grad_dsc_t * g, lv_coord_t w, lv_coord_t h);
+static bool grad_dsc_equal(const lv_grad_dsc_t * g1, const lv_grad_dsc_t * g2);
+static void normalize_size(const lv_grad_dsc_t * g, lv_coord_t * w, lv_coord_t * h);
 
 
 /**********************
@@ -57,16 +69,48 @@ static uint8_t * grad_cache_end = 0;
 /**********************
  *   STATIC FUNCTIONS
  **********************/
-union void_cast {
-    const void * ptr;
-    const uint32_t value;
-};
+static inline uint32_t hash_add(uint32_t key, uint32_t v)
+{
+    /*FNV-1a step*/
+    return (key ^ v) * 16777619;
+}
+
+static uint32_t compute_key(const lv_grad_dsc_t * g, lv_coord_t w, lv_coord_t h)
+{
+    /*Built from the content of the descriptor and not from its address
+     *as the descriptors are usually copied to the stack before drawing*/
+    uint32_t key = 2166136261;
+    key = hash_add(key, g->dir | (g->dither << 3) | (g->stops_count << 8));
+    for(uint8_t i = 0; i < g->stops_count; i++) {
+        key = hash_add(key, g->stops[i].color.full);
+        key = hash_add(key, g->stops[i].frac);
+    }
+    key = hash_add(key, (uint32_t)w);
+    key = hash_add(key, (uint32_t)h);
+    return key;
+}
+
+static bool grad_dsc_equal(const lv_grad_dsc_t * g1, const lv_grad_dsc_t * g2)
+{
+    if(g1->dir != g2->dir || g1->dither != g2->dither || g1->stops_count != g2->stops_count) return false;
+
+    for(uint8_t i = 0; i < g1->stops_count; i++) {
+        if(g1->stops[i].color.full != g2->stops[i].color.full) return false;
+        if(g1->stops[i].frac != g2->stops[i].frac) return false;
+    }
+    return true;
+}
 
-static uint32_t compute_key(const lv_grad_dsc_t * g, lv_coord_t size, lv_coord_t w)
+static void normalize_size(const lv_grad_dsc_t * g, lv_coord_t * w, lv_coord_t * h)
 {
-    union void_cast v;
-    v.ptr = g;
-    return (v.value ^ size ^ (w >> 1)); /*Yes, this is correct, it's like a hash that changes if the width changes*/
+    /*A horizontal map doesn't depend on the height and a vertical map doesn't depend on the width,
+     *unless it's dithered because then whole lines are rendered into the map*/
+    if(g->dir == LV_GRAD_DIR_HOR) *h = 0;
+#if _DITHER_GRADIENT
+    else if(g->dither == LV_DITHER_NONE) *w = 0;
+#else
+    else *w = 0;
+#endif
 }
 
 static size_t get_cache_item_size(lv_grad_t * c)
@@ -77,6 +121,7 @@ static size_t get_cache_item_size(lv_grad_t * c)
 #if LV_DITHER_ERROR_DIFFUSION == 1
     s += ALIGN(c->w * sizeof(lv_scolor24_t));
 #endif
+    if(c->dither_map) s += ALIGN(8 * c->size * sizeof(lv_color_t));
 #endif
     return s;
 }
@@ -130,6 +175,7 @@ static void free_item(lv_grad_t * c)
 #if LV_DITHER_ERROR_DIFFUSION == 1
             c->error_acc = (lv_scolor24_t *)(((uint8_t *)c->error_acc) - size);
 #endif
+            if(c->dither_map) c->dither_map = (lv_color_t *)(((uint8_t *)c->dither_map) - size);
 #endif
             c = (lv_grad_t *)(((uint8_t *)c) + get_cache_item_size(c));
         }
@@ -150,9 +196,10 @@ static lv_res_t kill_oldest_item(lv_grad_t * c, void * ctx)
 
 static lv_res_t find_item(lv_grad_t * c, void * ctx)
 {
-    uint32_t * k = (uint32_t *)ctx;
-    if(c->key == *k) return LV_RES_OK;
-    return LV_RES_INV;
+    grad_search_t * s = (grad_search_t *)ctx;
+    if(c->key != s->key || c->key_w != s->w || c->key_h != s->h) return LV_RES_INV;
+    if(!grad_dsc_equal(&c->dsc, s->dsc)) return LV_RES_INV;
+    return LV_RES_OK;
 }
 
 static lv_grad_t * allocate_item(const lv_grad_dsc_t * g, lv_coord_t w, lv_coord_t h)
@@ -162,23 +209,26 @@ static lv_grad_t * allocate_item(const lv_grad_dsc_t * g, lv_coord_t w, lv_coord
                                            no dithering is selected where it's used vertically */
 
     size_t req_size = ALIGN(sizeof(lv_grad_t)) + ALIGN(map_size * sizeof(lv_color_t));
+    size_t dither_size = 0;
 #if _DITHER_GRADIENT
     req_size += ALIGN(size * sizeof(lv_color32_t));
 #if LV_DITHER_ERROR_DIFFUSION == 1
     req_size += ALIGN(w * sizeof(lv_scolor24_t));
 #endif
+    /*Ordered dithering repeats in every 8 lines so it can be precomputed if the item can be cached*/
+    if(g->dither == LV_DITHER_ORDERED) dither_size = ALIGN(8 * size * sizeof(lv_color_t));
 #endif
 
     size_t act_size = (size_t)(grad_cache_end - LV_GC_ROOT(_lv_grad_cache_mem));
     lv_grad_t * item = NULL;
-    if(req_size + act_size < grad_cache_size) {
+    if(req_size + dither_size + act_size < grad_cache_size) {
         item = (lv_grad_t *)grad_cache_end;
         item->not_cached = 0;
     }
     else {
         /*Need to evict items from cache until we find enough space to allocate this one */
-        if(req_size <= grad_cache_size) {
-            while(act_size + req_size > grad_cache_size) {
+        if(req_size + dither_size <= grad_cache_size) {
+            while(act_size + req_size + dither_size > grad_cache_size) {
                 uint32_t oldest_life = UINT32_MAX;
                 iterate_cache(&find_oldest_item_life, &oldest_life, NULL);
                 iterate_cache(&kill_oldest_item, &oldest_life, NULL);
@@ -189,6 +239,7 @@ static lv_grad_t * allocate_item(const lv_grad_dsc_t * g, lv_coord_t w, lv_coord
         }
         else {
             /*The cache is too small. Allocate the item manually and free it later.*/
+            dither_size = 0;
             item = lv_mem_alloc(req_size);
             LV_ASSERT_MALLOC(item);
             if(item == NULL) return NULL;
@@ -196,35 +247,30 @@ static lv_grad_t * allocate_item(const lv_grad_dsc_t * g, lv_coord_t w, lv_coord
         }
     }
 
-    item->key = compute_key(g, size, w);
+    item->key = compute_key(g, w, h);
     item->life = 1;
     item->filled = 0;
+    item->dsc = *g;
+    item->key_w = w;
+    item->key_h = h;
     item->alloc_size = map_size;
     item->size = size;
-    if(item->not_cached) {
-        uint8_t * p = (uint8_t *)item;
-        item->map = (lv_color_t *)(p + ALIGN(sizeof(*item)));
-#if _DITHER_GRADIENT
-        item->hmap = (lv_color32_t *)(p + ALIGN(sizeof(*item)) + ALIGN(map_size * sizeof(lv_color_t)));
-#if LV_DITHER_ERROR_DIFFUSION == 1
-        item->error_acc = (lv_scolor24_t *)(p + ALIGN(sizeof(*item)) + ALIGN(size * sizeof(lv_grad_color_t)) +
-                                            ALIGN(map_size * sizeof(lv_color_t)));
-        item->w = w;
-#endif
-#endif
-    }
-    else {
-        item->map = (lv_color_t *)(grad_cache_end + ALIGN(sizeof(*item)));
+
+    uint8_t * p = (uint8_t *)item + ALIGN(sizeof(*item));
+    item->map = (lv_color_t *)p;
+    p += ALIGN(map_size * sizeof(lv_color_t));
 #if _DITHER_GRADIENT
-        item->hmap = (lv_color32_t *)(grad_cache_end + ALIGN(sizeof(*item)) + ALIGN(map_size * sizeof(lv_color_t)));
+    item->hmap = (lv_color32_t *)p;
+    p += ALIGN(size * sizeof(lv_color32_t));
 #if LV_DITHER_ERROR_DIFFUSION == 1
-        item->error_acc = (lv_scolor24_t *)(grad_cache_end + ALIGN(sizeof(*item)) + ALIGN(size * sizeof(lv_grad_color_t)) +
-                                            ALIGN(map_size * sizeof(lv_color_t)));
-        item->w = w;
+    item->error_acc = (lv_scolor24_t *)p;
+    p += ALIGN(w * sizeof(lv_scolor24_t));
+    item->w = w;
 #endif
+    item->dither_map = dither_size ? (lv_color_t *)p : NULL;
 #endif
-        grad_cache_end += req_size;
-    }
+
+    if(!item->not_cached) grad_cache_end += req_size + dither_size;
     return item;
 }
 
@@ -261,11 +307,19 @@ lv_grad_t * lv_gradient_get(const lv_grad_dsc_t * g, lv_coord_t w, lv_coord_t h)
     }
 
     /* Step 1: Search cache for the given key */
-    lv_coord_t size = g->dir == LV_GRAD_DIR_HOR ? w : h;
-    uint32_t key = compute_key(g, size, w);
+    normalize_size(g, &w, &h);
+    grad_search_t search;
+    search.dsc = g;
+    search.w = w;
+    search.h = h;
+    search.key = compute_key(g, w, h);
     lv_grad_t * item = NULL;
-    if(iterate_cache(&find_item, &key, &item) == LV_RES_OK) {
+    if(iterate_cache(&find_item, &search, &item) == LV_RES_OK) {
         item->life++; /* Don't forget to bump the counter */
+#if _DITHER_GRADIENT && LV_DITHER_ERROR_DIFFUSION == 1
+        /*Start from no error on every draw, as a new item would*/
+        if(item->dsc.dither == LV_DITHER_ERR_DIFF) lv_memset_00(item->error_acc, item->w * sizeof(lv_scolor24_t));
+#endif
         return item;
     }
 
@@ -284,6 +338,16 @@ lv_grad_t * lv_gradient_get(const lv_grad_dsc_t * g, lv_coord_t w, lv_coord_t h)
 #if LV_DITHER_ERROR_DIFFUSION == 1
     lv_memset_00(item->error_acc, w * sizeof(lv_scolor24_t));
 #endif
+    if(g->dither == LV_DITHER_NONE) {
+        /*Nothing changes from line to line so convert it once*/
+        for(lv_coord_t i = 0; i < item->size; i++) {
+            item->map[i] = lv_color_hex(item->hmap[i].full);
+        }
+        item->filled = 1;
+    }
+    else if(item->dither_map) {
+        lv_dither_ordered_precompute(item);
+    }
 #else
     for(lv_coord_t i = 0; i < item->size; i++) {
         item->map[i] = lv_gradient_calculate(g, item->size, i);
@@ -168,7 +168,7 @@ static void draw_bg(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, co
 
 
     /*Get gradient if appropriate*/
-    lv_grad_t * grad = lv_gradient_get(&dsc->bg_grad, coords_bg_w, coords_bg_h);
+    lv_grad_t * grad = grad_dir != LV_GRAD_DIR_NONE ? lv_gradient_get(&dsc->bg_grad, coords_bg_w, coords_bg_h) : NULL;
     if(grad && grad_dir == LV_GRAD_DIR_HOR) {
         blend_dsc.src_buf = grad->map + clipped_coords.x1 - bg_coords.x1;
     }
@@ -177,13 +177,14 @@ static void draw_bg(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, co
     lv_dither_mode_t dither_mode = dsc->bg_grad.dither;
     lv_dither_func_t dither_func = &lv_dither_none;
     lv_coord_t grad_size = coords_bg_w;
-    if(grad_dir == LV_GRAD_DIR_VER && dither_mode != LV_DITHER_NONE) {
+    if(grad && grad_dir == LV_GRAD_DIR_VER && dither_mode != LV_DITHER_NONE) {
         /* When dithering, we are still using a map that's changing from line to line*/
         blend_dsc.src_buf = grad->map;
     }
 
     if(grad && dither_mode == LV_DITHER_NONE) {
-        grad->filled = 0; /*Should we force refilling it each draw call ?*/
+        /*The map was already converted when the gradient was created*/
+        dither_func = NULL;
         if(grad_dir == LV_GRAD_DIR_VER)
             grad_size = coords_bg_h;
     }
@@ -193,10 +194,10 @@ static void draw_bg(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, co
 #endif
             switch(grad_dir) {
                 case LV_GRAD_DIR_HOR:
-                    dither_func = lv_dither_ordered_hor;
+                    dither_func = grad->dither_map ? lv_dither_ordered_hor_precomputed : lv_dither_ordered_hor;
                     break;
                 case LV_GRAD_DIR_VER:
-                    dither_func = lv_dither_ordered_ver;
+                    dither_func = grad->dither_map ? lv_dither_ordered_ver_precomputed : lv_dither_ordered_ver;
                     break;
                 default:
                     dither_func = NULL;
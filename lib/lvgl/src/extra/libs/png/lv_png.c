@@ -16,18 +16,85 @@
 /*********************
  *      DEFINES
  *********************/
+#define PNG_IN_BUF_SIZE     256     /*Size of the buffer for reading the compressed data*/
+#define PNG_HUFF_MAX_BITS   15      /*Longest Huffman code in the deflate format*/
 
 /**********************
  *      TYPEDEFS
  **********************/
+typedef enum {
+    PNG_INF_HEADER,             /*Read the header of the next deflate block*/
+    PNG_INF_STORED,             /*Copy the bytes of a stored block*/
+    PNG_INF_CODES,              /*Decode the symbols of a compressed block*/
+    PNG_INF_DONE,               /*The last block is finished*/
+} png_inf_state_t;
+
+/*Canonical Huffman code*/
+typedef struct {
+    uint16_t count[PNG_HUFF_MAX_BITS + 1];  /*Number of codes of each length*/
+    uint16_t symbol[288];                   /*Symbols ordered by their codes*/
+} png_huff_t;
+
+/*A PNG decoded row-by-row. The zlib stream of the IDAT chunks is inflated as the rows are requested.*/
+typedef struct {
+    /*Source*/
+    const uint8_t * data;       /*The PNG if it's a C array*/
+    uint32_t data_size;
+    lv_fs_file_t file;          /*The PNG if it's a file*/
+    bool is_file;
+    uint32_t pos;               /*Read position in the PNG*/
+
+    /*IDAT chunks*/
+    uint32_t idat_start;        /*Position of the first IDAT chunk*/
+    uint32_t idat_left;         /*Bytes of the current IDAT chunk not read into `in_buf` yet*/
+    bool idat_crc;              /*The CRC of the current IDAT chunk is still to be skipped*/
+    uint8_t in_buf[PNG_IN_BUF_SIZE];
+    uint16_t in_pos;
+    uint16_t in_len;
+
+    /*Inflate*/
+    png_inf_state_t inf_state;
+    bool inf_last;              /*The current block is the last one*/
+    bool error;
+    uint8_t bit_cnt;
+    uint32_t bit_buf;
+    uint32_t stored_left;
+    uint32_t copy_len;          /*Bytes of a match still to be copied from the window*/
+    uint32_t copy_dist;
+    png_huff_t lencode;
+    png_huff_t distcode;
+    uint8_t * window;           /*The last `win_size` inflated bytes*/
+    uint32_t win_size;
+    uint32_t win_pos;
+    uint32_t win_fill;
+
+    /*Rows*/
+    LodePNGColorMode color;     /*Color type of the PNG*/
+    LodePNGColorMode color_rgba;
+    uint32_t w;
+    uint32_t h;
+    uint32_t line_size;         /*Size of a filtered line without the filter type byte*/
+    uint32_t bpp_bytes;         /*Distance of the corresponding bytes of neighbouring pixels*/
+    uint8_t * line;             /*The last unfiltered line*/
+    uint8_t * prev_line;
+    uint8_t * px_line;          /*The last line converted to the color format of LVGL*/
+    int32_t next_y;             /*The row to inflate next*/
+} png_stream_t;
 
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 static lv_res_t decoder_info(struct _lv_img_decoder_t * decoder, const void * src, lv_img_header_t * header);
 static lv_res_t decoder_open(lv_img_decoder_t * dec, lv_img_decoder_dsc_t * dsc);
+static lv_res_t decoder_read_line(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc, lv_coord_t x, lv_coord_t y,
+                                  lv_coord_t len, uint8_t * buf);
 static void decoder_close(lv_img_decoder_t * dec, lv_img_decoder_dsc_t * dsc);
 static void convert_color_depth(uint8_t * img, uint32_t px_cnt);
+static png_stream_t * png_stream_open(const void * src, lv_img_src_t src_type);
+static void png_stream_close(png_stream_t * s);
+static lv_res_t png_stream_restart(png_stream_t * s);
+static lv_res_t png_stream_next_row(png_stream_t * s, bool convert);
+static lv_res_t inf_read(png_stream_t * s, uint8_t * out, uint32_t len);
 
 /**********************
  *  STATIC VARIABLES
@@ -49,6 +116,7 @@ void lv_png_init(void)
     lv_img_decoder_t * dec = lv_img_decoder_create();
     lv_img_decoder_set_info_cb(dec, decoder_info);
     lv_img_decoder_set_open_cb(dec, decoder_open);
+    lv_img_decoder_set_read_line_cb(dec, decoder_read_line);
     lv_img_decoder_set_close_cb(dec, decoder_close);
 }
 
@@ -139,6 +207,7 @@ static lv_res_t decoder_info(struct _lv_img_decoder_t * decoder, const void * sr
 
 /**
  * Open a PNG image and return the decided image
+ * Non-interlaced images are decoded line-by-line in `decoder_read_line`, only the interlaced ones are fully decoded.
  * @param src can be file name or pointer to a C array
  * @param style style of the image object (unused now but certain formats might use it)
  * @return pointer to the decoded image or `LV_IMG_DECODER_OPEN_FAIL` if failed
@@ -156,6 +225,12 @@ static lv_res_t decoder_open(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t *
         const char * fn = dsc->src;
         if(strcmp(lv_fs_get_ext(fn), "png") == 0) {              /*Check the extension*/
 
+            dsc->user_data = png_stream_open(fn, LV_IMG_SRC_FILE);
+            if(dsc->user_data) {
+                dsc->img_data = NULL;
+                return LV_RES_OK;     /*The lines will be decoded in `decoder_read_line`*/
+            }
+
             /*Load the PNG file into buffer. It's still compressed (not decoded)*/
             unsigned char * png_data;      /*Pointer to the loaded data. Same as the original file just loaded into the RAM*/
             size_t png_data_size;          /*Size of `png_data` in bytes*/
@@ -193,6 +268,12 @@ static lv_res_t decoder_open(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t *
         unsigned png_width;             /*No used, just required by he decoder*/
         unsigned png_height;            /*No used, just required by he decoder*/
 
+        dsc->user_data = png_stream_open(img_dsc, LV_IMG_SRC_VARIABLE);
+        if(dsc->user_data) {
+            dsc->img_data = NULL;
+            return LV_RES_OK;     /*The lines will be decoded in `decoder_read_line`*/
+        }
+
         /*Decode the image in ARGB8888 */
         error = lodepng_decode32(&img_data, &png_width, &png_height, img_dsc->data, img_dsc->data_size);
 
@@ -213,6 +294,41 @@ static lv_res_t decoder_open(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t *
     return LV_RES_INV;    /*If not returned earlier then it failed*/
 }
 
+/**
+ * Decode `len` pixels starting from the given `x`, `y` coordinates and store them in `buf`.
+ * The rows are inflated from the top, so reading a row above the last one restarts the decoding.
+ * @param decoder pointer to the decoder the function associated with
+ * @param dsc pointer to decoder descriptor
+ * @param x start x coordinate
+ * @param y start y coordinate
+ * @param len number of pixels to decode
+ * @param buf a buffer to store the decoded pixels
+ * @return LV_RES_OK: ok; LV_RES_INV: failed
+ */
+static lv_res_t decoder_read_line(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc, lv_coord_t x, lv_coord_t y,
+                                  lv_coord_t len, uint8_t * buf)
+{
+    LV_UNUSED(decoder); /*Unused*/
+    png_stream_t * s = dsc->user_data;
+    if(s == NULL) return LV_RES_INV;
+    if(y < 0 || (uint32_t)y >= s->h || x < 0 || (uint32_t)(x + len) > s->w) return LV_RES_INV;
+
+    if(s->error || y < s->next_y - 1) {
+        if(png_stream_restart(s) != LV_RES_OK) return LV_RES_INV;
+    }
+
+    while(s->next_y <= y) {
+        /*Only the requested row needs to be converted*/
+        if(png_stream_next_row(s, s->next_y == y) != LV_RES_OK) {
+            s->error = true;
+            return LV_RES_INV;
+        }
+    }
+
+    lv_memcpy(buf, s->px_line + x * LV_IMG_PX_SIZE_ALPHA_BYTE, len * LV_IMG_PX_SIZE_ALPHA_BYTE);
+    return LV_RES_OK;
+}
+
 /**
  * Free the allocated resources
  */
@@ -223,6 +339,10 @@ static void decoder_close(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc
         lv_mem_free((uint8_t *)dsc->img_data);
         dsc->img_data = NULL;
     }
+    if(dsc->user_data) {
+        png_stream_close(dsc->user_data);
+        dsc->user_data = NULL;
+    }
 }
 
 /**
@@ -273,6 +393,551 @@ static void convert_color_depth(uint8_t * img, uint32_t px_cnt)
 #endif
 }
 
+/**********************
+ *   LINE-BY-LINE DECODING
+ **********************/
+
+static bool src_read(png_stream_t * s, void * buf, uint32_t len)
+{
+    if(s->is_file) {
+        uint32_t rn;
+        if(lv_fs_read(&s->file, buf, len, &rn) != LV_FS_RES_OK || rn != len) return false;
+    }
+    else {
+        if(s->pos + len > s->data_size) return false;
+        lv_memcpy(buf, s->data + s->pos, len);
+    }
+    s->pos += len;
+    return true;
+}
+
+static bool src_seek(png_stream_t * s, uint32_t pos)
+{
+    if(s->is_file) {
+        if(lv_fs_seek(&s->file, pos, LV_FS_SEEK_SET) != LV_FS_RES_OK) return false;
+    }
+    else if(pos > s->data_size) return false;
+    s->pos = pos;
+    return true;
+}
+
+static uint32_t read_u32_be(const uint8_t * p)
+{
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+
+/**
+ * Open a PNG to be decoded line-by-line.
+ * Only the header and the chunks before the first IDAT are processed here.
+ * @param src file name or pointer to an `lv_img_dsc_t`
+ * @param src_type type of `src`
+ * @return the new stream or NULL if the PNG can't be streamed (e.g. it's interlaced)
+ */
+static png_stream_t * png_stream_open(const void * src, lv_img_src_t src_type)
+{
+    png_stream_t * s = lv_mem_alloc(sizeof(png_stream_t));
+    if(s == NULL) return NULL;
+    lv_memset_00(s, sizeof(png_stream_t));
+    lodepng_color_mode_init(&s->color);
+    lodepng_color_mode_init(&s->color_rgba);    /*The default mode is 8 bit RGBA*/
+
+    if(src_type == LV_IMG_SRC_FILE) {
+        if(lv_fs_open(&s->file, src, LV_FS_MODE_RD) != LV_FS_RES_OK) {
+            lv_mem_free(s);
+            return NULL;
+        }
+        s->is_file = true;
+    }
+    else {
+        const lv_img_dsc_t * img_dsc = src;
+        s->data = img_dsc->data;
+        s->data_size = img_dsc->data_size;
+    }
+
+    /*The signature and the IHDR chunk*/
+    uint8_t head[33];
+    if(!src_read(s, head, sizeof(head))) goto fail;
+
+    LodePNGState state;
+    lodepng_state_init(&state);
+    unsigned w, h;
+    unsigned error = lodepng_inspect(&w, &h, &state, head, sizeof(head));
+    if(error == 0 && state.info_png.interlace_method != 0) error = 1;
+
+    /*Process the chunks up to the first IDAT. Only PLTE and tRNS matter for the pixels.*/
+    while(error == 0) {
+        uint8_t chunk_head[8];
+        uint32_t chunk_pos = s->pos;
+        if(!src_read(s, chunk_head, sizeof(chunk_head))) {
+            error = 1;
+            break;
+        }
+
+        uint32_t chunk_len = read_u32_be(chunk_head);
+        if(lodepng_chunk_type_equals(chunk_head, "IDAT")) {
+            s->idat_start = chunk_pos;
+            break;
+        }
+        else if(lodepng_chunk_type_equals(chunk_head, "IEND")) {
+            error = 1;
+        }
+        else if(lodepng_chunk_type_equals(chunk_head, "PLTE") || lodepng_chunk_type_equals(chunk_head, "tRNS")) {
+            /*At most 256 RGB or alpha entries*/
+            uint8_t * chunk = chunk_len <= 768 ? lv_mem_alloc(chunk_len + 12) : NULL;
+            if(chunk == NULL) {
+                error = 1;
+                break;
+            }
+            lv_memcpy(chunk, chunk_head, sizeof(chunk_head));
+            if(src_read(s, chunk + sizeof(chunk_head), chunk_len + 4)) {
+                error = lodepng_inspect_chunk(&state, 0, chunk, chunk_len + 12);
+            }
+            else {
+                error = 1;
+            }
+            lv_mem_free(chunk);
+        }
+        else if(!src_seek(s, chunk_pos + chunk_len + 12)) {
+            error = 1;
+        }
+    }
+
+    if(error == 0) error = lodepng_color_mode_copy(&s->color, &state.info_png.color);
+    lodepng_state_cleanup(&state);
+    if(error) goto fail;
+
+    uint32_t bpp = lodepng_get_bpp(&s->color);
+    s->w = w;
+    s->h = h;
+    s->line_size = (w * bpp + 7) / 8;
+    s->bpp_bytes = (bpp + 7) / 8;
+    s->line = lv_mem_alloc(s->line_size);
+    s->prev_line = lv_mem_alloc(s->line_size);
+    s->px_line = lv_mem_alloc(w * 4);
+    if(s->line == NULL || s->prev_line == NULL || s->px_line == NULL) goto fail;
+
+    if(png_stream_restart(s) != LV_RES_OK) goto fail;
+
+    return s;
+
+fail:
+    png_stream_close(s);
+    return NULL;
+}
+
+static void png_stream_close(png_stream_t * s)
+{
+    if(s->is_file) lv_fs_close(&s->file);
+    lodepng_color_mode_cleanup(&s->color);
+    lodepng_color_mode_cleanup(&s->color_rgba);
+    if(s->line) lv_mem_free(s->line);
+    if(s->prev_line) lv_mem_free(s->prev_line);
+    if(s->px_line) lv_mem_free(s->px_line);
+    if(s->window) lv_mem_free(s->window);
+    lv_mem_free(s);
+}
+
+/**
+ * Get the next byte of the zlib stream from the IDAT chunks
+ * @return the byte or -1 at the end of the stream
+ */
+static int idat_byte(png_stream_t * s)
+{
+    if(s->in_pos < s->in_len) return s->in_buf[s->in_pos++];
+
+    while(s->idat_left == 0) {
+        /*Skip the CRC of the current IDAT and start the next one*/
+        uint8_t chunk_head[12];
+        uint8_t * head = chunk_head;
+        uint32_t head_size = 8;
+        if(s->idat_crc) head_size += 4;
+        if(!src_read(s, chunk_head, head_size)) return -1;
+        if(s->idat_crc) head += 4;
+        if(!lodepng_chunk_type_equals(head, "IDAT")) return -1;
+        s->idat_left = read_u32_be(head);
+        s->idat_crc = true;
+    }
+
+    uint32_t rn = LV_MIN(s->idat_left, PNG_IN_BUF_SIZE);
+    if(!src_read(s, s->in_buf, rn)) return -1;
+    s->idat_left -= rn;
+    s->in_len = rn;
+    s->in_pos = 1;
+    return s->in_buf[0];
+}
+
+/**
+ * Start the decoding from the first row
+ */
+static lv_res_t png_stream_restart(png_stream_t * s)
+{
+    if(!src_seek(s, s->idat_start)) return LV_RES_INV;
+    s->idat_left = 0;
+    s->idat_crc = false;
+    s->in_pos = 0;
+    s->in_len = 0;
+
+    s->inf_state = PNG_INF_HEADER;
+    s->inf_last = false;
+    s->error = false;
+    s->bit_cnt = 0;
+    s->bit_buf = 0;
+    s->copy_len = 0;
+    s->win_pos = 0;
+    s->win_fill = 0;
+
+    /*zlib header: only deflate without preset dictionary is allowed in PNG*/
+    int cmf = idat_byte(s);
+    int flg = idat_byte(s);
+    if(cmf < 0 || flg < 0) return LV_RES_INV;
+    if((cmf & 0x0F) != 8 || (cmf >> 4) > 7 || ((cmf << 8) | flg) % 31 != 0 || (flg & 0x20)) return LV_RES_INV;
+
+    /*The window is only as large as the encoder used*/
+    uint32_t win_size = 1UL << ((cmf >> 4) + 8);
+    if(s->win_size < win_size) {
+        if(s->window) lv_mem_free(s->window);
+        s->window = lv_mem_alloc(win_size);
+        s->win_size = s->window ? win_size : 0;
+        if(s->window == NULL) return LV_RES_INV;
+    }
+
+    /*The first row is filtered against a row of zeros*/
+    lv_memset_00(s->prev_line, s->line_size);
+    lv_memset_00(s->line, s->line_size);
+    s->next_y = 0;
+
+    return LV_RES_OK;
+}
+
+static uint8_t paeth_predictor(int16_t a, int16_t b, int16_t c)
+{
+    int16_t pa = LV_ABS(b - c);
+    int16_t pb = LV_ABS(a - c);
+    int16_t pc = LV_ABS(a + b - c - c);
+    if(pa <= pb && pa <= pc) return (uint8_t)a;
+    if(pb <= pc) return (uint8_t)b;
+    return (uint8_t)c;
+}
+
+static bool unfilter_line(uint8_t * line, const uint8_t * prev, uint8_t filter, uint32_t bpp, uint32_t size)
+{
+    uint32_t i;
+    switch(filter) {
+        case 0:
+            break;
+        case 1:
+            for(i = bpp; i < size; i++) line[i] += line[i - bpp];
+            break;
+        case 2:
+            for(i = 0; i < size; i++) line[i] += prev[i];
+            break;
+        case 3:
+            for(i = 0; i < bpp; i++) line[i] += prev[i] >> 1;
+            for(; i < size; i++) line[i] += (line[i - bpp] + prev[i]) >> 1;
+            break;
+        case 4:
+            for(i = 0; i < bpp; i++) line[i] += prev[i];
+            for(; i < size; i++) line[i] += paeth_predictor(line[i - bpp], prev[i], prev[i - bpp]);
+            break;
+        default:
+            return false;
+    }
+    return true;
+}
+
+/**
+ * Inflate and unfilter the next row
+ * @param s the stream
+ * @param convert true: convert the row to the color format of LVGL into `px_line`
+ */
+static lv_res_t png_stream_next_row(png_stream_t * s, bool convert)
+{
+    uint8_t * tmp = s->prev_line;
+    s->prev_line = s->line;
+    s->line = tmp;
+
+    uint8_t filter;
+    if(inf_read(s, &filter, 1) != LV_RES_OK) return LV_RES_INV;
+    if(inf_read(s, s->line, s->line_size) != LV_RES_OK) return LV_RES_INV;
+    if(!unfilter_line(s->line, s->prev_line, filter, s->bpp_bytes, s->line_size)) return LV_RES_INV;
+
+    if(convert) {
+        unsigned error = lodepng_convert(s->px_line, s->line, &s->color_rgba, &s->color, s->w, 1);
+        if(error) return LV_RES_INV;
+        convert_color_depth(s->px_line, s->w);
+    }
+
+    s->next_y++;
+    return LV_RES_OK;
+}
+
+/*Inflate (RFC 1951) based on the canonical decoding of zlib's "puff"*/
+
+static uint32_t inf_bits(png_stream_t * s, uint8_t need)
+{
+    uint32_t val = s->bit_buf;
+    while(s->bit_cnt < need) {
+        int b = idat_byte(s);
+        if(b < 0) {
+            s->error = true;
+            return 0;
+        }
+        val |= (uint32_t)b << s->bit_cnt;
+        s->bit_cnt += 8;
+    }
+
+    s->bit_buf = val >> need;
+    s->bit_cnt -= need;
+    return val & ((1UL << need) - 1);
+}
+
+static int inf_decode(png_stream_t * s, const png_huff_t * h)
+{
+    int code = 0;       /*The bits read so far*/
+    int first = 0;      /*The first code of the current length*/
+    int index = 0;      /*Index of the first code of the current length in `symbol`*/
+    int len;
+    for(len = 1; len <= PNG_HUFF_MAX_BITS; len++) {
+        code |= inf_bits(s, 1);
+        if(s->error) return -1;
+        int count = h->count[len];
+        if(code - count < first) return h->symbol[index + (code - first)];
+        index += count;
+        first += count;
+        first <<= 1;
+        code <<= 1;
+    }
+    return -1;
+}
+
+/**
+ * Build a Huffman code from the code lengths
+ * @return 0: complete code, <0: over-subscribed code, >0: incomplete code
+ */
+static int inf_build(png_huff_t * h, const uint8_t * length, uint16_t n)
+{
+    uint16_t offs[PNG_HUFF_MAX_BITS + 1];
+    uint16_t sym;
+    int len;
+
+    lv_memset_00(h->count, sizeof(h->count));
+    for(sym = 0; sym < n; sym++) h->count[length[sym]]++;
+    if(h->count[0] == n) return 0;
+
+    int left = 1;
+    for(len = 1; len <= PNG_HUFF_MAX_BITS; len++) {
+        left <<= 1;
+        left -= h->count[len];
+        if(left < 0) return left;
+    }
+
+    offs[1] = 0;
+    for(len = 1; len < PNG_HUFF_MAX_BITS; len++) offs[len + 1] = offs[len] + h->count[len];
+    for(sym = 0; sym < n; sym++) {
+        if(length[sym]) h->symbol[offs[length[sym]]++] = sym;
+    }
+
+    return left;
+}
+
+static lv_res_t inf_fixed(png_stream_t * s)
+{
+    uint8_t length[288];
+    uint16_t sym;
+    for(sym = 0; sym < 144; sym++) length[sym] = 8;
+    for(; sym < 256; sym++) length[sym] = 9;
+    for(; sym < 280; sym++) length[sym] = 7;
+    for(; sym < 288; sym++) length[sym] = 8;
+    inf_build(&s->lencode, length, 288);
+
+    for(sym = 0; sym < 30; sym++) length[sym] = 5;
+    inf_build(&s->distcode, length, 30);
+
+    return LV_RES_OK;
+}
+
+static lv_res_t inf_dynamic(png_stream_t * s)
+{
+    static const uint8_t order[19] = {16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15};
+    uint8_t length[286 + 30];
+    uint16_t index;
+
+    uint16_t nlen = inf_bits(s, 5) + 257;
+    uint16_t ndist = inf_bits(s, 5) + 1;
+    uint16_t ncode = inf_bits(s, 4) + 4;
+    if(s->error || nlen > 286 || ndist > 30) return LV_RES_INV;
+
+    /*The code of the code lengths*/
+    for(index = 0; index < ncode; index++) length[order[index]] = inf_bits(s, 3);
+    for(; index < 19; index++) length[order[index]] = 0;
+    if(s->error || inf_build(&s->lencode, length, 19) != 0) return LV_RES_INV;
+
+    index = 0;
+    while(index < nlen + ndist) {
+        int sym = inf_decode(s, &s->lencode);
+        if(sym < 0) return LV_RES_INV;
+        if(sym < 16) {
+            length[index++] = sym;
+            continue;
+        }
+
+        uint8_t len = 0;
+        uint16_t rep;
+        if(sym == 16) {
+            if(index == 0) return LV_RES_INV;
+            len = length[index - 1];
+            rep = 3 + inf_bits(s, 2);
+        }
+        else if(sym == 17) {
+            rep = 3 + inf_bits(s, 3);
+        }
+        else {
+            rep = 11 + inf_bits(s, 7);
+        }
+        if(s->error || index + rep > nlen + ndist) return LV_RES_INV;
+        while(rep--) length[index++] = len;
+    }
+
+    /*The end-of-block code is required*/
+    if(length[256] == 0) return LV_RES_INV;
+
+    /*Incomplete codes are allowed only with a single code*/
+    int err = inf_build(&s->lencode, length, nlen);
+    if(err < 0 || (err > 0 && nlen - s->lencode.count[0] != 1)) return LV_RES_INV;
+    err = inf_build(&s->distcode, length + nlen, ndist);
+    if(err < 0 || (err > 0 && ndist - s->distcode.count[0] != 1)) return LV_RES_INV;
+
+    return LV_RES_OK;
+}
+
+static lv_res_t inf_header(png_stream_t * s)
+{
+    if(s->inf_last) return LV_RES_INV;  /*No more data after the last block*/
+
+    s->inf_last = inf_bits(s, 1);
+    uint32_t type = inf_bits(s, 2);
+    if(s->error) return LV_RES_INV;
+
+    if(type == 0) {
+        /*Stored block: skip to a byte boundary and read the length and its complement*/
+        s->bit_buf = 0;
+        s->bit_cnt = 0;
+        uint32_t len = inf_bits(s, 16);
+        uint32_t nlen = inf_bits(s, 16);
+        if(s->error || len != (~nlen & 0xFFFF)) return LV_RES_INV;
+        s->stored_left = len;
+        s->inf_state = PNG_INF_STORED;
+        return LV_RES_OK;
+    }
+
+    lv_res_t res;
+    if(type == 1) res = inf_fixed(s);
+    else if(type == 2) res = inf_dynamic(s);
+    else res = LV_RES_INV;
+
+    s->inf_state = PNG_INF_CODES;
+    return res;
+}
+
+static inline void inf_put(png_stream_t * s, uint8_t b)
+{
+    s->window[s->win_pos] = b;
+    s->win_pos = (s->win_pos + 1) & (s->win_size - 1);
+    if(s->win_fill < s->win_size) s->win_fill++;
+}
+
+/**
+ * Inflate the next `len` bytes
+ */
+static lv_res_t inf_read(png_stream_t * s, uint8_t * out, uint32_t len)
+{
+    static const uint16_t len_base[29] = {
+        3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258
+    };
+    static const uint8_t len_extra[29] = {
+        0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0
+    };
+    static const uint16_t dist_base[30] = {
+        1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073,
+        4097, 6145, 8193, 12289, 16385, 24577
+    };
+    static const uint8_t dist_extra[30] = {
+        0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13
+    };
+
+    while(len) {
+        /*Finish the pending match first*/
+        if(s->copy_len) {
+            uint32_t n = LV_MIN(s->copy_len, len);
+            uint32_t from = (s->win_pos - s->copy_dist) & (s->win_size - 1);
+            s->copy_len -= n;
+            len -= n;
+            while(n--) {
+                uint8_t b = s->window[from];
+                from = (from + 1) & (s->win_size - 1);
+                inf_put(s, b);
+                *out++ = b;
+            }
+            continue;
+        }
+
+        switch(s->inf_state) {
+            case PNG_INF_HEADER:
+                if(inf_header(s) != LV_RES_OK) return LV_RES_INV;
+                break;
+
+            case PNG_INF_STORED:
+                if(s->stored_left == 0) {
+                    s->inf_state = s->inf_last ? PNG_INF_DONE : PNG_INF_HEADER;
+                    break;
+                }
+                else {
+                    int b = idat_byte(s);
+                    if(b < 0) return LV_RES_INV;
+                    s->stored_left--;
+                    inf_put(s, b);
+                    *out++ = b;
+                    len--;
+                }
+                break;
+
+            case PNG_INF_CODES: {
+                    int sym = inf_decode(s, &s->lencode);
+                    if(sym < 0) return LV_RES_INV;
+                    if(sym < 256) {
+                        inf_put(s, sym);
+                        *out++ = sym;
+                        len--;
+                        break;
+                    }
+                    if(sym == 256) {
+                        s->inf_state = s->inf_last ? PNG_INF_DONE : PNG_INF_HEADER;
+                        break;
+                    }
+
+                    sym -= 257;
+                    if(sym >= 29) return LV_RES_INV;
+                    uint32_t copy_len = len_base[sym] + inf_bits(s, len_extra[sym]);
+
+                    int dsym = inf_decode(s, &s->distcode);
+                    if(dsym < 0 || dsym >= 30) return LV_RES_INV;
+                    uint32_t dist = dist_base[dsym] + inf_bits(s, dist_extra[dsym]);
+                    if(s->error || dist > s->win_fill) return LV_RES_INV;
+
+                    s->copy_len = copy_len;
+                    s->copy_dist = dist;
+                    break;
+                }
+
+            case PNG_INF_DONE:
+            default:
+                return LV_RES_INV;      /*The image data ended before the last row*/
+        }
+    }
+
+    return LV_RES_OK;
+}
+
 #endif /*LV_USE_PNG*/
 
 
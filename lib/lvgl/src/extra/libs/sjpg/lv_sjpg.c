@@ -37,8 +37,13 @@
 /                   JPEG DECODER
 /                   ------------
 /   We are using TJpgDec - Tiny JPEG Decompressor library from ELM-CHAN for decoding each split-jpeg fragments.
-/   The tjpgd.c and tjpgd.h is not modified and those are used as it is. So if any update comes for the tiny-jpeg,
-/   just replace those files with updated files.
+/   The tjpgd.c and tjpgd.h is modified only to add jd_decomp_row() which decodes one MCU row at a time.
+/   So if any update comes for the tiny-jpeg, replace those files and add jd_decomp_row() again.
+/
+/   Normal JPG files are not split into fragments, so they are decoded one MCU row at a time instead.
+/   The decoder state is saved at the start of every MCU row which was decoded once, so a row can be
+/   decoded again without starting from the top of the image. This way only `width * MCU height` pixels
+/   need to be stored in the RAM.
 /---------------------------------------------------------------------------------------------------------------------------------*/
 
 /*********************
@@ -80,11 +85,25 @@ typedef struct {
     uint8_t * img_cache_buff;
     int img_cache_x_res;
     int img_cache_y_res;
+    int img_cache_y_ofs;                  //The first row of the image stored in img_cache_buff
     uint8_t * raw_sjpg_data;              //Used when type==SJPEG_IO_SOURCE_C_ARRAY.
     uint32_t raw_sjpg_data_size;          //Num bytes pointed to by raw_sjpg_data.
     uint32_t raw_sjpg_data_next_read_pos; //Used for all types.
 } io_source_t;
 
+typedef struct {
+    uint32_t pos;                       //Position of the JDEC read pointer in the stream
+    int16_t dcv[3];
+    uint16_t rst;
+    uint16_t rsc;
+    uint8_t dbit;
+#if JD_FASTDECODE == 0
+    uint8_t stuffed;                    //The byte at the read pointer was a stuffed 0x00 replaced by 0xFF
+#else
+    uint8_t marker;
+    uint32_t wreg;
+#endif
+} jpg_row_state_t;
 
 typedef struct {
     uint8_t * sjpeg_data;
@@ -100,6 +119,10 @@ typedef struct {
     uint8_t * workb;                    //JPG work buffer for jpeg library
     JDEC * tjpeg_jd;
     io_source_t io;
+    jpg_row_state_t * jpg_row_states;   //Decoder state at the start of the MCU rows of a JPG (NULL for SJPG)
+    uint8_t scale;                      //The image is decoded at 1 / 2^scale size
+    int jpg_row_state_cnt;              //Number of MCU rows whose state is known
+    int jpg_next_row;                   //The MCU row the decoder continues with (-1: not prepared)
 } SJPEG;
 
 /**********************
@@ -112,6 +135,11 @@ static lv_res_t decoder_read_line(lv_img_decoder_t * decoder, lv_img_decoder_dsc
 static void decoder_close(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc);
 static size_t input_func(JDEC * jd, uint8_t * buff, size_t ndata);
 static int is_jpg(const uint8_t * raw_data, size_t len);
+static uint8_t get_file_scale(const char * src, char * fn);
+static uint8_t get_scale(uint8_t scale, int w, int h, int frame_h);
+static lv_res_t jpg_alloc_rows(SJPEG * sjpeg, const JDEC * jd, uint8_t scale);
+static void sjpg_apply_scale(SJPEG * sjpeg, uint8_t scale);
+static lv_res_t jpg_decode_mcu_row(SJPEG * sjpeg, int row);
 static void lv_sjpg_cleanup(SJPEG * sjpeg);
 static void lv_sjpg_free(SJPEG * sjpeg);
 
@@ -173,6 +201,14 @@ static lv_res_t decoder_info(lv_img_decoder_t * decoder, const void * src, lv_im
             header->h = *raw_sjpeg_data++;
             header->h |= *raw_sjpeg_data++ << 8;
 
+            raw_sjpeg_data += 2; //skip the number of frames
+            int frame_h = *raw_sjpeg_data++;
+            frame_h |= *raw_sjpeg_data++ << 8;
+
+            uint8_t scale = get_scale(img_dsc->header.reserved, header->w, header->h, frame_h);
+            header->w >>= scale;
+            header->h >>= scale;
+
             return ret;
 
         }
@@ -193,8 +229,9 @@ static lv_res_t decoder_info(lv_img_decoder_t * decoder, const void * src, lv_im
 
             JRESULT rc = jd_prepare(&jd_tmp, input_func, workb_temp, (size_t)TJPGD_WORKBUFF_SIZE, &io_source_temp);
             if(rc == JDR_OK) {
-                header->w = jd_tmp.width;
-                header->h = jd_tmp.height;
+                uint8_t scale = get_scale(img_dsc->header.reserved, jd_tmp.width, jd_tmp.height, jd_tmp.msy * 8);
+                header->w = jd_tmp.width >> scale;
+                header->h = jd_tmp.height >> scale;
 
             }
             else {
@@ -210,7 +247,8 @@ end:
         }
     }
     else if(src_type == LV_IMG_SRC_FILE) {
-        const char * fn = src;
+        char fn[LV_FS_MAX_PATH_LENGTH];
+        uint8_t src_scale = get_file_scale(src, fn);
         if(strcmp(lv_fs_get_ext(fn), "sjpg") == 0) {
 
             uint8_t buff[22];
@@ -229,8 +267,8 @@ end:
 
             if(strcmp((char *)buff, "_SJPG__") == 0) {
                 lv_fs_seek(&file, 14, LV_FS_SEEK_SET);
-                res = lv_fs_read(&file, buff, 4, &rn);
-                if(res != LV_FS_RES_OK || rn != 4) {
+                res = lv_fs_read(&file, buff, 8, &rn);
+                if(res != LV_FS_RES_OK || rn != 8) {
                     lv_fs_close(&file);
                     return LV_RES_INV;
                 }
@@ -241,6 +279,12 @@ end:
                 header->w |= *raw_sjpeg_data++ << 8;
                 header->h = *raw_sjpeg_data++;
                 header->h |= *raw_sjpeg_data++ << 8;
+                raw_sjpeg_data += 2; //skip the number of frames
+                int frame_h = *raw_sjpeg_data++;
+                frame_h |= *raw_sjpeg_data++ << 8;
+                uint8_t scale = get_scale(src_scale, header->w, header->h, frame_h);
+                header->w >>= scale;
+                header->h >>= scale;
                 lv_fs_close(&file);
                 return LV_RES_OK;
 
@@ -269,10 +313,11 @@ end:
             lv_fs_close(&file);
 
             if(rc == JDR_OK) {
+                uint8_t scale = get_scale(src_scale, jd_tmp.width, jd_tmp.height, jd_tmp.msy * 8);
                 header->always_zero = 0;
                 header->cf = LV_IMG_CF_RAW;
-                header->w = jd_tmp.width;
-                header->h = jd_tmp.height;
+                header->w = jd_tmp.width >> scale;
+                header->h = jd_tmp.height >> scale;
                 return LV_RES_OK;
             }
         }
@@ -291,7 +336,7 @@ static int img_data_cb(JDEC * jd, void * data, JRECT * rect)
     const int row_size = row_width * INPUT_PIXEL_SIZE;  // Row size (bytes).
 
     for(int y = rect->top; y <= rect->bottom; y++) {
-        int row_offset = y * xres * INPUT_PIXEL_SIZE + rect->left * INPUT_PIXEL_SIZE;
+        int row_offset = (y - io->img_cache_y_ofs) * xres * INPUT_PIXEL_SIZE + rect->left * INPUT_PIXEL_SIZE;
         memcpy(cache + row_offset, buf, row_size);
         buf += row_size;
     }
@@ -348,6 +393,7 @@ static lv_res_t decoder_open(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t *
 
     if(dsc->src_type == LV_IMG_SRC_VARIABLE) {
         uint8_t * data;
+        uint8_t src_scale = ((lv_img_dsc_t *)dsc->src)->header.reserved;
         SJPEG * sjpeg = (SJPEG *) dsc->user_data;
         const uint32_t raw_sjpeg_data_size = ((lv_img_dsc_t *)dsc->src)->data_size;
         if(sjpeg == NULL) {
@@ -396,6 +442,7 @@ static lv_res_t decoder_open(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t *
                 sjpeg->frame_base_array[i] = sjpeg->frame_base_array[i - 1] + offset;
             }
             sjpeg->sjpeg_cache_frame_index = -1;
+            sjpg_apply_scale(sjpeg, src_scale);
             sjpeg->frame_cache = (void *)lv_mem_alloc(sjpeg->sjpeg_x_res * sjpeg->sjpeg_single_frame_height * 3/*2*/);
             if(! sjpeg->frame_cache) {
                 lv_sjpg_cleanup(sjpeg);
@@ -442,29 +489,14 @@ static lv_res_t decoder_open(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t *
 
 
             if(rc == JDR_OK) {
-                sjpeg->sjpeg_x_res = jd_tmp.width;
-                sjpeg->sjpeg_y_res = jd_tmp.height;
-                sjpeg->sjpeg_total_frames = 1;
-                sjpeg->sjpeg_single_frame_height = jd_tmp.height;
-
-                sjpeg->frame_base_array = lv_mem_alloc(sizeof(uint8_t *) * sjpeg->sjpeg_total_frames);
-                if(! sjpeg->frame_base_array) {
+                if(jpg_alloc_rows(sjpeg, &jd_tmp, src_scale) != LV_RES_OK) {
                     lv_sjpg_cleanup(sjpeg);
                     sjpeg = NULL;
                     return LV_RES_INV;
                 }
-                sjpeg->frame_base_offset = NULL;
-
-                uint8_t * img_frame_base = sjpeg->sjpeg_data;
-                sjpeg->frame_base_array[0] = img_frame_base;
 
-                sjpeg->sjpeg_cache_frame_index = -1;
-                sjpeg->frame_cache = (void *)lv_mem_alloc(sjpeg->sjpeg_x_res * sjpeg->sjpeg_single_frame_height * 3);
-                if(! sjpeg->frame_cache) {
-                    lv_sjpg_cleanup(sjpeg);
-                    sjpeg = NULL;
-                    return LV_RES_INV;
-                }
+                sjpeg->io.raw_sjpg_data = sjpeg->sjpeg_data;
+                sjpeg->io.raw_sjpg_data_size = sjpeg->sjpeg_data_size;
 
                 sjpeg->io.img_cache_buff = sjpeg->frame_cache;
                 sjpeg->io.img_cache_x_res = sjpeg->sjpeg_x_res;
@@ -500,7 +532,8 @@ end:
     }
     else if(dsc->src_type == LV_IMG_SRC_FILE) {
         /* If all fine, then the file will be kept open */
-        const char * fn = dsc->src;
+        char fn[LV_FS_MAX_PATH_LENGTH];
+        uint8_t src_scale = get_file_scale(dsc->src, fn);
         uint8_t * data;
 
         if(strcmp(lv_fs_get_ext(fn), "sjpg") == 0) {
@@ -578,6 +611,7 @@ end:
                 }
 
                 sjpeg->sjpeg_cache_frame_index = -1; //INVALID AT BEGINNING for a forced compare mismatch at first time.
+                sjpg_apply_scale(sjpeg, src_scale);
                 sjpeg->frame_cache = (void *)lv_mem_alloc(sjpeg->sjpeg_x_res * sjpeg->sjpeg_single_frame_height * 3);
                 if(! sjpeg->frame_cache) {
                     lv_fs_close(&lv_file);
@@ -649,25 +683,7 @@ end:
 
 
             if(rc == JDR_OK) {
-                sjpeg->sjpeg_x_res = jd_tmp.width;
-                sjpeg->sjpeg_y_res = jd_tmp.height;
-                sjpeg->sjpeg_total_frames = 1;
-                sjpeg->sjpeg_single_frame_height = jd_tmp.height;
-
-                sjpeg->frame_base_array = NULL;
-                sjpeg->frame_base_offset =  lv_mem_alloc(sizeof(uint8_t *) * sjpeg->sjpeg_total_frames);
-                if(! sjpeg->frame_base_offset) {
-                    lv_fs_close(&lv_file);
-                    lv_sjpg_cleanup(sjpeg);
-                    return LV_RES_INV;
-                }
-
-                int img_frame_start_offset = 0;
-                sjpeg->frame_base_offset[0] = img_frame_start_offset;
-
-                sjpeg->sjpeg_cache_frame_index = -1;
-                sjpeg->frame_cache = (void *)lv_mem_alloc(sjpeg->sjpeg_x_res * sjpeg->sjpeg_single_frame_height * 3);
-                if(! sjpeg->frame_cache) {
+                if(jpg_alloc_rows(sjpeg, &jd_tmp, src_scale) != LV_RES_OK) {
                     lv_fs_close(&lv_file);
                     lv_sjpg_cleanup(sjpeg);
                     return LV_RES_INV;
@@ -729,7 +745,11 @@ static lv_res_t decoder_read_line(lv_img_decoder_t * decoder, lv_img_decoder_dsc
         int sjpeg_req_frame_index = y / sjpeg->sjpeg_single_frame_height;
 
         /*If line not from cache, refresh cache */
-        if(sjpeg_req_frame_index != sjpeg->sjpeg_cache_frame_index) {
+        if(sjpeg_req_frame_index != sjpeg->sjpeg_cache_frame_index && sjpeg->jpg_row_states) {
+            if(jpg_decode_mcu_row(sjpeg, sjpeg_req_frame_index) != LV_RES_OK) return LV_RES_INV;
+            sjpeg->sjpeg_cache_frame_index = sjpeg_req_frame_index;
+        }
+        else if(sjpeg_req_frame_index != sjpeg->sjpeg_cache_frame_index) {
             sjpeg->io.raw_sjpg_data = sjpeg->frame_base_array[ sjpeg_req_frame_index ];
             if(sjpeg_req_frame_index == (sjpeg->sjpeg_total_frames - 1)) {
                 /*This is the last frame. */
@@ -743,7 +763,7 @@ static lv_res_t decoder_read_line(lv_img_decoder_t * decoder, lv_img_decoder_dsc
             sjpeg->io.raw_sjpg_data_next_read_pos = 0;
             rc = jd_prepare(sjpeg->tjpeg_jd, input_func, sjpeg->workb, (size_t)TJPGD_WORKBUFF_SIZE, &(sjpeg->io));
             if(rc != JDR_OK) return LV_RES_INV;
-            rc = jd_decomp(sjpeg->tjpeg_jd, img_data_cb, 0);
+            rc = jd_decomp(sjpeg->tjpeg_jd, img_data_cb, sjpeg->scale);
             if(rc != JDR_OK) return LV_RES_INV;
             sjpeg->sjpeg_cache_frame_index = sjpeg_req_frame_index;
         }
@@ -800,14 +820,18 @@ static lv_res_t decoder_read_line(lv_img_decoder_t * decoder, lv_img_decoder_dsc
         if(!lv_file_p) goto end;
 
         /*If line not from cache, refresh cache */
-        if(sjpeg_req_frame_index != sjpeg->sjpeg_cache_frame_index) {
+        if(sjpeg_req_frame_index != sjpeg->sjpeg_cache_frame_index && sjpeg->jpg_row_states) {
+            if(jpg_decode_mcu_row(sjpeg, sjpeg_req_frame_index) != LV_RES_OK) return LV_RES_INV;
+            sjpeg->sjpeg_cache_frame_index = sjpeg_req_frame_index;
+        }
+        else if(sjpeg_req_frame_index != sjpeg->sjpeg_cache_frame_index) {
             sjpeg->io.raw_sjpg_data_next_read_pos = (int)(sjpeg->frame_base_offset [ sjpeg_req_frame_index ]);
             lv_fs_seek(&(sjpeg->io.lv_file), sjpeg->io.raw_sjpg_data_next_read_pos, LV_FS_SEEK_SET);
 
             rc = jd_prepare(sjpeg->tjpeg_jd, input_func, sjpeg->workb, (size_t)TJPGD_WORKBUFF_SIZE, &(sjpeg->io));
             if(rc != JDR_OK) return LV_RES_INV;
 
-            rc = jd_decomp(sjpeg->tjpeg_jd, img_data_cb, 0);
+            rc = jd_decomp(sjpeg->tjpeg_jd, img_data_cb, sjpeg->scale);
             if(rc != JDR_OK) return LV_RES_INV;
 
             sjpeg->sjpeg_cache_frame_index = sjpeg_req_frame_index;
@@ -897,6 +921,202 @@ static int is_jpg(const uint8_t * raw_data, size_t len)
     return memcmp(jpg_signature, raw_data, sizeof(jpg_signature)) == 0;
 }
 
+/**
+ * Split a file source into the file name and the scale given by its `LV_SJPG_SCALE_SUFFIX`
+ * @param src the file source, e.g. "S:/cover.jpg" or "S:/cover.jpg?scale=2"
+ * @param fn store the file name without the suffix here (`LV_FS_MAX_PATH_LENGTH` bytes)
+ * @return the scale of the source, 0 without suffix
+ */
+static uint8_t get_file_scale(const char * src, char * fn)
+{
+    const char * suffix = strstr(src, LV_SJPG_SCALE_SUFFIX);
+    size_t len = suffix ? (size_t)(suffix - src) : strlen(src);
+    if(len > LV_FS_MAX_PATH_LENGTH - 1) len = LV_FS_MAX_PATH_LENGTH - 1;
+    lv_memcpy(fn, src, len);
+    fn[len] = '\0';
+
+    if(!suffix) return 0;
+    const char * digit = suffix + strlen(LV_SJPG_SCALE_SUFFIX);
+    return (*digit >= '0' && *digit <= '9') ? LV_MIN(*digit - '0', 3) : 0;
+}
+
+/**
+ * Get the scale to use for an image.
+ * The scale is reduced if the image or its frames would be smaller than a pixel.
+ * @param scale the scale given by the image source
+ * @param w width of the image
+ * @param h height of the image
+ * @param frame_h height of the SJPG frames or the MCU rows
+ * @return the scale: the image is decoded at 1 / 2^scale size
+ */
+static uint8_t get_scale(uint8_t scale, int w, int h, int frame_h)
+{
+    while(scale > 0 && ((w >> scale) == 0 || (h >> scale) == 0 || (frame_h & ((1 << scale) - 1)) != 0)) scale--;
+    return scale;
+}
+
+/**
+ * Scale the size of the image and of the frames. tjpgd rounds down the scaled size of each MCU.
+ * The MCUs are 8 or 16 pixels and SJPG frames are multiple of 2^scale so it's the same
+ * as rounding down the size of the image.
+ * @param sjpeg the image being opened with the unscaled sizes already set
+ * @param scale the scale given by the image source
+ */
+static void sjpg_apply_scale(SJPEG * sjpeg, uint8_t scale)
+{
+    sjpeg->scale = get_scale(scale, sjpeg->sjpeg_x_res, sjpeg->sjpeg_y_res, sjpeg->sjpeg_single_frame_height);
+    sjpeg->sjpeg_x_res >>= sjpeg->scale;
+    sjpeg->sjpeg_y_res >>= sjpeg->scale;
+    sjpeg->sjpeg_single_frame_height >>= sjpeg->scale;
+}
+
+/**
+ * Set up a JPG to be decoded one MCU row at a time: every MCU row is handled as an SJPG frame.
+ * @param sjpeg the JPG being opened
+ * @param jd a decompression object prepared on the JPG
+ * @param scale the scale given by the image source
+ * @return LV_RES_OK: no error; LV_RES_INV: out of memory
+ */
+static lv_res_t jpg_alloc_rows(SJPEG * sjpeg, const JDEC * jd, uint8_t scale)
+{
+    sjpeg->sjpeg_x_res = jd->width;
+    sjpeg->sjpeg_y_res = jd->height;
+    sjpeg->sjpeg_single_frame_height = jd->msy * 8;
+    sjpeg->sjpeg_total_frames = (jd->height + sjpeg->sjpeg_single_frame_height - 1) / sjpeg->sjpeg_single_frame_height;
+    sjpg_apply_scale(sjpeg, scale);
+    sjpeg->sjpeg_cache_frame_index = -1;
+    sjpeg->frame_base_array = NULL;
+    sjpeg->frame_base_offset = NULL;
+
+    sjpeg->jpg_row_states = lv_mem_alloc(sizeof(jpg_row_state_t) * sjpeg->sjpeg_total_frames);
+    if(!sjpeg->jpg_row_states) return LV_RES_INV;
+    sjpeg->jpg_row_state_cnt = 0;
+    sjpeg->jpg_next_row = -1;
+
+    sjpeg->frame_cache = (void *)lv_mem_alloc(sjpeg->sjpeg_x_res * sjpeg->sjpeg_single_frame_height * 3);
+    if(!sjpeg->frame_cache) return LV_RES_INV;
+
+    return LV_RES_OK;
+}
+
+static uint32_t io_tell(io_source_t * io)
+{
+    if(io->type == SJPEG_IO_SOURCE_DISK) {
+        uint32_t pos = 0;
+        lv_fs_tell(&io->lv_file, &pos);
+        return pos;
+    }
+    return io->raw_sjpg_data_next_read_pos;
+}
+
+static void io_seek(io_source_t * io, uint32_t pos)
+{
+    if(io->type == SJPEG_IO_SOURCE_DISK) lv_fs_seek(&io->lv_file, pos, LV_FS_SEEK_SET);
+    io->raw_sjpg_data_next_read_pos = pos;
+}
+
+static void jpg_row_state_save(SJPEG * sjpeg, jpg_row_state_t * st)
+{
+    JDEC * jd = sjpeg->tjpeg_jd;
+    uint32_t read_end = io_tell(&sjpeg->io);
+
+#if JD_FASTDECODE == 0
+    /*`dptr` is the last consumed byte and `dctr` bytes follow it in the input buffer.
+     *A consumed byte can be 0xFF here only if it was a stuffed 0x00 patched by the decoder.*/
+    st->pos = read_end - (uint32_t)jd->dctr - 1;
+    st->stuffed = jd->dptr >= jd->inbuf && *jd->dptr == 0xFF;
+#else
+    st->pos = read_end - (uint32_t)jd->dctr;
+    st->marker = jd->marker;
+    st->wreg = jd->wreg;
+#endif
+    st->dbit = jd->dbit;
+    st->dcv[0] = jd->dcv[0];
+    st->dcv[1] = jd->dcv[1];
+    st->dcv[2] = jd->dcv[2];
+    st->rst = jd->rst;
+    st->rsc = jd->rsc;
+}
+
+static lv_res_t jpg_row_state_restore(SJPEG * sjpeg, const jpg_row_state_t * st)
+{
+    JDEC * jd = sjpeg->tjpeg_jd;
+
+    io_seek(&sjpeg->io, st->pos);
+    size_t rn = input_func(jd, jd->inbuf, JD_SZBUF);
+    if(rn == 0) return LV_RES_INV;
+
+    jd->dptr = jd->inbuf;
+#if JD_FASTDECODE == 0
+    jd->dctr = rn - 1;
+    if(st->stuffed) jd->inbuf[0] = 0xFF;
+#else
+    jd->dctr = rn;
+    jd->marker = st->marker;
+    jd->wreg = st->wreg;
+#endif
+    jd->dbit = st->dbit;
+    jd->dcv[0] = st->dcv[0];
+    jd->dcv[1] = st->dcv[1];
+    jd->dcv[2] = st->dcv[2];
+    jd->rst = st->rst;
+    jd->rsc = st->rsc;
+
+    return LV_RES_OK;
+}
+
+/**
+ * Decode an MCU row of a JPG into `frame_cache`.
+ * Continue the decoding if the decoder is above the row, else start from the closest saved row.
+ * @param sjpeg the JPG to decode
+ * @param row index of the MCU row
+ * @return LV_RES_OK: no error; LV_RES_INV: decoding error
+ */
+static lv_res_t jpg_decode_mcu_row(SJPEG * sjpeg, int row)
+{
+    JDEC * jd = sjpeg->tjpeg_jd;
+    JRESULT rc;
+
+    if(sjpeg->jpg_next_row < 0) {
+        /*Parse the headers. It leaves the stream at the first MCU*/
+        io_seek(&sjpeg->io, 0);
+        rc = jd_prepare(jd, input_func, sjpeg->workb, (size_t)TJPGD_WORKBUFF_SIZE, &(sjpeg->io));
+        if(rc != JDR_OK) return LV_RES_INV;
+        jpg_row_state_save(sjpeg, &sjpeg->jpg_row_states[0]);
+        sjpeg->jpg_row_state_cnt = 1;
+        sjpeg->jpg_next_row = 0;
+    }
+
+    int start = LV_MIN(row, sjpeg->jpg_row_state_cnt - 1);
+    if(sjpeg->jpg_next_row > row || sjpeg->jpg_next_row < start) {
+        if(jpg_row_state_restore(sjpeg, &sjpeg->jpg_row_states[start]) != LV_RES_OK) {
+            sjpeg->jpg_next_row = -1;
+            return LV_RES_INV;
+        }
+        sjpeg->jpg_next_row = start;
+    }
+
+    while(sjpeg->jpg_next_row <= row) {
+        int r = sjpeg->jpg_next_row;
+        if(r == sjpeg->jpg_row_state_cnt) {
+            jpg_row_state_save(sjpeg, &sjpeg->jpg_row_states[r]);
+            sjpeg->jpg_row_state_cnt++;
+        }
+
+        /*The skipped rows are overwritten by the next ones in the cache.
+         *The MCU row is addressed in the original size but the output is scaled.*/
+        sjpeg->io.img_cache_y_ofs = r * sjpeg->sjpeg_single_frame_height;
+        rc = jd_decomp_row(jd, img_data_cb, sjpeg->scale, (uint16_t)(r * jd->msy * 8));
+        if(rc != JDR_OK) {
+            sjpeg->jpg_next_row = -1;
+            return LV_RES_INV;
+        }
+        sjpeg->jpg_next_row++;
+    }
+
+    return LV_RES_OK;
+}
+
 static void lv_sjpg_free(SJPEG * sjpeg)
 {
     if(sjpeg->frame_cache) lv_mem_free(sjpeg->frame_cache);
@@ -904,6 +1124,7 @@ static void lv_sjpg_free(SJPEG * sjpeg)
     if(sjpeg->frame_base_offset) lv_mem_free(sjpeg->frame_base_offset);
     if(sjpeg->tjpeg_jd) lv_mem_free(sjpeg->tjpeg_jd);
     if(sjpeg->workb) lv_mem_free(sjpeg->workb);
+    if(sjpeg->jpg_row_states) lv_mem_free(sjpeg->jpg_row_states);
 }
 
 static void lv_sjpg_cleanup(SJPEG * sjpeg)
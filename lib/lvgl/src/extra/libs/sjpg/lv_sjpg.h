@@ -20,6 +20,17 @@ extern "C" {
  *      DEFINES
  *********************/
 
+/**
+ * JPG and SJPG images can be decoded at 1/2, 1/4 or 1/8 of their size, e.g. for thumbnails.
+ * Smaller sizes are decoded faster and need less RAM. The scale is part of the image source,
+ * so the same image can be shown at several sizes:
+ * - file names end with this suffix and the scale, e.g. "S:/cover.jpg?scale=2"
+ * - C arrays have the scale in `header.reserved` of their `lv_img_dsc_t`
+ * The scale is 0: original size, 1: 1/2, 2: 1/4, 3: 1/8.
+ * It's reduced for images which would be smaller than a pixel.
+ */
+#define LV_SJPG_SCALE_SUFFIX "?scale="
+
 /**********************
  *      TYPEDEFS
  **********************/
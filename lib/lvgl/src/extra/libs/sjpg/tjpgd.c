@@ -22,6 +22,8 @@
 / Jun 11, 2021 R0.02a Some performance improvement.
 / Jul 01, 2021 R0.03  Added JD_FASTDECODE option.
 /                     Some performance improvement.
+/ LVGL: Added jd_decomp_row() to decompress the picture one MCU row at a time.
+/ LVGL: Added SIMD IDCT (JD_SIMD), downscaling in the IDCT and single pass color conversion.
 /----------------------------------------------------------------------------*/
 
 #include "tjpgd.h"
@@ -123,6 +125,107 @@ static uint8_t BYTECLIP (int val)
 
 #endif
 
+/* Descale the transformed values 8 bits and store them in the MCU buffer */
+#if JD_FASTDECODE >= 1
+#define YUVOUT(v)	(int16_t)((v) >> 8)
+#else
+#define YUVOUT(v)	BYTECLIP((v) >> 8)
+#endif
+
+
+
+/*---------------------------------------------*/
+/* Vector operations for the IDCT              */
+/*---------------------------------------------*/
+
+#if !defined(JD_IDCT_FUNC) && JD_SIMD >= 2 && defined(__SSE2__)
+#include <emmintrin.h>
+#define JD_VEC	1
+
+typedef __m128i jd_vec;		/* 4 x int32_t */
+
+#define VLOAD(p)		_mm_loadu_si128((const __m128i*)(p))
+#define VSTORE(p, v)	_mm_storeu_si128((__m128i*)(p), v)
+#define VADD(a, b)		_mm_add_epi32(a, b)
+#define VSUB(a, b)		_mm_sub_epi32(a, b)
+#define VDUP(n)			_mm_set1_epi32(n)
+
+#if defined(__SSE4_1__)
+#include <smmintrin.h>
+#define VMULS(a, m)		_mm_srai_epi32(_mm_mullo_epi32(a, _mm_set1_epi32(m)), 12)	/* a * m >> 12 */
+#else
+static jd_vec VMULS (jd_vec a, int32_t m)	/* a * m >> 12 (SSE2 has no 32-bit multiplication) */
+{
+	jd_vec k = _mm_set1_epi32(m);
+	jd_vec e = _mm_mul_epu32(a, k);						/* Elements 0 and 2 (the low 32 bits are the same as a signed product) */
+	jd_vec o = _mm_mul_epu32(_mm_srli_epi64(a, 32), k);	/* Elements 1 and 3 */
+
+	e = _mm_shuffle_epi32(e, _MM_SHUFFLE(3, 1, 2, 0));
+	o = _mm_shuffle_epi32(o, _MM_SHUFFLE(3, 1, 2, 0));
+	return _mm_srai_epi32(_mm_unpacklo_epi32(e, o), 12);
+}
+#endif
+
+#define VTRANSPOSE(a, b, c, d) {					\
+	jd_vec t0 = _mm_unpacklo_epi32(a, b);			\
+	jd_vec t1 = _mm_unpacklo_epi32(c, d);			\
+	jd_vec t2 = _mm_unpackhi_epi32(a, b);			\
+	jd_vec t3 = _mm_unpackhi_epi32(c, d);			\
+	a = _mm_unpacklo_epi64(t0, t1);					\
+	b = _mm_unpackhi_epi64(t0, t1);					\
+	c = _mm_unpacklo_epi64(t2, t3);					\
+	d = _mm_unpackhi_epi64(t2, t3);					\
+}
+
+static void VSTORE_ROW (jd_yuv_t* dst, jd_vec lo, jd_vec hi)	/* Descale 8 bits and store 8 values */
+{
+	lo = _mm_srai_epi32(lo, 8);
+	hi = _mm_srai_epi32(hi, 8);
+#if JD_FASTDECODE >= 1
+	lo = _mm_srai_epi32(_mm_slli_epi32(lo, 16), 16);	/* Truncate to int16_t as (int16_t) does */
+	hi = _mm_srai_epi32(_mm_slli_epi32(hi, 16), 16);
+	_mm_storeu_si128((__m128i*)dst, _mm_packs_epi32(lo, hi));
+#else
+	lo = _mm_packs_epi32(lo, hi);						/* Saturate to 0..255 as BYTECLIP() does */
+	_mm_storel_epi64((__m128i*)dst, _mm_packus_epi16(lo, lo));
+#endif
+}
+
+#elif !defined(JD_IDCT_FUNC) && JD_SIMD && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+#include <arm_neon.h>
+#define JD_VEC	1
+
+typedef int32x4_t jd_vec;	/* 4 x int32_t */
+
+#define VLOAD(p)		vld1q_s32(p)
+#define VSTORE(p, v)	vst1q_s32(p, v)
+#define VADD(a, b)		vaddq_s32(a, b)
+#define VSUB(a, b)		vsubq_s32(a, b)
+#define VDUP(n)			vdupq_n_s32(n)
+#define VMULS(a, m)		vshrq_n_s32(vmulq_n_s32(a, m), 12)	/* a * m >> 12 */
+
+#define VTRANSPOSE(a, b, c, d) {										\
+	int32x4x2_t t0 = vtrnq_s32(a, b);									\
+	int32x4x2_t t1 = vtrnq_s32(c, d);									\
+	a = vcombine_s32(vget_low_s32(t0.val[0]), vget_low_s32(t1.val[0]));	\
+	b = vcombine_s32(vget_low_s32(t0.val[1]), vget_low_s32(t1.val[1]));	\
+	c = vcombine_s32(vget_high_s32(t0.val[0]), vget_high_s32(t1.val[0]));	\
+	d = vcombine_s32(vget_high_s32(t0.val[1]), vget_high_s32(t1.val[1]));	\
+}
+
+static void VSTORE_ROW (jd_yuv_t* dst, jd_vec lo, jd_vec hi)	/* Descale 8 bits and store 8 values */
+{
+	lo = vshrq_n_s32(lo, 8);
+	hi = vshrq_n_s32(hi, 8);
+#if JD_FASTDECODE >= 1
+	vst1q_s16(dst, vcombine_s16(vmovn_s32(lo), vmovn_s32(hi)));	/* Truncate to int16_t as (int16_t) does */
+#else
+	vst1_u8(dst, vqmovun_s16(vcombine_s16(vqmovn_s32(lo), vqmovn_s32(hi))));	/* Saturate to 0..255 as BYTECLIP() does */
+#endif
+}
+
+#endif
+
 
 
 /*-----------------------------------------------------------------------*/
@@ -576,6 +679,92 @@ static JRESULT restart (
 /* Apply Inverse-DCT in Arai Algorithm (see also aa_idct.png)            */
 /*-----------------------------------------------------------------------*/
 
+#if defined(JD_IDCT_FUNC)
+
+/* External IDCT (e.g. with the ESP32-S3 PIE instructions), same arguments and output as below */
+void JD_IDCT_FUNC (int32_t* src, jd_yuv_t* dst);
+#define block_idct(src, dst)	JD_IDCT_FUNC(src, dst)
+
+#elif defined(JD_VEC)
+
+static void idct_vec (
+	jd_vec* v		/* Elements 0..7 of four columns or rows, transformed in place */
+)
+{
+	const int32_t M13 = (int32_t)(1.41421*4096), M2 = (int32_t)(1.08239*4096), M4 = (int32_t)(2.61313*4096), M5 = (int32_t)(1.84776*4096);
+	jd_vec v0, v1, v2, v3, v4, v5, v6, v7;
+	jd_vec t10, t11, t12, t13;
+
+	/* The same operations as the scalar version, on four columns or rows at a time */
+	v0 = v[0]; v1 = v[2]; v2 = v[4]; v3 = v[6];	/* Get even elements */
+
+	t10 = VADD(v0, v2);		/* Process the even elements */
+	t12 = VSUB(v0, v2);
+	t11 = VMULS(VSUB(v1, v3), M13);
+	v3 = VADD(v3, v1);
+	t11 = VSUB(t11, v3);
+	v0 = VADD(t10, v3);
+	v3 = VSUB(t10, v3);
+	v1 = VADD(t11, t12);
+	v2 = VSUB(t12, t11);
+
+	v4 = v[7]; v5 = v[1]; v6 = v[5]; v7 = v[3];	/* Get odd elements */
+
+	t10 = VSUB(v5, v4);		/* Process the odd elements */
+	t11 = VADD(v5, v4);
+	t12 = VSUB(v6, v7);
+	v7 = VADD(v7, v6);
+	v5 = VMULS(VSUB(t11, v7), M13);
+	v7 = VADD(v7, t11);
+	t13 = VMULS(VADD(t10, t12), M5);
+	v4 = VSUB(t13, VMULS(t10, M2));
+	v6 = VSUB(VSUB(t13, VMULS(t12, M4)), v7);
+	v5 = VSUB(v5, v6);
+	v4 = VSUB(v4, v5);
+
+	v[0] = VADD(v0, v7);	/* Write-back transformed values */
+	v[7] = VSUB(v0, v7);
+	v[1] = VADD(v1, v6);
+	v[6] = VSUB(v1, v6);
+	v[2] = VADD(v2, v5);
+	v[5] = VSUB(v2, v5);
+	v[3] = VADD(v3, v4);
+	v[4] = VSUB(v3, v4);
+}
+
+static void block_idct (
+	int32_t* src,	/* Input block data (de-quantized and pre-scaled for Arai Algorithm) */
+	jd_yuv_t* dst	/* Pointer to the destination to store the block as byte array */
+)
+{
+	jd_vec v[8];
+	int i, j;
+
+	/* Process columns, four at a time */
+	for (i = 0; i < 8; i += 4) {
+		for (j = 0; j < 8; j++) v[j] = VLOAD(&src[8 * j + i]);
+		idct_vec(v);
+		for (j = 0; j < 8; j++) VSTORE(&src[8 * j + i], v[j]);
+	}
+
+	/* Process rows, four at a time (transposed so that each vector holds an element of the rows) */
+	for (i = 0; i < 8; i += 4) {
+		for (j = 0; j < 4; j++) {
+			v[j] = VLOAD(&src[8 * (i + j)]);
+			v[j + 4] = VLOAD(&src[8 * (i + j) + 4]);
+		}
+		VTRANSPOSE(v[0], v[1], v[2], v[3]);
+		VTRANSPOSE(v[4], v[5], v[6], v[7]);
+		v[0] = VADD(v[0], VDUP(128L << 8));	/* Remove DC offset (-128) here */
+		idct_vec(v);
+		VTRANSPOSE(v[0], v[1], v[2], v[3]);
+		VTRANSPOSE(v[4], v[5], v[6], v[7]);
+		for (j = 0; j < 4; j++) VSTORE_ROW(&dst[8 * (i + j)], v[j], v[j + 4]);
+	}
+}
+
+#else
+
 static void block_idct (
 	int32_t* src,	/* Input block data (de-quantized and pre-scaled for Arai Algorithm) */
 	jd_yuv_t* dst	/* Pointer to the destination to store the block as byte array */
@@ -692,6 +881,111 @@ static void block_idct (
 	}
 }
 
+#endif
+
+
+
+/*-----------------------------------------------------------------------*/
+/* Apply Inverse-DCT and downscale the block to 4x4 or 2x2 pixels        */
+/*-----------------------------------------------------------------------*/
+/* Each output pixel is the average of 2x2 or 4x4 pixels of the full IDCT.
+/  Averaged that way, the element u and 8-u of the Arai algorithm input
+/  fold into a 4-point (or 2-point) IDCT, so no averaging pass is needed
+/  after the color conversion. The width and the height can differ, the
+/  sub-sampled C blocks are downscaled less than the Y blocks. */
+
+static void idct_scaled_1d (
+	int32_t* s,			/* Elements 0..7 of a column or row, the n outputs are stored in place */
+	unsigned int step,	/* Distance of the elements (8: column, 1: row) */
+	unsigned int n		/* Number of outputs (8, 4, 2 or 1) */
+)
+{
+	const int32_t M13 = (int32_t)(1.41421*4096), M2 = (int32_t)(1.08239*4096), M4 = (int32_t)(2.61313*4096), M5 = (int32_t)(1.84776*4096);
+	const int32_t C1 = (int32_t)(0.92388*4096), C2 = (int32_t)(0.70711*4096), C3 = (int32_t)(0.38268*4096);
+	const int32_t C4 = (int32_t)(0.65328*4096), C5 = (int32_t)(0.27060*4096);
+	int32_t v0, v1, v2, v3, v4, v5, v6, v7;
+	int32_t t10, t11, t12, t13;
+
+	switch (n) {
+	case 8:		/* Full size, the same operations as block_idct() */
+		v0 = s[step * 0]; v1 = s[step * 2]; v2 = s[step * 4]; v3 = s[step * 6];
+		t10 = v0 + v2;
+		t12 = v0 - v2;
+		t11 = (v1 - v3) * M13 >> 12;
+		v3 += v1;
+		t11 -= v3;
+		v0 = t10 + v3;
+		v3 = t10 - v3;
+		v1 = t11 + t12;
+		v2 = t12 - t11;
+		v4 = s[step * 7]; v5 = s[step * 1]; v6 = s[step * 5]; v7 = s[step * 3];
+		t10 = v5 - v4;
+		t11 = v5 + v4;
+		t12 = v6 - v7;
+		v7 += v6;
+		v5 = (t11 - v7) * M13 >> 12;
+		v7 += t11;
+		t13 = (t10 + t12) * M5 >> 12;
+		v4 = t13 - (t10 * M2 >> 12);
+		v6 = t13 - (t12 * M4 >> 12) - v7;
+		v5 -= v6;
+		v4 -= v5;
+		s[step * 0] = v0 + v7;
+		s[step * 7] = v0 - v7;
+		s[step * 1] = v1 + v6;
+		s[step * 6] = v1 - v6;
+		s[step * 2] = v2 + v5;
+		s[step * 5] = v2 - v5;
+		s[step * 3] = v3 + v4;
+		s[step * 4] = v3 - v4;
+		break;
+
+	case 4:		/* Fold the elements into a 4-point IDCT */
+		v0 = s[step * 0];
+		v1 = s[step * 1] - s[step * 7];
+		v2 = s[step * 2] - s[step * 6];
+		v3 = s[step * 3] - s[step * 5];
+		t12 = v2 * C2 >> 12;
+		t10 = v0 + t12;
+		t11 = v0 - t12;
+		t12 = (v1 * C1 + v3 * C3) >> 12;
+		t13 = (v1 * C3 - v3 * C1) >> 12;
+		s[step * 0] = t10 + t12;
+		s[step * 1] = t11 + t13;
+		s[step * 2] = t11 - t13;
+		s[step * 3] = t10 - t12;
+		break;
+
+	case 2:		/* Fold the elements into a 2-point IDCT */
+		t10 = ((s[step * 1] - s[step * 7]) * C4 - (s[step * 3] - s[step * 5]) * C5) >> 12;
+		s[step * 1] = s[step * 0] - t10;
+		s[step * 0] += t10;
+		break;
+
+	default:	/* 1 output, the DC element is the average */
+		break;
+	}
+}
+
+static void block_idct_scaled (
+	int32_t* src,		/* Input block data (de-quantized and pre-scaled for Arai Algorithm) */
+	jd_yuv_t* dst,		/* Pointer to the destination to store the nx x ny block */
+	unsigned int nx,	/* Width of the output block (8, 4, 2 or 1) */
+	unsigned int ny		/* Height of the output block (8, 4, 2 or 1) */
+)
+{
+	unsigned int i, j;
+
+	for (i = 0; i < 8; i++) {		/* Process columns */
+		idct_scaled_1d(src + i, 8, ny);
+	}
+	for (i = 0; i < ny; i++, src += 8) {	/* Process rows */
+		src[0] += 128L << 8;		/* Remove DC offset (-128) here */
+		idct_scaled_1d(src, 1, nx);
+		for (j = 0; j < nx; j++) *dst++ = YUVOUT(src[j]);
+	}
+}
+
 
 
 
@@ -705,7 +999,7 @@ static JRESULT mcu_load (
 {
 	int32_t *tmp = (int32_t*)jd->workbuf;	/* Block working buffer for de-quantize and IDCT */
 	int d, e;
-	unsigned int blk, nby, i, bc, z, id, cmp;
+	unsigned int blk, nby, i, bc, z, id, cmp, n, nx, ny;
 	jd_yuv_t *bp;
 	const int32_t *dqf;
 
@@ -759,13 +1053,24 @@ static JRESULT mcu_load (
 			} while (++z < 64);		/* Next AC element */
 
 			if (JD_FORMAT != 2 || !cmp) {	/* C components may not be processed if in grayscale output */
-				if (z == 1 || (JD_USE_SCALE && jd->scale == 3)) {	/* If no AC element or scale ratio is 1/8, IDCT can be ommited and the block is filled with DC value */
+				nx = ny = 8;
+				if (JD_USE_SCALE) {		/* Size of the downscaled block, C blocks of a sub-sampled MCU are downscaled less */
+					nx = ny = 8 >> jd->scale;
+					if (cmp) {
+						nx = (nx * jd->msx > 8) ? 8 : nx * jd->msx;
+						ny = (ny * jd->msy > 8) ? 8 : ny * jd->msy;
+					}
+				}
+				if (z == 1 || nx * ny == 1) {	/* If no AC element or the block is downscaled to a pixel, IDCT can be ommited and the block is filled with DC value */
 					d = (jd_yuv_t)((*tmp / 256) + 128);
+					n = nx * ny;
 					if (JD_FASTDECODE >= 1) {
-						for (i = 0; i < 64; bp[i++] = d) ;
+						for (i = 0; i < n; bp[i++] = d) ;
 					} else {
-						memset(bp, d, 64);
+						memset(bp, d, n);
 					}
+				} else if (nx * ny != 64) {
+					block_idct_scaled(tmp, bp, nx, ny);	/* Apply IDCT, downscale and store the block to the MCU buffer */
 				} else {
 					block_idct(tmp, bp);	/* Apply IDCT and store the block to the MCU buffer */
 				}
@@ -793,8 +1098,9 @@ static JRESULT mcu_output (
 )
 {
 	const int CVACC = (sizeof (int) > 2) ? 1024 : 128;	/* Adaptive accuracy for both 16-/32-bit systems */
-	unsigned int ix, iy, mx, my, rx, ry;
+	unsigned int ix, iy, mx, my, rx, ry, bs, cx, cy;
 	int yy, cb, cr;
+	uint8_t r, g, b;
 	jd_yuv_t *py, *pc;
 	uint8_t *pix;
 	JRECT rect;
@@ -812,139 +1118,47 @@ static JRESULT mcu_output (
 	rect.top = img_y; rect.bottom = img_y + ry - 1;
 
 
-	if (!JD_USE_SCALE || jd->scale != 3) {	/* Not for 1/8 scaling */
-		pix = (uint8_t*)jd->workbuf;
-
-		if (JD_FORMAT != 2) {	/* RGB output (build an RGB MCU from Y/C component) */
-			for (iy = 0; iy < my; iy++) {
-				pc = py = jd->mcubuf;
-				if (my == 16) {		/* Double block height? */
-					pc += 64 * 4 + (iy >> 1) * 8;
-					if (iy >= 8) py += 64;
-				} else {			/* Single block height */
-					pc += mx * 8 + iy * 8;
+	/* Build the effective pixels of the output from the Y/C blocks, which are downscaled by the IDCT to bs x bs pixels */
+	bs = 8 >> jd->scale;
+	cx = (bs == 8 && jd->msx == 2);		/* C blocks have half the resolution of the output (only at 1/1 scale) */
+	cy = (bs == 8 && jd->msy == 2);
+	pix = (uint8_t*)jd->workbuf;
+	for (iy = 0; iy < ry; iy++) {
+		py = jd->mcubuf + (iy & (bs - 1)) * bs;
+		if (iy >= bs) py += 64 * jd->msx;		/* Lower Y blocks of a double block height MCU */
+		pc = jd->mcubuf + 64 * jd->msx * jd->msy + (iy >> cy) * (bs * jd->msx >> cx);	/* Cb block, Cr block follows it */
+		for (ix = 0; ix < rx; ix++) {
+			if (ix == bs) py += 64 - bs;		/* Jump to next block if double block width */
+			yy = *py++;							/* Get Y component */
+			if (JD_FORMAT != 2) {	/* RGB output (build an RGB MCU from Y/C component) */
+				cb = pc[0] - 128; 	/* Get Cb/Cr component and remove offset */
+				cr = pc[64] - 128;
+				if (cx) {						/* Sub-sampled C block? */
+					pc += ix & 1;				/* Step forward chroma pointer every two pixels */
+				} else {						/* Same resolution as the output */
+					pc++;						/* Step forward chroma pointer every pixel */
 				}
-				py += iy * 8;
-				for (ix = 0; ix < mx; ix++) {
-					cb = pc[0] - 128; 	/* Get Cb/Cr component and remove offset */
-					cr = pc[64] - 128;
-					if (mx == 16) {					/* Double block width? */
-						if (ix == 8) py += 64 - 8;	/* Jump to next block if double block heigt */
-						pc += ix & 1;				/* Step forward chroma pointer every two pixels */
-					} else {						/* Single block width */
-						pc++;						/* Step forward chroma pointer every pixel */
-					}
-					yy = *py++;			/* Get Y component */
-					*pix++ = /*R*/ BYTECLIP(yy + ((int)(1.402 * CVACC) * cr) / CVACC);
-					*pix++ = /*G*/ BYTECLIP(yy - ((int)(0.344 * CVACC) * cb + (int)(0.714 * CVACC) * cr) / CVACC);
-					*pix++ = /*B*/ BYTECLIP(yy + ((int)(1.772 * CVACC) * cb) / CVACC);
+				r = BYTECLIP(yy + ((int)(1.402 * CVACC) * cr) / CVACC);
+				g = BYTECLIP(yy - ((int)(0.344 * CVACC) * cb + (int)(0.714 * CVACC) * cr) / CVACC);
+				b = BYTECLIP(yy + ((int)(1.772 * CVACC) * cb) / CVACC);
+				if (JD_FORMAT == 0) {
+					*pix++ = r;
+					*pix++ = g;
+					*pix++ = b;
+				} else {	/* Convert to RGB565 in the same pass */
+					*(uint16_t*)pix = (uint16_t)((r & 0xF8) << 8 | (g & 0xFC) << 3 | b >> 3);
+					pix += 2;
 				}
-			}
-		} else {	/* Monochrome output (build a grayscale MCU from Y comopnent) */
-			for (iy = 0; iy < my; iy++) {
-				py = jd->mcubuf + iy * 8;
-				if (my == 16) {		/* Double block height? */
-					if (iy >= 8) py += 64;
-				}
-				for (ix = 0; ix < mx; ix++) {
-					if (mx == 16) {					/* Double block width? */
-						if (ix == 8) py += 64 - 8;	/* Jump to next block if double block height */
-					}
-					*pix++ = (uint8_t)*py++;			/* Get and store a Y value as grayscale */
-				}
-			}
-		}
-
-		/* Descale the MCU rectangular if needed */
-		if (JD_USE_SCALE && jd->scale) {
-			unsigned int x, y, r, g, b, s, w, a;
-			uint8_t *op;
-
-			/* Get averaged RGB value of each square correcponds to a pixel */
-			s = jd->scale * 2;	/* Number of shifts for averaging */
-			w = 1 << jd->scale;	/* Width of square */
-			a = (mx - w) * (JD_FORMAT != 2 ? 3 : 1);	/* Bytes to skip for next line in the square */
-			op = (uint8_t*)jd->workbuf;
-			for (iy = 0; iy < my; iy += w) {
-				for (ix = 0; ix < mx; ix += w) {
-					pix = (uint8_t*)jd->workbuf + (iy * mx + ix) * (JD_FORMAT != 2 ? 3 : 1);
-					r = g = b = 0;
-					for (y = 0; y < w; y++) {	/* Accumulate RGB value in the square */
-						for (x = 0; x < w; x++) {
-							r += *pix++;	/* Accumulate R or Y (monochrome output) */
-							if (JD_FORMAT != 2) {	/* RGB output? */
-								g += *pix++;	/* Accumulate G */
-								b += *pix++;	/* Accumulate B */
-							}
-						}
-						pix += a;
-					}							/* Put the averaged pixel value */
-					*op++ = (uint8_t)(r >> s);	/* Put R or Y (monochrome output) */
-					if (JD_FORMAT != 2) {	/* RGB output? */
-						*op++ = (uint8_t)(g >> s);	/* Put G */
-						*op++ = (uint8_t)(b >> s);	/* Put B */
-					}
-				}
-			}
-		}
-
-	} else {	/* For only 1/8 scaling (left-top pixel in each block are the DC value of the block) */
-
-		/* Build a 1/8 descaled RGB MCU from discrete comopnents */
-		pix = (uint8_t*)jd->workbuf;
-		pc = jd->mcubuf + mx * my;
-		cb = pc[0] - 128;		/* Get Cb/Cr component and restore right level */
-		cr = pc[64] - 128;
-		for (iy = 0; iy < my; iy += 8) {
-			py = jd->mcubuf;
-			if (iy == 8) py += 64 * 2;
-			for (ix = 0; ix < mx; ix += 8) {
-				yy = *py;	/* Get Y component */
-				py += 64;
-				if (JD_FORMAT != 2) {
-					*pix++ = /*R*/ BYTECLIP(yy + ((int)(1.402 * CVACC) * cr / CVACC));
-					*pix++ = /*G*/ BYTECLIP(yy - ((int)(0.344 * CVACC) * cb + (int)(0.714 * CVACC) * cr) / CVACC);
-					*pix++ = /*B*/ BYTECLIP(yy + ((int)(1.772 * CVACC) * cb / CVACC));
+			} else {	/* Monochrome output (build a grayscale MCU from Y comopnent) */
+				if (JD_FASTDECODE >= 1) {
+					*pix++ = BYTECLIP(yy);		/* Store a Y value as grayscale */
 				} else {
-					*pix++ = yy;
+					*pix++ = (uint8_t)yy;		/* Store a Y value as grayscale */
 				}
 			}
 		}
 	}
 
-	/* Squeeze up pixel table if a part of MCU is to be truncated */
-	mx >>= jd->scale;
-	if (rx < mx) {	/* Is the MCU spans rigit edge? */
-		uint8_t *s, *d;
-		unsigned int x, y;
-
-		s = d = (uint8_t*)jd->workbuf;
-		for (y = 0; y < ry; y++) {
-			for (x = 0; x < rx; x++) {	/* Copy effective pixels */
-				*d++ = *s++;
-				if (JD_FORMAT != 2) {
-					*d++ = *s++;
-					*d++ = *s++;
-				}
-			}
-			s += (mx - rx) * (JD_FORMAT != 2 ? 3 : 1);	/* Skip truncated pixels */
-		}
-	}
-
-	/* Convert RGB888 to RGB565 if needed */
-	if (JD_FORMAT == 1) {
-		uint8_t *s = (uint8_t*)jd->workbuf;
-		uint16_t w, *d = (uint16_t*)s;
-		unsigned int n = rx * ry;
-
-		do {
-			w = (*s++ & 0xF8) << 8;		/* RRRRR----------- */
-			w |= (*s++ & 0xFC) << 3;	/* -----GGGGGG----- */
-			w |= *s++ >> 3;				/* -----------BBBBB */
-			*d++ = w;
-		} while (--n);
-	}
-
 	/* Output the rectangular */
 	return outfunc(jd, jd->workbuf, &rect) ? JDR_OK : JDR_INTR;
 }
@@ -1112,41 +1326,69 @@ JRESULT jd_prepare (
 
 
 /*-----------------------------------------------------------------------*/
-/* Start to decompress the JPEG picture                                  */
+/* Decompress one MCU row of the JPEG picture                            */
 /*-----------------------------------------------------------------------*/
 
-JRESULT jd_decomp (
+JRESULT jd_decomp_row (
 	JDEC* jd,								/* Initialized decompression object */
 	int (*outfunc)(JDEC*, void*, JRECT*),	/* RGB output function */
-	uint8_t scale							/* Output de-scaling factor (0 to 3) */
+	uint8_t scale,							/* Output de-scaling factor (0 to 3) */
+	uint16_t y								/* Top of the MCU row (pixel). 0 starts a new decompression. */
 )
 {
-	unsigned int x, y, mx, my;
-	uint16_t rst, rsc;
+	unsigned int x, mx;
 	JRESULT rc;
 
 
 	if (scale > (JD_USE_SCALE ? 3 : 0)) return JDR_PAR;
+	if (y >= jd->height || y % (jd->msy * 8)) return JDR_PAR;
 	jd->scale = scale;
 
-	mx = jd->msx * 8; my = jd->msy * 8;			/* Size of the MCU (pixel) */
+	mx = jd->msx * 8;							/* Width of the MCU (pixel) */
 
-	jd->dcv[2] = jd->dcv[1] = jd->dcv[0] = 0;	/* Initialize DC values */
-	rst = rsc = 0;
+	if (y == 0) {
+		jd->dcv[2] = jd->dcv[1] = jd->dcv[0] = 0;	/* Initialize DC values */
+		jd->rst = jd->rsc = 0;
+	}
 
 	rc = JDR_OK;
-	for (y = 0; y < jd->height; y += my) {		/* Vertical loop of MCUs */
-		for (x = 0; x < jd->width; x += mx) {	/* Horizontal loop of MCUs */
-			if (jd->nrst && rst++ == jd->nrst) {	/* Process restart interval if enabled */
-				rc = restart(jd, rsc++);
-				if (rc != JDR_OK) return rc;
-				rst = 1;
-			}
-			rc = mcu_load(jd);					/* Load an MCU (decompress huffman coded stream, dequantize and apply IDCT) */
-			if (rc != JDR_OK) return rc;
-			rc = mcu_output(jd, outfunc, x, y);	/* Output the MCU (YCbCr to RGB, scaling and output) */
+	for (x = 0; x < jd->width; x += mx) {		/* Horizontal loop of MCUs */
+		if (jd->nrst && jd->rst++ == jd->nrst) {	/* Process restart interval if enabled */
+			rc = restart(jd, jd->rsc++);
 			if (rc != JDR_OK) return rc;
+			jd->rst = 1;
 		}
+		rc = mcu_load(jd);						/* Load an MCU (decompress huffman coded stream, dequantize and apply IDCT) */
+		if (rc != JDR_OK) return rc;
+		rc = mcu_output(jd, outfunc, x, y);		/* Output the MCU (YCbCr to RGB, scaling and output) */
+		if (rc != JDR_OK) return rc;
+	}
+
+	return rc;
+}
+
+
+
+/*-----------------------------------------------------------------------*/
+/* Start to decompress the JPEG picture                                  */
+/*-----------------------------------------------------------------------*/
+
+JRESULT jd_decomp (
+	JDEC* jd,								/* Initialized decompression object */
+	int (*outfunc)(JDEC*, void*, JRECT*),	/* RGB output function */
+	uint8_t scale							/* Output de-scaling factor (0 to 3) */
+)
+{
+	unsigned int y, my;
+	JRESULT rc;
+
+
+	my = jd->msy * 8;							/* Height of the MCU (pixel) */
+
+	rc = JDR_OK;
+	for (y = 0; y < jd->height; y += my) {		/* Vertical loop of MCUs */
+		rc = jd_decomp_row(jd, outfunc, scale, (uint16_t)y);
+		if (rc != JDR_OK) return rc;
 	}
 
 	return rc;
@@ -62,6 +62,16 @@ static void set_px_cb_alpha8(lv_disp_drv_t * disp_drv, uint8_t * buf, lv_coord_t
 
 static void set_px_alpha_generic(lv_img_dsc_t * d, lv_coord_t x, lv_coord_t y, lv_color_t color, lv_opa_t opa);
 
+static void set_px_cb_indexed4(lv_disp_drv_t * disp_drv, uint8_t * buf, lv_coord_t buf_w, lv_coord_t x, lv_coord_t y,
+                               lv_color_t color, lv_opa_t opa);
+
+static void set_px_cb_indexed8(lv_disp_drv_t * disp_drv, uint8_t * buf, lv_coord_t buf_w, lv_coord_t x, lv_coord_t y,
+                               lv_color_t color, lv_opa_t opa);
+
+static inline uint32_t palette_bucket(lv_color_t color);
+static inline uint8_t palette_find(const lv_disp_palette_t * pal, lv_color_t color);
+static bool color_is_gray(lv_color_t color);
+
 /**********************
  *  STATIC VARIABLES
  **********************/
@@ -186,6 +196,13 @@ lv_disp_t * lv_disp_drv_register(lv_disp_drv_t * driver)
 
     disp->inv_en_cnt = 1;
 
+    /*No area is scrolled by the display yet*/
+    lv_area_set(&disp->hw_scroll_area, 0, 0, -1, -1);
+
+#if LV_DISP_PACING_MIN_PERIOD
+    disp->pacing.fps_start = lv_tick_get();
+#endif
+
     _lv_ll_init(&disp->sync_areas, sizeof(lv_area_t));
 
     lv_disp_t * disp_def_tmp = disp_def;
@@ -556,6 +573,34 @@ lv_disp_draw_buf_t * lv_disp_get_draw_buf(lv_disp_t * disp)
     return disp->driver->draw_buf;
 }
 
+#if LV_DISP_PACING_MIN_PERIOD
+/**
+ * Get the statistics of the refreshes of a display
+ * @param disp pointer to a display (NULL to use the default display)
+ * @return pointer to the statistics or NULL if there is no display
+ */
+const lv_disp_pacing_t * lv_disp_get_pacing(lv_disp_t * disp)
+{
+    if(disp == NULL) disp = lv_disp_get_default();
+    if(disp == NULL) return NULL;
+
+    return &disp->pacing;
+}
+
+/**
+ * Clear the statistics of the refreshes of a display
+ * @param disp pointer to a display (NULL to use the default display)
+ */
+void lv_disp_reset_pacing(lv_disp_t * disp)
+{
+    if(disp == NULL) disp = lv_disp_get_default();
+    if(disp == NULL) return;
+
+    lv_memset_00(&disp->pacing, sizeof(disp->pacing));
+    disp->pacing.fps_start = lv_tick_get();
+}
+#endif
+
 /**
  * Set the rotation of this display.
  * @param disp pointer to a display (NULL to use the default display)
@@ -600,11 +645,123 @@ void lv_disp_drv_use_generic_set_px_cb(lv_disp_drv_t * disp_drv, lv_img_cf_t cf)
         case LV_IMG_CF_ALPHA_8BIT:
             disp_drv->set_px_cb = set_px_cb_alpha8;
             break;
+        case LV_IMG_CF_INDEXED_4BIT:
+            disp_drv->set_px_cb = set_px_cb_indexed4;
+            break;
+        case LV_IMG_CF_INDEXED_8BIT:
+            disp_drv->set_px_cb = set_px_cb_indexed8;
+            break;
         default:
             disp_drv->set_px_cb = NULL;
     }
 }
 
+void lv_disp_palette_init(lv_disp_palette_t * pal, lv_img_cf_t cf, const lv_color_t * colors, uint32_t cnt)
+{
+    LV_ASSERT_NULL(pal);
+    LV_ASSERT(cf == LV_IMG_CF_INDEXED_4BIT || cf == LV_IMG_CF_INDEXED_8BIT);
+
+    lv_memset_00(pal, sizeof(lv_disp_palette_t));
+    pal->cf = cf;
+    pal->size = cf == LV_IMG_CF_INDEXED_4BIT ? 16 : 256;
+    if(cnt > pal->size) cnt = pal->size;
+
+    uint32_t i;
+    uint32_t chroma_cnt = 0;
+    for(i = 0; i < cnt; i++) {
+        pal->colors[i] = colors[i];
+        if(!color_is_gray(colors[i])) chroma_cnt++;
+    }
+
+    /*Give the shades of the not gray colors 3/4 of the free entries, alternately towards white and black.
+     *The gray colors and the rest are covered by the gray ramp.*/
+    uint32_t idx = cnt;
+    uint32_t free_cnt = pal->size - cnt;
+    uint32_t shade_cnt = chroma_cnt ? (free_cnt - free_cnt / 4) / chroma_cnt : 0;
+    uint32_t step_cnt = (shade_cnt + 1) / 2 + 1;
+    for(i = 0; i < cnt; i++) {
+        if(color_is_gray(colors[i])) continue;
+
+        uint32_t s;
+        for(s = 0; s < shade_cnt; s++) {
+            lv_color_t to = (s & 0x1) ? lv_color_black() : lv_color_white();
+            lv_opa_t mix = (LV_OPA_COVER * (s / 2 + 1)) / step_cnt;
+            pal->colors[idx++] = lv_color_mix(to, colors[i], mix);
+        }
+    }
+
+    uint32_t gray_cnt = pal->size - idx;
+    for(i = 0; i < gray_cnt; i++) {
+        uint8_t v = gray_cnt == 1 ? 128 : (255 * i) / (gray_cnt - 1);
+        pal->colors[idx++] = lv_color_make(v, v, v);
+    }
+
+    /*Map every RGB444 color to the nearest color of the palette*/
+    lv_color32_t * pal32 = lv_mem_buf_get(pal->size * sizeof(lv_color32_t));
+    LV_ASSERT_MALLOC(pal32);
+    if(pal32 == NULL) return;
+    for(i = 0; i < pal->size; i++) pal32[i].full = lv_color_to32(pal->colors[i]);
+
+    uint32_t q;
+    for(q = 0; q < LV_DISP_PALETTE_QUANT_SIZE; q++) {
+        int32_t r = ((q >> 8) & 0xF) * 17;
+        int32_t g = ((q >> 4) & 0xF) * 17;
+        int32_t b = (q & 0xF) * 17;
+        uint32_t dist_min = UINT32_MAX;
+        for(i = 0; i < pal->size; i++) {
+            int32_t dr = r - pal32[i].ch.red;
+            int32_t dg = g - pal32[i].ch.green;
+            int32_t db = b - pal32[i].ch.blue;
+            /*The eye is the most sensitive to green and the least to red*/
+            uint32_t dist = 2 * dr * dr + 4 * dg * dg + 3 * db * db;
+            if(dist < dist_min) {
+                dist_min = dist;
+                pal->quant[q] = i;
+            }
+        }
+    }
+
+    lv_mem_buf_release(pal32);
+
+    /*The given colors are mapped to themselves. The first one wins if they are very close.*/
+    for(i = cnt; i > 0; i--) {
+        pal->quant[palette_bucket(colors[i - 1])] = i - 1;
+    }
+}
+
+uint8_t lv_disp_palette_find(const lv_disp_palette_t * pal, lv_color_t color)
+{
+    LV_ASSERT_NULL(pal);
+    return palette_find(pal, color);
+}
+
+void lv_disp_palette_expand(const lv_disp_palette_t * pal, lv_color_t * dest, const uint8_t * buf, lv_coord_t buf_w,
+                            const lv_area_t * area)
+{
+    LV_ASSERT_NULL(pal);
+
+    lv_coord_t x;
+    lv_coord_t y;
+    if(pal->cf == LV_IMG_CF_INDEXED_8BIT) {
+        for(y = area->y1; y <= area->y2; y++) {
+            const uint8_t * row = buf + (uint32_t)buf_w * y;
+            for(x = area->x1; x <= area->x2; x++) {
+                *dest++ = pal->colors[row[x]];
+            }
+        }
+    }
+    else {
+        uint32_t stride = (buf_w + 1) >> 1;
+        for(y = area->y1; y <= area->y2; y++) {
+            const uint8_t * row = buf + stride * y;
+            for(x = area->x1; x <= area->x2; x++) {
+                uint8_t px = row[x >> 1];
+                *dest++ = pal->colors[(x & 0x1) ? (px & 0xF) : (px >> 4)];
+            }
+        }
+    }
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -686,6 +843,54 @@ static void set_px_alpha_generic(lv_img_dsc_t * d, lv_coord_t x, lv_coord_t y, l
     lv_img_buf_set_px_alpha(d, x, y, br);
 }
 
+static void set_px_cb_indexed4(lv_disp_drv_t * disp_drv, uint8_t * buf, lv_coord_t buf_w, lv_coord_t x, lv_coord_t y,
+                               lv_color_t color, lv_opa_t opa)
+{
+    if(opa <= LV_OPA_MIN) return;
+
+    const lv_disp_palette_t * pal = disp_drv->palette;
+    uint8_t * px = buf + ((uint32_t)(buf_w + 1) >> 1) * y + (x >> 1);
+    uint8_t shift = (x & 0x1) ? 0 : 4;
+    if(opa < LV_OPA_MAX) color = lv_color_mix(color, pal->colors[(*px >> shift) & 0xF], opa);
+
+    *px = (*px & ~(0xF << shift)) | (palette_find(pal, color) << shift);
+}
+
+static void set_px_cb_indexed8(lv_disp_drv_t * disp_drv, uint8_t * buf, lv_coord_t buf_w, lv_coord_t x, lv_coord_t y,
+                               lv_color_t color, lv_opa_t opa)
+{
+    if(opa <= LV_OPA_MIN) return;
+
+    const lv_disp_palette_t * pal = disp_drv->palette;
+    uint8_t * px = buf + (uint32_t)buf_w * y + x;
+    if(opa < LV_OPA_MAX) color = lv_color_mix(color, pal->colors[*px], opa);
+
+    *px = palette_find(pal, color);
+}
+
+/*Index of a color in the RGB444 table of the palettes*/
+static inline uint32_t palette_bucket(lv_color_t color)
+{
+    lv_color32_t c32;
+    c32.full = lv_color_to32(color);
+    return ((c32.ch.red & 0xF0) << 4) | (c32.ch.green & 0xF0) | (c32.ch.blue >> 4);
+}
+
+static inline uint8_t palette_find(const lv_disp_palette_t * pal, lv_color_t color)
+{
+    return pal->quant[palette_bucket(color)];
+}
+
+static bool color_is_gray(lv_color_t color)
+{
+    /*Allow the rounding of RGB565 where red and blue have one bit less than green*/
+    lv_color32_t c32;
+    c32.full = lv_color_to32(color);
+    uint8_t max = LV_MAX3(c32.ch.red, c32.ch.green, c32.ch.blue);
+    uint8_t min = LV_MIN3(c32.ch.red, c32.ch.green, c32.ch.blue);
+    return max - min <= 8;
+}
+
 static void set_px_true_color_alpha(lv_disp_drv_t * disp_drv, uint8_t * buf, lv_coord_t buf_w,
                                     lv_coord_t x, lv_coord_t y,
                                     lv_color_t color, lv_opa_t opa)
@@ -32,10 +32,18 @@ extern "C" {
 #define LV_INV_BUF_SIZE 32 /*Buffer size for invalid areas*/
 #endif
 
+#ifndef LV_INV_MERGE_BUF_SIZE
+#define LV_INV_MERGE_BUF_SIZE 16 /*Number of objects whose invalid areas are merged until the next refresh*/
+#endif
+
 #ifndef LV_ATTRIBUTE_FLUSH_READY
 #define LV_ATTRIBUTE_FLUSH_READY
 #endif
 
+#define LV_DISP_PACING_HIST_CNT 8 /*Number of ranges in the histogram of the refresh times*/
+
+#define LV_DISP_PALETTE_QUANT_SIZE 4096 /*Entries of the color -> index table of a palette (4 bits per channel)*/
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -70,6 +78,18 @@ typedef enum {
     LV_DISP_ROT_270
 } lv_disp_rot_t;
 
+/**
+ * Palette of an indexed draw buffer. (see `lv_disp_palette_init()`)
+ * The draw buffer stores a 4 or 8 bit index per pixel and `flush_cb` expands the indices
+ * to colors with `lv_disp_palette_expand()`.
+ */
+typedef struct {
+    lv_color_t colors[256];     /**< Color of each index*/
+    uint8_t quant[LV_DISP_PALETTE_QUANT_SIZE]; /**< Index of the nearest color of every RGB444 color*/
+    uint16_t size;              /**< Number of colors: 16 or 256*/
+    lv_img_cf_t cf;             /**< `LV_IMG_CF_INDEXED_4BIT` or `LV_IMG_CF_INDEXED_8BIT`*/
+} lv_disp_palette_t;
+
 /**
  * Display Driver structure to be registered by HAL.
  * Only its pointer will be saved in `lv_disp_t` so it should be declared as
@@ -116,6 +136,10 @@ typedef struct _lv_disp_drv_t {
     void (*set_px_cb)(struct _lv_disp_drv_t * disp_drv, uint8_t * buf, lv_coord_t buf_w, lv_coord_t x, lv_coord_t y,
                       lv_color_t color, lv_opa_t opa);
 
+    /** OPTIONAL: Palette of the indexed draw buffer used by the generic indexed `set_px_cb`.
+     * (see `lv_disp_drv_use_generic_set_px_cb()`)*/
+    const lv_disp_palette_t * palette;
+
     void (*clear_cb)(struct _lv_disp_drv_t * disp_drv, uint8_t * buf, uint32_t size);
 
 
@@ -137,6 +161,15 @@ typedef struct _lv_disp_drv_t {
     /** OPTIONAL: called when start rendering */
     void (*render_start_cb)(struct _lv_disp_drv_t * disp_drv);
 
+    /** OPTIONAL: Move the content of a full width area `dy` rows down (negative: up) on the display,
+     * e.g. with the vertical scrolling of the display controller. Then only the uncovered rows are redrawn.
+     * Return `false` if the area can't be scrolled, it's redrawn then. See `LV_OBJ_FLAG_HW_SCROLL`*/
+    bool (*hw_scroll_cb)(struct _lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_coord_t dy);
+
+    /** OPTIONAL: Called before the first area of a refresh is flushed. Wait here for the start of a new frame
+     * of the display (e.g. the TE signal of the display controller) to update the display without tearing*/
+    void (*vsync_wait_cb)(struct _lv_disp_drv_t * disp_drv);
+
     /** On CHROMA_KEYED images this color will be transparent.
      * `LV_COLOR_CHROMA_KEY` by default. (lv_conf.h)*/
     lv_color_t color_chroma_key;
@@ -152,6 +185,28 @@ typedef struct _lv_disp_drv_t {
 
 } lv_disp_drv_t;
 
+#if LV_DISP_PACING_MIN_PERIOD
+/**
+ * Statistics of the refreshes of a display. (see `LV_DISP_PACING_MIN_PERIOD`)
+ * The times are measured from the start of the refresh to the end of the last flush,
+ * without the time spent in `vsync_wait_cb`.
+ */
+typedef struct {
+    uint32_t frame_cnt;         /**< Number of refreshes which drew something*/
+    uint32_t missed_cnt;        /**< Number of refreshes which took longer than the refresh period*/
+    uint32_t time_hist[LV_DISP_PACING_HIST_CNT]; /**< Number of refreshes by time: 0..1, 2..3, 4..7, 8..15 ms etc.
+                                                      The last one counts the longer refreshes too*/
+    uint32_t time_max;          /**< The longest refresh [ms]*/
+    uint16_t time_avg;          /**< Average time of the recent refreshes [ms]*/
+    uint16_t fps;               /**< Refreshes which drew something in the last second*/
+
+    /*Internal, used by the library*/
+    uint32_t time_avg_x16;
+    uint32_t fps_start;
+    uint16_t fps_cnt;
+} lv_disp_pacing_t;
+#endif
+
 /**
  * Display structure.
  * @note `lv_disp_drv_t` should be the first member of the structure.
@@ -188,6 +243,20 @@ typedef struct _lv_disp_t {
     uint16_t inv_p;
     int32_t inv_en_cnt;
 
+    /** Invalidated areas of objects merged per object until the next refresh. (see `_lv_inv_obj_area`)*/
+    lv_area_t inv_merge_areas[LV_INV_MERGE_BUF_SIZE];
+    const void * inv_merge_keys[LV_INV_MERGE_BUF_SIZE];
+    uint8_t inv_merge_cnt;
+
+    /** Area moved by `hw_scroll_cb` and its scroll to apply at the next refresh. (see `_lv_refr_hw_scroll`)*/
+    lv_area_t hw_scroll_area;
+    lv_coord_t hw_scroll_dy;
+    uint8_t hw_scroll_new : 1;      /**< 1: The area has changed since the last call of `hw_scroll_cb`*/
+
+#if LV_DISP_PACING_MIN_PERIOD
+    lv_disp_pacing_t pacing;        /**< Statistics of the refreshes used to adapt the refresh period*/
+#endif
+
     /** Double buffer sync areas */
     lv_ll_t sync_areas;
 
@@ -360,8 +429,60 @@ lv_disp_t * lv_disp_get_next(lv_disp_t * disp);
  */
 lv_disp_draw_buf_t * lv_disp_get_draw_buf(lv_disp_t * disp);
 
+#if LV_DISP_PACING_MIN_PERIOD
+/**
+ * Get the statistics of the refreshes of a display
+ * @param disp pointer to a display (NULL to use the default display)
+ * @return pointer to the statistics or NULL if there is no display
+ */
+const lv_disp_pacing_t * lv_disp_get_pacing(lv_disp_t * disp);
+
+/**
+ * Clear the statistics of the refreshes of a display
+ * @param disp pointer to a display (NULL to use the default display)
+ */
+void lv_disp_reset_pacing(lv_disp_t * disp);
+#endif
+
+/**
+ * Use a built-in `set_px_cb` to draw into a buffer of the given color format.
+ * With `LV_IMG_CF_INDEXED_4/8BIT` the colors are stored as the indices of `disp_drv->palette`.
+ * @param disp_drv  pointer to a display driver
+ * @param cf        color format of the draw buffer
+ */
 void lv_disp_drv_use_generic_set_px_cb(lv_disp_drv_t * disp_drv, lv_img_cf_t cf);
 
+/**
+ * Initialize a palette for an indexed draw buffer.
+ * The given colors are added first and mapped exactly, e.g. the colors of the theme.
+ * The rest of the palette is filled with lighter and darker shades of the colors and a gray ramp
+ * for the anti-aliased edges and the semi-transparent parts.
+ * @param pal       pointer to a palette to initialize
+ * @param cf        `LV_IMG_CF_INDEXED_4BIT` (16 colors) or `LV_IMG_CF_INDEXED_8BIT` (256 colors)
+ * @param colors    the colors to add
+ * @param cnt       number of colors
+ */
+void lv_disp_palette_init(lv_disp_palette_t * pal, lv_img_cf_t cf, const lv_color_t * colors, uint32_t cnt);
+
+/**
+ * Get the index of the color of a palette nearest to a color
+ * @param pal       pointer to a palette
+ * @param color     a color
+ * @return          index of the nearest color
+ */
+uint8_t lv_disp_palette_find(const lv_disp_palette_t * pal, lv_color_t color);
+
+/**
+ * Convert the indices of an area of an indexed buffer to colors
+ * @param pal       pointer to the palette of the buffer
+ * @param dest      store the `lv_area_get_size(area)` colors here
+ * @param buf       pointer to an indexed buffer
+ * @param buf_w     width of the buffer in pixels. Its rows start at whole bytes.
+ * @param area      the area to convert, relative to the buffer
+ */
+void lv_disp_palette_expand(const lv_disp_palette_t * pal, lv_color_t * dest, const uint8_t * buf, lv_coord_t buf_w,
+                            const lv_area_t * area);
+
 /**********************
  *      MACROS
  **********************/
@@ -220,6 +220,17 @@
     #endif
 #endif
 
+/*Adapt the period of the display refresh timer to the time taken by the refreshes.
+ *It's kept between this and `LV_DISP_DEF_REFR_PERIOD` and the statistics of the refresh times
+ *are collected (see `lv_disp_get_pacing()`). 0 to keep the period fixed.*/
+#ifndef LV_DISP_PACING_MIN_PERIOD
+    #ifdef CONFIG_LV_DISP_PACING_MIN_PERIOD
+        #define LV_DISP_PACING_MIN_PERIOD CONFIG_LV_DISP_PACING_MIN_PERIOD
+    #else
+        #define LV_DISP_PACING_MIN_PERIOD 0    /*[ms]*/
+    #endif
+#endif
+
 /*Input device read period in milliseconds*/
 #ifndef LV_INDEV_DEF_READ_PERIOD
     #ifdef CONFIG_LV_INDEV_DEF_READ_PERIOD
@@ -343,6 +354,19 @@
     #endif
 #endif
 
+/*Byte budget of the buffers of the objects with `LV_OBJ_FLAG_CACHED_LAYER`.
+ *These objects are rendered with their children once and redrawn by copying the buffer
+ *until something inside them is invalidated.
+ *If the budget is used up the objects are drawn normally. 0 to ignore the flag.
+ *With `LV_COLOR_SCREEN_TRANSP 0` only the objects which fully cover their area (e.g. no radius) are cached.*/
+#ifndef LV_LAYER_CACHE_MAX_SIZE
+    #ifdef CONFIG_LV_LAYER_CACHE_MAX_SIZE
+        #define LV_LAYER_CACHE_MAX_SIZE CONFIG_LV_LAYER_CACHE_MAX_SIZE
+    #else
+        #define LV_LAYER_CACHE_MAX_SIZE 0
+    #endif
+#endif
+
 /*Default image cache size. Image caching keeps the images opened.
  *If only the built-in image formats are used there is no real advantage of caching. (I.e. if no new image decoder is added)
  *With complex image decoders (e.g. PNG or JPG) caching can save the continuous open/decode of images.
@@ -355,6 +379,20 @@
         #define LV_IMG_CACHE_DEF_SIZE 0
     #endif
 #endif
+#if LV_IMG_CACHE_DEF_SIZE
+    /*Byte budget for keeping images fully decoded in the cache.
+     *Images which can be read only line-by-line (e.g. from files) are decoded once into a buffer
+     *if they fit into a quarter of this budget. Drawing them again doesn't call the decoder at all.
+     *The buffers can be placed into an external RAM with `lv_img_cache_set_decoded_alloc_cb()`.
+     *0: keep only the opened images*/
+    #ifndef LV_IMG_CACHE_DECODED_SIZE
+        #ifdef CONFIG_LV_IMG_CACHE_DECODED_SIZE
+            #define LV_IMG_CACHE_DECODED_SIZE CONFIG_LV_IMG_CACHE_DECODED_SIZE
+        #else
+            #define LV_IMG_CACHE_DECODED_SIZE 0
+        #endif
+    #endif
+#endif
 
 /*Number of stops allowed per gradient. Increase this to allow more stops.
  *This adds (sizeof(lv_color_t) + 1) bytes per additional stop*/
@@ -20,25 +20,70 @@
  *********************/
 #define LV_ANIM_RESOLUTION 1024
 #define LV_ANIM_RES_SHIFT 10
+#define LV_ANIM_CHUNK_SIZE 8    /*Number of animation slots allocated at once*/
+
+#define anim_pool LV_GC_ROOT(_lv_anim_pool)
 
 /**********************
  *      TYPEDEFS
  **********************/
+typedef struct _lv_anim_chunk_t {
+    struct _lv_anim_chunk_t * next;
+    lv_anim_t slots[LV_ANIM_CHUNK_SIZE];
+} lv_anim_chunk_t;
+
+/*The built-in paths which are evaluated in batches. The others are called one by one.*/
+enum {
+    ANIM_PATH_CUSTOM = 0,
+    ANIM_PATH_LINEAR,
+    ANIM_PATH_EASE_IN,
+    ANIM_PATH_EASE_OUT,
+    ANIM_PATH_EASE_IN_OUT,
+    ANIM_PATH_OVERSHOOT,
+    _ANIM_PATH_NUM
+};
+
+typedef struct {
+    lv_anim_path_cb_t path_cb;
+    uint16_t p1;    /*Control points of the bezier curve*/
+    uint16_t p2;
+} anim_path_dsc_t;
 
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 static void anim_timer(lv_timer_t * param);
+static uint32_t anim_prepare(uint32_t elaps, uint32_t path_cnt[]);
+static void anim_eval(uint32_t cnt, const uint32_t path_cnt[]);
+static void anim_apply(uint32_t cnt);
 static void anim_mark_list_change(void);
 static void anim_ready_handler(lv_anim_t * a);
+static lv_anim_t * anim_slot_alloc(void);
+static void anim_slot_free(lv_anim_t * a);
+static void anim_unlink(lv_anim_t * a);
+static bool anim_reserve(void);
+static void anim_compact(void);
+static uint8_t anim_path_get_type(lv_anim_path_cb_t path_cb);
+static inline int32_t anim_path_step(uint8_t path, int32_t act_time, int32_t time);
+static inline int32_t anim_path_value(const lv_anim_t * a, int32_t step);
 
 /**********************
  *  STATIC VARIABLES
  **********************/
 static uint32_t last_timer_run;
-static bool anim_list_changed;
-static bool anim_run_round;
 static lv_timer_t * _lv_anim_tmr;
+static bool anim_timer_running;
+static bool anim_exec_active;
+static uint32_t anim_iter_lock;     /*`act_...` is being iterated, don't reorder it*/
+
+static const anim_path_dsc_t anim_paths[_ANIM_PATH_NUM] = {
+    {NULL, 0, 0},
+    {lv_anim_path_linear, 0, 0},
+    {lv_anim_path_ease_in, 50, 100},
+    {lv_anim_path_ease_out, 900, 950},
+    {lv_anim_path_ease_in_out, 50, 952},
+    {lv_anim_path_overshoot, 1000, 1300},
+};
 
 /**********************
  *      MACROS
@@ -56,10 +101,9 @@ static lv_timer_t * _lv_anim_tmr;
 
 void _lv_anim_core_init(void)
 {
-    _lv_ll_init(&LV_GC_ROOT(_lv_anim_ll), sizeof(lv_anim_t));
+    lv_memset_00(&anim_pool, sizeof(anim_pool));
     _lv_anim_tmr = lv_timer_create(anim_timer, LV_DISP_DEF_REFR_PERIOD, NULL);
     anim_mark_list_change(); /*Turn off the animation timer*/
-    anim_list_changed = false;
 }
 
 void lv_anim_init(lv_anim_t * a)
@@ -77,23 +121,35 @@ lv_anim_t * lv_anim_start(const lv_anim_t * a)
 {
     TRACE_ANIM("begin");
 
+    /*`a` might be a running animation deleted below (e.g. restarted from its `ready_cb`) so save it*/
+    lv_anim_t a_tmp;
+    lv_memcpy(&a_tmp, a, sizeof(lv_anim_t));
+
     /*Do not let two animations for the same 'var' with the same 'exec_cb'*/
-    if(a->exec_cb != NULL) lv_anim_del(a->var, a->exec_cb); /*exec_cb == NULL would delete all animations of var*/
+    if(a_tmp.exec_cb != NULL) lv_anim_del(a_tmp.var, a_tmp.exec_cb); /*exec_cb == NULL would delete all animations of var*/
 
-    /*If the list is empty the anim timer was suspended and it's last run measure is invalid*/
-    if(_lv_ll_is_empty(&LV_GC_ROOT(_lv_anim_ll))) {
+    /*If there are no animations the anim timer was suspended and it's last run measure is invalid*/
+    if(anim_pool.run_cnt == 0) {
         last_timer_run = lv_tick_get();
     }
 
-    /*Add the new animation to the animation linked list*/
-    lv_anim_t * new_anim = _lv_ll_ins_head(&LV_GC_ROOT(_lv_anim_ll));
-    LV_ASSERT_MALLOC(new_anim);
+    /*Get a slot for the new animation and add it to the running ones*/
+    if(!anim_reserve()) return NULL;
+    lv_anim_t * new_anim = anim_slot_alloc();
     if(new_anim == NULL) return NULL;
 
     /*Initialize the animation descriptor*/
-    lv_memcpy(new_anim, a, sizeof(lv_anim_t));
-    if(a->var == a) new_anim->var = new_anim;
-    new_anim->run_round = anim_run_round;
+    lv_memcpy(new_anim, &a_tmp, sizeof(lv_anim_t));
+    if(a_tmp.var == a) new_anim->var = new_anim;
+
+    anim_pool.last_id++;
+    if(anim_pool.last_id == 0) anim_pool.last_id = 1;   /*0 means not running*/
+    new_anim->run_id = anim_pool.last_id;
+
+    anim_pool.act_anim[anim_pool.act_cnt] = new_anim;
+    anim_pool.act_id[anim_pool.act_cnt] = new_anim->run_id;
+    anim_pool.act_cnt++;
+    anim_pool.run_cnt++;
 
     /*Set the start value*/
     if(new_anim->early_apply) {
@@ -106,8 +162,7 @@ lv_anim_t * lv_anim_start(const lv_anim_t * a)
         if(new_anim->exec_cb && new_anim->var) new_anim->exec_cb(new_anim->var, new_anim->start_value);
     }
 
-    /*Creating an animation changed the linked list.
-     *It's important if it happens in a ready callback. (see `anim_timer`)*/
+    /*Resume the animation timer if it was paused*/
     anim_mark_list_change();
 
     TRACE_ANIM("finished");
@@ -137,39 +192,49 @@ uint32_t lv_anim_get_playtime(lv_anim_t * a)
 
 bool lv_anim_del(void * var, lv_anim_exec_xcb_t exec_cb)
 {
-    lv_anim_t * a;
-    lv_anim_t * a_next;
     bool del = false;
-    a        = _lv_ll_get_head(&LV_GC_ROOT(_lv_anim_ll));
-    while(a != NULL) {
-        /*'a' might be deleted, so get the next object while 'a' is valid*/
-        a_next = _lv_ll_get_next(&LV_GC_ROOT(_lv_anim_ll), a);
+
+    /*Newest first. Animations started by `deleted_cb` are added to the end so they are not checked*/
+    anim_iter_lock++;
+    uint32_t i;
+    for(i = anim_pool.act_cnt; i > 0; i--) {
+        lv_anim_t * a = anim_pool.act_anim[i - 1];
+        if(anim_pool.act_id[i - 1] != a->run_id) continue;  /*Already deleted*/
 
         if((a->var == var || var == NULL) && (a->exec_cb == exec_cb || exec_cb == NULL)) {
-            _lv_ll_remove(&LV_GC_ROOT(_lv_anim_ll), a);
+            anim_unlink(a);
+            anim_mark_list_change();
             if(a->deleted_cb != NULL) a->deleted_cb(a);
-            lv_mem_free(a);
-            anim_mark_list_change(); /*Read by `anim_timer`. It need to know if a delete occurred in
-                                       the linked list*/
+            anim_slot_free(a);
             del = true;
         }
-
-        a = a_next;
     }
+    anim_iter_lock--;
 
     return del;
 }
 
 void lv_anim_del_all(void)
 {
-    _lv_ll_clear(&LV_GC_ROOT(_lv_anim_ll));
+    uint32_t i;
+    for(i = 0; i < anim_pool.act_cnt; i++) {
+        lv_anim_t * a = anim_pool.act_anim[i];
+        if(anim_pool.act_id[i] != a->run_id) continue;
+        anim_slot_free(a);
+    }
+
+    anim_pool.run_cnt = 0;
+    anim_compact();
     anim_mark_list_change();
 }
 
 lv_anim_t * lv_anim_get(void * var, lv_anim_exec_xcb_t exec_cb)
 {
-    lv_anim_t * a;
-    _LV_LL_READ(&LV_GC_ROOT(_lv_anim_ll), a) {
+    uint32_t i;
+    for(i = anim_pool.act_cnt; i > 0; i--) {
+        lv_anim_t * a = anim_pool.act_anim[i - 1];
+        if(anim_pool.act_id[i - 1] != a->run_id) continue;
+
         if(a->var == var && (a->exec_cb == exec_cb || exec_cb == NULL)) {
             return a;
         }
@@ -185,11 +250,7 @@ struct _lv_timer_t * lv_anim_get_timer(void)
 
 uint16_t lv_anim_count_running(void)
 {
-    uint16_t cnt = 0;
-    lv_anim_t * a;
-    _LV_LL_READ(&LV_GC_ROOT(_lv_anim_ll), a) cnt++;
-
-    return cnt;
+    return (uint16_t)anim_pool.run_cnt;
 }
 
 uint32_t lv_anim_speed_to_time(uint32_t speed, int32_t start, int32_t end)
@@ -204,6 +265,11 @@ uint32_t lv_anim_speed_to_time(uint32_t speed, int32_t start, int32_t end)
     return time;
 }
 
+bool _lv_anim_exec_in_progress(void)
+{
+    return anim_exec_active;
+}
+
 void lv_anim_refr_now(void)
 {
     anim_timer(NULL);
@@ -211,73 +277,27 @@ void lv_anim_refr_now(void)
 
 int32_t lv_anim_path_linear(const lv_anim_t * a)
 {
-    /*Calculate the current step*/
-    int32_t step = lv_map(a->act_time, 0, a->time, 0, LV_ANIM_RESOLUTION);
-
-    /*Get the new value which will be proportional to `step`
-     *and the `start` and `end` values*/
-    int32_t new_value;
-    new_value = step * (a->end_value - a->start_value);
-    new_value = new_value >> LV_ANIM_RES_SHIFT;
-    new_value += a->start_value;
-
-    return new_value;
+    return anim_path_value(a, anim_path_step(ANIM_PATH_LINEAR, a->act_time, a->time));
 }
 
 int32_t lv_anim_path_ease_in(const lv_anim_t * a)
 {
-    /*Calculate the current step*/
-    uint32_t t = lv_map(a->act_time, 0, a->time, 0, LV_BEZIER_VAL_MAX);
-    int32_t step = lv_bezier3(t, 0, 50, 100, LV_BEZIER_VAL_MAX);
-
-    int32_t new_value;
-    new_value = step * (a->end_value - a->start_value);
-    new_value = new_value >> LV_BEZIER_VAL_SHIFT;
-    new_value += a->start_value;
-
-    return new_value;
+    return anim_path_value(a, anim_path_step(ANIM_PATH_EASE_IN, a->act_time, a->time));
 }
 
 int32_t lv_anim_path_ease_out(const lv_anim_t * a)
 {
-    /*Calculate the current step*/
-    uint32_t t = lv_map(a->act_time, 0, a->time, 0, LV_BEZIER_VAL_MAX);
-    int32_t step = lv_bezier3(t, 0, 900, 950, LV_BEZIER_VAL_MAX);
-
-    int32_t new_value;
-    new_value = step * (a->end_value - a->start_value);
-    new_value = new_value >> LV_BEZIER_VAL_SHIFT;
-    new_value += a->start_value;
-
-    return new_value;
+    return anim_path_value(a, anim_path_step(ANIM_PATH_EASE_OUT, a->act_time, a->time));
 }
 
 int32_t lv_anim_path_ease_in_out(const lv_anim_t * a)
 {
-    /*Calculate the current step*/
-    uint32_t t = lv_map(a->act_time, 0, a->time, 0, LV_BEZIER_VAL_MAX);
-    int32_t step = lv_bezier3(t, 0, 50, 952, LV_BEZIER_VAL_MAX);
-
-    int32_t new_value;
-    new_value = step * (a->end_value - a->start_value);
-    new_value = new_value >> LV_BEZIER_VAL_SHIFT;
-    new_value += a->start_value;
-
-    return new_value;
+    return anim_path_value(a, anim_path_step(ANIM_PATH_EASE_IN_OUT, a->act_time, a->time));
 }
 
 int32_t lv_anim_path_overshoot(const lv_anim_t * a)
 {
-    /*Calculate the current step*/
-    uint32_t t = lv_map(a->act_time, 0, a->time, 0, LV_BEZIER_VAL_MAX);
-    int32_t step = lv_bezier3(t, 0, 1000, 1300, LV_BEZIER_VAL_MAX);
-
-    int32_t new_value;
-    new_value = step * (a->end_value - a->start_value);
-    new_value = new_value >> LV_BEZIER_VAL_SHIFT;
-    new_value += a->start_value;
-
-    return new_value;
+    return anim_path_value(a, anim_path_step(ANIM_PATH_OVERSHOOT, a->act_time, a->time));
 }
 
 int32_t lv_anim_path_bounce(const lv_anim_t * a)
@@ -345,69 +365,160 @@ int32_t lv_anim_path_step(const lv_anim_t * a)
 
 /**
  * Periodically handle the animations.
+ * The animations are handled in 3 steps to keep the same kind of work together:
+ * update the timing, calculate the new values grouped by path, apply the values.
  * @param param unused
  */
 static void anim_timer(lv_timer_t * param)
 {
     LV_UNUSED(param);
 
+    /*Called from a callback of an animation (e.g. via `lv_refr_now`)*/
+    if(anim_timer_running) return;
+    anim_timer_running = true;
+
     uint32_t elaps = lv_tick_elaps(last_timer_run);
 
-    /*Flip the run round*/
-    anim_run_round = anim_run_round ? false : true;
-
-    lv_anim_t * a = _lv_ll_get_head(&LV_GC_ROOT(_lv_anim_ll));
-
-    while(a != NULL) {
-        /*It can be set by `lv_anim_del()` typically in `end_cb`. If set then an animation delete
-         * happened in `anim_ready_handler` which could make this linked list reading corrupt
-         * because the list is changed meanwhile
-         */
-        anim_list_changed = false;
-
-        if(a->run_round != anim_run_round) {
-            a->run_round = anim_run_round; /*The list readying might be reset so need to know which anim has run already*/
-
-            /*The animation will run now for the first time. Call `start_cb`*/
-            int32_t new_act_time = a->act_time + elaps;
-            if(!a->start_cb_called && a->act_time <= 0 && new_act_time >= 0) {
-                if(a->early_apply == 0 && a->get_value_cb) {
-                    int32_t v_ofs = a->get_value_cb(a);
-                    a->start_value += v_ofs;
-                    a->end_value += v_ofs;
-                }
-                if(a->start_cb) a->start_cb(a);
-                a->start_cb_called = 1;
+    uint32_t path_cnt[_ANIM_PATH_NUM];
+    uint32_t cnt = anim_prepare(elaps, path_cnt);
+    anim_eval(cnt, path_cnt);
+    anim_apply(cnt);
+
+    /*Remove the deleted animations from the list*/
+    if(anim_pool.act_cnt != anim_pool.run_cnt) anim_compact();
+
+    anim_timer_running = false;
+    last_timer_run = lv_tick_get();
+}
+
+/**
+ * Step the time of the running animations and collect the ones to update into the `batch_...` arrays.
+ * @param elaps     elapsed time since the last run
+ * @param path_cnt  store the number of collected animations with each path type here
+ * @return          number of collected animations
+ */
+static uint32_t anim_prepare(uint32_t elaps, uint32_t path_cnt[])
+{
+    lv_memset_00(path_cnt, _ANIM_PATH_NUM * sizeof(uint32_t));
+
+    /*Take the running animations, newest first.
+     *The animations started by the callbacks below will run only in the next round.*/
+    uint32_t cnt = 0;
+    uint32_t i;
+    for(i = anim_pool.act_cnt; i > 0; i--) {
+        lv_anim_t * a = anim_pool.act_anim[i - 1];
+        if(anim_pool.act_id[i - 1] != a->run_id) continue;
+        anim_pool.batch_anim[cnt] = a;
+        anim_pool.batch_id[cnt] = a->run_id;
+        cnt++;
+    }
+
+    uint32_t run_cnt = 0;
+    for(i = 0; i < cnt; i++) {
+        /*The arrays might be reallocated by `start_cb` so always access them via `anim_pool`*/
+        lv_anim_t * a = anim_pool.batch_anim[i];
+        uint32_t id = anim_pool.batch_id[i];
+        if(a->run_id != id) continue;   /*Deleted by an other animation's `start_cb`*/
+
+        /*The animation will run now for the first time. Call `start_cb`*/
+        int32_t new_act_time = a->act_time + elaps;
+        if(!a->start_cb_called && a->act_time <= 0 && new_act_time >= 0) {
+            if(a->early_apply == 0 && a->get_value_cb) {
+                int32_t v_ofs = a->get_value_cb(a);
+                a->start_value += v_ofs;
+                a->end_value += v_ofs;
             }
-            a->act_time += elaps;
-            if(a->act_time >= 0) {
-                if(a->act_time > a->time) a->act_time = a->time;
-
-                int32_t new_value;
-                new_value = a->path_cb(a);
-
-                if(new_value != a->current_value) {
-                    a->current_value = new_value;
-                    /*Apply the calculated value*/
-                    if(a->exec_cb) a->exec_cb(a->var, new_value);
-                }
-
-                /*If the time is elapsed the animation is ready*/
-                if(a->act_time >= a->time) {
-                    anim_ready_handler(a);
-                }
+            if(a->start_cb) a->start_cb(a);
+            a->start_cb_called = 1;
+            if(a->run_id != id) continue;
+        }
+
+        a->act_time += elaps;
+        if(a->act_time < 0) continue;   /*Still in delay*/
+        if(a->act_time > a->time) a->act_time = a->time;
+
+        uint8_t path = anim_path_get_type(a->path_cb);
+        anim_pool.batch_anim[run_cnt] = a;
+        anim_pool.batch_id[run_cnt] = id;
+        anim_pool.batch_path[run_cnt] = path;
+        path_cnt[path]++;
+        run_cnt++;
+    }
+
+    return run_cnt;
+}
+
+/**
+ * Calculate the new value of the collected animations into `batch_value`.
+ * The animations with the same built-in path are calculated together and the step of the path is reused
+ * if the timing is the same (e.g. the animations were started together).
+ * @param cnt       number of collected animations
+ * @param path_cnt  number of collected animations with each path type
+ */
+static void anim_eval(uint32_t cnt, const uint32_t path_cnt[])
+{
+    lv_anim_t ** anims = anim_pool.batch_anim;
+    uint8_t * paths = anim_pool.batch_path;
+    int32_t * values = anim_pool.batch_value;
+    uint32_t i;
+
+    if(path_cnt[ANIM_PATH_CUSTOM]) {
+        for(i = 0; i < cnt; i++) {
+            if(paths[i] == ANIM_PATH_CUSTOM) values[i] = anims[i]->path_cb(anims[i]);
+        }
+    }
+
+    uint8_t path;
+    for(path = ANIM_PATH_CUSTOM + 1; path < _ANIM_PATH_NUM; path++) {
+        if(path_cnt[path] == 0) continue;
+
+        int32_t act_time_prev = -1;
+        int32_t time_prev = 0;
+        int32_t step = 0;
+        for(i = 0; i < cnt; i++) {
+            if(paths[i] != path) continue;
+
+            lv_anim_t * a = anims[i];
+            if(a->act_time != act_time_prev || a->time != time_prev) {
+                act_time_prev = a->act_time;
+                time_prev = a->time;
+                step = anim_path_step(path, a->act_time, a->time);
             }
+            values[i] = anim_path_value(a, step);
+        }
+    }
+}
+
+/**
+ * Apply the new values of the collected animations and handle the finished ones.
+ * @param cnt       number of collected animations
+ */
+static void anim_apply(uint32_t cnt)
+{
+    anim_exec_active = true;
+
+    uint32_t i;
+    for(i = 0; i < cnt; i++) {
+        /*The callbacks might start, delete or modify any animations*/
+        lv_anim_t * a = anim_pool.batch_anim[i];
+        uint32_t id = anim_pool.batch_id[i];
+        if(a->run_id != id) continue;
+
+        int32_t new_value = anim_pool.batch_value[i];
+        if(new_value != a->current_value) {
+            a->current_value = new_value;
+            /*Apply the calculated value*/
+            if(a->exec_cb) a->exec_cb(a->var, new_value);
+            if(a->run_id != id) continue;
         }
 
-        /*If the linked list changed due to anim. delete then it's not safe to continue
-         *the reading of the list from here -> start from the head*/
-        if(anim_list_changed)
-            a = _lv_ll_get_head(&LV_GC_ROOT(_lv_anim_ll));
-        else
-            a = _lv_ll_get_next(&LV_GC_ROOT(_lv_anim_ll), a);
+        /*If the time is elapsed the animation is ready*/
+        if(a->act_time >= a->time) {
+            anim_ready_handler(a);
+        }
     }
 
-    last_timer_run = lv_tick_get();
+    anim_exec_active = false;
 }
 
 /**
@@ -427,16 +538,15 @@ static void anim_ready_handler(lv_anim_t * a)
      * - no repeat, play back is enabled and play back is ready*/
     if(a->repeat_cnt == 0 && (a->playback_time == 0 || a->playback_now == 1)) {
 
-        /*Delete the animation from the list.
+        /*Remove the animation from the running ones.
          * This way the `ready_cb` will see the animations like it's animation is ready deleted*/
-        _lv_ll_remove(&LV_GC_ROOT(_lv_anim_ll), a);
-        /*Flag that the list has changed*/
+        anim_unlink(a);
         anim_mark_list_change();
 
         /*Call the callback function at the end*/
         if(a->ready_cb != NULL) a->ready_cb(a);
         if(a->deleted_cb != NULL) a->deleted_cb(a);
-        lv_mem_free(a);
+        anim_slot_free(a);
     }
     /*If the animation is not deleted then restart it*/
     else {
@@ -462,9 +572,165 @@ static void anim_ready_handler(lv_anim_t * a)
 
 static void anim_mark_list_change(void)
 {
-    anim_list_changed = true;
-    if(_lv_ll_get_head(&LV_GC_ROOT(_lv_anim_ll)) == NULL)
+    if(anim_pool.run_cnt == 0)
         lv_timer_pause(_lv_anim_tmr);
     else
         lv_timer_resume(_lv_anim_tmr);
 }
+
+/**
+ * Get a free animation slot. A new chunk of slots is allocated if there are no free slots.
+ * @return pointer to the slot or NULL on out of memory
+ */
+static lv_anim_t * anim_slot_alloc(void)
+{
+    if(anim_pool.free_slot == NULL) {
+        lv_anim_chunk_t * chunk = lv_mem_alloc(sizeof(lv_anim_chunk_t));
+        LV_ASSERT_MALLOC(chunk);
+        if(chunk == NULL) return NULL;
+
+        chunk->next = anim_pool.chunks;
+        anim_pool.chunks = chunk;
+
+        uint32_t i;
+        for(i = LV_ANIM_CHUNK_SIZE; i > 0; i--) anim_slot_free(&chunk->slots[i - 1]);
+    }
+
+    lv_anim_t * a = anim_pool.free_slot;
+    anim_pool.free_slot = a->var;
+    return a;
+}
+
+/**
+ * Put a slot back to the free slots. It's not freed to be reused by the next animation.
+ * @param a pointer to a slot
+ */
+static void anim_slot_free(lv_anim_t * a)
+{
+    a->run_id = 0;
+    a->var = anim_pool.free_slot;
+    anim_pool.free_slot = a;
+}
+
+/**
+ * Mark an animation as not running. The slot stays valid until `anim_slot_free` and
+ * its entry in `act_...` is skipped from now on.
+ * @param a pointer to a running animation
+ */
+static void anim_unlink(lv_anim_t * a)
+{
+    a->run_id = 0;
+    anim_pool.run_cnt--;
+}
+
+/**
+ * Be sure there is space for one more animation in the arrays of the running animations
+ * @return true: there is space; false: out of memory
+ */
+static bool anim_reserve(void)
+{
+    if(anim_pool.act_cnt < anim_pool.act_size) return true;
+
+    /*Try to make space by removing the deleted animations*/
+    anim_compact();
+    if(anim_pool.act_cnt < anim_pool.act_size) return true;
+
+    uint32_t new_size = anim_pool.act_size ? anim_pool.act_size * 2 : LV_ANIM_CHUNK_SIZE;
+
+    /*Reallocate one by one. On failure the ones already enlarged are fine to keep*/
+    void * p;
+    p = lv_mem_realloc(anim_pool.act_anim, new_size * sizeof(lv_anim_t *));
+    if(p == NULL) goto fail;
+    anim_pool.act_anim = p;
+
+    p = lv_mem_realloc(anim_pool.act_id, new_size * sizeof(uint32_t));
+    if(p == NULL) goto fail;
+    anim_pool.act_id = p;
+
+    p = lv_mem_realloc(anim_pool.batch_anim, new_size * sizeof(lv_anim_t *));
+    if(p == NULL) goto fail;
+    anim_pool.batch_anim = p;
+
+    p = lv_mem_realloc(anim_pool.batch_id, new_size * sizeof(uint32_t));
+    if(p == NULL) goto fail;
+    anim_pool.batch_id = p;
+
+    p = lv_mem_realloc(anim_pool.batch_value, new_size * sizeof(int32_t));
+    if(p == NULL) goto fail;
+    anim_pool.batch_value = p;
+
+    p = lv_mem_realloc(anim_pool.batch_path, new_size * sizeof(uint8_t));
+    if(p == NULL) goto fail;
+    anim_pool.batch_path = p;
+
+    anim_pool.act_size = new_size;
+    return true;
+
+fail:
+    LV_ASSERT_MALLOC(p);
+    return false;
+}
+
+/**
+ * Remove the entries of the deleted animations from the list of the running animations.
+ * Does nothing while the list is being iterated.
+ */
+static void anim_compact(void)
+{
+    if(anim_iter_lock) return;
+
+    uint32_t i;
+    uint32_t n = 0;
+    for(i = 0; i < anim_pool.act_cnt; i++) {
+        lv_anim_t * a = anim_pool.act_anim[i];
+        if(anim_pool.act_id[i] != a->run_id) continue;
+        anim_pool.act_anim[n] = a;
+        anim_pool.act_id[n] = anim_pool.act_id[i];
+        n++;
+    }
+
+    anim_pool.act_cnt = n;
+}
+
+static uint8_t anim_path_get_type(lv_anim_path_cb_t path_cb)
+{
+    uint8_t i;
+    for(i = ANIM_PATH_CUSTOM + 1; i < _ANIM_PATH_NUM; i++) {
+        if(anim_paths[i].path_cb == path_cb) return i;
+    }
+
+    return ANIM_PATH_CUSTOM;
+}
+
+/**
+ * Get the progress of a built-in path
+ * @param path      a built-in path type, e.g. `ANIM_PATH_EASE_IN`
+ * @param act_time  the current time of the animation
+ * @param time      the duration of the animation
+ * @return          the progress in [0..LV_ANIM_RESOLUTION] range (might be larger for overshoot)
+ */
+static inline int32_t anim_path_step(uint8_t path, int32_t act_time, int32_t time)
+{
+    int32_t t = lv_map(act_time, 0, time, 0, LV_ANIM_RESOLUTION);
+    if(path == ANIM_PATH_LINEAR) return t;
+
+    return lv_bezier3(t, 0, anim_paths[path].p1, anim_paths[path].p2, LV_BEZIER_VAL_MAX);
+}
+
+/**
+ * Get the value of an animation at a given progress
+ * @param a         pointer to an animation
+ * @param step      progress of the path in [0..LV_ANIM_RESOLUTION] range
+ * @return          the value of the animation
+ */
+static inline int32_t anim_path_value(const lv_anim_t * a, int32_t step)
+{
+    /*Get the new value which will be proportional to `step`
+     *and the `start` and `end` values*/
+    int32_t new_value;
+    new_value = step * (a->end_value - a->start_value);
+    new_value = new_value >> LV_ANIM_RES_SHIFT;
+    new_value += a->start_value;
+
+    return new_value;
+}
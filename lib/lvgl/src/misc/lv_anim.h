@@ -94,10 +94,36 @@ typedef struct _lv_anim_t {
 
     /*Animation system use these - user shouldn't set*/
     uint8_t playback_now : 1; /**< Play back is in progress*/
-    uint8_t run_round : 1;    /**< Indicates the animation has run in this round*/
     uint8_t start_cb_called : 1;    /**< Indicates that the `start_cb` was already called*/
+    uint32_t run_id;          /**< Identifies the running animation (0: not running)*/
 } lv_anim_t;
 
+struct _lv_anim_chunk_t;
+
+/** Storage of the running animations. Only the animation module should use it.
+ * The animations are kept in fixed slots allocated in chunks, so `lv_anim_t *`s remain valid
+ * while the animation runs and starting an animation usually doesn't allocate memory.
+ * The lists are stored as arrays of the fields to let the timer process them in batches.*/
+typedef struct {
+    struct _lv_anim_chunk_t * chunks;   /**< Allocated blocks of animation slots*/
+    lv_anim_t * free_slot;              /**< First free slot. The others are linked via `var`*/
+
+    /*Running animations in start order. Deleted ones are skipped by `run_id` until removed*/
+    lv_anim_t ** act_anim;
+    uint32_t * act_id;
+
+    /*Work arrays of the animation timer. They have the same size as `act_...`*/
+    lv_anim_t ** batch_anim;
+    uint32_t * batch_id;
+    int32_t * batch_value;
+    uint8_t * batch_path;
+
+    uint32_t act_cnt;                   /**< Used elements in `act_...`*/
+    uint32_t act_size;                  /**< Allocated elements in the arrays*/
+    uint32_t run_cnt;                   /**< Number of running animations*/
+    uint32_t last_id;                   /**< `run_id` of the last started animation*/
+} _lv_anim_pool_t;
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -411,6 +437,13 @@ uint16_t lv_anim_count_running(void);
  */
 uint32_t lv_anim_speed_to_time(uint32_t speed, int32_t start, int32_t end);
 
+/**
+ * Tell whether the animation timer is applying the new values of the animations.
+ * Used to merge the invalidated areas of objects having multiple animated properties.
+ * @return true: the `exec_cb`s of the animations are being called
+ */
+bool _lv_anim_exec_in_progress(void);
+
 /**
  * Manually refresh the state of the animations.
  * Useful to make the animations running in a blocking process where
@@ -152,6 +152,10 @@ static lv_fs_res_t lv_fs_read_cached(lv_fs_file_t * file_p, char * buf, uint32_t
             /*First part of data is in cache buffer, but we need to read rest of data from FS*/
             lv_memcpy(buf, buffer + buffer_offset, buffer_remaining_length);
 
+            /*The FS position is not the end of the cache if the file was seeked back into the cache*/
+            res = file_p->drv->seek_cb(file_p->drv, file_p->file_d, end, LV_FS_SEEK_SET);
+            if(res != LV_FS_RES_OK) return res;
+
             uint32_t bytes_read_to_buffer = 0;
             if(btr > buffer_size) {
                 /*If remaining data chuck is bigger than buffer size, then do not use cache, instead read it directly from FS*/
@@ -171,7 +175,10 @@ static lv_fs_res_t lv_fs_read_cached(lv_fs_file_t * file_p, char * buf, uint32_t
         }
     }
     else {
-        /*Data is not in cache buffer*/
+        /*Data is not in cache buffer. The FS position can be anywhere after a seek to the end of the cache*/
+        res = file_p->drv->seek_cb(file_p->drv, file_p->file_d, file_position, LV_FS_SEEK_SET);
+        if(res != LV_FS_RES_OK) return res;
+
         if(btr > buffer_size) {
             /*If bigger data is requested, then do not use cache, instead read it directly*/
             res = file_p->drv->read_cb(file_p->drv, file_p->file_d, (void *)buf, btr, br);
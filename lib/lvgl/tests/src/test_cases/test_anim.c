@@ -0,0 +1,315 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define STRESS_CNT  1000
+
+static int32_t values[STRESS_CNT];
+static uint32_t exec_cnt;
+static uint32_t ready_cnt;
+static uint32_t deleted_cnt;
+
+static int32_t custom_path(const lv_anim_t * a)
+{
+    return a->act_time < a->time / 2 ? a->start_value : a->end_value;
+}
+
+static const lv_anim_path_cb_t paths[] = {
+    lv_anim_path_linear, lv_anim_path_ease_in, lv_anim_path_ease_out, lv_anim_path_ease_in_out,
+    lv_anim_path_overshoot, lv_anim_path_bounce, lv_anim_path_step, custom_path
+};
+
+#define PATH_CNT (sizeof(paths) / sizeof(paths[0]))
+
+/*Check that the batched calculation gives the same value as the path function*/
+static void checked_exec_cb(void * var, int32_t v)
+{
+    lv_anim_t * a = lv_anim_get(var, checked_exec_cb);
+    TEST_ASSERT_NOT_NULL(a);
+    TEST_ASSERT_EQUAL_INT32(a->path_cb(a), v);
+    *((int32_t *)var) = v;
+    exec_cnt++;
+}
+
+static void exec_cb(void * var, int32_t v)
+{
+    *((int32_t *)var) = v;
+    exec_cnt++;
+}
+
+static void ready_cb(lv_anim_t * a)
+{
+    LV_UNUSED(a);
+    ready_cnt++;
+}
+
+static void deleted_cb(lv_anim_t * a)
+{
+    LV_UNUSED(a);
+    deleted_cnt++;
+}
+
+static void run_anims(uint32_t timeout_ms)
+{
+    uint32_t t = lv_tick_get();
+    while(lv_anim_count_running()) {
+        TEST_ASSERT_LESS_THAN(timeout_ms, lv_tick_elaps(t));
+        lv_tick_inc(10);
+        lv_anim_refr_now();
+    }
+}
+
+static int ptr_cmp(const void * p1, const void * p2)
+{
+    uintptr_t a = (uintptr_t) * ((void * const *)p1);
+    uintptr_t b = (uintptr_t) * ((void * const *)p2);
+    return a < b ? -1 : a > b ? 1 : 0;
+}
+
+void setUp(void)
+{
+    lv_memset_00(values, sizeof(values));
+    exec_cnt = 0;
+    ready_cnt = 0;
+    deleted_cnt = 0;
+}
+
+void tearDown(void)
+{
+    lv_anim_del_all();
+    lv_obj_clean(lv_scr_act());
+}
+
+void test_anim_values_match_path_cb(void)
+{
+    uint32_t i;
+    for(i = 0; i < 64; i++) {
+        lv_anim_t a;
+        lv_anim_init(&a);
+        lv_anim_set_var(&a, &values[i]);
+        lv_anim_set_exec_cb(&a, checked_exec_cb);
+        lv_anim_set_path_cb(&a, paths[i % PATH_CNT]);
+        /*Some of the animations have the same timing, some are different*/
+        lv_anim_set_time(&a, 50 + (i / PATH_CNT % 3) * 37);
+        lv_anim_set_values(&a, -1000 + i, 5000 - i * 7);
+        lv_anim_set_ready_cb(&a, ready_cb);
+        lv_anim_start(&a);
+    }
+
+    TEST_ASSERT_EQUAL(64, lv_anim_count_running());
+    run_anims(2000);
+
+    TEST_ASSERT_EQUAL(64, ready_cnt);
+    for(i = 0; i < 64; i++) {
+        TEST_ASSERT_EQUAL_INT32(5000 - i * 7, values[i]);
+    }
+}
+
+void test_anim_slots_are_reused(void)
+{
+    static lv_anim_t * first[STRESS_CNT];
+    uint32_t i;
+
+    lv_anim_t a;
+    lv_anim_init(&a);
+    lv_anim_set_exec_cb(&a, exec_cb);
+    lv_anim_set_time(&a, 1000);
+
+    for(i = 0; i < STRESS_CNT; i++) {
+        lv_anim_set_var(&a, &values[i]);
+        first[i] = lv_anim_start(&a);
+        TEST_ASSERT_NOT_NULL(first[i]);
+    }
+    TEST_ASSERT_EQUAL(STRESS_CNT, lv_anim_count_running());
+
+    lv_anim_del(NULL, NULL);
+    TEST_ASSERT_EQUAL(0, lv_anim_count_running());
+
+    /*The animations started again get the same slots, no new memory is allocated*/
+    qsort(first, STRESS_CNT, sizeof(first[0]), ptr_cmp);
+    for(i = 0; i < STRESS_CNT; i++) {
+        lv_anim_set_var(&a, &values[i]);
+        lv_anim_t * new_a = lv_anim_start(&a);
+        TEST_ASSERT_NOT_NULL(bsearch(&new_a, first, STRESS_CNT, sizeof(first[0]), ptr_cmp));
+    }
+
+    /*Restarting the same animation replaces it*/
+    lv_anim_set_var(&a, &values[0]);
+    lv_anim_start(&a);
+    TEST_ASSERT_EQUAL(STRESS_CNT, lv_anim_count_running());
+    TEST_ASSERT_EQUAL_PTR(&values[0], lv_anim_get(&values[0], exec_cb)->var);
+}
+
+static bool other_running;
+static uint32_t restart_cnt;
+
+static void del_other_ready_cb(lv_anim_t * a)
+{
+    LV_UNUSED(a);
+    TEST_ASSERT_TRUE(lv_anim_del(&values[1], NULL));
+    other_running = false;
+}
+
+static void other_exec_cb(void * var, int32_t v)
+{
+    /*Must not be called once the animation is deleted*/
+    TEST_ASSERT_TRUE(other_running);
+    exec_cb(var, v);
+}
+
+static void restart_ready_cb(lv_anim_t * a)
+{
+    /*Start the same animation again from its own `ready_cb`*/
+    if(restart_cnt < 3) {
+        restart_cnt++;
+        a->act_time = 0;
+        lv_anim_t * new_a = lv_anim_start(a);
+        TEST_ASSERT_NOT_NULL(new_a);
+        TEST_ASSERT_EQUAL_PTR(&values[2], new_a->var);
+    }
+}
+
+void test_anim_callbacks_modify_anims(void)
+{
+    restart_cnt = 0;
+
+    lv_anim_t a;
+    lv_anim_init(&a);
+    lv_anim_set_var(&a, &values[0]);
+    lv_anim_set_exec_cb(&a, exec_cb);
+    lv_anim_set_time(&a, 30);
+    lv_anim_set_ready_cb(&a, del_other_ready_cb);
+    lv_anim_start(&a);
+
+    other_running = true;
+    lv_anim_set_var(&a, &values[1]);
+    lv_anim_set_exec_cb(&a, other_exec_cb);
+    lv_anim_set_time(&a, 1000);
+    lv_anim_set_ready_cb(&a, NULL);
+    lv_anim_set_deleted_cb(&a, deleted_cb);
+    lv_anim_start(&a);
+
+    lv_anim_set_var(&a, &values[2]);
+    lv_anim_set_exec_cb(&a, exec_cb);
+    lv_anim_set_time(&a, 20);
+    lv_anim_set_values(&a, 0, 10);
+    lv_anim_set_deleted_cb(&a, NULL);
+    lv_anim_set_ready_cb(&a, restart_ready_cb);
+    lv_anim_start(&a);
+
+    run_anims(2000);
+
+    TEST_ASSERT_FALSE(other_running);
+    TEST_ASSERT_EQUAL(1, deleted_cnt);
+    TEST_ASSERT_EQUAL(3, restart_cnt);
+    TEST_ASSERT_EQUAL_INT32(10, values[2]);
+}
+
+void test_anim_stress(void)
+{
+    uint32_t i;
+    lv_anim_t a;
+    lv_anim_init(&a);
+    lv_anim_set_exec_cb(&a, exec_cb);
+    lv_anim_set_ready_cb(&a, ready_cb);
+
+    for(i = 0; i < STRESS_CNT; i++) {
+        lv_anim_set_var(&a, &values[i]);
+        lv_anim_set_path_cb(&a, paths[i % PATH_CNT]);
+        lv_anim_set_time(&a, 100 + (i % 4) * 50);
+        lv_anim_set_delay(&a, (i % 3) * 20);
+        lv_anim_set_playback_time(&a, i % 2 ? 100 : 0);
+        lv_anim_set_values(&a, 0, 1000 + i);
+        lv_anim_start(&a);
+    }
+    TEST_ASSERT_EQUAL(STRESS_CNT, lv_anim_count_running());
+
+    uint32_t round_cnt = 0;
+    clock_t cpu_time = 0;
+    uint32_t t = lv_tick_get();
+    while(lv_anim_count_running()) {
+        TEST_ASSERT_LESS_THAN(5000, lv_tick_elaps(t));
+        lv_tick_inc(10);
+        clock_t start = clock();
+        lv_anim_refr_now();
+        cpu_time += clock() - start;
+        round_cnt++;
+    }
+
+    TEST_ASSERT_EQUAL(STRESS_CNT, ready_cnt);
+    for(i = 0; i < STRESS_CNT; i++) {
+        TEST_ASSERT_EQUAL_INT32(i % 2 ? 0 : 1000 + i, values[i]);
+    }
+
+    char msg[128];
+    lv_snprintf(msg, sizeof(msg), "%d animations: %d rounds, %d exec_cb, %d us/round",
+                STRESS_CNT, (int)round_cnt, (int)exec_cnt,
+                (int)(round_cnt ? (uint64_t)cpu_time * 1000000 / CLOCKS_PER_SEC / round_cnt : 0));
+    TEST_MESSAGE(msg);
+}
+
+static void translate_x_cb(void * obj, int32_t v)
+{
+    lv_obj_set_style_translate_x(obj, v, 0);
+}
+
+static void translate_y_cb(void * obj, int32_t v)
+{
+    lv_obj_set_style_translate_y(obj, v, 0);
+}
+
+static void opa_cb(void * obj, int32_t v)
+{
+    lv_obj_set_style_bg_opa(obj, v, 0);
+}
+
+void test_anim_invalidations_are_merged(void)
+{
+    lv_obj_t * obj = lv_obj_create(lv_scr_act());
+    lv_obj_set_pos(obj, 100, 100);
+    lv_obj_set_size(obj, 100, 50);
+    lv_refr_now(NULL);
+
+    lv_disp_t * disp = lv_obj_get_disp(obj);
+    TEST_ASSERT_EQUAL(0, disp->inv_p);
+
+    lv_anim_t a;
+    lv_anim_init(&a);
+    lv_anim_set_var(&a, obj);
+    lv_anim_set_time(&a, 1000);
+    lv_anim_set_early_apply(&a, false);
+    lv_anim_set_exec_cb(&a, translate_x_cb);
+    lv_anim_set_values(&a, 0, 50);
+    lv_anim_start(&a);
+    lv_anim_set_exec_cb(&a, translate_y_cb);
+    lv_anim_start(&a);
+    lv_anim_set_exec_cb(&a, opa_cb);
+    lv_anim_set_values(&a, LV_OPA_COVER, LV_OPA_TRANSP);
+    lv_anim_start(&a);
+
+    lv_tick_inc(100);
+    lv_anim_refr_now();
+
+    /*All the properties invalidated the object but only one area is saved*/
+    TEST_ASSERT_EQUAL(0, disp->inv_p);
+    TEST_ASSERT_EQUAL(1, disp->inv_merge_cnt);
+    TEST_ASSERT_EQUAL_PTR(obj, disp->inv_merge_keys[0]);
+    TEST_ASSERT_TRUE(_lv_area_is_in(&obj->coords, &disp->inv_merge_areas[0], 0));
+
+    /*The merged area is invalidated by the refresh*/
+    TEST_ASSERT_FALSE(disp->refr_timer->paused);
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL(0, disp->inv_merge_cnt);
+    TEST_ASSERT_EQUAL(0, disp->inv_p);
+
+    /*Out of animations the areas are saved immediately*/
+    lv_obj_invalidate(obj);
+    TEST_ASSERT_EQUAL(0, disp->inv_merge_cnt);
+    TEST_ASSERT_EQUAL(1, disp->inv_p);
+}
+
+#endif
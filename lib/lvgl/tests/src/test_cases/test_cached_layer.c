@@ -0,0 +1,231 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#if LV_LAYER_CACHE_MAX_SIZE
+
+extern lv_color_t test_fb[];
+
+static lv_color_t ref_fb[800 * 480];
+static uint32_t draw_cnt;
+
+static void draw_event_cb(lv_event_t * e)
+{
+    LV_UNUSED(e);
+    draw_cnt++;
+}
+
+static void render(void)
+{
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+}
+
+static void render_ref(lv_obj_t * cached_obj)
+{
+    lv_obj_clear_flag(cached_obj, LV_OBJ_FLAG_CACHED_LAYER);
+    render();
+    lv_memcpy(ref_fb, test_fb, sizeof(ref_fb));
+    lv_obj_add_flag(cached_obj, LV_OBJ_FLAG_CACHED_LAYER);
+}
+
+/*A card with a background covering its area, so it can be cached without alpha channel*/
+static lv_obj_t * card_create(lv_obj_t * parent, lv_obj_t ** label)
+{
+    lv_obj_t * card = lv_obj_create(parent);
+    lv_obj_remove_style_all(card);
+    lv_obj_set_pos(card, 20, 30);
+    lv_obj_set_size(card, 300, 200);
+    lv_obj_set_style_bg_opa(card, LV_OPA_COVER, 0);
+    lv_obj_set_style_bg_color(card, lv_palette_lighten(LV_PALETTE_BLUE, 3), 0);
+    lv_obj_set_style_bg_grad_color(card, lv_palette_main(LV_PALETTE_BLUE), 0);
+    lv_obj_set_style_bg_grad_dir(card, LV_GRAD_DIR_VER, 0);
+    lv_obj_set_style_border_width(card, 3, 0);
+    lv_obj_set_style_border_color(card, lv_palette_darken(LV_PALETTE_BLUE, 2), 0);
+    lv_obj_set_style_pad_all(card, 10, 0);
+    lv_obj_add_flag(card, LV_OBJ_FLAG_CACHED_LAYER);
+
+    lv_obj_t * title = lv_label_create(card);
+    lv_label_set_text(title, "Title of the card");
+
+    lv_obj_t * btn = lv_btn_create(card);
+    lv_obj_align(btn, LV_ALIGN_BOTTOM_RIGHT, 0, 0);
+    lv_obj_t * btn_label = lv_label_create(btn);
+    lv_label_set_text(btn_label, "Button");
+
+    *label = lv_label_create(card);
+    lv_label_set_text(*label, "Hint: 1");
+    lv_obj_align(*label, LV_ALIGN_LEFT_MID, 0, 0);
+    lv_obj_add_event_cb(*label, draw_event_cb, LV_EVENT_DRAW_MAIN, NULL);
+
+    return card;
+}
+
+void setUp(void)
+{
+    draw_cnt = 0;
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_scr_act());
+}
+
+void test_cached_layer_output_is_identical(void)
+{
+    lv_obj_t * label;
+    lv_obj_t * card = card_create(lv_scr_act(), &label);
+    render_ref(card);
+
+    /*The first refresh renders the cache, the second one only copies it*/
+    draw_cnt = 0;
+    render();
+    TEST_ASSERT_NOT_NULL(_lv_obj_get_layer_cache(card));
+    TEST_ASSERT_EQUAL_MEMORY(ref_fb, test_fb, sizeof(ref_fb));
+    TEST_ASSERT_EQUAL(1, draw_cnt);
+
+    render();
+    TEST_ASSERT_EQUAL_MEMORY(ref_fb, test_fb, sizeof(ref_fb));
+    TEST_ASSERT_EQUAL(1, draw_cnt);
+}
+
+void test_cached_layer_rendered_again_on_change(void)
+{
+    lv_obj_t * label;
+    lv_obj_t * card = card_create(lv_scr_act(), &label);
+    render();
+    render();
+    draw_cnt = 0;
+
+    /*Change a child*/
+    lv_label_set_text(label, "Hint: 2");
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL(1, draw_cnt);
+    render_ref(card);
+    draw_cnt = 0;
+    render();
+    render();
+    TEST_ASSERT_EQUAL(1, draw_cnt);
+    TEST_ASSERT_EQUAL_MEMORY(ref_fb, test_fb, sizeof(ref_fb));
+
+    /*Change a style of the cached object*/
+    lv_obj_set_style_bg_color(card, lv_palette_lighten(LV_PALETTE_GREEN, 3), 0);
+    render_ref(card);
+    draw_cnt = 0;
+    render();
+    render();
+    TEST_ASSERT_EQUAL(1, draw_cnt);
+    TEST_ASSERT_EQUAL_MEMORY(ref_fb, test_fb, sizeof(ref_fb));
+
+    /*Resize the cached object*/
+    lv_obj_set_size(card, 250, 150);
+    render_ref(card);
+    render();
+    TEST_ASSERT_EQUAL(250, _lv_obj_get_layer_cache(card)->img.header.w);
+    TEST_ASSERT_EQUAL_MEMORY(ref_fb, test_fb, sizeof(ref_fb));
+}
+
+void test_cached_layer_scroll_parent(void)
+{
+    lv_obj_t * cont = lv_obj_create(lv_scr_act());
+    lv_obj_set_size(cont, 500, 300);
+    lv_obj_t * label;
+    lv_obj_t * card = card_create(cont, &label);
+    lv_obj_set_y(card, 200);
+    render();
+    draw_cnt = 0;
+
+    /*The cache is only moved with the parent*/
+    lv_obj_scroll_by(cont, 0, -100, LV_ANIM_OFF);
+    render();
+    TEST_ASSERT_EQUAL(0, draw_cnt);
+    lv_memcpy(ref_fb, test_fb, sizeof(ref_fb));
+
+    lv_obj_clear_flag(card, LV_OBJ_FLAG_CACHED_LAYER);
+    render();
+    TEST_ASSERT_EQUAL_MEMORY(ref_fb, test_fb, sizeof(ref_fb));
+}
+
+void test_cached_layer_budget(void)
+{
+    /*Both cards need more than half of the budget in any color depth*/
+    lv_coord_t h = LV_LAYER_CACHE_MAX_SIZE / 2 / (800 * sizeof(lv_color_t)) + 1;
+    lv_obj_t * label1;
+    lv_obj_t * card1 = card_create(lv_scr_act(), &label1);
+    lv_obj_set_size(card1, 800, h);
+    lv_obj_t * label2;
+    lv_obj_t * card2 = card_create(lv_scr_act(), &label2);
+    lv_obj_set_size(card2, 800, h);
+    render();
+
+    /*Only one of them fits into the budget*/
+    TEST_ASSERT_NOT_NULL(_lv_obj_get_layer_cache(card1));
+    TEST_ASSERT_NULL(_lv_obj_get_layer_cache(card2));
+
+    /*The freed memory can be used by the other object*/
+    lv_obj_del(card1);
+    render();
+    TEST_ASSERT_NOT_NULL(_lv_obj_get_layer_cache(card2));
+
+    lv_obj_clear_flag(card2, LV_OBJ_FLAG_CACHED_LAYER);
+    TEST_ASSERT_NULL(_lv_obj_get_layer_cache(card2));
+}
+
+void test_cached_layer_not_covering_obj(void)
+{
+    lv_obj_t * label;
+    lv_obj_t * card = card_create(lv_scr_act(), &label);
+    lv_obj_set_style_radius(card, 20, 0);
+    render_ref(card);
+
+    /*It needs alpha channel so it's cached only with LV_COLOR_SCREEN_TRANSP*/
+    render();
+    TEST_ASSERT_EQUAL_MEMORY(ref_fb, test_fb, sizeof(ref_fb));
+#if LV_COLOR_SCREEN_TRANSP == 0
+    TEST_ASSERT_NULL(_lv_obj_get_layer_cache(card));
+#else
+    TEST_ASSERT_NOT_NULL(_lv_obj_get_layer_cache(card));
+#endif
+}
+
+#else
+
+void setUp(void)
+{
+
+}
+
+void tearDown(void)
+{
+
+}
+
+void test_cached_layer_output_is_identical(void)
+{
+
+}
+
+void test_cached_layer_rendered_again_on_change(void)
+{
+
+}
+
+void test_cached_layer_scroll_parent(void)
+{
+
+}
+
+void test_cached_layer_budget(void)
+{
+
+}
+
+void test_cached_layer_not_covering_obj(void)
+{
+
+}
+
+#endif
+
+#endif
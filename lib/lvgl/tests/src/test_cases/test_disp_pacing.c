@@ -0,0 +1,203 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#if LV_DISP_PACING_MIN_PERIOD
+
+static uint32_t flush_time;
+static uint32_t flush_cnt;
+static uint32_t vsync_time;
+static uint32_t vsync_cnt;
+static uint32_t vsync_flush_cnt;
+static uint32_t refr_flush_cnt;     /*Flushes before the last refresh*/
+
+static void (*orig_flush_cb)(lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t * color_p);
+
+static void slow_flush_cb(lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t * color_p)
+{
+    LV_UNUSED(area);
+    LV_UNUSED(color_p);
+
+    flush_cnt++;
+    lv_tick_inc(flush_time);
+    lv_disp_flush_ready(disp_drv);
+}
+
+static void vsync_wait_cb(lv_disp_drv_t * disp_drv)
+{
+    LV_UNUSED(disp_drv);
+
+    vsync_cnt++;
+    vsync_flush_cnt = flush_cnt;
+    lv_tick_inc(vsync_time);
+}
+
+static lv_obj_t * label1;
+static lv_obj_t * label2;
+
+/*Change two labels far from each other to flush two areas in a refresh*/
+static void refresh(uint32_t cnt)
+{
+    uint32_t i;
+    for(i = 0; i < cnt; i++) {
+        lv_label_set_text_fmt(label1, "%d", (int)i);
+        lv_label_set_text_fmt(label2, "%d", (int)i);
+        refr_flush_cnt = flush_cnt;
+        lv_refr_now(NULL);
+    }
+}
+
+static uint32_t get_period(void)
+{
+    return lv_disp_get_default()->refr_timer->period;
+}
+
+void setUp(void)
+{
+    lv_disp_drv_t * drv = lv_disp_get_default()->driver;
+    orig_flush_cb = drv->flush_cb;
+    drv->flush_cb = slow_flush_cb;
+
+    flush_time = 0;
+    flush_cnt = 0;
+    vsync_time = 0;
+    vsync_cnt = 0;
+
+    /*No scrollbar to redraw when the labels change*/
+    lv_obj_clear_flag(lv_scr_act(), LV_OBJ_FLAG_SCROLLABLE);
+    label1 = lv_label_create(lv_scr_act());
+    label2 = lv_label_create(lv_scr_act());
+    lv_obj_align(label2, LV_ALIGN_BOTTOM_RIGHT, 0, 0);
+    lv_refr_now(NULL);
+
+    lv_disp_reset_pacing(NULL);
+}
+
+void tearDown(void)
+{
+    lv_disp_drv_t * drv = lv_disp_get_default()->driver;
+    drv->flush_cb = orig_flush_cb;
+    drv->vsync_wait_cb = NULL;
+    lv_obj_clean(lv_scr_act());
+    lv_obj_add_flag(lv_scr_act(), LV_OBJ_FLAG_SCROLLABLE);
+}
+
+void test_disp_pacing_fast_refreshes(void)
+{
+    refresh(10);
+
+    const lv_disp_pacing_t * pacing = lv_disp_get_pacing(NULL);
+    TEST_ASSERT_EQUAL(10, pacing->frame_cnt);
+    TEST_ASSERT_EQUAL(0, pacing->missed_cnt);
+    TEST_ASSERT_EQUAL(0, pacing->time_max);
+
+    uint32_t i;
+    uint32_t sum = 0;
+    for(i = 0; i < LV_DISP_PACING_HIST_CNT; i++) sum += pacing->time_hist[i];
+    TEST_ASSERT_EQUAL(10, sum);
+
+    /*As often as allowed*/
+    TEST_ASSERT_EQUAL(LV_DISP_PACING_MIN_PERIOD, get_period());
+}
+
+void test_disp_pacing_slow_refreshes(void)
+{
+    /*Longer than the shortest period: the period is adapted with some time left to the other tasks*/
+    flush_time = 10;
+    refresh(10);
+    const lv_disp_pacing_t * pacing = lv_disp_get_pacing(NULL);
+    TEST_ASSERT_EQUAL(20, pacing->time_avg);
+    TEST_ASSERT_EQUAL(25, get_period());
+    TEST_ASSERT_EQUAL(10, pacing->time_hist[4]);  /*16..31 ms*/
+
+    /*Longer than the default period: missed deadlines*/
+    lv_disp_reset_pacing(NULL);
+    flush_time = 20;
+    refresh(5);
+    TEST_ASSERT_EQUAL(5, pacing->frame_cnt);
+    TEST_ASSERT_EQUAL(5, pacing->missed_cnt);
+    TEST_ASSERT_EQUAL(5, pacing->time_hist[5]);  /*32..63 ms*/
+    TEST_ASSERT_EQUAL(40, pacing->time_max);
+    TEST_ASSERT_EQUAL(LV_DISP_DEF_REFR_PERIOD, get_period());
+
+    /*Faster again*/
+    flush_time = 0;
+    refresh(20);
+    TEST_ASSERT_EQUAL(LV_DISP_PACING_MIN_PERIOD, get_period());
+}
+
+void test_disp_pacing_vsync(void)
+{
+    lv_disp_get_default()->driver->vsync_wait_cb = vsync_wait_cb;
+    vsync_time = 20;
+    refresh(5);
+
+    /*Once per refresh before its first flush*/
+    TEST_ASSERT_GREATER_OR_EQUAL(10, flush_cnt);
+    TEST_ASSERT_EQUAL(5, vsync_cnt);
+    TEST_ASSERT_EQUAL(refr_flush_cnt, vsync_flush_cnt);
+
+    /*The wait is not counted in the time of the refresh but the deadline is missed*/
+    const lv_disp_pacing_t * pacing = lv_disp_get_pacing(NULL);
+    TEST_ASSERT_EQUAL(0, pacing->time_max);
+    TEST_ASSERT_EQUAL(5, pacing->missed_cnt);
+    TEST_ASSERT_EQUAL(LV_DISP_PACING_MIN_PERIOD, get_period());
+}
+
+void test_disp_pacing_static_screen(void)
+{
+    refresh(3);
+    uint32_t cnt = flush_cnt;
+    lv_timer_t * refr_timer = lv_disp_get_default()->refr_timer;
+    lv_timer_resume(refr_timer);
+
+    /*Nothing to draw*/
+    lv_refr_now(NULL);
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL(3, lv_disp_get_pacing(NULL)->frame_cnt);
+    TEST_ASSERT_EQUAL(cnt, flush_cnt);
+
+#if LV_USE_PERF_MONITOR == 0 && LV_USE_MEM_MONITOR == 0
+    /*The refresh timer is paused until something is invalidated*/
+    TEST_ASSERT_TRUE(refr_timer->paused);
+    lv_obj_invalidate(label1);
+    TEST_ASSERT_FALSE(refr_timer->paused);
+#endif
+}
+
+#else /*LV_DISP_PACING_MIN_PERIOD*/
+
+void setUp(void)
+{
+
+}
+
+void tearDown(void)
+{
+
+}
+
+void test_disp_pacing_fast_refreshes(void)
+{
+
+}
+
+void test_disp_pacing_slow_refreshes(void)
+{
+
+}
+
+void test_disp_pacing_vsync(void)
+{
+
+}
+
+void test_disp_pacing_static_screen(void)
+{
+
+}
+
+#endif
+
+#endif
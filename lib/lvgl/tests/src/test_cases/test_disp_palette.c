@@ -0,0 +1,230 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#define HOR_RES 800
+#define VER_RES 480
+
+extern lv_color_t test_fb[];
+
+static lv_disp_palette_t pal;
+static lv_color_t theme_colors[6];
+static uint8_t indexed_buf[HOR_RES * VER_RES];
+static lv_color_t expanded[HOR_RES * VER_RES];
+static lv_color_t rendered[HOR_RES * VER_RES];
+
+/*The colors used by the theme for the widgets below*/
+static void get_theme_colors(void)
+{
+    theme_colors[0] = lv_obj_get_style_bg_color(lv_scr_act(), LV_PART_MAIN);
+    theme_colors[1] = lv_obj_get_style_text_color(lv_scr_act(), LV_PART_MAIN);
+    theme_colors[2] = lv_theme_get_color_primary(NULL);
+    theme_colors[3] = lv_theme_get_color_secondary(NULL);
+    theme_colors[4] = lv_palette_main(LV_PALETTE_GREY);
+    theme_colors[5] = lv_color_black();
+}
+
+static uint32_t color_dist(lv_color_t c1, lv_color_t c2)
+{
+    lv_color32_t a;
+    lv_color32_t b;
+    a.full = lv_color_to32(c1);
+    b.full = lv_color_to32(c2);
+    return LV_MAX3(LV_ABS(a.ch.red - b.ch.red), LV_ABS(a.ch.green - b.ch.green), LV_ABS(a.ch.blue - b.ch.blue));
+}
+
+static lv_color_t quantize(lv_color_t color)
+{
+    uint8_t i = lv_disp_palette_find(&pal, color);
+    TEST_ASSERT_LESS_THAN(pal.size, i);
+    return pal.colors[i];
+}
+
+static void create_widgets(void)
+{
+    lv_obj_t * btn = lv_btn_create(lv_scr_act());
+    lv_obj_set_size(btn, 200, 80);
+    lv_obj_set_pos(btn, 50, 50);
+    lv_obj_t * label = lv_label_create(btn);
+    lv_label_set_text(label, "Button");
+    lv_obj_center(label);
+
+    lv_obj_t * slider = lv_slider_create(lv_scr_act());
+    lv_obj_set_pos(slider, 350, 80);
+    lv_slider_set_value(slider, 40, LV_ANIM_OFF);
+
+    lv_obj_t * sw = lv_switch_create(lv_scr_act());
+    lv_obj_set_pos(sw, 350, 200);
+    lv_obj_add_state(sw, LV_STATE_CHECKED);
+
+    label = lv_label_create(lv_scr_act());
+    lv_label_set_text(label, "Text in an indexed buffer");
+    lv_obj_set_pos(label, 50, 300);
+}
+
+static lv_disp_draw_buf_t * draw_buf_ori;
+static void (*flush_cb_ori)(lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t * color_p);
+
+static void indexed_flush_cb(lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t * color_p)
+{
+    LV_UNUSED(area);
+    /*In direct mode the whole frame buffer is passed*/
+    TEST_ASSERT_EQUAL_PTR(indexed_buf, color_p);
+    lv_disp_flush_ready(disp_drv);
+}
+
+/*Draw into a screen sized indexed buffer*/
+static void indexed_mode_begin(lv_img_cf_t cf)
+{
+    static lv_disp_draw_buf_t draw_buf;
+    lv_disp_draw_buf_init(&draw_buf, indexed_buf, NULL, HOR_RES * VER_RES);
+
+    lv_disp_drv_t * drv = lv_disp_get_default()->driver;
+    draw_buf_ori = drv->draw_buf;
+    flush_cb_ori = drv->flush_cb;
+
+    lv_disp_palette_init(&pal, cf, theme_colors, sizeof(theme_colors) / sizeof(theme_colors[0]));
+    drv->draw_buf = &draw_buf;
+    drv->flush_cb = indexed_flush_cb;
+    drv->direct_mode = 1;
+    drv->palette = &pal;
+    lv_disp_drv_use_generic_set_px_cb(drv, cf);
+}
+
+static void indexed_mode_end(void)
+{
+    lv_disp_drv_t * drv = lv_disp_get_default()->driver;
+    drv->draw_buf = draw_buf_ori;
+    drv->flush_cb = flush_cb_ori;
+    drv->direct_mode = 0;
+    drv->palette = NULL;
+    drv->set_px_cb = NULL;
+}
+
+static void expand_all(void)
+{
+    lv_area_t a;
+    lv_area_set(&a, 0, 0, HOR_RES - 1, VER_RES - 1);
+    lv_disp_palette_expand(&pal, expanded, indexed_buf, HOR_RES, &a);
+}
+
+static void render(void)
+{
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+}
+
+void setUp(void)
+{
+    get_theme_colors();
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_scr_act());
+}
+
+void test_disp_palette_theme_colors_are_exact(void)
+{
+    const lv_img_cf_t cfs[] = {LV_IMG_CF_INDEXED_8BIT, LV_IMG_CF_INDEXED_4BIT};
+    uint32_t c;
+    for(c = 0; c < sizeof(cfs) / sizeof(cfs[0]); c++) {
+        lv_disp_palette_init(&pal, cfs[c], theme_colors, sizeof(theme_colors) / sizeof(theme_colors[0]));
+        TEST_ASSERT_EQUAL(cfs[c] == LV_IMG_CF_INDEXED_8BIT ? 256 : 16, pal.size);
+
+        uint32_t i;
+        for(i = 0; i < sizeof(theme_colors) / sizeof(theme_colors[0]); i++) {
+            TEST_ASSERT_EQUAL_HEX32(lv_color_to32(theme_colors[i]), lv_color_to32(quantize(theme_colors[i])));
+        }
+    }
+}
+
+void test_disp_palette_shades(void)
+{
+    lv_color_t primary = lv_theme_get_color_primary(NULL);
+
+    /*The shades between a theme color and white or black are nearer than the ends*/
+    lv_disp_palette_init(&pal, LV_IMG_CF_INDEXED_4BIT, theme_colors, sizeof(theme_colors) / sizeof(theme_colors[0]));
+    lv_color_t to[] = {lv_color_white(), lv_color_black()};
+    uint32_t i;
+    for(i = 0; i < 2; i++) {
+        lv_color_t mixed = lv_color_mix(to[i], primary, LV_OPA_50);
+        uint32_t dist = color_dist(quantize(mixed), mixed);
+        TEST_ASSERT_LESS_THAN(color_dist(primary, mixed), dist);
+        TEST_ASSERT_LESS_THAN(color_dist(to[i], mixed), dist);
+    }
+
+    /*With 256 colors the mixes and the grays are close*/
+    lv_disp_palette_init(&pal, LV_IMG_CF_INDEXED_8BIT, theme_colors, sizeof(theme_colors) / sizeof(theme_colors[0]));
+    for(i = 0; i <= 255; i++) {
+        lv_color_t mixed = lv_color_mix(lv_color_white(), primary, i);
+        TEST_ASSERT_LESS_OR_EQUAL(24, color_dist(quantize(mixed), mixed));
+        mixed = lv_color_mix(lv_color_black(), primary, i);
+        TEST_ASSERT_LESS_OR_EQUAL(24, color_dist(quantize(mixed), mixed));
+
+        lv_color_t gray = lv_color_make(i, i, i);
+        TEST_ASSERT_LESS_OR_EQUAL(16, color_dist(quantize(gray), gray));
+    }
+}
+
+void test_disp_palette_render(void)
+{
+    create_widgets();
+    render();
+    lv_memcpy(rendered, test_fb, sizeof(rendered));
+
+    /*The theme colors are the same as with true color rendering and the rest is close*/
+    const lv_img_cf_t cfs[] = {LV_IMG_CF_INDEXED_8BIT, LV_IMG_CF_INDEXED_4BIT};
+    const uint32_t dist_max[] = {48, 96};
+    uint32_t c;
+    for(c = 0; c < sizeof(cfs) / sizeof(cfs[0]); c++) {
+        lv_memset_ff(indexed_buf, sizeof(indexed_buf));
+        indexed_mode_begin(cfs[c]);
+        render();
+        indexed_mode_end();
+        expand_all();
+
+        uint32_t same_cnt = 0;
+        uint32_t i;
+        for(i = 0; i < HOR_RES * VER_RES; i++) {
+            uint32_t dist = color_dist(expanded[i], rendered[i]);
+            if(dist == 0) same_cnt++;
+            TEST_ASSERT_LESS_OR_EQUAL(dist_max[c], dist);
+        }
+
+        TEST_ASSERT_GREATER_THAN(HOR_RES * VER_RES * 95 / 100, same_cnt);
+
+        /*Inside the button*/
+        TEST_ASSERT_EQUAL_HEX32(lv_color_to32(rendered[70 * HOR_RES + 60]), lv_color_to32(expanded[70 * HOR_RES + 60]));
+    }
+}
+
+void test_disp_palette_partial_refresh(void)
+{
+    create_widgets();
+    lv_obj_t * label = lv_label_create(lv_scr_act());
+    lv_label_set_text(label, "Changed");
+    lv_obj_set_pos(label, 100, 400);
+
+    indexed_mode_begin(LV_IMG_CF_INDEXED_4BIT);
+    render();
+
+    /*Only the changed area is redrawn, the rest of the frame buffer is kept*/
+    uint8_t corner = indexed_buf[0];
+    indexed_buf[0] = ~corner;
+    lv_label_set_text(label, "Changed again");
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL_HEX8((uint8_t)~corner, indexed_buf[0]);
+    indexed_buf[0] = corner;
+    expand_all();
+    lv_memcpy(rendered, expanded, sizeof(rendered));
+
+    /*The same as redrawing the whole screen*/
+    render();
+    indexed_mode_end();
+    expand_all();
+    TEST_ASSERT_EQUAL_MEMORY(expanded, rendered, sizeof(rendered));
+}
+
+#endif
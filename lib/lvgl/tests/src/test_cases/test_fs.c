@@ -50,4 +50,44 @@ void test_read(void)
     lv_fs_close(&fb);
 }
 
+void test_read_after_seek_back(void)
+{
+    lv_fs_res_t res;
+    lv_fs_file_t f;
+    res = lv_fs_open(&f, "A:src/test_files/readtest.txt", LV_FS_MODE_RD);
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, res);
+
+    /*Fill the cache and read more than the cache's size to move the FS position far behind the cache*/
+    uint8_t buf[150];
+    uint32_t br;
+    res = lv_fs_read(&f, buf, 79, &br);
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, res);
+    res = lv_fs_read(&f, buf, 79, &br);
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, res);
+    res = lv_fs_read(&f, buf, 150, &br);
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, res);
+    TEST_ASSERT_TRUE(memcmp(buf, read_exp + 158, br) == 0);
+
+    /*Seek back into the cache and read over its end*/
+    res = lv_fs_seek(&f, 150, LV_FS_SEEK_SET);
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, res);
+    res = lv_fs_read(&f, buf, 79, &br);
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, res);
+    TEST_ASSERT_EQUAL(79, br);
+    TEST_ASSERT_TRUE(memcmp(buf, read_exp + 150, br) == 0);
+
+    /*Seek to the end of the cache*/
+    res = lv_fs_seek(&f, 300, LV_FS_SEEK_SET);
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, res);
+    res = lv_fs_read(&f, buf, 150, &br);
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, res);
+    res = lv_fs_seek(&f, 329, LV_FS_SEEK_SET);
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, res);
+    res = lv_fs_read(&f, buf, 20, &br);
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, res);
+    TEST_ASSERT_TRUE(memcmp(buf, read_exp + 329, br) == 0);
+
+    lv_fs_close(&f);
+}
+
 #endif
@@ -0,0 +1,225 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+#include <string.h>
+
+#if LV_GRAD_CACHE_DEF_SIZE != 0
+
+extern lv_color_t test_fb[];
+
+static lv_color_t ref_fb[800 * 480];
+#if _DITHER_GRADIENT
+static lv_color_t dither_fb[800 * 480];
+#endif
+
+static lv_obj_t * grad_obj_create(lv_coord_t x, lv_coord_t y, lv_coord_t w, lv_coord_t h, lv_grad_dir_t dir,
+                                  lv_color_t c1, lv_color_t c2)
+{
+    lv_obj_t * obj = lv_obj_create(lv_scr_act());
+    lv_obj_remove_style_all(obj);
+    lv_obj_set_pos(obj, x, y);
+    lv_obj_set_size(obj, w, h);
+    lv_obj_set_style_bg_opa(obj, LV_OPA_COVER, 0);
+    lv_obj_set_style_bg_color(obj, c1, 0);
+    lv_obj_set_style_bg_grad_color(obj, c2, 0);
+    lv_obj_set_style_bg_grad_dir(obj, dir, 0);
+    return obj;
+}
+
+static void create_objs(void)
+{
+    lv_obj_t * obj;
+    /*Same size but different colors*/
+    grad_obj_create(10, 10, 200, 60, LV_GRAD_DIR_HOR, lv_palette_main(LV_PALETTE_RED), lv_palette_main(LV_PALETTE_BLUE));
+    grad_obj_create(10, 80, 200, 60, LV_GRAD_DIR_HOR, lv_palette_main(LV_PALETTE_GREEN),
+                    lv_palette_main(LV_PALETTE_YELLOW));
+    grad_obj_create(220, 10, 60, 200, LV_GRAD_DIR_VER, lv_palette_main(LV_PALETTE_RED), lv_palette_main(LV_PALETTE_BLUE));
+    grad_obj_create(290, 10, 60, 200, LV_GRAD_DIR_VER, lv_color_white(), lv_color_black());
+
+    /*Same colors but different stops*/
+    obj = grad_obj_create(10, 150, 200, 60, LV_GRAD_DIR_HOR, lv_palette_main(LV_PALETTE_RED),
+                          lv_palette_main(LV_PALETTE_BLUE));
+    lv_obj_set_style_bg_main_stop(obj, 64, 0);
+    lv_obj_set_style_bg_grad_stop(obj, 200, 0);
+
+    /*Rounded and dithered with different sizes*/
+    obj = grad_obj_create(360, 10, 300, 100, LV_GRAD_DIR_VER, lv_palette_main(LV_PALETTE_TEAL),
+                          lv_palette_main(LV_PALETTE_DEEP_ORANGE));
+    lv_obj_set_style_radius(obj, 30, 0);
+    lv_obj_set_style_bg_dither_mode(obj, LV_DITHER_ORDERED, 0);
+
+    obj = grad_obj_create(360, 120, 400, 150, LV_GRAD_DIR_HOR, lv_palette_main(LV_PALETTE_TEAL),
+                          lv_palette_main(LV_PALETTE_DEEP_ORANGE));
+    lv_obj_set_style_radius(obj, LV_RADIUS_CIRCLE, 0);
+    lv_obj_set_style_bg_dither_mode(obj, LV_DITHER_ORDERED, 0);
+
+    obj = grad_obj_create(10, 280, 780, 190, LV_GRAD_DIR_VER, lv_palette_main(LV_PALETTE_INDIGO),
+                          lv_palette_main(LV_PALETTE_AMBER));
+    lv_obj_set_style_radius(obj, 10, 0);
+    lv_obj_set_style_bg_dither_mode(obj, LV_DITHER_ERR_DIFF, 0);
+}
+
+static void render(void)
+{
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+}
+
+void setUp(void)
+{
+    lv_gradient_set_cache_size(LV_GRAD_CACHE_DEF_SIZE);
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_scr_act());
+    lv_gradient_set_cache_size(LV_GRAD_CACHE_DEF_SIZE);
+}
+
+void test_gradient_cached_output_is_identical(void)
+{
+    create_objs();
+
+    /*Reference without cache*/
+    lv_gradient_set_cache_size(0);
+    render();
+    lv_memcpy(ref_fb, test_fb, sizeof(ref_fb));
+
+    /*The first draw fills the cache, the second one uses it*/
+    lv_gradient_set_cache_size(LV_GRAD_CACHE_DEF_SIZE);
+    render();
+    TEST_ASSERT_EQUAL_MEMORY(ref_fb, test_fb, sizeof(ref_fb));
+    render();
+    TEST_ASSERT_EQUAL_MEMORY(ref_fb, test_fb, sizeof(ref_fb));
+
+    /*Items are evicted and created again if the cache is small*/
+    lv_gradient_set_cache_size(1024);
+    render();
+    TEST_ASSERT_EQUAL_MEMORY(ref_fb, test_fb, sizeof(ref_fb));
+    render();
+    TEST_ASSERT_EQUAL_MEMORY(ref_fb, test_fb, sizeof(ref_fb));
+}
+
+void test_gradient_cache_key(void)
+{
+    lv_grad_dsc_t g1;
+    lv_memset_00(&g1, sizeof(g1));
+    g1.dir = LV_GRAD_DIR_HOR;
+    g1.stops_count = 2;
+    g1.stops[0].color = lv_palette_main(LV_PALETTE_RED);
+    g1.stops[0].frac = 0;
+    g1.stops[1].color = lv_palette_main(LV_PALETTE_BLUE);
+    g1.stops[1].frac = 255;
+
+    lv_grad_t * item1 = lv_gradient_get(&g1, 100, 50);
+    TEST_ASSERT_NOT_NULL(item1);
+    TEST_ASSERT_FALSE(item1->not_cached);
+
+    /*The same content from another address is found in the cache.
+     *The height doesn't matter for a horizontal gradient*/
+    lv_grad_dsc_t g2 = g1;
+    TEST_ASSERT_EQUAL_PTR(item1, lv_gradient_get(&g2, 100, 50));
+    TEST_ASSERT_EQUAL_PTR(item1, lv_gradient_get(&g2, 100, 80));
+
+    /*Anything else that changes the map creates a new item*/
+    TEST_ASSERT_NOT_EQUAL(item1, lv_gradient_get(&g2, 120, 50));
+
+    g2.stops[1].color = lv_palette_main(LV_PALETTE_GREEN);
+    TEST_ASSERT_NOT_EQUAL(item1, lv_gradient_get(&g2, 100, 50));
+
+    g2 = g1;
+    g2.stops[1].frac = 200;
+    TEST_ASSERT_NOT_EQUAL(item1, lv_gradient_get(&g2, 100, 50));
+
+    g2 = g1;
+    g2.dir = LV_GRAD_DIR_VER;
+    lv_grad_t * item2 = lv_gradient_get(&g2, 100, 50);
+    TEST_ASSERT_NOT_EQUAL(item1, item2);
+    TEST_ASSERT_EQUAL(50, item2->size);
+
+    /*The first item is still in the cache*/
+    TEST_ASSERT_EQUAL_PTR(item1, lv_gradient_get(&g1, 100, 50));
+    TEST_ASSERT_EQUAL_COLOR(lv_palette_main(LV_PALETTE_RED), item1->map[0]);
+}
+
+void test_gradient_dithered(void)
+{
+#if _DITHER_GRADIENT
+    lv_grad_dsc_t g;
+    lv_memset_00(&g, sizeof(g));
+    g.dir = LV_GRAD_DIR_VER;
+    g.stops_count = 2;
+    g.stops[0].color = lv_palette_main(LV_PALETTE_TEAL);
+    g.stops[0].frac = 0;
+    g.stops[1].color = lv_palette_main(LV_PALETTE_DEEP_ORANGE);
+    g.stops[1].frac = 255;
+
+    /*The dither mode is part of the key and dithered vertical maps depend on the width too*/
+    lv_grad_t * item1 = lv_gradient_get(&g, 100, 50);
+    TEST_ASSERT_EQUAL_PTR(item1, lv_gradient_get(&g, 120, 50));
+    g.dither = LV_DITHER_ORDERED;
+    lv_grad_t * item2 = lv_gradient_get(&g, 100, 50);
+    TEST_ASSERT_NOT_EQUAL(item1, item2);
+    TEST_ASSERT_NOT_NULL(item2->dither_map);
+    TEST_ASSERT_EQUAL_PTR(item2, lv_gradient_get(&g, 100, 50));
+    TEST_ASSERT_NOT_EQUAL(item2, lv_gradient_get(&g, 120, 50));
+
+    /*Dithering really changes the output, so comparing the cached and uncached rendering is meaningful*/
+    lv_obj_t * obj = grad_obj_create(0, 0, 800, 480, LV_GRAD_DIR_VER, lv_palette_main(LV_PALETTE_TEAL),
+                                     lv_palette_main(LV_PALETTE_DEEP_ORANGE));
+    render();
+    lv_memcpy(ref_fb, test_fb, sizeof(ref_fb));
+
+    lv_dither_mode_t modes[] = {LV_DITHER_ORDERED,
+#if LV_DITHER_ERROR_DIFFUSION
+                                LV_DITHER_ERR_DIFF
+#endif
+                               };
+    uint32_t i;
+    for(i = 0; i < sizeof(modes) / sizeof(modes[0]); i++) {
+        lv_obj_set_style_bg_dither_mode(obj, modes[i], 0);
+        lv_gradient_set_cache_size(0);
+        render();
+        TEST_ASSERT_TRUE(memcmp(ref_fb, test_fb, sizeof(ref_fb)) != 0);
+        lv_memcpy(dither_fb, test_fb, sizeof(dither_fb));
+
+        lv_gradient_set_cache_size(LV_GRAD_CACHE_DEF_SIZE);
+        render();
+        TEST_ASSERT_EQUAL_MEMORY(dither_fb, test_fb, sizeof(dither_fb));
+        render();
+        TEST_ASSERT_EQUAL_MEMORY(dither_fb, test_fb, sizeof(dither_fb));
+    }
+#endif
+}
+
+#else
+
+void setUp(void)
+{
+
+}
+
+void tearDown(void)
+{
+
+}
+
+void test_gradient_cached_output_is_identical(void)
+{
+
+}
+
+void test_gradient_cache_key(void)
+{
+
+}
+
+void test_gradient_dithered(void)
+{
+
+}
+
+#endif
+
+#endif
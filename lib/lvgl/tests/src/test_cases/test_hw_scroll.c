@@ -0,0 +1,267 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#define HOR_RES 800
+#define VER_RES 480
+
+extern lv_color_t test_fb[];
+
+/*Simulated memory of a display controller with vertical scrolling (e.g. VSCRDEF and VSCRSADD of
+ *the ST7789). The rows of the scroll area are shown from an offset and wrap round.*/
+static lv_color_t gram[HOR_RES * VER_RES];
+static lv_color_t shown[HOR_RES * VER_RES];
+static lv_coord_t scroll_top;
+static lv_coord_t scroll_h;
+static lv_coord_t scroll_ofs;
+static bool scroll_fail;
+static uint32_t scroll_cnt;
+static uint32_t flushed_px;
+
+static void (*orig_flush_cb)(lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t * color_p);
+
+static lv_coord_t gram_row(lv_coord_t y)
+{
+    if(y < scroll_top || y >= scroll_top + scroll_h) return y;
+    return scroll_top + (y - scroll_top + scroll_ofs) % scroll_h;
+}
+
+static void gram_flush_cb(lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t * color_p)
+{
+    lv_coord_t w = lv_area_get_width(area);
+    lv_coord_t y;
+    for(y = area->y1; y <= area->y2; y++) {
+        lv_memcpy(&gram[gram_row(y) * HOR_RES + area->x1], color_p, w * sizeof(lv_color_t));
+        color_p += w;
+    }
+
+    flushed_px += lv_area_get_size(area);
+    lv_disp_flush_ready(disp_drv);
+}
+
+static bool gram_scroll_cb(lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_coord_t dy)
+{
+    LV_UNUSED(disp_drv);
+    TEST_ASSERT_EQUAL(0, area->x1);
+    TEST_ASSERT_EQUAL(HOR_RES - 1, area->x2);
+
+    scroll_cnt++;
+    if(scroll_fail) return false;
+
+    /*A new area starts from offset 0*/
+    if(area->y1 != scroll_top || lv_area_get_height(area) != scroll_h) {
+        scroll_top = area->y1;
+        scroll_h = lv_area_get_height(area);
+        scroll_ofs = 0;
+    }
+
+    scroll_ofs = ((scroll_ofs - dy) % scroll_h + scroll_h) % scroll_h;
+    return true;
+}
+
+/*Check the rows shown by the display against a normal rendering of the whole screen*/
+static void check_shown(void)
+{
+    lv_coord_t y;
+    for(y = 0; y < VER_RES; y++) {
+        lv_memcpy(&shown[y * HOR_RES], &gram[gram_row(y) * HOR_RES], HOR_RES * sizeof(lv_color_t));
+    }
+
+    lv_disp_drv_t * drv = lv_disp_get_default()->driver;
+    drv->flush_cb = orig_flush_cb;
+    drv->hw_scroll_cb = NULL;
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+    drv->flush_cb = gram_flush_cb;
+    drv->hw_scroll_cb = gram_scroll_cb;
+
+    TEST_ASSERT_EQUAL_MEMORY(test_fb, shown, sizeof(shown));
+}
+
+static void render(void)
+{
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+}
+
+static lv_obj_t * list_create(lv_coord_t y, lv_coord_t w, lv_coord_t h)
+{
+    lv_obj_t * list = lv_obj_create(lv_scr_act());
+    lv_obj_set_pos(list, 0, y);
+    lv_obj_set_size(list, w, h);
+    lv_obj_set_style_radius(list, 0, 0);
+    lv_obj_set_style_border_side(list, LV_BORDER_SIDE_TOP | LV_BORDER_SIDE_BOTTOM, 0);
+    lv_obj_set_flex_flow(list, LV_FLEX_FLOW_COLUMN);
+    lv_obj_add_flag(list, LV_OBJ_FLAG_HW_SCROLL);
+
+    uint32_t i;
+    for(i = 0; i < 30; i++) {
+        lv_obj_t * btn = lv_btn_create(list);
+        lv_obj_set_width(btn, lv_pct(100));
+        lv_obj_t * label = lv_label_create(btn);
+        lv_label_set_text_fmt(label, "Network %d", (int)i);
+    }
+
+    return list;
+}
+
+void setUp(void)
+{
+    lv_disp_drv_t * drv = lv_disp_get_default()->driver;
+    orig_flush_cb = drv->flush_cb;
+    drv->flush_cb = gram_flush_cb;
+    drv->hw_scroll_cb = gram_scroll_cb;
+
+    scroll_top = 0;
+    scroll_h = 0;
+    scroll_ofs = 0;
+    scroll_fail = false;
+    scroll_cnt = 0;
+
+    lv_obj_t * title = lv_label_create(lv_scr_act());
+    lv_label_set_text(title, "Title above the scrolled area");
+}
+
+void tearDown(void)
+{
+    lv_disp_drv_t * drv = lv_disp_get_default()->driver;
+    drv->flush_cb = orig_flush_cb;
+    drv->hw_scroll_cb = NULL;
+    lv_obj_clean(lv_scr_act());
+}
+
+void test_hw_scroll_redraws_only_uncovered_rows(void)
+{
+    lv_obj_t * list = list_create(60, HOR_RES, 300);
+    lv_obj_set_scrollbar_mode(list, LV_SCROLLBAR_MODE_OFF);
+    render();
+
+    lv_obj_scroll_by(list, 0, -10, LV_ANIM_OFF);
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL(1, scroll_cnt);
+    check_shown();
+
+    /*The area inside the top and bottom border is moved*/
+    lv_coord_t border_w = lv_obj_get_style_border_width(list, LV_PART_MAIN);
+    lv_coord_t area_h = 300 - 2 * border_w;
+    const lv_coord_t steps[] = {-20, -7, -1, -50, 33, 1, -120, 60, -area_h + 1};
+    uint32_t i;
+    for(i = 0; i < sizeof(steps) / sizeof(steps[0]); i++) {
+        flushed_px = 0;
+        lv_obj_scroll_by(list, 0, steps[i], LV_ANIM_OFF);
+        lv_refr_now(NULL);
+        TEST_ASSERT_EQUAL(LV_ABS(steps[i]) * HOR_RES, flushed_px);
+        check_shown();
+    }
+
+    /*Scrolling more than the area's height redraws the whole object*/
+    flushed_px = 0;
+    lv_obj_scroll_by(list, 0, area_h + 5, LV_ANIM_OFF);
+    lv_refr_now(NULL);
+    TEST_ASSERT_GREATER_OR_EQUAL(300 * HOR_RES, flushed_px);
+    check_shown();
+}
+
+void test_hw_scroll_many_scrolls_in_a_refresh(void)
+{
+    lv_obj_t * list = list_create(60, HOR_RES, 300);
+    render();
+    lv_obj_scroll_by(list, 0, -10, LV_ANIM_OFF);
+    lv_refr_now(NULL);
+
+    /*The changed parts which are not redrawn yet are moved with the content and the scrollbar is redrawn*/
+    lv_obj_t * label = lv_obj_get_child(lv_obj_get_child(list, 3), 0);
+    lv_label_set_text(label, "Changed before the scroll");
+    lv_obj_scroll_by(list, 0, -15, LV_ANIM_OFF);
+    lv_obj_scroll_by(list, 0, -40, LV_ANIM_OFF);
+    lv_label_set_text(label, "Changed between the scrolls");
+    lv_obj_scroll_by(list, 0, 22, LV_ANIM_OFF);
+    uint32_t cnt = scroll_cnt;
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL(cnt + 1, scroll_cnt);
+    check_shown();
+
+    /*Scrolling back and forth doesn't need the display to scroll*/
+    lv_obj_scroll_by(list, 0, -30, LV_ANIM_OFF);
+    lv_obj_scroll_by(list, 0, 30, LV_ANIM_OFF);
+    cnt = scroll_cnt;
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL(cnt, scroll_cnt);
+    check_shown();
+}
+
+void test_hw_scroll_two_areas(void)
+{
+    lv_obj_t * list1 = list_create(40, HOR_RES, 200);
+    lv_obj_t * list2 = list_create(250, HOR_RES, 200);
+    render();
+
+    lv_obj_scroll_by(list1, 0, -30, LV_ANIM_OFF);
+    lv_refr_now(NULL);
+    check_shown();
+    lv_obj_scroll_by(list1, 0, -30, LV_ANIM_OFF);
+    lv_refr_now(NULL);
+    check_shown();
+
+    /*The display resets the scroll of the first area when the second one is scrolled*/
+    lv_obj_scroll_by(list2, 0, -25, LV_ANIM_OFF);
+    lv_refr_now(NULL);
+    check_shown();
+    lv_obj_scroll_by(list2, 0, -25, LV_ANIM_OFF);
+    lv_refr_now(NULL);
+    check_shown();
+
+    /*Only one of them can be moved in a refresh*/
+    lv_obj_scroll_by(list2, 0, 10, LV_ANIM_OFF);
+    lv_obj_scroll_by(list1, 0, 10, LV_ANIM_OFF);
+    lv_refr_now(NULL);
+    check_shown();
+}
+
+void test_hw_scroll_not_used(void)
+{
+    /*Not as wide as the display*/
+    lv_obj_t * list = list_create(60, HOR_RES - 100, 300);
+    render();
+    lv_obj_scroll_by(list, 0, -30, LV_ANIM_OFF);
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL(0, scroll_cnt);
+    check_shown();
+
+    /*Background which can't be moved*/
+    lv_obj_set_width(list, HOR_RES);
+    lv_obj_set_style_bg_grad_dir(list, LV_GRAD_DIR_VER, 0);
+    lv_obj_set_style_bg_grad_color(list, lv_palette_main(LV_PALETTE_RED), 0);
+    render();
+    lv_obj_scroll_by(list, 0, -30, LV_ANIM_OFF);
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL(0, scroll_cnt);
+    check_shown();
+
+    /*Horizontal scroll*/
+    lv_obj_set_style_bg_grad_dir(list, LV_GRAD_DIR_NONE, 0);
+    render();
+    lv_obj_scroll_by(list, -5, -30, LV_ANIM_OFF);
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL(0, scroll_cnt);
+    check_shown();
+}
+
+void test_hw_scroll_fails(void)
+{
+    lv_obj_t * list = list_create(60, HOR_RES, 300);
+    render();
+    lv_obj_scroll_by(list, 0, -30, LV_ANIM_OFF);
+    lv_refr_now(NULL);
+    check_shown();
+
+    /*The display can't scroll so the whole area is drawn again*/
+    scroll_fail = true;
+    lv_obj_scroll_by(list, 0, -30, LV_ANIM_OFF);
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL(2, scroll_cnt);
+    check_shown();
+}
+
+#endif
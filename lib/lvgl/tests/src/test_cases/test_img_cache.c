@@ -0,0 +1,245 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#if LV_IMG_CACHE_DEF_SIZE
+
+/*A decoder for "Z:<size>" sources which can provide the pixels only line-by-line*/
+static lv_img_decoder_t * decoder;
+static uint32_t info_cnt;
+static uint32_t open_cnt;
+static uint32_t read_line_cnt;
+static uint32_t alloc_cnt;
+static uint32_t free_cnt;
+
+static lv_res_t fake_info(lv_img_decoder_t * dec, const void * src, lv_img_header_t * header)
+{
+    LV_UNUSED(dec);
+    if(lv_img_src_get_type(src) != LV_IMG_SRC_FILE) return LV_RES_INV;
+    if(strncmp(src, "Z:", 2) != 0) return LV_RES_INV;
+
+    info_cnt++;
+    int size = atoi((const char *)src + 2);
+    header->always_zero = 0;
+    header->cf = LV_IMG_CF_TRUE_COLOR;
+    header->w = size;
+    header->h = size;
+    return LV_RES_OK;
+}
+
+static lv_res_t fake_open(lv_img_decoder_t * dec, lv_img_decoder_dsc_t * dsc)
+{
+    LV_UNUSED(dec);
+    open_cnt++;
+    dsc->img_data = NULL;
+    return LV_RES_OK;
+}
+
+static lv_res_t fake_read_line(lv_img_decoder_t * dec, lv_img_decoder_dsc_t * dsc,
+                               lv_coord_t x, lv_coord_t y, lv_coord_t len, uint8_t * buf)
+{
+    LV_UNUSED(dec);
+    LV_UNUSED(dsc);
+    LV_UNUSED(x);
+    read_line_cnt++;
+
+    lv_color_t * px = (lv_color_t *)buf;
+    lv_coord_t i;
+    for(i = 0; i < len; i++) {
+        px[i] = y == 0 ? lv_color_hex(0xff0000) : lv_color_hex(0x0000ff);
+    }
+    return LV_RES_OK;
+}
+
+static void * counting_alloc(size_t size)
+{
+    alloc_cnt++;
+    return malloc(size);
+}
+
+static void counting_free(void * p)
+{
+    free_cnt++;
+    free(p);
+}
+
+static lv_obj_t * img_create(const char * src, lv_coord_t y)
+{
+    lv_obj_t * img = lv_img_create(lv_scr_act());
+    lv_img_set_src(img, src);
+    lv_obj_set_pos(img, 0, y);
+    return img;
+}
+
+void setUp(void)
+{
+    decoder = lv_img_decoder_create();
+    lv_img_decoder_set_info_cb(decoder, fake_info);
+    lv_img_decoder_set_open_cb(decoder, fake_open);
+    lv_img_decoder_set_read_line_cb(decoder, fake_read_line);
+
+    lv_img_cache_invalidate_src(NULL);
+    lv_img_cache_set_decoded_budget(64 * 1024);
+    lv_img_cache_reset_stats();
+
+    info_cnt = 0;
+    open_cnt = 0;
+    read_line_cnt = 0;
+    alloc_cnt = 0;
+    free_cnt = 0;
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_scr_act());
+    lv_img_cache_invalidate_src(NULL);
+    lv_img_cache_set_decoded_alloc_cb(NULL, NULL);
+    lv_img_decoder_delete(decoder);
+}
+
+void test_small_image_is_drawn_without_decoder_calls(void)
+{
+    lv_obj_t * img = img_create("Z:16", 0);
+    lv_refr_now(NULL);
+
+    TEST_ASSERT_EQUAL(1, open_cnt);
+    TEST_ASSERT_EQUAL(16, read_line_cnt);
+
+    info_cnt = 0;
+    open_cnt = 0;
+    read_line_cnt = 0;
+    lv_img_cache_reset_stats();
+
+    lv_obj_invalidate(img);
+    lv_refr_now(NULL);
+    lv_obj_invalidate(img);
+    lv_refr_now(NULL);
+
+    TEST_ASSERT_EQUAL(0, info_cnt);
+    TEST_ASSERT_EQUAL(0, open_cnt);
+    TEST_ASSERT_EQUAL(0, read_line_cnt);
+
+    lv_img_cache_stats_t stats;
+    lv_img_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL(2, stats.hit);
+    TEST_ASSERT_EQUAL(0, stats.miss);
+    TEST_ASSERT_EQUAL(1, stats.decoded_cnt);
+    TEST_ASSERT_EQUAL(16 * 16 * sizeof(lv_color_t), stats.decoded_size);
+}
+
+void test_decoded_image_has_the_decoded_pixels(void)
+{
+    _lv_img_cache_entry_t * entry = _lv_img_cache_open("Z:8", lv_color_black(), 0);
+    TEST_ASSERT_NOT_NULL(entry);
+    TEST_ASSERT_NOT_NULL(entry->dec_dsc.img_data);
+
+    const lv_color_t * px = (const lv_color_t *)entry->dec_dsc.img_data;
+    TEST_ASSERT_EQUAL_COLOR(lv_color_hex(0xff0000), px[0]);
+    TEST_ASSERT_EQUAL_COLOR(lv_color_hex(0xff0000), px[7]);
+    TEST_ASSERT_EQUAL_COLOR(lv_color_hex(0x0000ff), px[8]);
+    TEST_ASSERT_EQUAL_COLOR(lv_color_hex(0x0000ff), px[8 * 8 - 1]);
+}
+
+void test_large_image_is_read_line_by_line(void)
+{
+    /*100 x 100 pixels don't fit into the quarter of the budget*/
+    lv_obj_t * img = img_create("Z:100", 0);
+    lv_refr_now(NULL);
+
+    open_cnt = 0;
+    read_line_cnt = 0;
+
+    lv_obj_invalidate(img);
+    lv_refr_now(NULL);
+
+    TEST_ASSERT_EQUAL(0, open_cnt);
+    TEST_ASSERT_EQUAL(100, read_line_cnt);
+
+    lv_img_cache_stats_t stats;
+    lv_img_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL(0, stats.decoded_cnt);
+    TEST_ASSERT_EQUAL(0, stats.decoded_size);
+}
+
+void test_decoded_images_stay_in_the_budget(void)
+{
+    const uint32_t img_size = 16 * 16 * sizeof(lv_color_t);
+    lv_img_cache_set_decoded_budget(img_size * 4);
+
+    img_create("Z:16", 0);
+    img_create("Z:15", 20);
+    img_create("Z:14", 40);
+    img_create("Z:13", 60);
+    img_create("Z:12", 80);
+    img_create("Z:11", 100);
+    lv_refr_now(NULL);
+
+    lv_img_cache_stats_t stats;
+    lv_img_cache_get_stats(&stats);
+    TEST_ASSERT_LESS_OR_EQUAL(img_size * 4, stats.decoded_size);
+    TEST_ASSERT_GREATER_THAN(0, stats.decoded_cnt);
+
+    /*Shrinking the budget frees the decoded buffers*/
+    lv_img_cache_set_decoded_budget(0);
+    lv_img_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL(0, stats.decoded_cnt);
+    TEST_ASSERT_EQUAL(0, stats.decoded_size);
+}
+
+void test_decoded_images_use_the_custom_allocator(void)
+{
+    lv_img_cache_set_decoded_alloc_cb(counting_alloc, counting_free);
+
+    img_create("Z:16", 0);
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL(1, alloc_cnt);
+    TEST_ASSERT_EQUAL(0, free_cnt);
+
+    lv_img_cache_set_decoded_alloc_cb(NULL, NULL);
+    TEST_ASSERT_EQUAL(1, free_cnt);
+}
+
+#else /*LV_IMG_CACHE_DEF_SIZE*/
+
+void setUp(void)
+{
+
+}
+
+void tearDown(void)
+{
+
+}
+
+void test_small_image_is_drawn_without_decoder_calls(void)
+{
+
+}
+
+void test_decoded_image_has_the_decoded_pixels(void)
+{
+
+}
+
+void test_large_image_is_read_line_by_line(void)
+{
+
+}
+
+void test_decoded_images_stay_in_the_budget(void)
+{
+
+}
+
+void test_decoded_images_use_the_custom_allocator(void)
+{
+
+}
+
+#endif
+
+#endif
@@ -0,0 +1,397 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#if LV_USE_PNG && LV_USE_SJPG && LV_COLOR_DEPTH == 32
+
+#include "../../src/extra/libs/png/lodepng.h"
+#include "../../src/extra/libs/sjpg/tjpgd.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/*The decoders are checked against a full decoding of the same file with the underlying library*/
+static uint8_t * file_data;
+static uint32_t file_size;
+static uint8_t * ref_rgb;      /*Reference pixels: RGBA for PNG, RGB for JPG*/
+static uint32_t ref_w;
+static uint32_t ref_h;
+
+static void load_file(const char * path)
+{
+    FILE * f = fopen(path, "rb");
+    TEST_ASSERT_NOT_NULL(f);
+    fseek(f, 0, SEEK_END);
+    file_size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    file_data = malloc(file_size);
+    TEST_ASSERT_EQUAL(file_size, fread(file_data, 1, file_size, f));
+    fclose(f);
+}
+
+static size_t jpg_in(JDEC * jd, uint8_t * buf, size_t len)
+{
+    uint32_t * pos = jd->device;
+    if(len > file_size - *pos) len = file_size - *pos;
+    if(buf) memcpy(buf, file_data + *pos, len);
+    *pos += len;
+    return len;
+}
+
+static int jpg_out(JDEC * jd, void * data, JRECT * rect)
+{
+    LV_UNUSED(jd);
+    uint8_t * px = data;
+    uint32_t y;
+    for(y = rect->top; y <= rect->bottom; y++) {
+        uint32_t row_size = (rect->right - rect->left + 1) * 3;
+        memcpy(ref_rgb + (y * ref_w + rect->left) * 3, px, row_size);
+        px += row_size;
+    }
+    return 1;
+}
+
+static void jpg_ref_decode(uint8_t scale)
+{
+    uint8_t * work = malloc(4096);
+    JDEC jd;
+    uint32_t pos = 0;
+    TEST_ASSERT_EQUAL(JDR_OK, jd_prepare(&jd, jpg_in, work, 4096, &pos));
+    ref_w = jd.width >> scale;
+    ref_h = jd.height >> scale;
+    ref_rgb = malloc(ref_w * ref_h * 3);
+    TEST_ASSERT_EQUAL(JDR_OK, jd_decomp(&jd, jpg_out, scale));
+    free(work);
+}
+
+/*Decode the JPG fragments of an SJPG one by one below each other*/
+static uint32_t sjpg_frame_y;
+
+static int sjpg_out(JDEC * jd, void * data, JRECT * rect)
+{
+    JRECT r = *rect;
+    r.top += sjpg_frame_y;
+    r.bottom += sjpg_frame_y;
+    return jpg_out(jd, data, &r);
+}
+
+static void sjpg_ref_decode(uint8_t scale)
+{
+    const uint8_t * d = file_data;
+    uint32_t frame_cnt = d[18] | (d[19] << 8);
+    uint32_t frame_h = d[20] | (d[21] << 8);
+    ref_w = (d[14] | (d[15] << 8)) >> scale;
+    ref_h = (d[16] | (d[17] << 8)) >> scale;
+    ref_rgb = malloc(ref_w * ref_h * 3);
+
+    uint8_t * work = malloc(4096);
+    uint32_t ofs = 22 + frame_cnt * 2;
+    uint32_t i;
+    for(i = 0; i < frame_cnt; i++) {
+        /*Decode from a copy starting at the fragment*/
+        JDEC jd;
+        uint32_t pos = ofs;
+        sjpg_frame_y = i * (frame_h >> scale);
+        TEST_ASSERT_EQUAL(JDR_OK, jd_prepare(&jd, jpg_in, work, 4096, &pos));
+        TEST_ASSERT_EQUAL(JDR_OK, jd_decomp(&jd, sjpg_out, scale));
+        if(i < frame_cnt - 1) ofs += d[22 + i * 2] | (d[23 + i * 2] << 8);
+    }
+    free(work);
+}
+
+static void png_ref_decode(void)
+{
+    unsigned w, h;
+    unsigned char * rgba;
+    TEST_ASSERT_EQUAL(0, lodepng_decode32(&rgba, &w, &h, file_data, file_size));
+    ref_w = w;
+    ref_h = h;
+    ref_rgb = malloc(w * h * 4);
+    memcpy(ref_rgb, rgba, w * h * 4);
+    lv_mem_free(rgba);
+}
+
+static void check_line(lv_img_decoder_dsc_t * dsc, bool png, lv_coord_t x, lv_coord_t y, lv_coord_t len)
+{
+    lv_color32_t buf[512];
+    TEST_ASSERT_LESS_OR_EQUAL(512, len);
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_read_line(dsc, x, y, len, (uint8_t *)buf));
+
+    lv_coord_t i;
+    for(i = 0; i < len; i++) {
+        uint32_t px = y * ref_w + x + i;
+        if(png) {
+            TEST_ASSERT_EQUAL_HEX8(ref_rgb[px * 4 + 0], buf[i].ch.red);
+            TEST_ASSERT_EQUAL_HEX8(ref_rgb[px * 4 + 1], buf[i].ch.green);
+            TEST_ASSERT_EQUAL_HEX8(ref_rgb[px * 4 + 2], buf[i].ch.blue);
+            TEST_ASSERT_EQUAL_HEX8(ref_rgb[px * 4 + 3], buf[i].ch.alpha);
+        }
+        else {
+            TEST_ASSERT_EQUAL_HEX8(ref_rgb[px * 3 + 0], buf[i].ch.red);
+            TEST_ASSERT_EQUAL_HEX8(ref_rgb[px * 3 + 1], buf[i].ch.green);
+            TEST_ASSERT_EQUAL_HEX8(ref_rgb[px * 3 + 2], buf[i].ch.blue);
+        }
+    }
+}
+
+static void check_src(const void * src, bool png)
+{
+    lv_img_decoder_dsc_t dsc;
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_open(&dsc, src, lv_color_black(), 0));
+
+    /*Nothing is decoded in advance*/
+    TEST_ASSERT_NULL(dsc.img_data);
+    TEST_ASSERT_EQUAL(ref_w, dsc.header.w);
+    TEST_ASSERT_EQUAL(ref_h, dsc.header.h);
+
+    lv_coord_t y;
+    /*Top to bottom as the image is drawn*/
+    for(y = 0; y < (lv_coord_t)ref_h; y++) check_line(&dsc, png, 0, y, ref_w);
+
+    /*Bottom to top needs to go back for each line*/
+    for(y = ref_h - 1; y >= 0; y--) check_line(&dsc, png, 1, y, ref_w - 3);
+
+    /*Jumping around and reading the same line again*/
+    for(y = 0; y < (lv_coord_t)ref_h; y++) {
+        lv_coord_t y2 = (y * 7) % ref_h;
+        check_line(&dsc, png, 2, y2, 5);
+        check_line(&dsc, png, 0, y2, ref_w);
+    }
+
+    lv_img_decoder_close(&dsc);
+}
+
+/*The scale is given by the sources, it's ignored for PNG*/
+static void check_loaded_file(const char * path, bool png, uint8_t scale)
+{
+    char fn[64];
+    if(scale) lv_snprintf(fn, sizeof(fn), "A:%s" LV_SJPG_SCALE_SUFFIX "%d", path, scale);
+    else lv_snprintf(fn, sizeof(fn), "A:%s", path);
+    check_src(fn, png);
+
+    fn[0] = 'B';
+    check_src(fn, png);
+
+    lv_img_dsc_t img_dsc;
+    lv_memset_00(&img_dsc, sizeof(img_dsc));
+    img_dsc.header.reserved = scale;
+    img_dsc.data = file_data;
+    img_dsc.data_size = file_size;
+    check_src(&img_dsc, png);
+}
+
+static void check_file(const char * path, bool png)
+{
+    load_file(path);
+    if(png) png_ref_decode();
+    else jpg_ref_decode(0);
+    check_loaded_file(path, png, 0);
+}
+
+static void check_jpg_scaled(const char * path, bool sjpg, uint8_t scale)
+{
+    load_file(path);
+    if(sjpg) sjpg_ref_decode(scale);
+    else jpg_ref_decode(scale);
+
+    check_loaded_file(path, false, scale);
+
+    free(file_data);
+    free(ref_rgb);
+    file_data = NULL;
+    ref_rgb = NULL;
+}
+
+void setUp(void)
+{
+    file_data = NULL;
+    ref_rgb = NULL;
+}
+
+void tearDown(void)
+{
+    free(file_data);
+    free(ref_rgb);
+}
+
+void test_jpg_read_line(void)
+{
+    check_file("src/test_files/eye_80x64.jpg", false);
+}
+
+void test_jpg_scaled_read_line(void)
+{
+    uint8_t scale;
+    for(scale = 1; scale <= 3; scale++) {
+        check_jpg_scaled("src/test_files/eye_80x64.jpg", false, scale);
+    }
+}
+
+void test_jpg_partial_mcus_and_restarts(void)
+{
+    /*75x50 pixels with 16x16 MCUs and a restart interval of 3 MCUs*/
+    uint8_t scale;
+    for(scale = 0; scale <= 3; scale++) {
+        check_jpg_scaled("src/test_files/thumb_75x50.jpg", false, scale);
+    }
+}
+
+void test_sjpg_scaled_read_line(void)
+{
+    uint8_t scale;
+    for(scale = 0; scale <= 3; scale++) {
+        check_jpg_scaled("src/test_files/small_image.sjpg", true, scale);
+    }
+}
+
+void test_jpg_scale_reduced(void)
+{
+    /*1/8 of 6x20 would be 0x2 pixels so it's decoded at 1/4 instead*/
+    load_file("src/test_files/tiny_6x20.jpg");
+    jpg_ref_decode(2);
+    TEST_ASSERT_EQUAL(1, ref_w);
+    TEST_ASSERT_EQUAL(5, ref_h);
+
+    lv_img_dsc_t img_dsc;
+    lv_memset_00(&img_dsc, sizeof(img_dsc));
+    img_dsc.data = file_data;
+    img_dsc.data_size = file_size;
+    img_dsc.header.reserved = 3;
+
+    lv_img_decoder_dsc_t dsc;
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_open(&dsc, &img_dsc, lv_color_black(), 0));
+    TEST_ASSERT_EQUAL(1, dsc.header.w);
+    TEST_ASSERT_EQUAL(5, dsc.header.h);
+    lv_coord_t y;
+    for(y = 4; y >= 0; y--) check_line(&dsc, false, 0, y, 1);
+    lv_img_decoder_close(&dsc);
+
+    /*Larger values are the same as 1/8*/
+    lv_img_header_t header;
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_get_info("A:src/test_files/thumb_75x50.jpg?scale=9", &header));
+    TEST_ASSERT_EQUAL(9, header.w);
+    TEST_ASSERT_EQUAL(6, header.h);
+}
+
+void test_jpg_two_scales_side_by_side(void)
+{
+    /*Both sizes are open at the same time and read line by line in turns as they are drawn*/
+    load_file("src/test_files/eye_80x64.jpg");
+    jpg_ref_decode(0);
+    uint8_t * full_rgb = ref_rgb;
+    jpg_ref_decode(1);
+    uint8_t * half_rgb = ref_rgb;
+
+    lv_img_decoder_dsc_t full;
+    lv_img_decoder_dsc_t half;
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_open(&full, "A:src/test_files/eye_80x64.jpg", lv_color_black(), 0));
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_open(&half, "A:src/test_files/eye_80x64.jpg?scale=1", lv_color_black(),
+                                                     0));
+    TEST_ASSERT_EQUAL(80, full.header.w);
+    TEST_ASSERT_EQUAL(64, full.header.h);
+    TEST_ASSERT_EQUAL(40, half.header.w);
+    TEST_ASSERT_EQUAL(32, half.header.h);
+
+    lv_coord_t y;
+    for(y = 0; y < 64; y++) {
+        ref_rgb = full_rgb;
+        ref_w = 80;
+        check_line(&full, false, 0, y, 80);
+        ref_rgb = half_rgb;
+        ref_w = 40;
+        check_line(&half, false, 0, y / 2, 40);
+    }
+    lv_img_decoder_close(&full);
+    lv_img_decoder_close(&half);
+
+    /*The image objects and the image cache keep them apart too*/
+    lv_obj_t * img_full = lv_img_create(lv_scr_act());
+    lv_obj_t * img_half = lv_img_create(lv_scr_act());
+    lv_img_set_src(img_full, "A:src/test_files/eye_80x64.jpg");
+    lv_img_set_src(img_half, "A:src/test_files/eye_80x64.jpg?scale=1");
+    lv_obj_update_layout(lv_scr_act());
+    TEST_ASSERT_EQUAL(80, lv_obj_get_width(img_full));
+    TEST_ASSERT_EQUAL(40, lv_obj_get_width(img_half));
+    lv_refr_now(NULL);
+    lv_obj_del(img_full);
+    lv_obj_del(img_half);
+
+    free(full_rgb);
+}
+
+void test_png_read_line(void)
+{
+    check_file("src/test_files/eagle_eye.png", true);
+}
+
+void test_png_palette_fixed_codes_small_window(void)
+{
+    check_file("src/test_files/stream_palette.png", true);
+}
+
+void test_png_16bit_stored_blocks_multiple_idat(void)
+{
+    check_file("src/test_files/stream_gray16.png", true);
+}
+
+#else
+
+void setUp(void)
+{
+
+}
+
+void tearDown(void)
+{
+
+}
+
+void test_jpg_read_line(void)
+{
+
+}
+
+void test_jpg_scaled_read_line(void)
+{
+
+}
+
+void test_jpg_partial_mcus_and_restarts(void)
+{
+
+}
+
+void test_sjpg_scaled_read_line(void)
+{
+
+}
+
+void test_jpg_scale_reduced(void)
+{
+
+}
+
+void test_jpg_two_scales_side_by_side(void)
+{
+
+}
+
+void test_png_read_line(void)
+{
+
+}
+
+void test_png_palette_fixed_codes_small_window(void)
+{
+
+}
+
+void test_png_16bit_stored_blocks_multiple_idat(void)
+{
+
+}
+
+#endif
+
+#endif
@@ -0,0 +1,275 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#if LV_USE_SJPG
+
+#include "../../src/extra/libs/sjpg/tjpgd.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+
+/*Conformance of the TJpgDec back end (IDCT, scaling and color conversion).
+ *The pattern_*.jpg and thumb_75x50.jpg files are encoded from pattern_px() below.*/
+
+typedef struct {
+    const char * path;
+    uint32_t hash[4];       /*FNV-1a of the RGB888 output at 1/1, 1/2, 1/4 and 1/8 scale*/
+} jpg_file_t;
+
+static uint8_t * file_data;
+static uint32_t file_size;
+static uint8_t * out_rgb;
+static uint32_t out_w;
+static uint32_t out_h;
+
+static void load_file(const char * path)
+{
+    FILE * f = fopen(path, "rb");
+    TEST_ASSERT_NOT_NULL(f);
+    fseek(f, 0, SEEK_END);
+    file_size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    file_data = malloc(file_size);
+    TEST_ASSERT_EQUAL(file_size, fread(file_data, 1, file_size, f));
+    fclose(f);
+}
+
+static size_t jpg_in(JDEC * jd, uint8_t * buf, size_t len)
+{
+    uint32_t * pos = jd->device;
+    if(len > file_size - *pos) len = file_size - *pos;
+    if(buf) memcpy(buf, file_data + *pos, len);
+    *pos += len;
+    return len;
+}
+
+static int jpg_out(JDEC * jd, void * data, JRECT * rect)
+{
+    LV_UNUSED(jd);
+    uint8_t * px = data;
+    uint32_t y;
+    for(y = rect->top; y <= rect->bottom; y++) {
+        uint32_t row_size = (rect->right - rect->left + 1) * 3;
+        memcpy(out_rgb + (y * out_w + rect->left) * 3, px, row_size);
+        px += row_size;
+    }
+    return 1;
+}
+
+static void decode(uint8_t scale)
+{
+    static uint8_t work[4096];
+    JDEC jd;
+    uint32_t pos = 0;
+    TEST_ASSERT_EQUAL(JDR_OK, jd_prepare(&jd, jpg_in, work, sizeof(work), &pos));
+    out_w = jd.width >> scale;
+    out_h = jd.height >> scale;
+    free(out_rgb);
+    out_rgb = calloc(out_w * out_h, 3);
+    TEST_ASSERT_EQUAL(JDR_OK, jd_decomp(&jd, jpg_out, scale));
+}
+
+static uint32_t hash_rgb(void)
+{
+    uint32_t h = 2166136261u;
+    uint32_t i;
+    for(i = 0; i < out_w * out_h * 3; i++) h = (h ^ out_rgb[i]) * 16777619u;
+    return h;
+}
+
+/*The image the test JPGs were encoded from*/
+static void pattern_px(int32_t x, int32_t y, int32_t w, int32_t h, uint8_t * rgb)
+{
+    double dx = x - w * 0.4;
+    double dy = y - h * 0.5;
+    double r = LV_MIN(w, h) * 0.3;
+    rgb[0] = x * 255 / LV_MAX(w - 1, 1);
+    rgb[1] = y * 255 / LV_MAX(h - 1, 1);
+    rgb[2] = 128;
+    if(dx * dx + dy * dy < r * r) {
+        rgb[0] = 250;
+        rgb[1] = 240;
+        rgb[2] = 30;
+    }
+    if(((x / 6 + y / 6) % 2) && x > w * 0.7) {
+        rgb[0] = 20;
+        rgb[1] = 30;
+        rgb[2] = 200;
+    }
+    if(LV_ABS(x - y) < 2) {
+        rgb[0] = 255;
+        rgb[1] = 255;
+        rgb[2] = 255;
+    }
+}
+
+/*Box filtered pattern at 1/2^scale size, gray is the luma only*/
+static void pattern_scaled(int32_t x, int32_t y, int32_t w, int32_t h, uint8_t scale, bool gray, double * rgb)
+{
+    int32_t n = 1 << scale;
+    int32_t i, j;
+    rgb[0] = rgb[1] = rgb[2] = 0;
+    for(j = 0; j < n; j++) {
+        for(i = 0; i < n; i++) {
+            uint8_t px[3];
+            pattern_px(x * n + i, y * n + j, w, h, px);
+            if(gray) {
+                double l = 0.299 * px[0] + 0.587 * px[1] + 0.114 * px[2];
+                px[0] = px[1] = px[2] = (uint8_t)(l + 0.5);
+            }
+            rgb[0] += px[0];
+            rgb[1] += px[1];
+            rgb[2] += px[2];
+        }
+    }
+    rgb[0] /= n * n;
+    rgb[1] /= n * n;
+    rgb[2] /= n * n;
+}
+
+static double psnr_to_pattern(int32_t w, int32_t h, uint8_t scale, bool gray)
+{
+    double se = 0;
+    uint32_t x, y, c;
+    for(y = 0; y < out_h; y++) {
+        for(x = 0; x < out_w; x++) {
+            double ref[3];
+            pattern_scaled(x, y, w, h, scale, gray, ref);
+            for(c = 0; c < 3; c++) {
+                double d = out_rgb[(y * out_w + x) * 3 + c] - ref[c];
+                se += d * d;
+            }
+        }
+    }
+
+    double mse = se / (out_w * out_h * 3);
+    return mse > 0 ? 10 * log10(255.0 * 255.0 / mse) : 99;
+}
+
+static const jpg_file_t files[] = {
+    {"src/test_files/thumb_75x50.jpg", {0xc3c563b9, 0x74b74f7d, 0xae35769d, 0xe58505a8}},
+    {"src/test_files/eye_80x64.jpg", {0x5931117a, 0x50f02fa6, 0x75903a4e, 0xd1fce51d}},
+    {"src/test_files/tiny_6x20.jpg", {0x14a013e3, 0x036dd25c, 0x20d467ee, 0x811c9dc5}},
+    {"src/test_files/pattern_44x36_444.jpg", {0xc00fef4a, 0x9fddce72, 0x76252cd7, 0xb7e2063f}},
+    {"src/test_files/pattern_37x22_gray.jpg", {0xbdf24194, 0xf91ab316, 0x218fc160, 0x9df35096}},
+    {"src/test_files/pattern_320x240.jpg", {0xb4ace90f, 0x0a6afb6a, 0x8b97d2d7, 0xd9b698ef}},
+};
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+    free(file_data);
+    free(out_rgb);
+    file_data = NULL;
+    out_rgb = NULL;
+}
+
+/*The output is the same with the portable C and the SIMD IDCT, update the hashes only if the output changes on purpose*/
+void test_tjpgd_bit_exact(void)
+{
+    uint32_t i;
+    uint8_t scale;
+    for(i = 0; i < sizeof(files) / sizeof(files[0]); i++) {
+        load_file(files[i].path);
+        for(scale = 0; scale < 4; scale++) {
+            decode(scale);
+            char msg[96];
+            lv_snprintf(msg, sizeof(msg), "%s 1/%d", files[i].path, 1 << scale);
+            TEST_ASSERT_EQUAL_HEX32_MESSAGE(files[i].hash[scale], hash_rgb(), msg);
+        }
+        free(file_data);
+        file_data = NULL;
+    }
+}
+
+void test_tjpgd_psnr(void)
+{
+    static const struct {
+        const char * path;
+        int32_t w;
+        int32_t h;
+        bool gray;
+        double min_psnr[4];
+    } tests[] = {
+        {"src/test_files/thumb_75x50.jpg", 75, 50, false, {22.5, 27, 33, 40}},
+        {"src/test_files/pattern_44x36_444.jpg", 44, 36, false, {27, 33, 40, 46}},
+        {"src/test_files/pattern_37x22_gray.jpg", 37, 22, true, {31, 40, 47, 50}},
+        {"src/test_files/pattern_320x240.jpg", 320, 240, false, {27, 30, 36, 41}},
+    };
+
+    uint32_t i;
+    uint8_t scale;
+    for(i = 0; i < sizeof(tests) / sizeof(tests[0]); i++) {
+        load_file(tests[i].path);
+        for(scale = 0; scale < 4; scale++) {
+            decode(scale);
+            double psnr = psnr_to_pattern(tests[i].w, tests[i].h, scale, tests[i].gray);
+            char msg[96];
+            lv_snprintf(msg, sizeof(msg), "%s 1/%d: %d.%d dB", tests[i].path, 1 << scale, (int)psnr,
+                        (int)(psnr * 10) % 10);
+            TEST_MESSAGE(msg);
+            TEST_ASSERT_MESSAGE(psnr >= tests[i].min_psnr[scale], msg);
+        }
+        free(file_data);
+        file_data = NULL;
+    }
+}
+
+/*Not a pass/fail test, prints the decoding speed*/
+void test_tjpgd_benchmark(void)
+{
+    load_file("src/test_files/pattern_320x240.jpg");
+
+    uint8_t scale;
+    for(scale = 0; scale < 4; scale++) {
+        const uint32_t cnt = 20;
+        uint32_t i;
+        clock_t start = clock();
+        for(i = 0; i < cnt; i++) decode(scale);
+        clock_t t = clock() - start;
+
+        uint32_t us = (uint32_t)((uint64_t)t * 1000000 / CLOCKS_PER_SEC / cnt);
+        char msg[96];
+        lv_snprintf(msg, sizeof(msg), "320x240 at 1/%d: %d us/image, %d kpixel/s", 1 << scale, (int)us,
+                    (int)(us ? 320 * 240 * 1000ULL / us : 0));
+        TEST_MESSAGE(msg);
+    }
+}
+
+#else
+
+void setUp(void)
+{
+
+}
+
+void tearDown(void)
+{
+
+}
+
+void test_tjpgd_bit_exact(void)
+{
+
+}
+
+void test_tjpgd_psnr(void)
+{
+
+}
+
+void test_tjpgd_benchmark(void)
+{
+
+}
+
+#endif
+
+#endif
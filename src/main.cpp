@@ -9,6 +9,7 @@
 #include <Adafruit_SHT31.h>
 #include <PubSubClient.h>  // Add MQTT library
 #include <map>
+#include <esp_heap_caps.h>
 
 // 开发板配置
 #define BOARD_ESP32S3  // 如果使用ESP32，请注释此行
@@ -111,8 +112,24 @@ Adafruit_SHT31 sht31 = Adafruit_SHT31();  // 温湿度传感器对象
 static const uint16_t screenWidth  = 240;  // 屏幕宽度
 static const uint16_t screenHeight = 240;  // 屏幕高度
 
+// 用调色板索引的整屏缓冲区渲染：8位约58KB，4位约29KB，刷新时查表展开成RGB565
+// 注释掉则按20行分块渲染（渲染更快，且可以使用屏幕的硬件滚动）
+//#define DISP_INDEXED_BPP 8
+
+// 刷新时与上一次写入屏幕的内容比较（每行每16个像素保存一个哈希值，约14KB），只发送变化的部分
+#define DISP_FRAME_DIFF
+
+// 每5秒通过串口输出刷新统计（帧率、帧耗时分布），调试刷新性能时取消注释
+//#define DISP_PACING_STATS
+
 static lv_disp_draw_buf_t draw_buf;  // LVGL显示缓冲区
+#ifdef DISP_INDEXED_BPP
+static uint8_t buf[(screenWidth * DISP_INDEXED_BPP + 7) / 8 * screenHeight];  // 整屏的颜色索引
+static lv_disp_palette_t disp_palette;   // 主题颜色的调色板
+static lv_color_t line_buf[screenWidth * 10]; // 展开10行颜色的缓冲区
+#else
 static lv_color_t buf[screenWidth * 20]; // 进一步增加缓冲区大小
+#endif
 
 TFT_eSPI tft = TFT_eSPI(screenWidth, screenHeight);  // TFT显示屏对象
 bool isTouching = false;  // 触摸状态标志
@@ -161,15 +178,153 @@ void my_print(const char * buf)
 void my_disp_flush(lv_disp_drv_t *disp, const lv_area_t *area, lv_color_t *color_p)
 {
     uint32_t w = (area->x2 - area->x1 + 1);
-    uint32_t h = (area->y2 - area->y1 + 1);
+    int32_t y = area->y1;
 
+    // 硬件滚动区域的行在显存中是环绕存放的，按连续的行分段写入
     tft.startWrite();
-    tft.setAddrWindow(area->x1, area->y1, w, h);
-    tft.pushColors((uint16_t *)&color_p->full, w * h, true);
+    while (y <= area->y2) {
+        int32_t rows;
+        int32_t row = tft.getScrollRow(y, &rows);
+        if (rows > area->y2 - y + 1) rows = area->y2 - y + 1;
+#ifdef DISP_FRAME_DIFF
+        tft.pushImageDiff(area->x1, row, w, rows, (uint16_t *)&color_p->full, true);
+#else
+        tft.setAddrWindow(area->x1, row, w, rows);
+        tft.pushColors((uint16_t *)&color_p->full, w * rows, true);
+#endif
+        color_p += w * rows;
+        y += rows;
+    }
     tft.endWrite();
 
     lv_disp_flush_ready(disp);
 }
+
+#ifdef DISP_INDEXED_BPP
+// 直接模式下每个重绘区域都会调用一次，最后一次调用时把所有重绘区域分块查表展开后发送
+void my_disp_flush_indexed(lv_disp_drv_t *disp, const lv_area_t *area, lv_color_t *color_p)
+{
+    LV_UNUSED(area);
+
+    if (lv_disp_flush_is_last(disp)) {
+        lv_disp_t *d = _lv_refr_get_disp_refreshing();
+        tft.startWrite();
+        for (uint16_t i = 0; i < d->inv_p; i++) {
+            if (d->inv_area_joined[i]) continue;  // 已合并到其他区域
+
+            const lv_area_t *a = &d->inv_areas[i];
+            uint32_t w = lv_area_get_width(a);
+            lv_coord_t rows = sizeof(line_buf) / sizeof(line_buf[0]) / w;
+            for (lv_coord_t y = a->y1; y <= a->y2; y += rows) {
+                lv_area_t part = {a->x1, y, a->x2, LV_MIN(y + rows - 1, a->y2)};
+                lv_disp_palette_expand(disp->palette, line_buf, (const uint8_t *)color_p, screenWidth, &part);
+#ifdef DISP_FRAME_DIFF
+                tft.pushImageDiff(part.x1, part.y1, w, lv_area_get_height(&part), (uint16_t *)&line_buf[0].full, true);
+#else
+                tft.setAddrWindow(part.x1, part.y1, w, lv_area_get_height(&part));
+                tft.pushColors((uint16_t *)&line_buf[0].full, lv_area_get_size(&part), true);
+#endif
+            }
+        }
+        tft.endWrite();
+    }
+
+    lv_disp_flush_ready(disp);
+}
+
+// 调色板包含主题和界面用到的颜色，其余是它们的深浅色和灰阶
+static void init_disp_palette()
+{
+    const lv_color_t colors[] = {
+        lv_obj_get_style_bg_color(lv_scr_act(), LV_PART_MAIN),
+        lv_obj_get_style_text_color(lv_scr_act(), LV_PART_MAIN),
+        lv_theme_get_color_primary(NULL),
+        lv_theme_get_color_secondary(NULL),
+        lv_color_white(),
+        lv_color_black(),
+        lv_palette_main(LV_PALETTE_BLUE),
+        lv_palette_main(LV_PALETTE_RED),
+        lv_palette_main(LV_PALETTE_GREEN),
+        lv_palette_darken(LV_PALETTE_BLUE, 2),
+        lv_palette_darken(LV_PALETTE_BLUE, 3),
+        lv_palette_darken(LV_PALETTE_BLUE, 4),
+        lv_palette_lighten(LV_PALETTE_BLUE, 3),
+    };
+    lv_disp_palette_init(&disp_palette, DISP_INDEXED_BPP == 4 ? LV_IMG_CF_INDEXED_4BIT : LV_IMG_CF_INDEXED_8BIT,
+                         colors, sizeof(colors) / sizeof(colors[0]));
+}
+#endif
+
+// 用屏幕的垂直滚动移动整行宽的区域，区域改变时重新设置滚动区
+static bool my_disp_hw_scroll(lv_disp_drv_t *disp, const lv_area_t *area, lv_coord_t dy)
+{
+    static lv_coord_t scroll_y = -1;
+    static lv_coord_t scroll_h = 0;
+    LV_UNUSED(disp);
+
+    if (area->y1 != scroll_y || lv_area_get_height(area) != scroll_h) {
+        if (!tft.setScrollArea(area->y1, lv_area_get_height(area))) return false;
+        scroll_y = area->y1;
+        scroll_h = lv_area_get_height(area);
+    }
+
+    tft.scrollArea(dy);
+    return true;
+}
+
+// 等待屏幕新一帧开始再刷新，避免画面撕裂。有TE引脚时等TE信号；
+// 没有TE引脚时只按帧周期估算，使刷新间隔为整帧，但与屏幕扫描不同步，不能防止撕裂
+static void my_disp_vsync_wait(lv_disp_drv_t *disp)
+{
+    LV_UNUSED(disp);
+    tft.waitVsync();
+}
+
+#ifdef DISP_PACING_STATS
+// 定时通过串口输出刷新统计：帧率、帧耗时分布和超时帧数
+static void print_pacing_stats(lv_timer_t *timer)
+{
+    LV_UNUSED(timer);
+    const lv_disp_pacing_t *pacing = lv_disp_get_pacing(NULL);
+    if (pacing == NULL || pacing->frame_cnt == 0) return;  // 静止页面没有刷新，不输出
+
+    Serial.printf("Refresh: %u frames, %u fps, avg %u ms, max %u ms, missed %u, period %u ms\n",
+                  (unsigned)pacing->frame_cnt, (unsigned)pacing->fps, (unsigned)pacing->time_avg,
+                  (unsigned)pacing->time_max, (unsigned)pacing->missed_cnt,
+                  (unsigned)lv_disp_get_default()->refr_timer->period);
+    Serial.print("Frame time histogram (ms 0-1/2-3/4-7/8-15/16-31/32-63/64-127/128+):");
+    for (int i = 0; i < LV_DISP_PACING_HIST_CNT; i++) {
+        Serial.printf(" %u", (unsigned)pacing->time_hist[i]);
+    }
+    Serial.println();
+
+#ifdef DISP_FRAME_DIFF
+    // 与屏幕上相同而没有发送的字节
+    uint32_t sent, saved;
+    tft.getFrameDiffStats(&sent, &saved);
+    Serial.printf("Frame diff: sent %u bytes, saved %u bytes (%u%%)\n", (unsigned)sent, (unsigned)saved,
+                  (unsigned)(sent + saved ? (uint64_t)saved * 100 / (sent + saved) : 0));
+#endif
+
+    lv_disp_reset_pacing(NULL);
+}
+#endif
+
+// 图片缓存的解码缓冲区优先放在PSRAM中，没有PSRAM时使用内部RAM，不占用LVGL的内存池
+static void * img_cache_alloc(size_t size)
+{
+    void * p = heap_caps_malloc(size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if (p == NULL) {
+        p = heap_caps_malloc(size, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    }
+    return p;
+}
+
+static void img_cache_free(void * p)
+{
+    heap_caps_free(p);
+}
+
 // 页面切换动画回调函数
 static void page_switch_anim_cb(void * var, int32_t v)
 {
@@ -827,12 +982,16 @@ void create_wifi_scan_page() {
     lv_obj_align(title, LV_ALIGN_TOP_MID, 0, 10);
     
     // 创建一个容器来放置WiFi列表
+    // 容器占满屏幕宽度、无圆角，滚动时由屏幕的硬件垂直滚动移动内容，只重绘露出的行
     lv_obj_t* list_cont = lv_obj_create(wifi_scan_page);
-    lv_obj_set_size(list_cont, screenWidth - 20, screenHeight - 100);
+    lv_obj_set_size(list_cont, screenWidth, screenHeight - 100);
     lv_obj_align(list_cont, LV_ALIGN_TOP_MID, 0, 45);
     lv_obj_set_style_bg_color(list_cont, lv_color_black(), 0);
     lv_obj_set_style_border_width(list_cont, 0, 0);
+    lv_obj_set_style_radius(list_cont, 0, 0);
     lv_obj_set_style_pad_all(list_cont, 5, 0);
+    lv_obj_set_style_pad_hor(list_cont, 15, 0);
+    lv_obj_add_flag(list_cont, LV_OBJ_FLAG_HW_SCROLL);
     
     // 创建WiFi列表标签
     wifi_list_label = lv_label_create(list_cont);
@@ -1262,6 +1421,10 @@ lv_obj_t* create_time_label() {
     // 设置深色主题
     lv_theme_default_init(NULL, lv_palette_main(LV_PALETTE_BLUE), lv_palette_main(LV_PALETTE_RED),
                          LV_THEME_DEFAULT_DARK, &lv_font_montserrat_16);
+#ifdef DISP_INDEXED_BPP
+    init_disp_palette();  // 主题颜色改变后重新生成调色板并重绘
+    lv_obj_invalidate(lv_scr_act());
+#endif
 
     // 创建日期标签
     lv_obj_t* date_label = lv_label_create(main_page);
@@ -1428,12 +1591,20 @@ void setup()
 
     // 初始化显示相关
     lv_init();
+    lv_img_cache_set_decoded_alloc_cb(img_cache_alloc, img_cache_free);  // 设置图片解码缓存的内存分配函数
     tft.begin();
     tft.setRotation(0);
     tft.fillScreen(TFT_BLACK);
+#ifdef DISP_FRAME_DIFF
+    if (!tft.setFrameDiff(true)) Serial.println("No memory for the frame diff, every pixel is sent");
+#endif
 
     // 初始化显示缓冲区
+#ifdef DISP_INDEXED_BPP
+    lv_disp_draw_buf_init(&draw_buf, buf, NULL, screenWidth * screenHeight);
+#else
     lv_disp_draw_buf_init(&draw_buf, buf, NULL, screenWidth * 20);
+#endif
 
     // 初始化显示驱动
     static lv_disp_drv_t disp_drv;
@@ -1441,8 +1612,23 @@ void setup()
     disp_drv.hor_res = screenWidth;
     disp_drv.ver_res = screenHeight;
     disp_drv.flush_cb = my_disp_flush;
+    disp_drv.hw_scroll_cb = my_disp_hw_scroll;
+    disp_drv.vsync_wait_cb = my_disp_vsync_wait;
     disp_drv.draw_buf = &draw_buf;
+#ifdef DISP_INDEXED_BPP
+    // 在整屏的索引缓冲区中直接绘制，只重绘变化的区域
+    disp_drv.flush_cb = my_disp_flush_indexed;
+    disp_drv.direct_mode = 1;
+    disp_drv.palette = &disp_palette;
+    lv_disp_drv_use_generic_set_px_cb(&disp_drv, DISP_INDEXED_BPP == 4 ? LV_IMG_CF_INDEXED_4BIT : LV_IMG_CF_INDEXED_8BIT);
+#endif
     lv_disp_drv_register(&disp_drv);
+#ifdef DISP_INDEXED_BPP
+    init_disp_palette();  // 第一次刷新之前
+#endif
+#ifdef DISP_PACING_STATS
+    lv_timer_create(print_pacing_stats, 5000, NULL);
+#endif
 
     // 立即创建并显示启动页面
     create_boot_page("Starting system...");
@@ -1598,13 +1784,13 @@ void setup()
 // 主循环函数
 void loop()
 {
-    lv_task_handler();  // 处理LVGL任务
-    if (!isTouching) {
-        delay(20);
-    }
-    else {
-        delay(5);
+    // 处理LVGL任务，然后休眠到下一个定时器到期。刷新周期由LVGL按帧耗时自动调整，
+    // 页面静止时刷新定时器暂停，只剩输入设备的读取
+    uint32_t wait = lv_task_handler();
+    if (wait > LV_INDEV_DEF_READ_PERIOD) {
+        wait = LV_INDEV_DEF_READ_PERIOD;
     }
+    delay(wait);
 }
 
 
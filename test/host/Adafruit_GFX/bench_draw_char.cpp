@@ -0,0 +1,67 @@
+// Bus transactions for 256 characters drawn on an Adafruit_ST7789 pixel by pixel, as
+// drawChar() did, and in runs of pixels. Adafruit_SPITFT sends opaque classic font
+// characters as one window each.
+//
+// The counts are what the library sends to the display: address windows (column and
+// row address commands), commands, SPI transactions and bytes. The time is for the host
+// CPU and includes the display model.
+
+#include <chrono>
+#include <Adafruit_ST7789.h>
+#include <Fonts/FreeSans9pt7b.h>
+#include <Fonts/FreeMonoBold12pt7b.h>
+#include <Fonts/FreeSerifItalic18pt7b.h>
+#include "draw_char_reference.h"
+#include "TFT_eSPI/st7789_model.h"
+
+#define TFT_CS 10
+#define TFT_DC 9
+
+static ST7789Model      panel;
+static Adafruit_ST7789* tft;
+
+static void run(const char* name, const GFXfont* font, uint8_t size, bool opaque, bool reference)
+{
+  tft->setFont(font);
+  tft->fillScreen(ST77XX_BLACK);
+  panel.resetCounts();
+  host_spi_reset_stats();
+
+  uint16_t bg = opaque ? ST77XX_BLUE : ST77XX_WHITE;
+  int16_t  dx = font ? 14 * size : 6 * size, dy = font ? 24 * size : 8 * size;
+  auto t0 = std::chrono::steady_clock::now();
+  for (int c = 0; c < 256; c++) {
+    // Custom fonts only have the printable ASCII characters
+    unsigned char ch = font ? 32 + c % 95 : c;
+    int16_t x = (c * dx) % 240, y = (c * dx) / 240 * dy + (font ? dy : 0);
+    if (reference) referenceDrawChar(*tft, font, x, y % 240, ch, ST77XX_WHITE, bg, size, size);
+    else           tft->drawChar(x, y % 240, ch, ST77XX_WHITE, bg, size, size);
+  }
+  auto t1 = std::chrono::steady_clock::now();
+
+  printf("%-24s %-9s %8u %8u %10u %10llu %8lld\n", name, reference ? "per pixel" : "runs",
+         panel.windows, panel.commands, host_spi_stats.transfers,
+         (unsigned long long)host_spi_stats.bytes,
+         (long long)std::chrono::duration_cast<std::chrono::microseconds>(t1 - t0).count());
+}
+
+int main(void)
+{
+  host_spi_device = &panel;
+  host_spi_dc_pin = TFT_DC;
+  tft = new Adafruit_ST7789(TFT_CS, TFT_DC, -1);
+  tft->init(240, 240);
+
+  printf("%-24s %-9s %8s %8s %10s %10s %8s\n", "", "", "windows", "commands", "transfers", "bytes",
+         "host us");
+  for (int reference = 1; reference >= 0; reference--) {
+    run("classic 1x transparent", nullptr, 1, false, reference);
+    run("classic 1x opaque", nullptr, 1, true, reference);
+    run("classic 2x opaque", nullptr, 2, true, reference);
+    run("FreeSans9pt7b", &FreeSans9pt7b, 1, false, reference);
+    run("FreeMonoBold12pt7b", &FreeMonoBold12pt7b, 1, false, reference);
+    run("FreeSerifItalic18pt7b", &FreeSerifItalic18pt7b, 1, false, reference);
+  }
+  delete tft;
+  return 0;
+}
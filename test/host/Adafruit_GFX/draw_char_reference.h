@@ -0,0 +1,80 @@
+// Adafruit_GFX::drawChar() as it was before drawing runs of pixels: one writePixel() or
+// writeFillRect() per pixel of the character. The tests and benchmarks compare with it.
+
+#ifndef DRAW_CHAR_REFERENCE_H
+#define DRAW_CHAR_REFERENCE_H
+
+#include <Adafruit_GFX.h>
+#include "glcdfont.c"
+
+static void referenceDrawChar(Adafruit_GFX& gfx, const GFXfont* gfxFont, int16_t x, int16_t y,
+                              unsigned char c, uint16_t color, uint16_t bg, uint8_t size_x,
+                              uint8_t size_y)
+{
+  if (!gfxFont) { // 'Classic' built-in font
+    if ((x >= gfx.width()) || (y >= gfx.height()) || ((x + 6 * size_x - 1) < 0) ||
+        ((y + 8 * size_y - 1) < 0))
+      return;
+
+    if (c >= 176) c++; // Handle 'classic' charset behavior
+
+    gfx.startWrite();
+    for (int8_t i = 0; i < 5; i++) { // Char bitmap = 5 columns
+      uint8_t line = pgm_read_byte(&font[c * 5 + i]);
+      for (int8_t j = 0; j < 8; j++, line >>= 1) {
+        if (line & 1) {
+          if (size_x == 1 && size_y == 1)
+            gfx.writePixel(x + i, y + j, color);
+          else
+            gfx.writeFillRect(x + i * size_x, y + j * size_y, size_x, size_y, color);
+        } else if (bg != color) {
+          if (size_x == 1 && size_y == 1)
+            gfx.writePixel(x + i, y + j, bg);
+          else
+            gfx.writeFillRect(x + i * size_x, y + j * size_y, size_x, size_y, bg);
+        }
+      }
+    }
+    if (bg != color) { // If opaque, draw vertical line for last column
+      if (size_x == 1 && size_y == 1)
+        gfx.writeFastVLine(x + 5, y, 8, bg);
+      else
+        gfx.writeFillRect(x + 5 * size_x, y, size_x, 8 * size_y, bg);
+    }
+    gfx.endWrite();
+
+  } else { // Custom font
+    c -= (uint8_t)pgm_read_byte(&gfxFont->first);
+    GFXglyph* glyph = gfxFont->glyph + c;
+    uint8_t*  bitmap = gfxFont->bitmap;
+
+    uint16_t bo = pgm_read_word(&glyph->bitmapOffset);
+    uint8_t  w = pgm_read_byte(&glyph->width), h = pgm_read_byte(&glyph->height);
+    int8_t   xo = pgm_read_byte(&glyph->xOffset), yo = pgm_read_byte(&glyph->yOffset);
+    uint8_t  xx, yy, bits = 0, bit = 0;
+    int16_t  xo16 = 0, yo16 = 0;
+
+    if (size_x > 1 || size_y > 1) {
+      xo16 = xo;
+      yo16 = yo;
+    }
+
+    gfx.startWrite();
+    for (yy = 0; yy < h; yy++) {
+      for (xx = 0; xx < w; xx++) {
+        if (!(bit++ & 7)) bits = pgm_read_byte(&bitmap[bo++]);
+        if (bits & 0x80) {
+          if (size_x == 1 && size_y == 1)
+            gfx.writePixel(x + xo + xx, y + yo + yy, color);
+          else
+            gfx.writeFillRect(x + (xo16 + xx) * size_x, y + (yo16 + yy) * size_y, size_x, size_y,
+                              color);
+        }
+        bits <<= 1;
+      }
+    }
+    gfx.endWrite();
+  }
+}
+
+#endif
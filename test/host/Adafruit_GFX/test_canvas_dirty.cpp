@@ -0,0 +1,325 @@
+// GFXdirtyRects keeps every changed pixel of a canvas inside one of its areas, and blitTo()
+// sending only those areas must leave the display as sending the whole canvas does.
+// Built as test_canvas_dirty with GFX_DIRTY_TRACKING and as test_canvas_untracked without
+// it, where the whole canvas is always changed.
+
+#include <vector>
+#include <Adafruit_ST7789.h>
+#include "host_test.h"
+#include "TFT_eSPI/st7789_model.h"
+
+#define TFT_CS 10
+#define TFT_DC 9
+
+// Gives the tests the helpers used by add()
+struct TestRects : public GFXdirtyRects
+{
+  using GFXdirtyRects::waste;
+  using GFXdirtyRects::remove;
+};
+
+typedef GFXdirtyRects::Rect Rect;
+
+static bool sameRect(const Rect& r, int16_t x1, int16_t y1, int16_t x2, int16_t y2)
+{
+  return r.x1 == x1 && r.y1 == y1 && r.x2 == x2 && r.y2 == y2;
+}
+
+static bool covered(const GFXdirtyRects& d, int16_t x, int16_t y)
+{
+  for (uint8_t i = 0; i < d.count; i++)
+    if (x >= d.rect[i].x1 && x <= d.rect[i].x2 && y >= d.rect[i].y1 && y <= d.rect[i].y2) return true;
+  return false;
+}
+
+static void setUp(void) {}
+static void tearDown(void) {}
+
+static void test_waste(void)
+{
+  Rect a = { 0, 0, 9, 9 };
+  Rect touching = { 10, 0, 19, 9 }, apart = { 20, 0, 29, 9 }, overlapping = { 5, 0, 14, 9 };
+  TEST_ASSERT_EQUAL(0, TestRects::waste(a, touching));
+  TEST_ASSERT_EQUAL(100, TestRects::waste(a, apart));
+  TEST_ASSERT_EQUAL(-50, TestRects::waste(a, overlapping));
+  TEST_ASSERT_EQUAL(-100, TestRects::waste(a, a));
+
+  // Diagonal pixels: the 3x3 bounding box less the two pixels
+  Rect p = { 0, 0, 0, 0 }, q = { 2, 2, 2, 2 };
+  TEST_ASSERT_EQUAL(7, TestRects::waste(p, q));
+  TEST_ASSERT_EQUAL(7, TestRects::waste(q, p));
+}
+
+static void test_remove(void)
+{
+  TestRects d;
+  d.add(0, 0, 5, 5);
+  d.add(100, 0, 5, 5);
+  d.add(0, 100, 5, 5);
+  TEST_ASSERT_EQUAL(3, d.count);
+
+  // The last area takes the place of the removed one
+  d.remove(0);
+  TEST_ASSERT_EQUAL(2, d.count);
+  TEST_ASSERT_TRUE(sameRect(d.rect[0], 0, 100, 4, 104));
+  TEST_ASSERT_TRUE(sameRect(d.rect[1], 100, 0, 104, 4));
+  d.remove(1);
+  TEST_ASSERT_EQUAL(1, d.count);
+  TEST_ASSERT_TRUE(sameRect(d.rect[0], 0, 100, 4, 104));
+}
+
+static void test_add_ignores_empty_and_contained_areas(void)
+{
+  GFXdirtyRects d;
+  d.add(10, 10, 0, 5);
+  d.add(10, 10, 5, -1);
+  TEST_ASSERT_EQUAL(0, d.count);
+
+  d.add(10, 10, 20, 20);
+  d.add(15, 15, 5, 5);
+  d.add(10, 10, 20, 20);
+  d.add(29, 29, 1, 1);
+  TEST_ASSERT_EQUAL(1, d.count);
+  TEST_ASSERT_TRUE(sameRect(d.rect[0], 10, 10, 29, 29));
+}
+
+static void test_add_keeps_distant_areas_apart(void)
+{
+  GFXdirtyRects d;
+  for (int i = 0; i < GFX_DIRTY_RECTS; i++) d.add(i * 50, i * 50, 10, 10);
+  TEST_ASSERT_EQUAL(GFX_DIRTY_RECTS, d.count);
+  for (int i = 0; i < GFX_DIRTY_RECTS; i++)
+    TEST_ASSERT_TRUE(sameRect(d.rect[i], i * 50, i * 50, i * 50 + 9, i * 50 + 9));
+}
+
+static void test_add_merges_close_areas(void)
+{
+  GFXdirtyRects d;
+  d.add(0, 0, 10, 10);
+  d.add(10, 0, 10, 10);
+  TEST_ASSERT_EQUAL(1, d.count);
+  TEST_ASSERT_TRUE(sameRect(d.rect[0], 0, 0, 19, 9));
+
+  // Two pixels dx apart waste dx - 1 pixels, up to GFX_DIRTY_SLACK are merged
+  d.clear();
+  d.add(0, 0, 1, 1);
+  d.add(GFX_DIRTY_SLACK + 1, 0, 1, 1);
+  TEST_ASSERT_EQUAL(1, d.count);
+  d.clear();
+  d.add(0, 0, 1, 1);
+  d.add(GFX_DIRTY_SLACK + 2, 0, 1, 1);
+  TEST_ASSERT_EQUAL(2, d.count);
+}
+
+static void test_add_merges_again_after_growing(void)
+{
+  GFXdirtyRects d;
+  d.add(0, 0, 10, 10);
+  d.add(30, 0, 10, 10);
+  TEST_ASSERT_EQUAL(2, d.count);
+  // Joins the first, which then touches the second
+  d.add(10, 0, 20, 10);
+  TEST_ASSERT_EQUAL(1, d.count);
+  TEST_ASSERT_TRUE(sameRect(d.rect[0], 0, 0, 39, 9));
+}
+
+static void test_add_when_full_grows_the_closest_area(void)
+{
+  GFXdirtyRects d;
+  for (int i = 0; i < GFX_DIRTY_RECTS; i++) d.add(i * 50, 0, 10, 10);
+  // Nearest to the second area
+  d.add(65, 20, 5, 5);
+  TEST_ASSERT_EQUAL(GFX_DIRTY_RECTS, d.count);
+  TEST_ASSERT_TRUE(sameRect(d.rect[0], 0, 0, 9, 9));
+  TEST_ASSERT_TRUE(sameRect(d.rect[1], 50, 0, 69, 24));
+  TEST_ASSERT_TRUE(sameRect(d.rect[2], 100, 0, 109, 9));
+}
+
+#ifdef GFX_DIRTY_TRACKING
+static void test_pixels_grow_one_area(void)
+{
+  GFXcanvas16 canvas(100, 50);
+  canvas.clearDirty();
+  canvas.drawPixel(3, 4, 0xFFFF);
+  canvas.drawPixel(60, 20, 0xFFFF);
+  canvas.drawPixel(-1, 20, 0xFFFF); // Off the canvas
+  const GFXdirtyRects& d = canvas.getDirtyRects();
+#ifdef GFX_DIRTY_PIXELS
+  TEST_ASSERT_EQUAL(2, d.count);
+#else
+  TEST_ASSERT_EQUAL(1, d.count);
+  TEST_ASSERT_TRUE(sameRect(d.rect[0], 3, 4, 60, 20));
+#endif
+
+  // Lines are areas of their own
+  canvas.drawFastHLine(70, 45, 20, 0xFFFF);
+  TEST_ASSERT_TRUE(covered(canvas.getDirtyRects(), 89, 45));
+  canvas.clearDirty();
+  TEST_ASSERT_EQUAL(0, canvas.getDirtyRects().count);
+}
+#else
+static void test_untracked_canvas_is_always_changed(void)
+{
+  GFXcanvas16 canvas(100, 50);
+  canvas.clearDirty();
+  TEST_ASSERT_EQUAL(1, canvas.getDirtyRects().count);
+  canvas.drawPixel(3, 4, 0xFFFF);
+  canvas.drawFastHLine(70, 45, 20, 0xFFFF);
+  canvas.clearDirty();
+  TEST_ASSERT_EQUAL(1, canvas.getDirtyRects().count);
+  TEST_ASSERT_TRUE(sameRect(canvas.getDirtyRects().rect[0], 0, 0, 99, 49));
+}
+#endif
+
+static void test_new_canvas_and_fill_screen_mark_everything(void)
+{
+  GFXcanvas16 canvas(100, 50);
+  TEST_ASSERT_EQUAL(1, canvas.getDirtyRects().count);
+  TEST_ASSERT_TRUE(sameRect(canvas.getDirtyRects().rect[0], 0, 0, 99, 49));
+  canvas.clearDirty();
+  canvas.fillScreen(0x1234);
+  TEST_ASSERT_TRUE(sameRect(canvas.getDirtyRects().rect[0], 0, 0, 99, 49));
+
+  GFXcanvas8 canvas8(30, 70);
+  TEST_ASSERT_TRUE(sameRect(canvas8.getDirtyRects().rect[0], 0, 0, 29, 69));
+}
+
+static void drawRandom(Adafruit_GFX& gfx)
+{
+  int16_t  x = random(-20, 120), y = random(-20, 80);
+  uint16_t c = random(0x10000);
+  switch (random(7)) {
+    case 0: gfx.drawPixel(x, y, c); break;
+    case 1: gfx.drawFastHLine(x, y, random(-10, 60), c); break;
+    case 2: gfx.drawFastVLine(x, y, random(-10, 60), c); break;
+    case 3: gfx.fillRect(x, y, random(30), random(30), c); break;
+    case 4: gfx.drawCircle(x, y, random(20), c); break;
+    case 5: gfx.drawLine(x, y, random(100), random(60), c); break;
+    case 6:
+      gfx.setCursor(x, y);
+      gfx.setTextColor(c, random(2) ? c ^ 0xFFFF : c);
+      gfx.print("Dirty");
+      break;
+  }
+}
+
+template <typename Canvas, typename Pixel>
+static void checkTracking(Canvas& canvas)
+{
+  const int16_t w = canvas.width(), h = canvas.height();
+  std::vector<Pixel> before(w * h);
+  for (uint8_t r = 0; r < 4; r++) {
+    canvas.setRotation(r);
+    for (int i = 0; i < 300; i++) {
+      memcpy(before.data(), canvas.getBuffer(), w * h * sizeof(Pixel));
+      canvas.clearDirty();
+      for (int n = random(1, 6); n > 0; n--) drawRandom(canvas);
+      const GFXdirtyRects& d = canvas.getDirtyRects();
+      TEST_ASSERT_LESS_OR_EQUAL(GFX_DIRTY_RECTS, d.count);
+      for (uint8_t k = 0; k < d.count; k++) {
+        TEST_ASSERT(d.rect[k].x1 >= 0 && d.rect[k].x2 < w && d.rect[k].x1 <= d.rect[k].x2);
+        TEST_ASSERT(d.rect[k].y1 >= 0 && d.rect[k].y2 < h && d.rect[k].y1 <= d.rect[k].y2);
+      }
+      // Rects are in buffer (rotation 0) coordinates
+      for (int16_t y = 0; y < h; y++)
+        for (int16_t x = 0; x < w; x++)
+          if (before[y * w + x] != canvas.getBuffer()[y * w + x] && !covered(d, x, y)) {
+            printf("rotation %d pixel %d,%d changed outside the areas\n", r, x, y);
+            TEST_FAIL_MESSAGE("Changed pixel not tracked");
+          }
+    }
+  }
+}
+
+static void test_changed_pixels_are_in_the_areas(void)
+{
+  randomSeed(44);
+  GFXcanvas16 canvas16(100, 60);
+  checkTracking<GFXcanvas16, uint16_t>(canvas16);
+  GFXcanvas8 canvas8(100, 60);
+  checkTracking<GFXcanvas8, uint8_t>(canvas8);
+}
+
+static void test_blit_matches_draw_rgb_bitmap(void)
+{
+  ST7789Model panel, expected;
+  host_spi_dc_pin = TFT_DC;
+  Adafruit_ST7789 tft(TFT_CS, TFT_DC, -1);
+  host_spi_device = &expected;
+  tft.init(240, 240);
+  host_spi_device = &panel;
+  tft.init(240, 240);
+
+  static uint16_t palette[256];
+  for (int i = 0; i < 256; i++) palette[i] = i * 0x0101 ^ 0x5A5A;
+  static uint16_t converted[100 * 60];
+
+  randomSeed(4400);
+  // Inside, and clipped at each edge
+  const int16_t at[][2] = { { 20, 30 }, { -30, -20 }, { 180, 200 }, { 70, -50 } };
+  for (uint8_t r = 0; r < 4; r++) {
+    // Both models are sent the rotation command
+    host_spi_device = &expected;
+    tft.setRotation(r);
+    tft.fillScreen(ST77XX_BLUE);
+    host_spi_device = &panel;
+    tft.setRotation(r);
+    tft.fillScreen(ST77XX_BLUE);
+
+    for (const auto& p : at) {
+      GFXcanvas16 canvas(100, 60);
+      GFXcanvas8  canvas8(100, 60);
+      for (int frame = 0; frame < 10; frame++) {
+        canvas.setRotation(frame & 3);
+        canvas8.setRotation(frame & 3);
+        for (int n = random(1, 5); n > 0; n--) drawRandom(canvas);
+        for (int n = random(1, 5); n > 0; n--) drawRandom(canvas8);
+
+        host_spi_device = &expected;
+        tft.drawRGBBitmap(p[0], p[1], canvas.getBuffer(), 100, 60);
+        for (int i = 0; i < 100 * 60; i++) converted[i] = palette[canvas8.getBuffer()[i]];
+        tft.drawRGBBitmap(p[0], p[1] + 60, converted, 100, 60);
+        host_spi_device = &panel;
+        panel.resetCounts();
+        canvas.blitTo(tft, p[0], p[1]);
+        canvas8.blitTo(tft, p[0], p[1] + 60, palette);
+        TEST_ASSERT_TRUE(panel.sameGram(expected));
+#ifdef GFX_DIRTY_TRACKING
+        TEST_ASSERT_EQUAL(0, canvas.getDirtyRects().count);
+
+        // A frame without changes sends nothing
+        canvas.blitTo(tft, p[0], p[1]);
+        TEST_ASSERT_TRUE(panel.sameGram(expected));
+        if (frame > 0) TEST_ASSERT(panel.pixels < 2 * 100 * 60);
+#else
+        // The whole canvas is sent again
+        uint32_t sent = panel.pixels;
+        canvas.blitTo(tft, p[0], p[1]);
+        TEST_ASSERT_TRUE(panel.sameGram(expected));
+        TEST_ASSERT(panel.pixels > sent);
+#endif
+      }
+    }
+  }
+  host_spi_device = nullptr;
+}
+
+int main(void)
+{
+  RUN_TEST(test_waste);
+  RUN_TEST(test_remove);
+  RUN_TEST(test_add_ignores_empty_and_contained_areas);
+  RUN_TEST(test_add_keeps_distant_areas_apart);
+  RUN_TEST(test_add_merges_close_areas);
+  RUN_TEST(test_add_merges_again_after_growing);
+  RUN_TEST(test_add_when_full_grows_the_closest_area);
+#ifdef GFX_DIRTY_TRACKING
+  RUN_TEST(test_pixels_grow_one_area);
+#else
+  RUN_TEST(test_untracked_canvas_is_always_changed);
+#endif
+  RUN_TEST(test_new_canvas_and_fill_screen_mark_everything);
+  RUN_TEST(test_changed_pixels_are_in_the_areas);
+  RUN_TEST(test_blit_matches_draw_rgb_bitmap);
+  return TEST_END();
+}
@@ -0,0 +1,158 @@
+// drawChar() draws runs of pixels, and Adafruit_SPITFT sends opaque classic font characters
+// as one window of pixels. Both must leave the same pixels as drawing the character pixel
+// by pixel did.
+
+#include <Adafruit_ST7789.h>
+#include <Fonts/FreeSans9pt7b.h>
+#include <Fonts/FreeMonoBold12pt7b.h>
+#include <Fonts/FreeSerifItalic18pt7b.h>
+#include <Fonts/Picopixel.h>
+#include "host_test.h"
+#include "draw_char_reference.h"
+#include "TFT_eSPI/st7789_model.h"
+
+#define TFT_CS 10
+#define TFT_DC 9
+
+static const GFXfont* const fonts[] = { nullptr, &FreeSans9pt7b, &FreeMonoBold12pt7b,
+                                        &FreeSerifItalic18pt7b, &Picopixel };
+static const uint8_t sizes[][2] = { { 1, 1 }, { 2, 2 }, { 3, 1 }, { 1, 4 } };
+
+static GFXcanvas16* canvas;
+static GFXcanvas16* reference;
+
+static void setUp(void)
+{
+  canvas = new GFXcanvas16(150, 100);
+  reference = new GFXcanvas16(150, 100);
+}
+
+static void tearDown(void)
+{
+  delete canvas;
+  delete reference;
+}
+
+// Something under the characters so that drawing the background or not shows
+static void fillPattern(GFXcanvas16& c)
+{
+  uint16_t* b = c.getBuffer();
+  for (int i = 0; i < 150 * 100; i++) b[i] = i * 0x9E37;
+}
+
+static bool sameCanvas(void)
+{
+  return memcmp(canvas->getBuffer(), reference->getBuffer(), 150 * 100 * 2) == 0;
+}
+
+static void test_characters_match_per_pixel_drawing(void)
+{
+  // Inside, and clipped at each edge
+  const int16_t at[][2] = { { 40, 40 }, { -7, 30 }, { 140, 60 }, { 70, -3 }, { 20, 95 }, { -2, 99 } };
+  for (const GFXfont* const& font : fonts) {
+    canvas->setFont(font);
+    for (const auto& size : sizes) {
+      for (uint8_t r = 0; r < 4; r++) {
+        canvas->setRotation(r);
+        reference->setRotation(r);
+        uint16_t first = font ? font->first : 0, last = font ? font->last : 255;
+        for (uint16_t c = first; c <= last; c++) {
+          for (const auto& p : at) {
+            int16_t y = p[1] + (font ? 20 : 0); // Custom fonts are drawn from the baseline
+            for (int opaque = 0; opaque < 2; opaque++) {
+              uint16_t bg = opaque ? 0x1234 : 0xF81F;
+              fillPattern(*canvas);
+              fillPattern(*reference);
+              canvas->drawChar(p[0], y, c, 0xF81F, bg, size[0], size[1]);
+              referenceDrawChar(*reference, font, p[0], y, c, 0xF81F, bg, size[0], size[1]);
+              if (!sameCanvas()) {
+                printf("font %d size %dx%d rotation %d char %d at %d,%d %s\n", (int)(&font - fonts),
+                       size[0], size[1], r, c, p[0], y, opaque ? "opaque" : "transparent");
+                TEST_FAIL_MESSAGE("Different pixels");
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+static void test_same_pixels_and_fewer_windows_on_st7789(void)
+{
+  ST7789Model panel, expected;
+  host_spi_dc_pin = TFT_DC;
+  Adafruit_ST7789 tft(TFT_CS, TFT_DC, -1);
+  host_spi_device = &expected;
+  tft.init(240, 240);
+  host_spi_device = &panel;
+  tft.init(240, 240);
+
+  for (const GFXfont* font : fonts) {
+    tft.setFont(font);
+    for (uint8_t r = 0; r < 4; r++) {
+      // Both models are sent the rotation command
+      host_spi_device = &expected;
+      tft.setRotation(r);
+      tft.fillScreen(ST77XX_BLUE);
+      host_spi_device = &panel;
+      tft.setRotation(r);
+      tft.fillScreen(ST77XX_BLUE);
+      panel.resetCounts();
+      expected.resetCounts();
+
+      for (int c = 32; c < 127; c++) {
+        int16_t x = (c % 16) * 16 - 4, y = (c / 16) * 36 + 10;
+        uint16_t bg = (c & 1) ? ST77XX_BLACK : ST77XX_WHITE; // Opaque and transparent
+        host_spi_device = &expected;
+        referenceDrawChar(tft, font, x, y, c, ST77XX_WHITE, bg, 1 + (c & 2) / 2, 1 + (c & 2) / 2);
+        host_spi_device = &panel;
+        tft.drawChar(x, y, c, ST77XX_WHITE, bg, 1 + (c & 2) / 2, 1 + (c & 2) / 2);
+      }
+      TEST_ASSERT_TRUE(panel.sameGram(expected));
+      TEST_ASSERT(panel.windows < expected.windows);
+    }
+  }
+  host_spi_device = nullptr;
+}
+
+static void test_print_sends_an_opaque_character_in_one_window(void)
+{
+  ST7789Model panel, expected;
+  host_spi_dc_pin = TFT_DC;
+  Adafruit_ST7789 tft(TFT_CS, TFT_DC, -1);
+  host_spi_device = &expected;
+  tft.init(240, 240);
+  tft.fillScreen(ST77XX_BLUE);
+  host_spi_device = &panel;
+  tft.init(240, 240);
+  tft.fillScreen(ST77XX_BLUE);
+  panel.resetCounts();
+
+  // The text wraps at the right edge
+  const char* text = "Opaque classic font text, wrapped at the right edge";
+  const int16_t top[] = { 0, 40, 100 };
+  for (uint8_t size = 1; size <= 3; size++) {
+    int16_t y = top[size - 1], perLine = 240 / (6 * size);
+    host_spi_device = &expected;
+    for (int i = 0; text[i]; i++)
+      referenceDrawChar(tft, nullptr, i % perLine * 6 * size, y + i / perLine * 8 * size,
+                        text[i], ST77XX_WHITE, ST77XX_BLACK, size, size);
+    host_spi_device = &panel;
+    tft.setTextSize(size);
+    tft.setTextColor(ST77XX_WHITE, ST77XX_BLACK);
+    tft.setCursor(0, y);
+    tft.print(text);
+  }
+  TEST_ASSERT_TRUE(panel.sameGram(expected));
+  TEST_ASSERT_EQUAL(3 * 2 * strlen(text), panel.windows);
+  host_spi_device = nullptr;
+}
+
+int main(void)
+{
+  RUN_TEST(test_characters_match_per_pixel_drawing);
+  RUN_TEST(test_same_pixels_and_fewer_windows_on_st7789);
+  RUN_TEST(test_print_sends_an_opaque_character_in_one_window);
+  return TEST_END();
+}
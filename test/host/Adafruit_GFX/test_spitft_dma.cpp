@@ -0,0 +1,312 @@
+// Adafruit_SPITFT pixel writes with ESP32 DMA: writePixels() blocking and not, in both byte
+// orders, and the double-buffered writeColor(). A mock DMA queue checks that no buffer is
+// changed while it is being sent and that CS stays low until the transfers are complete.
+
+#include <deque>
+#include <vector>
+#include <Adafruit_SPITFT.h>
+#include <hal/gpio_ll.h>
+#include <hal/spi_ll.h>
+#include "host_test.h"
+#include "TFT_eSPI/st7789_model.h"
+
+#define TFT_CS 10
+#define TFT_DC 9
+
+// Transfers complete in order when the library waits for them, or when the test says so
+struct MockDMAQueue : public Adafruit_SPITFT_DMAQueue
+{
+  struct Transfer { const uint8_t* data; std::vector<uint8_t> copy; };
+  std::deque<Transfer> inFlight;
+  std::vector<const uint8_t*> sources; // Data of every transfer
+  size_t   maxInFlight = 0;
+  uint32_t begins = 0, freq = 0, waits = 0;
+  uint32_t changed = 0;                // Transfers whose data changed while in flight
+  uint32_t csHigh = 0;                 // Transfers completed with CS high
+  bool     hold = false;               // busy() does not complete transfers
+
+  bool begin(uint32_t f, uint8_t spiMode) override
+  {
+    wait();
+    begins++;
+    freq = f;
+    return true;
+  }
+
+  void complete(void)
+  {
+    Transfer& t = inFlight.front();
+    if (memcmp(t.data, t.copy.data(), t.copy.size())) changed++;
+    if (host_pin_get(TFT_CS)) csHigh++;
+    host_spi_write(true, t.copy.data(), t.copy.size());
+    inFlight.pop_front();
+  }
+
+  void reserve(void) override
+  {
+    while (inFlight.size() >= 2) complete();
+  }
+
+  void queue(const void* data, uint32_t len) override
+  {
+    reserve();
+    const uint8_t* p = (const uint8_t*)data;
+    inFlight.push_back({ p, std::vector<uint8_t>(p, p + len) });
+    sources.push_back(p);
+    if (inFlight.size() > maxInFlight) maxInFlight = inFlight.size();
+  }
+
+  bool busy(void) override
+  {
+    if (!hold) while (!inFlight.empty()) complete();
+    return !inFlight.empty();
+  }
+
+  void wait(void) override
+  {
+    while (!inFlight.empty()) complete();
+    waits++;
+  }
+};
+
+// The smallest display: address window like the ST7789, nothing else
+class TestTFT : public Adafruit_SPITFT
+{
+public:
+  TestTFT() : Adafruit_SPITFT(240, 240, TFT_CS, TFT_DC) {}
+  void begin(uint32_t freq) override { initSPI(freq); }
+  void setAddrWindow(uint16_t x, uint16_t y, uint16_t w, uint16_t h) override
+  {
+    writeCommand(0x2A);
+    SPI_WRITE32(((uint32_t)x << 16) | (x + w - 1));
+    writeCommand(0x2B);
+    SPI_WRITE32(((uint32_t)y << 16) | (y + h - 1));
+    writeCommand(0x2C);
+  }
+  uint16_t fillBufferPixels(void) const { return maxFillLen; }
+};
+
+static ST7789Model* panel;
+static MockDMAQueue* mock;
+static TestTFT*      tft;
+static uint16_t      image[240 * 240];
+
+static void setUp(void)
+{
+  panel = new ST7789Model;
+  host_spi_device = panel;
+  host_spi_dc_pin = TFT_DC;
+  host_spi_reset_stats();
+  mock = new MockDMAQueue;
+  tft = new TestTFT;
+  tft->setDMAQueue(mock);
+  tft->begin(40000000);
+  for (int i = 0; i < 240 * 240; i++) image[i] = i * 2654435761u >> 16;
+}
+
+static void tearDown(void)
+{
+  delete tft;
+  delete mock;
+  host_spi_device = nullptr;
+  delete panel;
+}
+
+// The first len pixels of the window from (0, 0) to the bottom right
+static bool panelShows(const uint16_t* pixels, uint32_t len)
+{
+  for (uint32_t i = 0; i < len; i++)
+    if (panel->gram[i / 240][i % 240] != pixels[i]) return false;
+  return true;
+}
+
+static bool panelShowsColor(uint16_t color, uint32_t len)
+{
+  for (uint32_t i = 0; i < len; i++)
+    if (panel->gram[i / 240][i % 240] != color) return false;
+  return true;
+}
+
+static const uint32_t lengths[] = { 1, 2, 239, 240, 241, 479, 480, 481, 1000, 240 * 240 };
+
+static void test_queue_is_used(void)
+{
+  TEST_ASSERT_EQUAL(1, mock->begins);
+  TEST_ASSERT_EQUAL(40000000, mock->freq);
+  TEST_ASSERT_EQUAL(480, tft->fillBufferPixels());
+
+  // The clock is changed by starting the queue again
+  tft->setSPISpeed(20000000);
+  TEST_ASSERT_EQUAL(2, mock->begins);
+  TEST_ASSERT_EQUAL(20000000, mock->freq);
+}
+
+static void test_write_pixels_blocking(void)
+{
+  for (uint32_t len : lengths) {
+    panel->clear(0);
+    mock->sources.clear();
+    tft->startWrite();
+    tft->setAddrWindow(0, 0, 240, 240);
+    tft->writePixels(image, len, true);
+    // Everything is sent before returning
+    TEST_ASSERT_TRUE(mock->inFlight.empty());
+    TEST_ASSERT_TRUE(panelShows(image, len));
+    // One scanline per transfer
+    TEST_ASSERT_EQUAL((len + 239) / 240, mock->sources.size());
+    tft->endWrite();
+  }
+  TEST_ASSERT_EQUAL(0, mock->changed);
+  TEST_ASSERT_EQUAL(0, mock->csHigh);
+}
+
+static void test_write_pixels_non_blocking(void)
+{
+  mock->hold = true;
+  for (uint32_t len : lengths) {
+    panel->clear(0);
+    mock->maxInFlight = 0;
+    tft->startWrite();
+    tft->setAddrWindow(0, 0, 240, 240);
+    tft->writePixels(image, len, false);
+    // The last transfers are still in progress
+    TEST_ASSERT_TRUE(tft->dmaBusy());
+    TEST_ASSERT_EQUAL(len > 240 ? 2 : 1, mock->maxInFlight);
+    tft->dmaWait();
+    TEST_ASSERT_FALSE(tft->dmaBusy());
+    TEST_ASSERT_TRUE(panelShows(image, len));
+    tft->endWrite();
+  }
+  // Each working buffer was filled only when its last transfer was complete
+  TEST_ASSERT_EQUAL(0, mock->changed);
+  TEST_ASSERT_EQUAL(0, mock->csHigh);
+}
+
+static void test_end_write_waits_for_transfers(void)
+{
+  mock->hold = true;
+  tft->startWrite();
+  tft->setAddrWindow(0, 0, 240, 240);
+  tft->writePixels(image, 1000, false);
+  TEST_ASSERT_FALSE(mock->inFlight.empty());
+  tft->endWrite();
+  TEST_ASSERT_TRUE(mock->inFlight.empty());
+  TEST_ASSERT_EQUAL(0, mock->csHigh);
+  TEST_ASSERT_TRUE(panelShows(image, 1000));
+}
+
+static void test_write_pixels_big_endian(void)
+{
+  static uint16_t swapped[240 * 240];
+  for (int i = 0; i < 240 * 240; i++) swapped[i] = __builtin_bswap16(image[i]);
+
+  for (int block = 0; block < 2; block++) {
+    panel->clear(0);
+    mock->sources.clear();
+    tft->startWrite();
+    tft->setAddrWindow(0, 0, 240, 240);
+    tft->writePixels(swapped, 240 * 240, block, true);
+    tft->endWrite();
+    // Sent straight from the caller's pixels, in the largest transfers
+    TEST_ASSERT_EQUAL(4, mock->sources.size());
+    for (int i = 0; i < 4; i++) TEST_ASSERT((const void*)mock->sources[i] == (const void*)(swapped + i * 16384));
+    TEST_ASSERT_TRUE(panelShows(image, 240 * 240));
+  }
+}
+
+static void test_write_color_double_buffered(void)
+{
+  // Repeated colours reuse the filled buffer, the first write after writePixels() refills it
+  const uint16_t colors[] = { 0xF800, 0xF800, 0x07E0, 0x07E0, 0x07E0, 0x001F, 0xFFFF };
+  for (uint16_t color : colors) {
+    for (uint32_t len : lengths) {
+      panel->clear(0x1234);
+      mock->sources.clear();
+      mock->maxInFlight = 0;
+      tft->startWrite();
+      tft->setAddrWindow(0, 0, 240, 240);
+      tft->writeColor(color, len);
+      TEST_ASSERT_TRUE(mock->inFlight.empty());
+      TEST_ASSERT_TRUE(panelShowsColor(color, len));
+      TEST_ASSERT_EQUAL(0x1234, panel->gram[len / 240][len % 240]);
+      if (len < 16) {
+        TEST_ASSERT_EQUAL(1, mock->sources.size()); // Short runs go through writePixels()
+      } else {
+        // The same buffer of two scanlines is sent repeatedly, two transfers in progress
+        TEST_ASSERT_EQUAL((len + 479) / 480, mock->sources.size());
+        TEST_ASSERT_EQUAL(len > 480 ? 2 : 1, mock->maxInFlight);
+      }
+      tft->endWrite();
+    }
+    if (color == 0x07E0) {
+      tft->startWrite();
+      tft->setAddrWindow(0, 0, 240, 240);
+      tft->writePixels(image, 1000, false);
+      tft->endWrite();
+    }
+  }
+  TEST_ASSERT_EQUAL(0, mock->changed);
+  TEST_ASSERT_EQUAL(0, mock->csHigh);
+}
+
+static void test_write_color_after_non_blocking_write_pixels(void)
+{
+  mock->hold = true;
+  tft->startWrite();
+  tft->setAddrWindow(0, 0, 240, 240);
+  tft->writePixels(image, 1000, false);
+  // writeColor() waits before filling the buffer the pixels are sent from
+  tft->writeColor(0x5555, 1000);
+  tft->endWrite();
+  TEST_ASSERT_EQUAL(0, mock->changed);
+  TEST_ASSERT_TRUE(panelShows(image, 1000));
+  for (uint32_t i = 1000; i < 2000; i++) TEST_ASSERT_EQUAL(0x5555, panel->gram[i / 240][i % 240]);
+}
+
+static void test_fill_rect_and_default_queue(void)
+{
+  // The ESP-IDF SPI master driver queue, on the host driver model
+  ST7789Model expected;
+  TestTFT direct;
+  delete tft;
+  tft = new TestTFT;
+  tft->begin(40000000);
+
+  host_spi_device = &expected;
+  for (int i = 0; i < 20; i++) {
+    direct.startWrite();
+    direct.writeFillRect(i * 7, i * 11, 100 - i, 13 + i * 3, i * 0x0841);
+    direct.setAddrWindow(5, 5 + i, 200, 1);
+    direct.writePixels(image + i * 200, 200);
+    direct.endWrite();
+  }
+  host_spi_device = panel;
+  host_spi_reset_stats();
+  host_spi_ll_dev.user.usr_miso = 0;
+  host_spi_ll_dev.dma_tx_enabled = true;
+  for (int i = 0; i < 20; i++) {
+    tft->fillRect(i * 7, i * 11, 100 - i, 13 + i * 3, i * 0x0841);
+    tft->startWrite();
+    tft->setAddrWindow(5, 5 + i, 200, 1);
+    tft->writePixels(image + i * 200, 200, false);
+    tft->endWrite();
+  }
+  TEST_ASSERT(host_spi_stats.dmaTransfers > 0);
+  TEST_ASSERT_TRUE(panel->sameGram(expected));
+  // The SPI registers were handed back to the Arduino SPI functions
+  TEST_ASSERT_EQUAL(1, host_spi_ll_dev.user.usr_miso);
+  TEST_ASSERT_FALSE(host_spi_ll_dev.dma_tx_enabled);
+}
+
+int main(void)
+{
+  RUN_TEST(test_queue_is_used);
+  RUN_TEST(test_write_pixels_blocking);
+  RUN_TEST(test_write_pixels_non_blocking);
+  RUN_TEST(test_end_write_waits_for_transfers);
+  RUN_TEST(test_write_pixels_big_endian);
+  RUN_TEST(test_write_color_double_buffered);
+  RUN_TEST(test_write_color_after_non_blocking_write_pixels);
+  RUN_TEST(test_fill_rect_and_default_queue);
+  return TEST_END();
+}
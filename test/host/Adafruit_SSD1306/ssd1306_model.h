@@ -0,0 +1,136 @@
+// Model of the SSD1306 display RAM (GDDRAM) on the I2C bus for the host tests.
+//
+// Decodes the control byte of each transmission, the commands with their parameters and
+// the data written in horizontal or vertical addressing mode within the PAGEADDR and
+// COLUMNADDR window. The page and column start commands of page addressing mode move
+// the RAM pointer as well (U8g2 uses them in horizontal mode). The other commands are
+// only counted.
+
+#ifndef SSD1306_MODEL_H
+#define SSD1306_MODEL_H
+
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+#include <Wire.h>
+
+class SSD1306Model : public HostI2cDevice
+{
+public:
+  static const int COLUMNS = 128;
+  static const int PAGES   = 8;
+
+  struct Transmission { bool data; std::vector<uint8_t> bytes; };
+
+  uint8_t  gddram[PAGES][COLUMNS];
+  uint8_t  address;
+  uint32_t windows  = 0;         // PAGEADDR or COLUMNADDR commands
+  uint32_t commands = 0;         // All commands
+  uint32_t dataBytes = 0;        // Bytes written to the GDDRAM
+  std::vector<Transmission> log; // Every transmission without its control byte
+
+  SSD1306Model(uint8_t addr = 0x3C) : address(addr) { memset(gddram, 0, sizeof(gddram)); }
+
+  void resetCounts() { windows = commands = dataBytes = 0; log.clear(); }
+
+  // Compare with a library buffer of the same layout, one byte per column of each page
+  bool sameAs(const uint8_t* buffer, int width, int pages) const
+  {
+    for (int p = 0; p < pages; p++)
+      if (memcmp(gddram[p], buffer + p * width, width)) return false;
+    return true;
+  }
+
+  void transmission(uint8_t addr, const uint8_t* data, size_t len) override
+  {
+    if (addr != address || len == 0) return;
+    // Control byte: Co = 0, D/C# selects commands or data for all the following bytes
+    bool dc = data[0] & 0x40;
+    log.push_back({ dc, std::vector<uint8_t>(data + 1, data + len) });
+    for (size_t i = 1; i < len; i++) {
+      if (dc) write(data[i]);
+      else    command(data[i]);
+    }
+  }
+
+private:
+  uint8_t cmd = 0;
+  uint8_t params[6];
+  int     paramCount = 0, paramsNeeded = 0;
+  uint8_t mode = 2;              // Page addressing after reset
+  uint8_t col1 = 0, col2 = COLUMNS - 1, page1 = 0, page2 = PAGES - 1;
+  uint8_t col = 0, page = 0;
+
+  static int paramsOf(uint8_t c)
+  {
+    switch (c) {
+      case 0x20: case 0x81: case 0x8D: case 0xA8: case 0xD3:
+      case 0xD5: case 0xD9: case 0xDA: case 0xDB:   return 1;
+      case 0x21: case 0x22: case 0xA3:              return 2;
+      case 0x29: case 0x2A:                         return 5;
+      case 0x26: case 0x27:                         return 6;
+      default:                                      return 0;
+    }
+  }
+
+  void command(uint8_t b)
+  {
+    if (paramCount < paramsNeeded) {
+      params[paramCount++] = b;
+      if (paramCount == paramsNeeded) execute();
+      return;
+    }
+    commands++;
+    cmd = b;
+    paramCount = 0;
+    paramsNeeded = paramsOf(b);
+    if (paramsNeeded == 0) execute();
+  }
+
+  void execute(void)
+  {
+    switch (cmd) {
+      case 0x20: // Memory addressing mode
+        mode = params[0] & 3;
+        break;
+      case 0x21: // Column address
+        windows++;
+        col1 = params[0] & 0x7F;
+        col2 = params[1] & 0x7F;
+        col = col1;
+        break;
+      case 0x22: // Page address
+        windows++;
+        page1 = params[0] & 7;
+        page2 = params[1] & 7;
+        page = page1;
+        break;
+      default:
+        if (cmd < 0x10) col = (col & 0xF0) | cmd;                   // Lower column start
+        else if (cmd < 0x20) col = (col & 0x0F) | (cmd & 0x07) << 4; // Higher column start
+        else if ((cmd & 0xF8) == 0xB0) page = cmd & 7;               // Page start
+        break;
+    }
+  }
+
+  void write(uint8_t b)
+  {
+    dataBytes++;
+    gddram[page][col] = b;
+    if (mode == 0) {        // Horizontal: columns, then the next page
+      if (col++ == col2) {
+        col = col1;
+        page = (page == page2) ? page1 : page + 1;
+      }
+    }
+    else if (mode == 1) {   // Vertical: pages, then the next column
+      if (page++ == page2) {
+        page = page1;
+        col = (col == col2) ? col1 : col + 1;
+      }
+    }
+    else col = (col + 1) & 0x7F;
+  }
+};
+
+#endif
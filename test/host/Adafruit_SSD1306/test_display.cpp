@@ -0,0 +1,205 @@
+// display() sends only the changed columns of each page, the display RAM must always end
+// up the same as the buffer
+
+#include <Adafruit_SSD1306.h>
+#include "host_test.h"
+#include "ssd1306_model.h"
+
+// Gives the tests the buffer without marking it all changed like getBuffer() does
+class TestSSD1306 : public Adafruit_SSD1306
+{
+public:
+  using Adafruit_SSD1306::Adafruit_SSD1306;
+  const uint8_t* buf(void) { return buffer; }
+};
+
+static SSD1306Model* oled;
+static TestSSD1306*  display;
+
+static void setUp(void)
+{
+  oled = new SSD1306Model(0x3C);
+  host_i2c_device = oled;
+  display = new TestSSD1306(128, 64, &Wire, -1);
+  display->begin(SSD1306_SWITCHCAPVCC, 0x3C);
+  display->display();
+  oled->resetCounts();
+}
+
+static void tearDown(void)
+{
+  delete display;
+  host_i2c_device = nullptr;
+  delete oled;
+}
+
+static bool sameAsBuffer(void)
+{
+  return oled->sameAs(display->buf(), 128, 8);
+}
+
+static uint32_t dataBytes(void)
+{
+  uint32_t n = 0;
+  for (const auto& t : oled->log)
+    if (t.data) n += t.bytes.size();
+  return n;
+}
+
+static void test_begin_then_display_sends_whole_buffer(void)
+{
+  delete display;
+  delete oled;
+  oled = new SSD1306Model(0x3C);
+  host_i2c_device = oled;
+  display = new TestSSD1306(128, 64, &Wire, -1);
+  display->begin(SSD1306_SWITCHCAPVCC, 0x3C);
+  oled->resetCounts();
+
+  display->display();
+  TEST_ASSERT_EQUAL(1024, oled->dataBytes);
+  TEST_ASSERT_EQUAL(2, oled->windows);
+  TEST_ASSERT_TRUE(sameAsBuffer());
+}
+
+static void test_unchanged_buffer_sends_nothing(void)
+{
+  uint32_t before = Wire.transmissions;
+  display->display();
+  TEST_ASSERT_EQUAL(before, Wire.transmissions);
+}
+
+static void test_pixel_sends_one_byte(void)
+{
+  display->drawPixel(70, 21, SSD1306_WHITE);
+  display->display();
+
+  const uint8_t window[] = { SSD1306_PAGEADDR, 2, 2, SSD1306_COLUMNADDR, 70, 70 };
+  TEST_ASSERT_EQUAL(2, oled->log.size());
+  TEST_ASSERT_FALSE(oled->log[0].data);
+  TEST_ASSERT_EQUAL(sizeof(window), oled->log[0].bytes.size());
+  TEST_ASSERT_EQUAL_MEMORY(window, oled->log[0].bytes.data(), sizeof(window));
+  TEST_ASSERT_TRUE(oled->log[1].data);
+  TEST_ASSERT_EQUAL(1, oled->log[1].bytes.size());
+  TEST_ASSERT_EQUAL(display->buf()[2 * 128 + 70], oled->log[1].bytes[0]);
+  TEST_ASSERT_TRUE(sameAsBuffer());
+}
+
+static void test_pages_with_the_same_columns_share_a_window(void)
+{
+  display->fillRect(10, 0, 20, 64, SSD1306_INVERSE);
+  display->display();
+
+  const uint8_t window[] = { SSD1306_PAGEADDR, 0, 7, SSD1306_COLUMNADDR, 10, 29 };
+  TEST_ASSERT_EQUAL(2, oled->windows);
+  TEST_ASSERT_EQUAL_MEMORY(window, oled->log[0].bytes.data(), sizeof(window));
+  TEST_ASSERT_EQUAL(8 * 20, dataBytes());
+  // Split to fit the Wire buffer with the control byte
+  for (const auto& t : oled->log) TEST_ASSERT_LESS_OR_EQUAL(I2C_BUFFER_LENGTH - 1, t.bytes.size());
+  TEST_ASSERT_EQUAL(0, Wire.overflows);
+  TEST_ASSERT_TRUE(sameAsBuffer());
+}
+
+static void test_pages_with_different_columns(void)
+{
+  display->drawLine(0, 0, 127, 63, SSD1306_WHITE);
+  display->drawFastHLine(40, 60, 10, SSD1306_WHITE);
+  display->display();
+
+  // Each page has its own columns, the line covers 16 of them in each page
+  TEST_ASSERT_EQUAL(16, oled->windows);
+  TEST_ASSERT(dataBytes() < 8 * 128 / 2);
+  TEST_ASSERT_TRUE(sameAsBuffer());
+}
+
+static void test_random_drawing_matches_buffer(void)
+{
+  randomSeed(1234);
+  for (int r = 0; r < 4; r++) {
+    display->setRotation(r);
+    for (int i = 0; i < 200; i++) {
+      int16_t  x = random(-20, 140), y = random(-20, 80);
+      uint16_t c = random(3); // SSD1306_BLACK, SSD1306_WHITE or SSD1306_INVERSE
+      switch (random(7)) {
+        case 0: display->drawPixel(x, y, c); break;
+        case 1: display->drawFastHLine(x, y, random(-10, 60), c); break;
+        case 2: display->drawFastVLine(x, y, random(-10, 60), c); break;
+        case 3: display->fillRect(x, y, random(40), random(40), c); break;
+        case 4: display->drawCircle(x, y, random(30), c); break;
+        case 5: display->drawLine(x, y, random(128), random(64), c); break;
+        case 6:
+          display->setCursor(x, y);
+          display->setTextColor(c ? SSD1306_WHITE : SSD1306_BLACK);
+          display->print("Hello");
+          break;
+      }
+      if (random(4) == 0) {
+        display->display();
+        TEST_ASSERT_TRUE(sameAsBuffer());
+      }
+    }
+    display->display();
+    TEST_ASSERT_TRUE(sameAsBuffer());
+  }
+  TEST_ASSERT_EQUAL(0, Wire.overflows);
+}
+
+static void test_get_buffer_marks_everything(void)
+{
+  uint8_t* b = display->getBuffer();
+  b[5 * 128 + 100] ^= 0xA5;
+  display->display();
+  TEST_ASSERT_EQUAL(1024, oled->dataBytes);
+  TEST_ASSERT_TRUE(sameAsBuffer());
+
+  // Changes through a kept pointer need markDirty()
+  oled->resetCounts();
+  b[7 * 128 + 3] ^= 0x5A;
+  display->markDirty();
+  display->display();
+  TEST_ASSERT_EQUAL(1024, oled->dataBytes);
+  TEST_ASSERT_TRUE(sameAsBuffer());
+}
+
+static void test_clear_and_stop_scroll_mark_everything(void)
+{
+  display->clearDisplay();
+  display->display();
+  TEST_ASSERT_EQUAL(1024, oled->dataBytes);
+  TEST_ASSERT_TRUE(sameAsBuffer());
+
+  oled->resetCounts();
+  display->startscrollright(0, 7);
+  display->stopscroll();
+  display->display();
+  TEST_ASSERT_EQUAL(1024, oled->dataBytes);
+}
+
+static void test_128x32_display(void)
+{
+  delete display;
+  display = new TestSSD1306(128, 32, &Wire, -1);
+  display->begin(SSD1306_SWITCHCAPVCC, 0x3C);
+  display->display();
+  TEST_ASSERT_TRUE(oled->sameAs(display->buf(), 128, 4));
+
+  oled->resetCounts();
+  display->fillRect(100, 20, 28, 20, SSD1306_WHITE);
+  display->display();
+  TEST_ASSERT_EQUAL(28 * 2, oled->dataBytes);
+  TEST_ASSERT_TRUE(oled->sameAs(display->buf(), 128, 4));
+}
+
+int main(void)
+{
+  RUN_TEST(test_begin_then_display_sends_whole_buffer);
+  RUN_TEST(test_unchanged_buffer_sends_nothing);
+  RUN_TEST(test_pixel_sends_one_byte);
+  RUN_TEST(test_pages_with_the_same_columns_share_a_window);
+  RUN_TEST(test_pages_with_different_columns);
+  RUN_TEST(test_random_drawing_matches_buffer);
+  RUN_TEST(test_get_buffer_marks_everything);
+  RUN_TEST(test_clear_and_stop_scroll_mark_everything);
+  RUN_TEST(test_128x32_display);
+  return TEST_END();
+}
@@ -0,0 +1,53 @@
+// Bus transactions for the Batch_Drawing gauge drawn directly and in batch mode.
+//
+// The counts are what the ESP32-S3 code sends to the display: address windows, commands,
+// SPI transactions started by the CPU, DMA transactions and bytes. The time is for the
+// host CPU and includes the display model.
+
+#include <chrono>
+#include <TFT_eSPI.h>
+#include "st7789_model.h"
+#include "gauge.h"
+
+static ST7789Model panel;
+static TFT_eSPI    tft;
+
+static void run(const char* name, bool batch)
+{
+  tft.fillScreen(TFT_BLACK);
+  panel.resetCounts();
+  host_spi_reset_stats();
+
+  auto t0 = std::chrono::steady_clock::now();
+  if (batch) {
+    tft.startWrite();
+    tft.startBatch();
+  }
+  drawGauge(tft);
+  if (batch) {
+    tft.endBatch();
+    tft.endWrite();
+  }
+  auto t1 = std::chrono::steady_clock::now();
+
+  printf("%-12s %8u %8u %10u %8u %10llu %8lld\n", name, panel.windows, panel.commands,
+         host_spi_stats.transfers, host_spi_stats.dmaTransfers, (unsigned long long)host_spi_stats.bytes,
+         (long long)std::chrono::duration_cast<std::chrono::microseconds>(t1 - t0).count());
+}
+
+int main(void)
+{
+  host_spi_device = &panel;
+  host_spi_dc_pin = TFT_DC;
+  tft.init();
+  tft.setRotation(1);
+
+  printf("%-12s %8s %8s %10s %8s %10s %8s\n", "", "windows", "commands", "transfers", "DMA", "bytes", "host us");
+  run("direct", false);
+  run("batch", true);
+  tft.initDMA();
+  run("direct DMA", false);
+  run("batch DMA", true);
+  tft.deInitDMA();
+  return 0;
+}
@@ -0,0 +1,29 @@
+// The gauge drawn by the Batch_Drawing example, many small anti-aliased items
+
+#ifndef GAUGE_H
+#define GAUGE_H
+
+#include <TFT_eSPI.h>
+
+static inline void drawGauge(TFT_eSPI& tft)
+{
+  int32_t x = tft.width() / 2;
+  int32_t y = tft.height() / 2;
+  int32_t r = (tft.height() / 2) - 10;
+
+  tft.fillSmoothRoundRect(x - r, y - r, 2 * r, 2 * r, 20, TFT_DARKGREY, TFT_BLACK);
+
+  tft.drawSmoothArc(x, y, r - 10, r - 20, 30, 330, TFT_BLUE, TFT_DARKGREY, true);
+  tft.drawSmoothArc(x, y, r - 10, r - 20, 30, 210, TFT_GREEN, TFT_DARKGREY, true);
+
+  for (int a = 30; a <= 330; a += 30) {
+    float s = sin(a * DEG_TO_RAD);
+    float c = cos(a * DEG_TO_RAD);
+    tft.drawWideLine(x - s * (r - 25), y + c * (r - 25), x - s * (r - 35), y + c * (r - 35), 3, TFT_WHITE, TFT_DARKGREY);
+  }
+
+  tft.drawWedgeLine(x, y, x - (r - 40) * sin(150 * DEG_TO_RAD), y + (r - 40) * cos(150 * DEG_TO_RAD), 6, 1, TFT_RED, TFT_DARKGREY);
+  tft.fillSmoothCircle(x, y, 8, TFT_RED, TFT_DARKGREY);
+}
+
+#endif
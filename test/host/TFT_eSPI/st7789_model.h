@@ -0,0 +1,136 @@
+// Model of the ST7789 frame memory for the host tests.
+//
+// Implements the address window, memory write and memory read commands and the MADCTL
+// row/column exchange and mirror bits, enough to compare what different drawing paths
+// leave on the display. Other commands are counted and otherwise ignored.
+
+#ifndef ST7789_MODEL_H
+#define ST7789_MODEL_H
+
+#include <stdint.h>
+#include <string.h>
+#include "host_spi.h"
+
+class ST7789Model : public HostSpiDevice
+{
+public:
+  static const int WIDTH  = 240; // Frame memory size
+  static const int HEIGHT = 320;
+
+  uint16_t gram[HEIGHT][WIDTH];  // RGB565
+  uint32_t windows  = 0;         // Column or row address commands
+  uint32_t commands = 0;         // All commands
+  uint32_t pixels   = 0;         // Pixels written
+
+  ST7789Model() { clear(0); }
+
+  void clear(uint16_t color)
+  {
+    for (int y = 0; y < HEIGHT; y++)
+      for (int x = 0; x < WIDTH; x++) gram[y][x] = color;
+  }
+
+  void resetCounts() { windows = commands = pixels = 0; }
+
+  bool sameGram(const ST7789Model& other) const { return memcmp(gram, other.gram, sizeof(gram)) == 0; }
+
+  void write(bool dc, const uint8_t* data, size_t len) override
+  {
+    if (!dc) {
+      // Each byte sent with D/C low is a command
+      for (size_t i = 0; i < len; i++) command(data[i]);
+      return;
+    }
+    for (size_t i = 0; i < len; i++) param(data[i]);
+  }
+
+  uint8_t read(void) override
+  {
+    if (cmd != 0x2E) return 0;
+    // Dummy byte first, then 18 bit colour as three bytes per pixel
+    if (readByte < 0) { readByte = 0; return 0; }
+    uint16_t c = 0;
+    int px, py;
+    if (map(px, py)) c = gram[py][px];
+    uint8_t b;
+    if (readByte == 0)      b = (c >> 8) & 0xF8;
+    else if (readByte == 1) b = (c >> 3) & 0xFC;
+    else                    b = (c << 3) & 0xF8;
+    if (++readByte == 3) { readByte = 0; advance(); }
+    return b;
+  }
+
+private:
+  uint8_t  cmd = 0;
+  uint8_t  args[4];
+  int      nargs = 0;
+  uint16_t xs = 0, xe = WIDTH - 1, ys = 0, ye = HEIGHT - 1;
+  uint16_t col = 0, row = 0;
+  uint8_t  madctl = 0;
+  int      readByte = -1;
+  uint8_t  hiByte = 0;
+  bool     haveHi = false;
+
+  void command(uint8_t c)
+  {
+    cmd = c;
+    nargs = 0;
+    haveHi = false;
+    commands++;
+    if (c == 0x2A || c == 0x2B) windows++;
+    if (c == 0x2C || c == 0x2E) { col = xs; row = ys; readByte = -1; }
+  }
+
+  void param(uint8_t b)
+  {
+    switch (cmd) {
+      case 0x2A:
+      case 0x2B:
+        if (nargs < 4) args[nargs++] = b;
+        if (nargs == 4) {
+          uint16_t s = args[0] << 8 | args[1], e = args[2] << 8 | args[3];
+          if (cmd == 0x2A) { xs = s; xe = e; }
+          else             { ys = s; ye = e; }
+        }
+        break;
+      case 0x36:
+        madctl = b;
+        break;
+      case 0x2C:
+      case 0x3C:
+        // Pixels are sent most significant byte first
+        if (!haveHi) { hiByte = b; haveHi = true; break; }
+        haveHi = false;
+        {
+          int px, py;
+          if (map(px, py)) gram[py][px] = hiByte << 8 | b;
+        }
+        pixels++;
+        advance();
+        break;
+      default:
+        break;
+    }
+  }
+
+  void advance(void)
+  {
+    if (col < xe) { col++; return; }
+    col = xs;
+    row = (row < ye) ? row + 1 : ys;
+  }
+
+  // Frame memory position of the current column and row
+  bool map(int& px, int& py) const
+  {
+    int x = col, y = row;
+    if (madctl & 0x20) { int t = x; x = y; y = t; } // MV
+    if (madctl & 0x40) x = WIDTH - 1 - x;           // MX
+    if (madctl & 0x80) y = HEIGHT - 1 - y;          // MY
+    px = x;
+    py = y;
+    return x >= 0 && x < WIDTH && y >= 0 && y < HEIGHT;
+  }
+};
+
+#endif
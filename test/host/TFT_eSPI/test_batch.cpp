@@ -0,0 +1,110 @@
+// Batch mode must leave the same pixels as drawing directly
+
+#include <TFT_eSPI.h>
+#include "host_test.h"
+#include "st7789_model.h"
+#include "gauge.h"
+
+static ST7789Model* panel;
+static ST7789Model* reference;
+static TFT_eSPI*    tft;
+
+static void setUp(void)
+{
+  reference = new ST7789Model;
+  panel = new ST7789Model;
+  host_spi_dc_pin = TFT_DC;
+  tft = new TFT_eSPI;
+  tft->init();
+}
+
+static void tearDown(void)
+{
+  tft->endBatch();
+  delete tft;
+  host_spi_device = nullptr;
+  delete panel;
+  delete reference;
+}
+
+static void drawBoth(void (*draw)(void))
+{
+  host_spi_device = reference;
+  draw();
+
+  host_spi_device = panel;
+  tft->startWrite();
+  tft->startBatch();
+  draw();
+  tft->endBatch();
+  tft->endWrite();
+}
+
+static void gaugeAllRotations(void)
+{
+  for (int r = 0; r < 4; r++) {
+    tft->setRotation(r);
+    tft->fillScreen(TFT_BLACK);
+    drawGauge(*tft);
+  }
+}
+
+static void test_batch_matches_direct(void)
+{
+  drawBoth(gaugeAllRotations);
+  TEST_ASSERT_TRUE(panel->sameGram(*reference));
+  TEST_ASSERT(panel->windows < reference->windows);
+}
+
+static void test_batch_with_dma_matches_direct(void)
+{
+  tft->initDMA();
+  drawBoth(gaugeAllRotations);
+  TEST_ASSERT_TRUE(panel->sameGram(*reference));
+  tft->deInitDMA();
+}
+
+static void rotateWhileRecording(void)
+{
+  tft->setRotation(0);
+  tft->fillScreen(TFT_BLACK);
+  tft->fillSmoothCircle(40, 40, 20, TFT_RED, TFT_BLACK);
+  tft->drawFastHLine(0, 100, 200, TFT_GREEN);
+  tft->setRotation(1);
+  tft->fillSmoothCircle(40, 40, 20, TFT_BLUE, TFT_BLACK);
+  tft->drawFastVLine(100, 0, 200, TFT_YELLOW);
+  tft->setRotation(3);
+  tft->drawPixel(5, 6, TFT_WHITE);
+}
+
+static void test_set_rotation_flushes_batch(void)
+{
+  drawBoth(rotateWhileRecording);
+  TEST_ASSERT_TRUE(panel->sameGram(*reference));
+}
+
+static void test_raw_writes_flush_batch(void)
+{
+  host_spi_device = panel;
+  tft->startBatch();
+  tft->fillSmoothCircle(100, 100, 30, TFT_RED, TFT_BLACK);
+  TEST_ASSERT_EQUAL(0, panel->pixels);
+
+  // Commands and data sent by the sketch must come after the recorded drawing
+  tft->writecommand(ST7789_NOP);
+  TEST_ASSERT(panel->pixels > 0);
+
+  tft->drawPixel(1, 1, TFT_RED);
+  uint32_t pixels = panel->pixels;
+  tft->writedata(0);
+  TEST_ASSERT_EQUAL(pixels + 1, panel->pixels);
+}
+
+int main(void)
+{
+  RUN_TEST(test_batch_matches_direct);
+  RUN_TEST(test_batch_with_dma_matches_direct);
+  RUN_TEST(test_set_rotation_flushes_batch);
+  RUN_TEST(test_raw_writes_flush_batch);
+  return TEST_END();
+}
@@ -0,0 +1,180 @@
+// The buffer conversion functions must give the same pixels as the per-pixel code they
+// replaced, for every input value, buffer alignment and length
+
+#include <TFT_eSPI.h>
+#include "host_test.h"
+#include "st7789_model.h"
+
+#define PIXELS 4096
+#define GUARD  0x5AA5
+
+static uint16_t dst[PIXELS + 4];
+static uint16_t src[PIXELS + 4];
+static uint8_t  src8[PIXELS * 3 + 4];
+
+static void setUp(void)
+{
+}
+
+static void tearDown(void)
+{
+}
+
+static uint16_t swapped(uint16_t c)
+{
+  return c >> 8 | c << 8;
+}
+
+// Only pixels 1 to len of dst may be written, guarded() checks the pixels either side
+static void guard(void)
+{
+  for (uint32_t i = 0; i < PIXELS + 4; i++) dst[i] = GUARD;
+}
+
+static bool guarded(uint32_t len)
+{
+  return dst[0] == GUARD && dst[len + 1] == GUARD;
+}
+
+static void test_swap565(void)
+{
+  for (uint32_t so = 0; so < 2; so++) {
+    for (uint32_t v = 0; v < 0x10000; v += PIXELS) {
+      for (uint32_t i = 0; i < PIXELS; i++) src[so + i] = v + i;
+      for (uint32_t len = 0; len < 40; len++) {
+        guard();
+        TFT_eSPI::swap565(dst + 1, src + so, len);
+        TEST_ASSERT_TRUE(guarded(len));
+        for (uint32_t i = 0; i < len; i++) TEST_ASSERT_EQUAL(swapped(src[so + i]), dst[1 + i]);
+      }
+      guard();
+      TFT_eSPI::swap565(dst + 1 + so, src + so, PIXELS - 1);
+      for (uint32_t i = 0; i < PIXELS - 1; i++) TEST_ASSERT_EQUAL(swapped(v + i), dst[1 + so + i]);
+    }
+  }
+
+  // In place, at both alignments
+  for (uint32_t so = 0; so < 2; so++) {
+    for (uint32_t i = 0; i < 37; i++) src[so + i] = i * 0x0123;
+    TFT_eSPI::swap565(src + so, src + so, 37);
+    for (uint32_t i = 0; i < 37; i++) TEST_ASSERT_EQUAL(swapped(i * 0x0123), src[so + i]);
+  }
+}
+
+static void test_convert332to565(void)
+{
+  TFT_eSPI tft;
+  for (uint32_t i = 0; i < 512; i++) src8[i] = i;
+  for (uint32_t swap = 0; swap < 2; swap++) {
+    for (uint32_t dof = 0; dof < 2; dof++) {
+      for (uint32_t len = 0; len < 300; len += (len < 40) ? 1 : 37) {
+        guard();
+        TFT_eSPI::convert332to565(dst + 1 + dof, src8 + 1, len, swap);
+        TEST_ASSERT_TRUE(guarded(len + dof));
+        for (uint32_t i = 0; i < len; i++) {
+          uint16_t c = tft.color8to16(src8[1 + i]);
+          TEST_ASSERT_EQUAL(swap ? swapped(c) : c, dst[1 + dof + i]);
+        }
+      }
+    }
+  }
+}
+
+static void test_convert4to565(void)
+{
+  uint16_t cmap[16];
+  for (uint32_t i = 0; i < 16; i++) cmap[i] = i * 0x1111 ^ 0x0F0F;
+  for (uint32_t i = 0; i < 256; i++) src8[i] = i;
+
+  for (uint32_t odd = 0; odd < 2; odd++) {
+    for (uint32_t dof = 0; dof < 2; dof++) {
+      for (uint32_t len = 0; len < 512 - odd; len += (len < 40) ? 1 : 31) {
+        guard();
+        TFT_eSPI::convert4to565(dst + 1 + dof, src8, odd, len, cmap);
+        TEST_ASSERT_TRUE(guarded(len + dof));
+        for (uint32_t i = 0; i < len; i++) {
+          uint32_t p = i + odd;
+          uint8_t  c = (p & 1) ? src8[p >> 1] & 0x0F : src8[p >> 1] >> 4;
+          TEST_ASSERT_EQUAL(cmap[c], dst[1 + dof + i]);
+        }
+      }
+    }
+  }
+}
+
+static void test_convert1to565(void)
+{
+  for (uint32_t i = 0; i < 256; i++) src8[i] = i;
+  for (uint32_t bit = 0; bit < 8; bit++) {
+    for (uint32_t dof = 0; dof < 2; dof++) {
+      for (uint32_t len = 0; len < 2048 - bit; len += (len < 40) ? 1 : 97) {
+        guard();
+        TFT_eSPI::convert1to565(dst + 1 + dof, src8, bit, len, TFT_WHITE, TFT_BLUE);
+        TEST_ASSERT_TRUE(guarded(len + dof));
+        for (uint32_t i = 0; i < len; i++) {
+          uint32_t p = i + bit;
+          bool set = src8[p >> 3] & (0x80 >> (p & 7));
+          TEST_ASSERT_EQUAL(set ? TFT_WHITE : TFT_BLUE, dst[1 + dof + i]);
+        }
+      }
+    }
+  }
+}
+
+static void test_convert888to565(void)
+{
+  TFT_eSPI tft;
+  // Every value of each colour, the other two vary
+  for (uint32_t i = 0; i < 256 * 3; i++) {
+    src8[i * 3 + 0] = (i % 3 == 0) ? i / 3 : i * 7;
+    src8[i * 3 + 1] = (i % 3 == 1) ? i / 3 : i * 13;
+    src8[i * 3 + 2] = (i % 3 == 2) ? i / 3 : i * 29;
+  }
+  for (uint32_t swap = 0; swap < 2; swap++) {
+    for (uint32_t dof = 0; dof < 2; dof++) {
+      for (uint32_t len = 0; len <= 256 * 3; len += (len < 40) ? 1 : 41) {
+        guard();
+        TFT_eSPI::convert888to565(dst + 1 + dof, src8, len, swap);
+        TEST_ASSERT_TRUE(guarded(len + dof));
+        for (uint32_t i = 0; i < len; i++) {
+          uint16_t c = tft.color565(src8[i * 3], src8[i * 3 + 1], src8[i * 3 + 2]);
+          TEST_ASSERT_EQUAL(swap ? swapped(c) : c, dst[1 + dof + i]);
+        }
+      }
+    }
+  }
+}
+
+static void test_read_rect(void)
+{
+  // readRect() converts each line of 18 bit pixels read from the TFT with convert888to565()
+  ST7789Model panel;
+  host_spi_device = &panel;
+  host_spi_dc_pin = TFT_DC;
+  TFT_eSPI tft;
+  tft.init();
+  for (int y = 0; y < 240; y++)
+    for (int x = 0; x < 240; x++) panel.gram[y][x] = (x * 0x9E37 + y * 0x79B9) ^ (y << 7);
+
+  static uint16_t buf[240 * 240];
+  const int rects[][4] = { { 0, 0, 240, 240 }, { 13, 7, 1, 1 }, { 31, 100, 17, 9 }, { 200, 220, 60, 40 } };
+  for (const auto& r : rects) {
+    memset(buf, 0, sizeof(buf));
+    tft.readRect(r[0], r[1], r[2], r[3], buf);
+    for (int y = 0; y < r[3] && r[1] + y < 240; y++)
+      for (int x = 0; x < r[2] && r[0] + x < 240; x++)
+        TEST_ASSERT_EQUAL(swapped(panel.gram[r[1] + y][r[0] + x]), buf[y * r[2] + x]);
+  }
+  host_spi_device = nullptr;
+}
+
+int main(void)
+{
+  RUN_TEST(test_swap565);
+  RUN_TEST(test_convert332to565);
+  RUN_TEST(test_convert4to565);
+  RUN_TEST(test_convert1to565);
+  RUN_TEST(test_convert888to565);
+  RUN_TEST(test_read_rect);
+  return TEST_END();
+}
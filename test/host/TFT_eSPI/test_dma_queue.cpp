@@ -0,0 +1,206 @@
+// queueImageDMA(), the 32 slot transaction ring and the D/C pre-transaction callback
+
+#include <vector>
+#include <TFT_eSPI.h>
+#include "host_test.h"
+#include "st7789_model.h"
+
+// Records the D/C level and length of every transfer and passes it to the display model
+struct BusLog : public HostSpiDevice
+{
+  struct Transfer { bool dc; size_t len; };
+  ST7789Model* panel = nullptr;
+  std::vector<Transfer> log;
+
+  void write(bool dc, const uint8_t* data, size_t len) override
+  {
+    log.push_back({ dc, len });
+    panel->write(dc, data, len);
+  }
+};
+
+static ST7789Model* panel;
+static BusLog       bus;
+static TFT_eSPI*    tft;
+static uint16_t     image[240 * 240];
+
+static void setUp(void)
+{
+  panel = new ST7789Model;
+  bus.panel = panel;
+  bus.log.clear();
+  host_spi_device = &bus;
+  host_spi_dc_pin = TFT_DC;
+  host_spi_master_ready = -1;
+  tft = new TFT_eSPI;
+  tft->init();
+  tft->fillScreen(TFT_BLACK);
+  tft->initDMA();
+  for (int i = 0; i < 240 * 240; i++) image[i] = i * 2654435761u >> 16;
+}
+
+static void tearDown(void)
+{
+  tft->dmaWait();
+  tft->deInitDMA();
+  delete tft;
+  host_spi_device = nullptr;
+  delete panel;
+}
+
+// The same image drawn without DMA
+static ST7789Model* expected(int32_t x, int32_t y, int32_t w, int32_t h, const ST7789Model& before)
+{
+  ST7789Model* ref = new ST7789Model(before);
+  host_spi_device = ref;
+  tft->pushImage(x, y, w, h, image);
+  host_spi_device = &bus;
+  return ref;
+}
+
+static void test_window_commands_use_dc_from_user_field(void)
+{
+  ST7789Model* ref = expected(10, 20, 30, 40, *panel);
+  bus.log.clear();
+
+  tft->queueImageDMA(10, 20, 30, 40, image);
+  tft->dmaWait();
+
+  // CASET, columns, RASET, rows, RAMWR, pixels
+  const BusLog::Transfer seq[] = { {0, 1}, {1, 4}, {0, 1}, {1, 4}, {0, 1}, {1, 30 * 40 * 2} };
+  TEST_ASSERT_EQUAL(6, bus.log.size());
+  for (int i = 0; i < 6; i++) {
+    TEST_ASSERT_EQUAL(seq[i].dc, bus.log[i].dc);
+    TEST_ASSERT_EQUAL(seq[i].len, bus.log[i].len);
+  }
+  TEST_ASSERT_TRUE(panel->sameGram(*ref));
+  delete ref;
+}
+
+static void test_large_images_are_split(void)
+{
+  // 24000 pixels, more than one 32 kbyte SPI transfer
+  ST7789Model* ref = expected(0, 0, 240, 100, *panel);
+  bus.log.clear();
+
+  tft->queueImageDMA(0, 0, 240, 100, image);
+  tft->dmaWait();
+
+  TEST_ASSERT_EQUAL(7, bus.log.size());
+  TEST_ASSERT_EQUAL(0x4000 * 2, bus.log[5].len);
+  TEST_ASSERT_EQUAL((24000 - 0x4000) * 2, bus.log[6].len);
+  TEST_ASSERT_TRUE(panel->sameGram(*ref));
+  delete ref;
+}
+
+static std::vector<int> done;
+static std::vector<uint32_t> pixelsWhenDone;
+
+static void stripDone(void* arg)
+{
+  done.push_back((int)(intptr_t)arg);
+  pixelsWhenDone.push_back(panel->pixels);
+}
+
+static void test_ring_wraps_and_callbacks_run_in_order(void)
+{
+  // 48 strips of 6 transactions each go round the ring 9 times
+  ST7789Model* ref = new ST7789Model(*panel);
+  host_spi_device = ref;
+  tft->pushImage(0, 0, 240, 240, image);
+  host_spi_device = &bus;
+
+  done.clear();
+  pixelsWhenDone.clear();
+  panel->resetCounts();
+  host_spi_master_max_pending = 0;
+  for (int i = 0; i < 48; i++) tft->queueImageDMA(0, i * 5, 240, 5, image + i * 5 * 240, nullptr, stripDone, (void*)(intptr_t)i);
+  TEST_ASSERT_LESS_OR_EQUAL(DMA_QUEUE_SIZE, host_spi_master_max_pending);
+  TEST_ASSERT(done.size() < 48);
+
+  tft->dmaWait();
+  TEST_ASSERT_EQUAL(48, done.size());
+  for (int i = 0; i < 48; i++) {
+    TEST_ASSERT_EQUAL(i, done[i]);
+    // A callback runs after the last pixel of its strip has been sent
+    TEST_ASSERT_EQUAL((i + 1) * 5 * 240, pixelsWhenDone[i]);
+  }
+  TEST_ASSERT_TRUE(panel->sameGram(*ref));
+  delete ref;
+}
+
+static int nextStrip;
+
+static void queueNext(void* arg)
+{
+  TFT_eSPI* t = (TFT_eSPI*)arg;
+  if (++nextStrip < 24) t->queueImageDMA(0, nextStrip * 10, 240, 10, image + nextStrip * 10 * 240, nullptr, queueNext, t);
+}
+
+static void test_callback_can_queue_more(void)
+{
+  ST7789Model* ref = expected(0, 0, 240, 240, *panel);
+
+  nextStrip = 0;
+  tft->queueImageDMA(0, 0, 240, 10, image, nullptr, queueNext, tft);
+  tft->dmaWait();
+
+  TEST_ASSERT_EQUAL(24, nextStrip);
+  TEST_ASSERT_FALSE(tft->dmaBusy());
+  TEST_ASSERT_TRUE(panel->sameGram(*ref));
+  delete ref;
+}
+
+static void test_busy_until_transfers_complete(void)
+{
+  // The driver has not finished any transfer yet
+  host_spi_master_ready = 0;
+  bus.log.clear();
+  tft->queueImageDMA(0, 0, 20, 20, image);
+  TEST_ASSERT_TRUE(tft->dmaBusy());
+  TEST_ASSERT_EQUAL(0, bus.log.size());
+
+  host_spi_master_ready = 3;
+  TEST_ASSERT_TRUE(tft->dmaBusy());
+  TEST_ASSERT_EQUAL(3, bus.log.size());
+
+  host_spi_master_ready = -1;
+  TEST_ASSERT_FALSE(tft->dmaBusy());
+  TEST_ASSERT_EQUAL(6, bus.log.size());
+}
+
+static void test_clipped_image_and_swapped_bytes(void)
+{
+  tft->setSwapBytes(true);
+  ST7789Model* ref = expected(-15, 200, 100, 70, *panel);
+
+  uint16_t buffer[100 * 70];
+  tft->queueImageDMA(-15, 200, 100, 70, image, buffer);
+  tft->dmaWait();
+
+  TEST_ASSERT_TRUE(panel->sameGram(*ref));
+  delete ref;
+}
+
+static void test_off_screen_image_runs_callback(void)
+{
+  done.clear();
+  pixelsWhenDone.clear();
+  bus.log.clear();
+  tft->queueImageDMA(300, 0, 10, 10, image, nullptr, stripDone, (void*)7);
+  TEST_ASSERT_EQUAL(1, done.size());
+  TEST_ASSERT_EQUAL(7, done[0]);
+  TEST_ASSERT_EQUAL(0, bus.log.size());
+}
+
+int main(void)
+{
+  RUN_TEST(test_window_commands_use_dc_from_user_field);
+  RUN_TEST(test_large_images_are_split);
+  RUN_TEST(test_ring_wraps_and_callbacks_run_in_order);
+  RUN_TEST(test_callback_can_queue_more);
+  RUN_TEST(test_busy_until_transfers_complete);
+  RUN_TEST(test_clipped_image_and_swapped_bytes);
+  RUN_TEST(test_off_screen_image_runs_callback);
+  return TEST_END();
+}
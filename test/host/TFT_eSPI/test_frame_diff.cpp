@@ -0,0 +1,183 @@
+// pushImageDiff() must leave the same pixels on the panel as pushImage(), while sending only
+// the changed row segments. The reference panel is drawn with pushImage().
+
+#include <stdlib.h>
+#include <vector>
+#include <TFT_eSPI.h>
+#include "host_test.h"
+#include "st7789_model.h"
+
+static ST7789Model* panel;
+static ST7789Model* reference;
+static TFT_eSPI*    tft;
+
+typedef std::vector<uint16_t> Image;
+
+static void setUp(void)
+{
+  reference = new ST7789Model;
+  panel = new ST7789Model;
+  host_spi_dc_pin = TFT_DC;
+  tft = new TFT_eSPI;
+  host_spi_device = reference;
+  tft->init();
+  tft->fillScreen(TFT_BLACK);
+  host_spi_device = panel;
+  tft->init();
+  tft->fillScreen(TFT_BLACK);
+  tft->setFrameDiff(true);
+  srand(40);
+}
+
+static void tearDown(void)
+{
+  tft->setFrameDiff(false);
+  delete tft;
+  host_spi_device = nullptr;
+  delete panel;
+  delete reference;
+}
+
+static Image randomImage(int32_t w, int32_t h)
+{
+  Image img(w * h);
+  for (uint16_t& p : img) p = rand();
+  return img;
+}
+
+// Returns the pixels sent by pushImageDiff()
+static uint32_t pushBoth(int32_t x, int32_t y, int32_t w, int32_t h, Image& img)
+{
+  host_spi_device = reference;
+  tft->setSwapBytes(true);
+  tft->pushImage(x, y, w, h, img.data());
+  tft->setSwapBytes(false);
+
+  host_spi_device = panel;
+  return tft->pushImageDiff(x, y, w, h, img.data());
+}
+
+static void test_unchanged_pixels_are_not_sent(void)
+{
+  // Whole segments only
+  Image img = randomImage(64, 40);
+  TEST_ASSERT_EQUAL(64 * 40, pushBoth(16, 20, 64, 40, img));
+  TEST_ASSERT_EQUAL(0, pushBoth(16, 20, 64, 40, img));
+
+  img[5 * 64 + 17] ^= 0x0821;
+  img[30 * 64 + 63] ^= 0x0821;
+  TEST_ASSERT_EQUAL(2 * 16, pushBoth(16, 20, 64, 40, img));
+  TEST_ASSERT_TRUE(panel->sameGram(*reference));
+}
+
+static void test_partial_segments_are_always_sent(void)
+{
+  // Columns 5 to 104: 11 pixels of the first segment and 9 of the last one are not hashed
+  Image img = randomImage(100, 30);
+  TEST_ASSERT_EQUAL(100 * 30, pushBoth(5, 50, 100, 30, img));
+  TEST_ASSERT_EQUAL((11 + 9) * 30, pushBoth(5, 50, 100, 30, img));
+
+  // A push over part of the area makes the segments it covers partly unknown
+  Image patch = randomImage(20, 10);
+  TEST_ASSERT_EQUAL(20 * 10, pushBoth(40, 55, 20, 10, patch));
+  TEST_ASSERT_TRUE(panel->sameGram(*reference));
+  uint32_t sent = pushBoth(5, 50, 100, 30, img);
+  TEST_ASSERT_EQUAL((11 + 9) * 30 + 2 * 16 * 10, sent);
+  TEST_ASSERT_TRUE(panel->sameGram(*reference));
+}
+
+static void test_changed_frames_match_push_image(void)
+{
+  Image img = randomImage(150, 90);
+  uint32_t sent = 0;
+  for (int frame = 0; frame < 20; frame++) {
+    // A few changed pixels and a changed band of whole rows
+    for (int i = 0; i < 10; i++) img[rand() % img.size()] = rand();
+    int band = rand() % 80;
+    for (int i = band * 150; i < (band + 5) * 150; i++) img[i] = rand();
+    sent += pushBoth(3, 7, 150, 90, img);
+    TEST_ASSERT_TRUE(panel->sameGram(*reference));
+  }
+  TEST_ASSERT(sent < 20 * 150 * 90 / 3);
+}
+
+static void test_viewport_is_applied(void)
+{
+  host_spi_device = reference;
+  tft->setViewport(16, 32, 112, 80);
+  host_spi_device = panel;
+  tft->setViewport(16, 32, 112, 80);
+
+  // Clipped at the top left and bottom right of the viewport
+  Image img = randomImage(58, 50);
+  TEST_ASSERT_EQUAL(48 * 45, pushBoth(-10, -5, 58, 50, img));
+  Image big = randomImage(70, 40);
+  TEST_ASSERT_EQUAL(48 * 30, pushBoth(64, 50, 70, 40, big));
+  TEST_ASSERT_EQUAL(0, pushBoth(112, 10, 10, 10, img));
+  TEST_ASSERT_TRUE(panel->sameGram(*reference));
+
+  // Screen columns 16 to 63 and 80 to 127, all whole segments
+  TEST_ASSERT_EQUAL(0, pushBoth(-10, -5, 58, 50, img));
+  TEST_ASSERT_EQUAL(0, pushBoth(64, 50, 70, 40, big));
+  img[10 * 58 + 30] ^= 0x0821;
+  TEST_ASSERT_EQUAL(16, pushBoth(-10, -5, 58, 50, img));
+  TEST_ASSERT_TRUE(panel->sameGram(*reference));
+
+  // The hashes are kept for screen coordinates
+  host_spi_device = reference;
+  tft->resetViewport();
+  host_spi_device = panel;
+  tft->resetViewport();
+  Image shown(48 * 45);
+  for (int j = 0; j < 45; j++)
+    for (int i = 0; i < 48; i++) shown[j * 48 + i] = img[(j + 5) * 58 + i + 10];
+  TEST_ASSERT_EQUAL(0, pushBoth(16, 32, 48, 45, shown));
+  TEST_ASSERT_TRUE(panel->sameGram(*reference));
+}
+
+static void test_reset_area_after_other_drawing(void)
+{
+  Image img = randomImage(64, 32);
+  pushBoth(32, 32, 64, 32, img);
+
+  // Drawn over by another function, the hashes would hide the change
+  host_spi_device = reference;
+  tft->fillRect(40, 40, 20, 8, TFT_RED);
+  host_spi_device = panel;
+  tft->fillRect(40, 40, 20, 8, TFT_RED);
+  tft->resetFrameDiff(40, 40, 20, 8);
+
+  TEST_ASSERT_EQUAL(2 * 16 * 8, pushBoth(32, 32, 64, 32, img));
+  TEST_ASSERT_TRUE(panel->sameGram(*reference));
+}
+
+static void test_push_without_hashes(void)
+{
+  tft->setFrameDiff(false);
+  host_spi_device = reference;
+  tft->setViewport(10, 10, 200, 200);
+  host_spi_device = panel;
+  tft->setViewport(10, 10, 200, 200);
+
+  Image img = randomImage(80, 60);
+  TEST_ASSERT_EQUAL(80 * 60, pushBoth(5, 5, 80, 60, img));
+  TEST_ASSERT_EQUAL(80 * 60, pushBoth(5, 5, 80, 60, img));
+  TEST_ASSERT_EQUAL(30 * 50, pushBoth(170, 150, 80, 60, img));
+  TEST_ASSERT_TRUE(panel->sameGram(*reference));
+
+  uint32_t sent, saved;
+  tft->getFrameDiffStats(&sent, &saved);
+  TEST_ASSERT_EQUAL((2 * 80 * 60 + 30 * 50) * 2, sent);
+  TEST_ASSERT_EQUAL(0, saved);
+}
+
+int main(void)
+{
+  RUN_TEST(test_unchanged_pixels_are_not_sent);
+  RUN_TEST(test_partial_segments_are_always_sent);
+  RUN_TEST(test_changed_frames_match_push_image);
+  RUN_TEST(test_viewport_is_applied);
+  RUN_TEST(test_reset_area_after_other_drawing);
+  RUN_TEST(test_push_without_hashes);
+  return TEST_END();
+}
@@ -0,0 +1,201 @@
+// Smooth font glyph bitmap cache for fonts loaded from a file system
+
+#include <TFT_eSPI.h>
+#include "host_test.h"
+#include "st7789_model.h"
+#include "NotoSansBold15.h"
+
+static HostMemFS    memfs;
+static ST7789Model* panel;
+static TFT_eSPI*    tft;
+
+static void setUp(void)
+{
+  panel = new ST7789Model;
+  host_spi_device = panel;
+  host_spi_dc_pin = TFT_DC;
+  tft = new TFT_eSPI;
+  tft->init();
+  tft->loadFont("Noto", memfs);
+  tft->setTextColor(TFT_WHITE, TFT_BLACK, true);
+  memfs.resetStats();
+}
+
+static void tearDown(void)
+{
+  tft->unloadFont();
+  delete tft;
+  host_spi_device = nullptr;
+  delete panel;
+}
+
+static uint16_t glyph(uint16_t code)
+{
+  uint16_t gNum = 0;
+  tft->getUnicodeIndex(code, &gNum);
+  return gNum;
+}
+
+static uint32_t entrySize(uint16_t code)
+{
+  uint16_t gNum = glyph(code);
+  return sizeof(TFT_eSPI::glyphCacheEntry) + tft->gWidth[gNum] * tft->gHeight[gNum];
+}
+
+// Codes of the cached glyphs, most recently used first
+static std::string cached(void)
+{
+  std::string s;
+  for (TFT_eSPI::glyphCacheEntry* e = tft->gCache; e; e = e->next) s += (char)tft->gUnicode[e->gNum];
+  return s;
+}
+
+static uint32_t cachedBytes(void)
+{
+  uint32_t bytes = 0;
+  for (TFT_eSPI::glyphCacheEntry* e = tft->gCache; e; e = e->next) bytes += entrySize(tft->gUnicode[e->gNum]);
+  return bytes;
+}
+
+static void test_miss_reads_glyph_once(void)
+{
+  tft->setGlyphCache(4096);
+  const uint8_t* bitmap = tft->getGlyphBitmap(glyph('W'));
+
+  TEST_ASSERT_NOT_NULL(bitmap);
+  TEST_ASSERT_EQUAL(1, memfs.stats().seeks);
+  TEST_ASSERT_EQUAL(1, memfs.stats().reads);
+  TEST_ASSERT_EQUAL(entrySize('W') - sizeof(TFT_eSPI::glyphCacheEntry), memfs.stats().readBytes);
+  TEST_ASSERT_EQUAL_MEMORY(NotoSansBold15 + tft->gBitmap[glyph('W')], bitmap, memfs.stats().readBytes);
+  TEST_ASSERT_EQUAL(entrySize('W'), tft->gCacheUsed);
+}
+
+static void test_hit_does_not_read_file(void)
+{
+  tft->setGlyphCache(4096);
+  tft->setCursor(0, 0);
+  tft->print("Hello");
+  TEST_ASSERT_EQUAL(4, memfs.stats().reads); // 'l' is read once
+
+  memfs.resetStats();
+  tft->setCursor(0, 20);
+  tft->print("Hello Hello");
+  TEST_ASSERT_EQUAL(0, memfs.stats().reads);
+  TEST_ASSERT_EQUAL(0, memfs.stats().seeks);
+  TEST_ASSERT(cached() == "oleH");
+}
+
+static void test_without_cache_reads_every_line(void)
+{
+  tft->setCursor(0, 0);
+  tft->print("HH");
+  TEST_ASSERT_NULL(tft->gCache);
+  TEST_ASSERT_EQUAL(2 * tft->gHeight[glyph('H')], memfs.stats().reads);
+}
+
+static void test_least_recently_used_is_evicted(void)
+{
+  // Room for 'A' and 'B' but not for a third glyph
+  tft->setGlyphCache(entrySize('A') + entrySize('B') + entrySize('C') - 1);
+  tft->getGlyphBitmap(glyph('A'));
+  tft->getGlyphBitmap(glyph('B'));
+  tft->getGlyphBitmap(glyph('A'));
+  TEST_ASSERT(cached() == "AB");
+
+  tft->getGlyphBitmap(glyph('C'));
+  TEST_ASSERT(cached() == "CA");
+  TEST_ASSERT_EQUAL(cachedBytes(), tft->gCacheUsed);
+  TEST_ASSERT_LESS_OR_EQUAL(tft->gCacheSize, tft->gCacheUsed);
+
+  // A hit moves the glyph to the front, so 'C' goes next
+  tft->getGlyphBitmap(glyph('A'));
+  tft->getGlyphBitmap(glyph('D'));
+  TEST_ASSERT(cached()[0] == 'D');
+  TEST_ASSERT(cached().find('A') != std::string::npos);
+  TEST_ASSERT(cached().find('C') == std::string::npos);
+  TEST_ASSERT_EQUAL(cachedBytes(), tft->gCacheUsed);
+  TEST_ASSERT_LESS_OR_EQUAL(tft->gCacheSize, tft->gCacheUsed);
+}
+
+static void test_glyph_larger_than_cache_is_read_from_file(void)
+{
+  tft->setGlyphCache(entrySize('W') - 1);
+  TEST_ASSERT_NULL(tft->getGlyphBitmap(glyph('W')));
+  TEST_ASSERT_NULL(tft->gCache);
+  TEST_ASSERT_EQUAL(0, tft->gCacheUsed);
+
+  // Still drawn, line by line from the file
+  tft->setCursor(0, 0);
+  tft->print("W");
+  TEST_ASSERT_EQUAL(tft->gHeight[glyph('W')], memfs.stats().reads);
+}
+
+static void test_prefetch_reads_in_file_order(void)
+{
+  tft->setGlyphCache(4096);
+  tft->prefetchGlyphs("zyx cba zyx");
+  TEST_ASSERT_EQUAL(6, memfs.stats().reads);
+  TEST_ASSERT_EQUAL(0, memfs.stats().backSeeks);
+  TEST_ASSERT(cached() == "zyxcba");
+
+  memfs.resetStats();
+  tft->setCursor(0, 0);
+  tft->print("abc xyz");
+  TEST_ASSERT_EQUAL(0, memfs.stats().reads);
+}
+
+static void test_cached_glyphs_draw_same_pixels(void)
+{
+  const char* text = "Cached and uncached glyphs look the same 0123456789";
+  tft->fillScreen(TFT_BLACK);
+  tft->setCursor(0, 10);
+  tft->setTextWrap(true);
+  tft->print(text);
+  ST7789Model* reference = panel;
+
+  panel = new ST7789Model;
+  host_spi_device = panel;
+  tft->setGlyphCache(300); // Small enough to evict while drawing
+  tft->fillScreen(TFT_BLACK);
+  tft->setCursor(0, 10);
+  tft->print(text);
+  TEST_ASSERT(tft->gCache != NULL);
+
+  TEST_ASSERT_TRUE(panel->sameGram(*reference));
+  delete reference;
+}
+
+static void test_unload_frees_cache(void)
+{
+  tft->setGlyphCache(4096);
+  tft->prefetchGlyphs("Free me");
+  TEST_ASSERT(tft->gCache != NULL);
+
+  tft->unloadFont();
+  TEST_ASSERT_NULL(tft->gCache);
+  TEST_ASSERT_EQUAL(0, tft->gCacheUsed);
+  TEST_ASSERT_EQUAL(4096, tft->gCacheSize); // Budget kept for the next font
+
+  // Changing the budget also empties the cache
+  tft->loadFont("Noto", memfs);
+  tft->prefetchGlyphs("Free me");
+  TEST_ASSERT(tft->gCache != NULL);
+  tft->setGlyphCache(1024);
+  TEST_ASSERT_NULL(tft->gCache);
+  TEST_ASSERT_EQUAL(0, tft->gCacheUsed);
+}
+
+int main(void)
+{
+  memfs.add("/Noto.vlw", NotoSansBold15, sizeof(NotoSansBold15));
+
+  RUN_TEST(test_miss_reads_glyph_once);
+  RUN_TEST(test_hit_does_not_read_file);
+  RUN_TEST(test_without_cache_reads_every_line);
+  RUN_TEST(test_least_recently_used_is_evicted);
+  RUN_TEST(test_glyph_larger_than_cache_is_read_from_file);
+  RUN_TEST(test_prefetch_reads_in_file_order);
+  RUN_TEST(test_cached_glyphs_draw_same_pixels);
+  RUN_TEST(test_unload_frees_cache);
+  return TEST_END();
+}
@@ -0,0 +1,167 @@
+// Smooth font glyph lookup and buffered glyph rendering
+
+#include <algorithm>
+#include <TFT_eSPI.h>
+#include "host_test.h"
+#include "st7789_model.h"
+#include "vlw_font.h"
+#include "NotoSansBold15.h"
+
+static ST7789Model* panel;
+static TFT_eSPI*    tft;
+
+static void setUp(void)
+{
+  panel = new ST7789Model;
+  host_spi_device = panel;
+  host_spi_dc_pin = TFT_DC;
+  tft = new TFT_eSPI;
+  tft->init();
+}
+
+static void tearDown(void)
+{
+  tft->unloadFont();
+  delete tft;
+  host_spi_device = nullptr;
+  delete panel;
+}
+
+// The search used before the binary search, the first glyph in the file with the code
+static bool linearIndex(uint16_t unicode, uint16_t* index)
+{
+  for (uint16_t i = 0; i < tft->gFont.gCount; i++) {
+    if (tft->gUnicode[i] == unicode) { *index = i; return true; }
+  }
+  return false;
+}
+
+// Every 16 bit code, most of them are not in the font
+static void checkAllCodes(void)
+{
+  for (uint32_t code = 0; code <= 0xFFFF; code++) {
+    uint16_t expected = 0xFFFF, actual = 0xFFFF;
+    bool found = linearIndex(code, &expected);
+    TEST_ASSERT_EQUAL(found, tft->getUnicodeIndex(code, &actual));
+    TEST_ASSERT_EQUAL(expected, actual);
+  }
+}
+
+static void test_lookup_sorted_font(void)
+{
+  tft->loadFont(NotoSansBold15);
+  TEST_ASSERT_TRUE(tft->gSorted);
+  TEST_ASSERT_NULL(tft->gSortedIndex);
+  checkAllCodes();
+}
+
+static std::vector<uint8_t> unsortedFont;
+
+static void test_lookup_unsorted_font(void)
+{
+  // Glyphs in a scrambled order, with two codes that appear twice
+  VlwFont f = VlwFont::parse(NotoSansBold15);
+  std::reverse(f.glyphs.begin(), f.glyphs.end());
+  for (size_t i = 0; i + 7 < f.glyphs.size(); i += 7) std::swap(f.glyphs[i], f.glyphs[i + 5]);
+  f.glyphs.push_back(f.glyphs[3]);
+  f.glyphs.insert(f.glyphs.begin() + 10, f.glyphs[40]);
+  f.glyphs[10].xAdvance++;
+  unsortedFont = f.build();
+
+  tft->loadFont(unsortedFont.data());
+  TEST_ASSERT_TRUE(tft->gSorted);
+  TEST_ASSERT_NOT_NULL(tft->gSortedIndex);
+  checkAllCodes();
+}
+
+static void test_lookup_without_index(void)
+{
+  // The linear search is used when there is no memory for the sorted index
+  tft->loadFont(unsortedFont.data());
+  free(tft->gSortedIndex);
+  tft->gSortedIndex = NULL;
+  tft->gSorted = false;
+  checkAllCodes();
+}
+
+static uint16_t bgColor(uint16_t x, uint16_t y)
+{
+  return TFT_NAVY;
+}
+
+static uint16_t screenColor(uint16_t x, uint16_t y)
+{
+  return panel->gram[y][x];
+}
+
+static const char* text = "The quick brown fox, jumps over the lazy dog! 0123456789 {[(|)]} @#%&";
+
+static void drawText(void)
+{
+  tft->setCursor(3, 7);
+  tft->setTextWrap(true);
+  tft->print(text);
+  tft->setCursor(-4, 150);
+  tft->print("Clipped at the left and bottom edges");
+  tft->setCursor(0, 232);
+  tft->print("gjpqy");
+}
+
+static void test_buffered_glyphs_with_fill_match_pixels(void)
+{
+  tft->loadFont(NotoSansBold15);
+  tft->fillScreen(TFT_DARKGREEN);
+  tft->setTextColor(TFT_YELLOW, TFT_NAVY, true);
+
+  // The colour callback makes drawGlyph() plot pixel by pixel
+  tft->setCallback(bgColor);
+  panel->resetCounts();
+  drawText();
+  ST7789Model* reference = panel;
+
+  panel = new ST7789Model;
+  host_spi_device = panel;
+  tft->setCallback(nullptr);
+  tft->fillScreen(TFT_DARKGREEN);
+  panel->resetCounts();
+  drawText();
+
+  // Same pixels, with a fraction of the address windows
+  TEST_ASSERT_TRUE(panel->sameGram(*reference));
+  TEST_ASSERT_LESS_OR_EQUAL(reference->windows / 4, panel->windows);
+  delete reference;
+}
+
+static void test_buffered_glyphs_with_readback_match_pixels(void)
+{
+  tft->loadFont(NotoSansBold15);
+  tft->setTextColor(TFT_WHITE);
+  tft->setGlyphReadback(true);
+
+  // Glyphs are blended with a background that is different for every pixel
+  for (int y = 0; y < 240; y++)
+    for (int x = 0; x < 240; x++) panel->gram[y][x] = (x * 0x1F / 239) << 11 | (y * 0x3F / 239) << 5 | ((x ^ y) & 0x1F);
+  ST7789Model* reference = new ST7789Model(*panel);
+
+  drawText();
+
+  // Per pixel reference, the callback gives the colour under each pixel
+  std::swap(panel, reference);
+  host_spi_device = panel;
+  tft->setGlyphReadback(false);
+  tft->setCallback(screenColor);
+  drawText();
+
+  TEST_ASSERT_TRUE(panel->sameGram(*reference));
+  delete reference;
+}
+
+int main(void)
+{
+  RUN_TEST(test_lookup_sorted_font);
+  RUN_TEST(test_lookup_unsorted_font);
+  RUN_TEST(test_lookup_without_index);
+  RUN_TEST(test_buffered_glyphs_with_fill_match_pixels);
+  RUN_TEST(test_buffered_glyphs_with_readback_match_pixels);
+  return TEST_END();
+}
@@ -0,0 +1,79 @@
+// Reads and writes smooth font (.vlw) data so tests can make fonts with glyphs in any order.
+// The format is described in lib/TFT_eSPI/Extensions/Smooth_font.cpp, loadFont().
+
+#ifndef VLW_FONT_H
+#define VLW_FONT_H
+
+#include <stdint.h>
+#include <vector>
+
+struct VlwGlyph
+{
+  uint16_t code;
+  uint8_t  height, width, xAdvance;
+  int16_t  dY;
+  int8_t   dX;
+  std::vector<uint8_t> bitmap;
+};
+
+struct VlwFont
+{
+  uint32_t size = 0, ascent = 0, descent = 0;
+  std::vector<VlwGlyph> glyphs;
+
+  static uint32_t get32(const uint8_t* p) { return (uint32_t)p[0] << 24 | p[1] << 16 | p[2] << 8 | p[3]; }
+  static void     put32(std::vector<uint8_t>& v, uint32_t x)
+  {
+    v.push_back(x >> 24); v.push_back(x >> 16); v.push_back(x >> 8); v.push_back(x);
+  }
+
+  static VlwFont parse(const uint8_t* data)
+  {
+    VlwFont f;
+    uint32_t count = get32(data);
+    f.size    = get32(data + 8);
+    f.ascent  = get32(data + 16);
+    f.descent = get32(data + 20);
+    const uint8_t* bitmap = data + 24 + 28 * count;
+    for (uint32_t i = 0; i < count; i++) {
+      const uint8_t* m = data + 24 + 28 * i;
+      VlwGlyph g;
+      g.code     = get32(m);
+      g.height   = get32(m + 4);
+      g.width    = get32(m + 8);
+      g.xAdvance = get32(m + 12);
+      g.dY       = get32(m + 16);
+      g.dX       = get32(m + 20);
+      g.bitmap.assign(bitmap, bitmap + g.width * g.height);
+      bitmap += g.width * g.height;
+      f.glyphs.push_back(g);
+    }
+    return f;
+  }
+
+  std::vector<uint8_t> build() const
+  {
+    std::vector<uint8_t> v;
+    put32(v, glyphs.size());
+    put32(v, 11);
+    put32(v, size);
+    put32(v, 0);
+    put32(v, ascent);
+    put32(v, descent);
+    for (const VlwGlyph& g : glyphs) {
+      put32(v, g.code);
+      put32(v, g.height);
+      put32(v, g.width);
+      put32(v, g.xAdvance);
+      put32(v, (uint32_t)(int32_t)g.dY);
+      put32(v, (uint32_t)(int32_t)g.dX);
+      put32(v, 0);
+    }
+    for (const VlwGlyph& g : glyphs) v.insert(v.end(), g.bitmap.begin(), g.bitmap.end());
+    // Font names and the smoothing flag
+    v.push_back(0); v.push_back(0); v.push_back(0); v.push_back(0); v.push_back(1);
+    return v;
+  }
+};
+
+#endif
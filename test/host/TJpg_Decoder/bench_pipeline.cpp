@@ -0,0 +1,76 @@
+// Host time per image for the panda jpeg of the Flash_Jpg example, drawn with
+// TJpgDec.setPipeline() off and on. The pipeline runs the decoder in a std::thread.
+//
+// The callback copies each block to a frame buffer and then busy waits for the time a
+// pushImage() without DMA would keep the CPU on the SPI bus. That time per pixel is set to
+// the measured decode time per pixel, the balanced case in which the pipeline can at best
+// halve the time. The speedup needs a second CPU, with one CPU the two threads take turns.
+// The frame buffers of both modes must be identical.
+
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <TJpg_Decoder.h>
+#include "panda.h"
+
+typedef std::chrono::steady_clock Clock;
+
+static std::vector<uint16_t> frame;
+static uint16_t              width, height;
+static double                pushNsPerPixel;
+
+static bool output(int16_t x, int16_t y, uint16_t w, uint16_t h, uint16_t* bitmap)
+{
+  auto end = Clock::now() + std::chrono::nanoseconds((long long)(pushNsPerPixel * w * h));
+  for (int j = 0; j < h; j++)
+    for (int i = 0; i < w; i++)
+      if (x + i < width && y + j < height) frame[(y + j) * width + x + i] = bitmap[j * w + i];
+  while (Clock::now() < end) {}
+  return true;
+}
+
+// Milliseconds per image
+static double draw(bool pipeline, int count)
+{
+  TJpgDec.setPipeline(pipeline);
+  auto t0 = Clock::now();
+  for (int i = 0; i < count; i++) TJpgDec.drawJpg(0, 0, panda, sizeof(panda));
+  auto t1 = Clock::now();
+  TJpgDec.setPipeline(false);
+  return std::chrono::duration<double, std::milli>(t1 - t0).count() / count;
+}
+
+static bool run(const char* name, int count)
+{
+  std::vector<uint16_t> off, on;
+  frame.assign(width * height, 0);
+  double tOff = draw(false, count);
+  off.swap(frame);
+  frame.assign(width * height, 0);
+  double tOn = draw(true, count);
+  on.swap(frame);
+
+  printf("%-20s %10.3f %10.3f %8.2fx %s\n", name, tOff, tOn, tOff / tOn,
+         off == on ? "" : "DIFFERENT PIXELS");
+  return off == on;
+}
+
+int main(void)
+{
+  TJpgDec.setJpgScale(1);
+  TJpgDec.setSwapBytes(true);
+  TJpgDec.setCallback(output);
+  TJpgDec.getJpgSize(&width, &height, panda, sizeof(panda));
+
+  frame.assign(width * height, 0);
+  pushNsPerPixel = 0;
+  double decodeMs = draw(false, 200);
+
+  printf("%ux%u jpeg, %u CPU(s), decode %.3f ms\n", width, height,
+         std::thread::hardware_concurrency(), decodeMs);
+  printf("%-20s %10s %10s %9s\n", "", "off ms", "on ms", "speedup");
+  bool same = run("decode only", 200);
+  pushNsPerPixel = decodeMs * 1e6 / (width * height);
+  same &= run("decode + push", 100);
+  return same ? 0 : 1;
+}
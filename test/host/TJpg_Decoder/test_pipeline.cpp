@@ -0,0 +1,109 @@
+// TJpgDec.setPipeline() on std::thread: the blocks reach the callback as without the
+// pipeline, and a callback returning false stops the drawing with JDR_INTR in both modes,
+// including on a block which was queued after the decoding had already ended.
+
+#include <vector>
+#include <TJpg_Decoder.h>
+#include "host_test.h"
+#include "panda.h"
+
+static std::vector<uint16_t> frame;
+static uint16_t              width, height;
+static int                   calls;
+static int                   stopAt;
+
+static bool output(int16_t x, int16_t y, uint16_t w, uint16_t h, uint16_t* bitmap)
+{
+  for (int j = 0; j < h; j++)
+    for (int i = 0; i < w; i++)
+      if (x + i < width && y + j < height) frame[(y + j) * width + x + i] = bitmap[j * w + i];
+  return calls++ != stopAt;
+}
+
+static JRESULT draw(bool pipeline)
+{
+  TJpgDec.setPipeline(pipeline);
+  frame.assign(width * height, 0);
+  calls = 0;
+  return TJpgDec.drawJpg(0, 0, panda, sizeof(panda));
+}
+
+static void setUp(void)
+{
+  TJpgDec.setJpgScale(1);
+  TJpgDec.setSwapBytes(true);
+  TJpgDec.setCallback(output);
+  TJpgDec.getJpgSize(&width, &height, panda, sizeof(panda));
+  stopAt = -1;
+}
+
+static void tearDown(void)
+{
+  TJpgDec.setPipeline(false);
+}
+
+static void test_pipeline_draws_the_same_pixels(void)
+{
+  for (uint8_t scale = 1; scale <= 8; scale *= 2) {
+    TJpgDec.setJpgScale(scale);
+    TEST_ASSERT_EQUAL(JDR_OK, draw(false));
+    std::vector<uint16_t> off;
+    off.swap(frame);
+    int offCalls = calls;
+
+    TEST_ASSERT_EQUAL(JDR_OK, draw(true));
+    TEST_ASSERT_EQUAL(offCalls, calls);
+    TEST_ASSERT_TRUE(off == frame);
+  }
+}
+
+static void test_stop_in_the_image(void)
+{
+  // The blocks decoded ahead of the stop are dropped without calling the callback
+  stopAt = 10;
+  TEST_ASSERT_EQUAL(JDR_INTR, draw(false));
+  TEST_ASSERT_EQUAL(11, calls);
+  TEST_ASSERT_EQUAL(JDR_INTR, draw(true));
+  TEST_ASSERT_EQUAL(11, calls);
+}
+
+static void test_stop_on_the_last_block(void)
+{
+  // The decoder has queued every block and returned JDR_OK when the callback stops
+  TEST_ASSERT_EQUAL(JDR_OK, draw(false));
+  int blocks = calls;
+  for (stopAt = blocks - 1; stopAt >= blocks - TJPGD_PIPELINE_BLOCKS; stopAt--) {
+    TEST_ASSERT_EQUAL(JDR_INTR, draw(false));
+    TEST_ASSERT_EQUAL(stopAt + 1, calls);
+    TEST_ASSERT_EQUAL(JDR_INTR, draw(true));
+    TEST_ASSERT_EQUAL(stopAt + 1, calls);
+  }
+}
+
+static void test_pipeline_draws_after_a_stop(void)
+{
+  TEST_ASSERT_EQUAL(JDR_OK, draw(false));
+  std::vector<uint16_t> off;
+  off.swap(frame);
+
+  TJpgDec.setPipeline(true);
+  stopAt = 0;
+  frame.assign(width * height, 0);
+  calls = 0;
+  TEST_ASSERT_EQUAL(JDR_INTR, TJpgDec.drawJpg(0, 0, panda, sizeof(panda)));
+
+  stopAt = -1;
+  frame.assign(width * height, 0);
+  calls = 0;
+  TEST_ASSERT_EQUAL(JDR_OK, TJpgDec.drawJpg(0, 0, panda, sizeof(panda)));
+  TEST_ASSERT_TRUE(off == frame);
+}
+
+int main(void)
+{
+  RUN_TEST(test_pipeline_draws_the_same_pixels);
+  RUN_TEST(test_stop_in_the_image);
+  RUN_TEST(test_stop_on_the_last_block);
+  RUN_TEST(test_pipeline_draws_after_a_stop);
+  return TEST_END();
+}
@@ -0,0 +1,50 @@
+// Host time for drawing a clock with the test font. Built as bench_glyph_decode with u8g2
+// and as bench_glyph_cache with U8G2_WITH_GLYPH_CACHE.
+//
+// On the null display (8x8 pixels, nothing is sent) only the bottom rows of the first
+// glyph are visible, so the time is mostly the glyph lookup and decoding. On the 128x64
+// full buffer all the glyphs are drawn, the buffer is not sent.
+
+#include <chrono>
+#include <stdio.h>
+#include <u8g2.h>
+#include "test_font.h"
+
+#ifdef U8G2_WITH_GLYPH_CACHE
+#define CONFIG "cache"
+#else
+#define CONFIG "no cache"
+#endif
+
+static uint8_t byte_cb(u8x8_t* u8x8, uint8_t msg, uint8_t arg_int, void* arg_ptr)
+{
+  return 1;
+}
+
+static void run(const char* name, u8g2_t* u8g2, u8g2_uint_t y, int frames)
+{
+  char clock[8];
+  u8g2_SetFont(u8g2, test_font);
+  auto t0 = std::chrono::steady_clock::now();
+  for (int f = 0; f < frames; f++) {
+    snprintf(clock, sizeof(clock), "%02d:%02d", f / 60 % 60, f % 60);
+    u8g2_ClearBuffer(u8g2);
+    u8g2_DrawStr(u8g2, 0, y, clock);
+  }
+  auto t1 = std::chrono::steady_clock::now();
+  printf("%-16s %-9s %10.2f\n", name, CONFIG,
+         std::chrono::duration<double, std::micro>(t1 - t0).count() / frames);
+}
+
+int main(void)
+{
+  u8g2_t null, full;
+  u8g2_Setup_null(&null, U8G2_R0, byte_cb, byte_cb);
+  u8g2_Setup_ssd1306_128x64_noname_f(&full, U8G2_R0, byte_cb, byte_cb);
+  u8g2_InitDisplay(&full);
+
+  printf("%-16s %-9s %10s\n", "", "", "us/frame");
+  run("null display", &null, 8, 200000);
+  run("128x64 buffer", &full, 48, 50000);
+  return 0;
+}
@@ -0,0 +1,11 @@
+// Writes the buffers of the glyph scenes drawn without the glyph cache to stdout, for
+// test_glyph_cache to compare with
+
+#include <stdio.h>
+#include "glyph_scenes.h"
+
+int main(void)
+{
+  renderGlyphScenes([](const uint8_t* data, size_t len) { fwrite(data, 1, len, stdout); });
+  return 0;
+}
@@ -0,0 +1,77 @@
+// Text drawn with the test font for comparing u8g2 with and without U8G2_WITH_GLYPH_CACHE:
+// all font directions, font modes and draw colors, clipped at each edge, on a full buffer and
+// a page buffer, and the string widths. The same glyphs from a second copy of the font fill
+// the cache, so it is cleared on the way.
+
+#ifndef GLYPH_SCENES_H
+#define GLYPH_SCENES_H
+
+#include <string.h>
+#include <u8g2.h>
+#include "test_font.h"
+
+static uint8_t test_font_copy[sizeof(test_font)];
+
+static uint8_t glyph_scenes_byte_cb(u8x8_t* u8x8, uint8_t msg, uint8_t arg_int, void* arg_ptr)
+{
+  return 1;
+}
+
+// out(const uint8_t* data, size_t len) is called with the buffer after each scene
+template <typename Out>
+static void renderGlyphScenes(Out out)
+{
+  static const char* const strings[] = { "12:34.5 67 89 0", "9876", "00:00", " 1.1 " };
+  const uint8_t* fonts[] = { test_font, test_font_copy };
+  memcpy(test_font_copy, test_font, sizeof(test_font));
+
+  u8g2_t u8g2;
+  u8g2_Setup_ssd1306_128x64_noname_f(&u8g2, U8G2_R0, glyph_scenes_byte_cb, glyph_scenes_byte_cb);
+  u8g2_InitDisplay(&u8g2);
+  for (const uint8_t* font : fonts) {
+    u8g2_SetFont(&u8g2, font);
+    for (uint8_t dir = 0; dir < 4; dir++)
+      for (uint8_t mode = 0; mode < 2; mode++)
+        for (uint8_t color = 0; color < 3; color++)
+          for (int pos = 0; pos < 6; pos++) {
+            u8g2_ClearBuffer(&u8g2);
+            u8g2_SetDrawColor(&u8g2, 1);
+            u8g2_DrawBox(&u8g2, 10, 10, 60, 30); // Shows the background and XOR
+            u8g2_SetFontDirection(&u8g2, dir);
+            u8g2_SetFontMode(&u8g2, mode);
+            u8g2_SetDrawColor(&u8g2, color);
+            int x = pos * 23 - 20, y = pos * 13;
+            u8g2_DrawStr(&u8g2, x, y, strings[0]);
+            u8g2_DrawStr(&u8g2, x + 5, y + 20, strings[1]);
+            u8g2_DrawStr(&u8g2, 100 - x, 60 - y, strings[2 + pos % 2]);
+            out(u8g2_GetBufferPtr(&u8g2), 1024);
+
+            uint8_t widths[4];
+            for (int i = 0; i < 4; i++) widths[i] = u8g2_GetStrWidth(&u8g2, strings[i]);
+            out(widths, sizeof(widths));
+          }
+  }
+
+  // Rotated display
+  u8g2_SetDisplayRotation(&u8g2, U8G2_R1);
+  u8g2_SetFontDirection(&u8g2, 0);
+  u8g2_SetDrawColor(&u8g2, 1);
+  u8g2_ClearBuffer(&u8g2);
+  u8g2_DrawStr(&u8g2, 0, 40, "12:34");
+  u8g2_DrawStr(&u8g2, 3, 100, "5.6789");
+  out(u8g2_GetBufferPtr(&u8g2), 1024);
+
+  // Page mode
+  u8g2_t page;
+  u8g2_Setup_ssd1306_128x64_noname_1(&page, U8G2_R0, glyph_scenes_byte_cb, glyph_scenes_byte_cb);
+  u8g2_InitDisplay(&page);
+  u8g2_SetFont(&page, test_font);
+  u8g2_FirstPage(&page);
+  do {
+    u8g2_DrawStr(&page, 3, 40, "2468:13");
+    u8g2_DrawStr(&page, 50, 63, "0.5");
+    out(u8g2_GetBufferPtr(&page), 128);
+  } while (u8g2_NextPage(&page));
+}
+
+#endif
@@ -0,0 +1,110 @@
+#!/usr/bin/env python3
+# Writes test_font.h: a u8g2 font of 20x32 seven segment digits, ':', '.' and ' ', encoded
+# in the run length format of bdfconv. The U8g2 fonts are not in this tree.
+#
+#   python3 make_test_font.py > test_font.h
+
+# Bits of the zero and one runs, glyph width and height, x and y offset and delta x
+B0, B1, BW, BH, BX, BY, BD = 4, 4, 6, 6, 4, 5, 6
+W, H = 20, 32
+
+
+class Bits:
+    def __init__(self):
+        self.bytes = []
+        self.pos = 0
+
+    def put(self, v, n):
+        for i in range(n):
+            if self.pos % 8 == 0:
+                self.bytes.append(0)
+            self.bytes[-1] |= ((v >> i) & 1) << (self.pos % 8)
+            self.pos += 1
+
+
+def encode(w, h, x, y, d, px):
+    b = Bits()
+    b.put(w, BW)
+    b.put(h, BH)
+    b.put(x + (1 << (BX - 1)), BX)
+    b.put(y + (1 << (BY - 1)), BY)
+    b.put(d + (1 << (BD - 1)), BD)
+    if w:
+        pairs = []
+        i, n = 0, len(px)
+        while i < n:
+            a = 0
+            while i < n and px[i] == 0 and a < (1 << B0) - 1:
+                a += 1
+                i += 1
+            c = 0
+            while i < n and px[i] == 1 and c < (1 << B1) - 1:
+                c += 1
+                i += 1
+            pairs.append((a, c))
+        # Each pair is followed by a 1 bit for each repetition and a 0 bit
+        j = 0
+        while j < len(pairs):
+            b.put(pairs[j][0], B0)
+            b.put(pairs[j][1], B1)
+            k = j + 1
+            while k < len(pairs) and pairs[k] == pairs[j]:
+                b.put(1, 1)
+                k += 1
+            b.put(0, 1)
+            j = k
+    return b.bytes
+
+
+def digit(ch, w, h):
+    segs = {'0': 'abcdef', '1': 'bc', '2': 'abged', '3': 'abgcd', '4': 'fgbc', '5': 'afgcd',
+            '6': 'afgedc', '7': 'abc', '8': 'abcdefg', '9': 'abcdfg'}[ch]
+    t, m = 4, h // 2
+    px = [[0] * w for _ in range(h)]
+
+    def rect(x0, y0, x1, y1):
+        for yy in range(y0, y1):
+            for xx in range(x0, x1):
+                px[yy][xx] = 1
+
+    if 'a' in segs: rect(t, 0, w - t, t)
+    if 'g' in segs: rect(t, m - t // 2, w - t, m + t // 2)
+    if 'd' in segs: rect(t, h - t, w - t, h)
+    if 'f' in segs: rect(0, t, t, m)
+    if 'b' in segs: rect(w - t, t, w, m)
+    if 'e' in segs: rect(0, m, t, h - t)
+    if 'c' in segs: rect(w - t, m, w, h - t)
+    return sum(px, [])
+
+
+glyphs = {ord(c): (W, H, 1, 0, W + 3, digit(c, W, H)) for c in '0123456789'}
+glyphs[ord(':')] = (4, 20, 1, 4, 7, [1] * 16 + [0] * 48 + [1] * 16)
+glyphs[ord('.')] = (4, 4, 1, 0, 7, [1] * 16)
+glyphs[ord(' ')] = (0, 0, 0, 0, 8, [])
+
+data = []
+for e in sorted(glyphs):
+    g = encode(*glyphs[e])
+    data += [e, len(g) + 2] + g
+end = len(data)
+data += [0, 0]
+unicode_table = len(data)
+data += [0, 4, 0xff, 0xff, 0, 0]
+# No glyphs from 'A' or 'a' on: both start positions are the end of the glyphs
+header = [len(glyphs), 0, B0, B1, BW, BH, BX, BY, BD, W + 2, H, 0, 0, H, 0, H, 0,
+          end >> 8, end & 255, end >> 8, end & 255, unicode_table >> 8, unicode_table & 255]
+font = header + data
+
+print('// Generated by make_test_font.py: 20x32 seven segment digits, \':\', \'.\' and \' \'')
+print()
+print('#ifndef TEST_FONT_H')
+print('#define TEST_FONT_H')
+print()
+print('#include <stdint.h>')
+print()
+print('static const uint8_t test_font[%d] = {' % len(font))
+for i in range(0, len(font), 16):
+    print('  ' + ', '.join('%3d' % v for v in font[i:i + 16]) + ',')
+print('};')
+print()
+print('#endif')
@@ -0,0 +1,46 @@
+// Generated by make_test_font.py: 20x32 seven segment digits, ':', '.' and ' '
+
+#ifndef TEST_FONT_H
+#define TEST_FONT_H
+
+#include <stdint.h>
+
+static const uint8_t test_font[558] = {
+   13,   0,   4,   4,   6,   6,   4,   5,   6,  22,  32,   0,   0,  32,   0,  32,
+    0,   2,  15,   2,  15,   2,  17,  32,   6,   0, 128,  16,   5,  46,   8,   4,
+  145, 240, 132,   7,   1,  48,  18,  20, 152, 240,  38, 134,  60,  34, 140, 255,
+  255,  63,  38, 196, 144,  71,   0,  49,  63,  20, 152, 240, 126, 248, 140,  60,
+    8, 242,  32, 200, 131,  32,  15, 130,  60,   8, 242,  32, 200, 131,  32,  15,
+  130,  60,   8, 242,  32, 200, 131,  32,  15, 130,  60,   8, 242,  32, 200, 131,
+   32,  15, 130,  60,   8, 242,  32, 200, 131,  32,  15, 130,  60,   8, 242,  32,
+  200, 131,  32,  15, 175,   0,  50,  65,  20, 152, 240,  38, 134, 188,   7,  69,
+   30,   4, 121,  16, 228,  65, 144,   7,  65,  30,   4, 121,  16, 228,  65, 144,
+    7,  65,  30,   4, 161,   7, 129,  30,  60,  16, 244,  32,  16, 121,  16, 228,
+   65, 144,   7,  65,  30,   4, 121,  16, 228,  65, 144,   7,  65,  30,   4, 121,
+   16, 228,  65,  49, 228,  17,   0,  51,  66,  20, 152, 240,  38, 134, 188,   7,
+   69,  30,   4, 121,  16, 228,  65, 144,   7,  65,  30,   4, 121,  16, 228,  65,
+  144,   7,  65,  30,   4, 161,   7, 129,  30,   4, 122,  16, 232,  65, 120,  16,
+  228,  65, 144,   7,  65,  30,   4, 121,  16, 228,  65, 144,   7,  65,  30,   4,
+  121,  16, 228,  65,  16,  98, 200,  35,   0,  52,  44,  20, 152, 240, 126, 120,
+   69,  24, 255, 241, 131,   7, 142,  30,   4, 122,  16,  30,   4, 121,  16, 228,
+   65, 144,   7,  65,  30,   4, 121,  16, 228,  65, 144,   7,  65,  30,   4, 121,
+   16, 228, 225,  21,   0,  53,  66,  20, 152, 240,  38, 134,  60,  34,  15, 130,
+   60,   8, 242,  32, 200, 131,  32,  15, 130,  60,   8, 242,  32, 200, 131,  32,
+   15, 130,  60, 136,   7, 129,  30,   4, 124,  16, 232,  65, 120,  16, 228,  65,
+  144,   7,  65,  30,   4, 121,  16, 228,  65, 144,   7,  65,  30,   4, 121,  16,
+  228,  65,  16,  98, 200,  35,   0,  54,  46,  20, 152, 240,  38, 134,  60,  34,
+   15, 130,  60,   8, 242,  32, 200, 131,  32,  15, 130,  60,   8, 242,  32, 200,
+  131,  32,  15, 130,  60, 136,   7, 129,  30,   4, 122, 240, 192,  49, 254,  99,
+   66,  12, 121,   4,   0,  55,  65,  20, 152, 240,  38, 134, 188,   7,  69,  30,
+    4, 121,  16, 228,  65, 144,   7,  65,  30,   4, 121,  16, 228,  65, 144,   7,
+   65,  30,   4, 121,  16, 228,  65, 144,   7,  65,  30,   4, 121,  16, 228,  65,
+  144,   7,  65,  30,   4, 121,  16, 228,  65, 144,   7,  65,  30,   4, 121,  16,
+  228,  65, 144, 135,  87,   0,  56,  22,  20, 152, 240,  38, 134,  60,  34, 140,
+  255, 248, 193,  31,  52, 198, 127,  76, 136,  33, 143,   0,  57,  46,  20, 152,
+  240,  38, 134,  60,  34, 140, 255, 248, 193,   3,  71,  15,   2,  61,   8,  15,
+  130,  60,   8, 242,  32, 200, 131,  32,  15, 130,  60,   8, 242,  32, 200, 131,
+   32,  15, 130,  60,   8,  66,  12, 121,   4,   0,  58,  12,   4, 149, 244, 132,
+    7, 225,  97, 243,  32,   0,   0,   0,   0,   4, 255, 255,   0,   0,
+};
+
+#endif
@@ -0,0 +1,106 @@
+// Text drawn with U8G2_WITH_GLYPH_CACHE must be byte for byte the same as without it. The
+// glyph scenes are drawn here with the cache and by u8g2_glyph_reference, which is built
+// without it, and the buffers are compared.
+
+#include <stdio.h>
+#include <vector>
+#include "host_test.h"
+#include "glyph_scenes.h"
+
+#ifndef U8G2_WITH_GLYPH_CACHE
+#error "test_u8g2_glyph_cache needs the u8g2 library built with U8G2_WITH_GLYPH_CACHE"
+#endif
+
+typedef std::vector<uint8_t> Scene;
+
+static std::vector<Scene> reference, cached;
+
+static void setUp(void)
+{
+}
+
+static void tearDown(void)
+{
+}
+
+static void record(std::vector<Scene>& scenes, const uint8_t* data, size_t len)
+{
+  scenes.push_back(Scene(data, data + len));
+}
+
+static void test_reference_is_drawn(void)
+{
+  FILE* f = popen(GLYPH_REFERENCE, "r");
+  TEST_ASSERT(f != NULL);
+  std::vector<uint8_t> bytes;
+  uint8_t block[4096];
+  size_t n;
+  while ((n = fread(block, 1, sizeof(block), f)) > 0) bytes.insert(bytes.end(), block, block + n);
+  TEST_ASSERT_EQUAL(0, pclose(f));
+
+  // The reference has no scene boundaries, they are taken from the scenes drawn here
+  renderGlyphScenes([](const uint8_t* data, size_t len) { record(cached, data, len); });
+  size_t pos = 0;
+  for (const Scene& s : cached) {
+    if (pos + s.size() > bytes.size()) TEST_FAIL_MESSAGE("The reference is too short");
+    record(reference, bytes.data() + pos, s.size());
+    pos += s.size();
+  }
+  TEST_ASSERT_EQUAL(bytes.size(), pos);
+}
+
+static void test_cached_scenes_are_identical(void)
+{
+  TEST_ASSERT_EQUAL(reference.size(), cached.size());
+  size_t differ = 0;
+  for (size_t i = 0; i < cached.size(); i++)
+    if (cached[i] != reference[i]) {
+      if (differ++ == 0) printf("scene %zu differs\n", i);
+    }
+  printf("%zu scenes, %zu differ\n", cached.size(), differ);
+  TEST_ASSERT_EQUAL(0, differ);
+}
+
+static void test_scenes_draw_something(void)
+{
+  // Identical scenes of only the box would pass even if no glyph was drawn
+  u8g2_t u8g2;
+  u8g2_Setup_ssd1306_128x64_noname_f(&u8g2, U8G2_R0, glyph_scenes_byte_cb, glyph_scenes_byte_cb);
+  u8g2_ClearBuffer(&u8g2);
+  u8g2_DrawBox(&u8g2, 10, 10, 60, 30);
+  Scene box(u8g2_GetBufferPtr(&u8g2), u8g2_GetBufferPtr(&u8g2) + 1024);
+  size_t withText = 0;
+  for (const Scene& s : reference)
+    if (s.size() == 1024 && s != box) withText++;
+  TEST_ASSERT(withText > reference.size() / 4);
+}
+
+static void test_digits_are_cached(void)
+{
+  u8g2_t u8g2;
+  u8g2_Setup_ssd1306_128x64_noname_f(&u8g2, U8G2_R0, glyph_scenes_byte_cb, glyph_scenes_byte_cb);
+  u8g2_SetFont(&u8g2, test_font);
+  TEST_ASSERT_EQUAL(0, u8g2.glyph_cache.cnt);
+
+  u8g2_DrawStr(&u8g2, 0, 40, "12:21");
+  TEST_ASSERT_EQUAL(3, u8g2.glyph_cache.cnt);
+  TEST_ASSERT(u8g2.glyph_cache.digit_font == test_font);
+  TEST_ASSERT_TRUE(u8g2.glyph_cache.digit[1] != 0 && u8g2.glyph_cache.digit[2] != 0);
+  TEST_ASSERT_EQUAL(0, u8g2.glyph_cache.digit[3]);
+
+  u8g2_DrawStr(&u8g2, 0, 40, "1122");
+  TEST_ASSERT_EQUAL(3, u8g2.glyph_cache.cnt);
+
+  u8g2_ClearGlyphCache(&u8g2);
+  TEST_ASSERT_EQUAL(0, u8g2.glyph_cache.cnt);
+  TEST_ASSERT_EQUAL(0, u8g2.glyph_cache.used);
+}
+
+int main(void)
+{
+  RUN_TEST(test_reference_is_drawn);
+  RUN_TEST(test_cached_scenes_are_identical);
+  RUN_TEST(test_scenes_draw_something);
+  RUN_TEST(test_digits_are_cached);
+  return TEST_END();
+}
@@ -0,0 +1,134 @@
+// The I2C transfers of an SSD1306 with u8x8_cad_ssd13xx_fast_i2c() and the Arduino byte
+// procedure: commands are collected into transfers up to the Wire buffer, a tile row is its
+// address commands and the data in U8X8_I2C_MAX_DATA blocks. The transmissions are recorded
+// on the Wire stub and decoded by the display model.
+
+#include <stdlib.h>
+#include <U8x8lib.h>
+#include <u8g2.h>
+#include "host_test.h"
+#include "Adafruit_SSD1306/ssd1306_model.h"
+
+static SSD1306Model* oled;
+static u8g2_t        u8g2;
+
+static void setUp(void)
+{
+  oled = new SSD1306Model(0x3C);
+  host_i2c_device = oled;
+  Wire.overflows = 0;
+  u8g2_Setup_ssd1306_i2c_128x64_noname_f(&u8g2, U8G2_R0, u8x8_byte_arduino_hw_i2c,
+                                         u8x8_gpio_and_delay_arduino);
+  u8g2_InitDisplay(&u8g2);
+  u8g2_ClearBuffer(&u8g2); // The buffer is static, it has the last test's drawing
+  u8g2_SendBuffer(&u8g2);
+  oled->resetCounts();
+  Wire.transmissions = 0;
+}
+
+static void tearDown(void)
+{
+  host_i2c_device = nullptr;
+  delete oled;
+}
+
+static bool isCommand(const SSD1306Model::Transmission& t, std::vector<uint8_t> bytes)
+{
+  return !t.data && t.bytes == bytes;
+}
+
+// Every transmission with its control byte fits the Wire buffer
+static bool fitWireBuffer(void)
+{
+  for (const auto& t : oled->log)
+    if (t.bytes.size() + 1 > I2C_BUFFER_LENGTH) return false;
+  return Wire.overflows == 0;
+}
+
+static void test_init_sequence_is_one_transfer(void)
+{
+  u8g2_InitDisplay(&u8g2);
+  TEST_ASSERT_EQUAL(1, Wire.transmissions);
+  TEST_ASSERT_FALSE(oled->log[0].data);
+  TEST_ASSERT_EQUAL(0xAE, oled->log[0].bytes[0]); // Display off
+  TEST_ASSERT(oled->commands > 15);
+  TEST_ASSERT_TRUE(fitWireBuffer());
+}
+
+static void test_commands_are_split_at_the_wire_buffer(void)
+{
+  // A command with up to 31 args must fit after the last one in a transfer
+  u8x8_t* u8x8 = u8g2_GetU8x8(&u8g2);
+  u8x8_cad_StartTransfer(u8x8);
+  for (int i = 0; i < 60; i++) {
+    u8x8_cad_SendCmd(u8x8, 0x81);
+    u8x8_cad_SendArg(u8x8, i);
+  }
+  u8x8_cad_EndTransfer(u8x8);
+
+  TEST_ASSERT_EQUAL(2, oled->log.size());
+  TEST_ASSERT_EQUAL(2 * 48, oled->log[0].bytes.size());
+  TEST_ASSERT_EQUAL(60, oled->commands);
+  TEST_ASSERT_TRUE(fitWireBuffer());
+}
+
+static void test_frame_is_three_transfers_per_row(void)
+{
+  uint8_t* buf = u8g2_GetBufferPtr(&u8g2);
+  srand(47);
+  for (int i = 0; i < 1024; i++) buf[i] = rand();
+  u8g2_SendBuffer(&u8g2);
+
+  TEST_ASSERT_EQUAL(24, Wire.transmissions);
+  for (uint8_t row = 0; row < 8; row++) {
+    const auto* t = &oled->log[row * 3];
+    TEST_ASSERT_TRUE(isCommand(t[0], { 0x40, 0x10, 0x00, (uint8_t)(0xB0 | row) }));
+    TEST_ASSERT_TRUE(t[1].data && t[1].bytes.size() == U8X8_I2C_MAX_DATA);
+    TEST_ASSERT_TRUE(t[2].data && t[2].bytes.size() == 128 - U8X8_I2C_MAX_DATA);
+  }
+  TEST_ASSERT_EQUAL(1024, oled->dataBytes);
+  TEST_ASSERT_TRUE(oled->sameAs(buf, 128, 8));
+  TEST_ASSERT_TRUE(fitWireBuffer());
+
+  // Address byte, control byte and the payload of each transmission, without start and stop
+  uint32_t bytes = 0;
+  for (const auto& t : oled->log) bytes += t.bytes.size() + 2;
+  printf("%u transmissions, %u bytes on the bus for 1024 bytes of data (%.1f%%)\n",
+         Wire.transmissions, bytes, 100.0 * 1024 / bytes);
+}
+
+static void test_area_is_one_data_transfer(void)
+{
+  u8g2_DrawBox(&u8g2, 24, 16, 24, 8);
+  u8g2_UpdateDisplayArea(&u8g2, 3, 2, 3, 1);
+
+  TEST_ASSERT_EQUAL(2, oled->log.size());
+  TEST_ASSERT_TRUE(isCommand(oled->log[0], { 0x40, 0x11, 0x08, 0xB2 }));
+  TEST_ASSERT_TRUE(oled->log[1].data);
+  TEST_ASSERT_EQUAL(24, oled->log[1].bytes.size());
+  TEST_ASSERT_TRUE(oled->sameAs(u8g2_GetBufferPtr(&u8g2), 128, 8));
+}
+
+static void test_commands_after_data_start_a_new_transfer(void)
+{
+  u8g2_DrawBox(&u8g2, 0, 0, 8, 8);
+  u8g2_UpdateDisplayArea(&u8g2, 0, 0, 1, 1);
+  u8g2_SetContrast(&u8g2, 0x20);
+  u8g2_SetPowerSave(&u8g2, 1);
+
+  TEST_ASSERT_EQUAL(4, oled->log.size());
+  TEST_ASSERT_TRUE(oled->log[1].data);
+  TEST_ASSERT_TRUE(isCommand(oled->log[2], { 0x81, 0x20 }));
+  TEST_ASSERT_TRUE(isCommand(oled->log[3], { 0xAE }));
+  TEST_ASSERT_TRUE(oled->sameAs(u8g2_GetBufferPtr(&u8g2), 128, 8));
+}
+
+int main(void)
+{
+  RUN_TEST(test_init_sequence_is_one_transfer);
+  RUN_TEST(test_commands_are_split_at_the_wire_buffer);
+  RUN_TEST(test_frame_is_three_transfers_per_row);
+  RUN_TEST(test_area_is_one_data_transfer);
+  RUN_TEST(test_commands_after_data_start_a_new_transfer);
+  return TEST_END();
+}
@@ -0,0 +1,239 @@
+// u8g2_SendDirty() sends only the tiles changed since the buffer was last sent. The bytes
+// are recorded on the I2C bus of an SSD1306 and decoded by the display model, whose RAM must
+// always end up the same as the buffer.
+
+#include <stdlib.h>
+#include <vector>
+#include <u8g2.h>
+#include "host_test.h"
+#include "Adafruit_SSD1306/ssd1306_model.h"
+#include "test_font.h"
+
+static SSD1306Model*        oled;
+static u8g2_t               u8g2;
+static std::vector<uint8_t> transfer; // Bytes of the I2C transfer in progress
+
+// Each transfer is one transmission to the display, the address is not part of the bytes
+static uint8_t byte_cb(u8x8_t* u8x8, uint8_t msg, uint8_t arg_int, void* arg_ptr)
+{
+  const uint8_t* data = (const uint8_t*)arg_ptr;
+  switch (msg) {
+    case U8X8_MSG_BYTE_START_TRANSFER: transfer.clear(); break;
+    case U8X8_MSG_BYTE_SEND:           transfer.insert(transfer.end(), data, data + arg_int); break;
+    case U8X8_MSG_BYTE_END_TRANSFER:   oled->transmission(0x3C, transfer.data(), transfer.size()); break;
+  }
+  return 1;
+}
+
+static uint8_t gpio_cb(u8x8_t* u8x8, uint8_t msg, uint8_t arg_int, void* arg_ptr)
+{
+  return 1;
+}
+
+static void setUp(void)
+{
+  oled = new SSD1306Model(0x3C);
+  u8g2_Setup_ssd1306_i2c_128x64_noname_f(&u8g2, U8G2_R0, byte_cb, gpio_cb);
+  u8g2_InitDisplay(&u8g2);
+  u8g2_ClearBuffer(&u8g2); // The buffer is static, it has the last test's drawing
+  u8g2_SendDirty(&u8g2);
+  oled->resetCounts();
+}
+
+static void tearDown(void)
+{
+  delete oled;
+}
+
+// Pixel by pixel with the capture functions, both are in the SSD1306 RAM layout
+static bool sameAsBuffer(void)
+{
+  for (uint16_t y = 0; y < 64; y++)
+    for (uint16_t x = 0; x < 128; x++)
+      if (u8x8_capture_get_pixel_1(x, y, &oled->gddram[0][0], 16) !=
+          u8x8_capture_get_pixel_1(x, y, u8g2_GetBufferPtr(&u8g2), 16)) {
+        printf("pixel %d,%d differs\n", x, y);
+        return false;
+      }
+  return true;
+}
+
+static bool isCommand(const SSD1306Model::Transmission& t, std::vector<uint8_t> bytes)
+{
+  return !t.data && t.bytes == bytes;
+}
+
+static bool isTile(const SSD1306Model::Transmission& t, uint8_t tx, uint8_t ty, uint8_t cnt)
+{
+  const uint8_t* tile = u8g2_GetBufferPtr(&u8g2) + ty * 128 + tx * 8;
+  return t.data && t.bytes == std::vector<uint8_t>(tile, tile + cnt * 8);
+}
+
+static void test_first_send_dirty_sends_everything(void)
+{
+  u8g2_Setup_ssd1306_i2c_128x64_noname_f(&u8g2, U8G2_R0, byte_cb, gpio_cb);
+  u8g2_InitDisplay(&u8g2);
+  memset(oled->gddram, 0x5A, sizeof(oled->gddram)); // Whatever the display shows
+  oled->resetCounts();
+
+  u8g2_SendDirty(&u8g2);
+  TEST_ASSERT_EQUAL(1024, oled->dataBytes);
+  TEST_ASSERT_TRUE(sameAsBuffer());
+}
+
+static void test_unchanged_buffer_sends_nothing(void)
+{
+  u8g2_SendDirty(&u8g2);
+  TEST_ASSERT_EQUAL(0, oled->log.size());
+}
+
+static void test_pixel_sends_one_tile(void)
+{
+  u8g2_DrawPixel(&u8g2, 70, 21);
+  u8g2_SendDirty(&u8g2);
+
+  // Start line, column 64 and page 2, then the tile
+  TEST_ASSERT_EQUAL(2, oled->log.size());
+  TEST_ASSERT_TRUE(isCommand(oled->log[0], { 0x40, 0x14, 0x00, 0xB2 }));
+  TEST_ASSERT_TRUE(isTile(oled->log[1], 8, 2, 1));
+  TEST_ASSERT_TRUE(sameAsBuffer());
+}
+
+static void test_adjacent_tiles_are_sent_together(void)
+{
+  u8g2_DrawHLine(&u8g2, 3, 10, 40);   // Tiles 0 to 5 of row 1
+  u8g2_DrawPixel(&u8g2, 127, 63);     // Tile 15 of row 7
+  u8g2_SendDirty(&u8g2);
+
+  TEST_ASSERT_EQUAL(4, oled->log.size());
+  TEST_ASSERT_TRUE(isCommand(oled->log[0], { 0x40, 0x10, 0x00, 0xB1 }));
+  TEST_ASSERT_TRUE(isTile(oled->log[1], 0, 1, 6));
+  TEST_ASSERT_TRUE(isCommand(oled->log[2], { 0x40, 0x17, 0x08, 0xB7 }));
+  TEST_ASSERT_TRUE(isTile(oled->log[3], 15, 7, 1));
+  TEST_ASSERT_TRUE(sameAsBuffer());
+}
+
+static void test_glyphs_and_bitmaps_mark_their_tiles(void)
+{
+  static const uint8_t xbm[] = { 0x3C, 0x42, 0x81, 0xA5, 0x81, 0x99, 0x42, 0x3C };
+  u8g2_SetFont(&u8g2, test_font);
+  u8g2_DrawStr(&u8g2, 2, 40, "1");     // 21x32 from (3, 8): tiles 0 to 2 of rows 1 to 4
+  u8g2_DrawXBM(&u8g2, 100, 50, 8, 8, xbm);
+  u8g2_SendDirty(&u8g2);
+
+  TEST_ASSERT_EQUAL(4 * 3 * 8 + 2 * 2 * 8, oled->dataBytes);
+  TEST_ASSERT_TRUE(sameAsBuffer());
+}
+
+static void test_clear_buffer_marks_only_tiles_with_pixels(void)
+{
+  u8g2_DrawBox(&u8g2, 20, 20, 10, 10); // Tiles 2 and 3 of rows 2 and 3
+  u8g2_SendDirty(&u8g2);
+  TEST_ASSERT_EQUAL(4 * 8, oled->dataBytes);
+
+  oled->resetCounts();
+  u8g2_ClearBuffer(&u8g2);
+  u8g2_SendDirty(&u8g2);
+  TEST_ASSERT_EQUAL(4 * 8, oled->dataBytes);
+  TEST_ASSERT_TRUE(sameAsBuffer());
+
+  oled->resetCounts();
+  u8g2_ClearBuffer(&u8g2);
+  u8g2_SendDirty(&u8g2);
+  TEST_ASSERT_EQUAL(0, oled->log.size());
+}
+
+static void test_sent_areas_are_not_sent_again(void)
+{
+  u8g2_DrawBox(&u8g2, 0, 0, 16, 8);
+  u8g2_UpdateDisplayArea(&u8g2, 0, 0, 2, 1);
+  oled->resetCounts();
+  u8g2_SendDirty(&u8g2);
+  TEST_ASSERT_EQUAL(0, oled->log.size());
+
+  u8g2_DrawBox(&u8g2, 50, 30, 16, 8);
+  u8g2_SendBuffer(&u8g2);
+  oled->resetCounts();
+  u8g2_SendDirty(&u8g2);
+  TEST_ASSERT_EQUAL(0, oled->log.size());
+  TEST_ASSERT_TRUE(sameAsBuffer());
+}
+
+static void test_set_buffer_dirty_sends_everything(void)
+{
+  // Written to the buffer directly
+  u8g2_GetBufferPtr(&u8g2)[500] ^= 0xFF;
+  u8g2_SetBufferDirty(&u8g2);
+  u8g2_SendDirty(&u8g2);
+  TEST_ASSERT_EQUAL(1024, oled->dataBytes);
+  TEST_ASSERT_TRUE(sameAsBuffer());
+}
+
+static void test_random_drawing_in_all_rotations(void)
+{
+  static const uint8_t xbm[] = { 0x3C, 0x42, 0x81, 0xA5, 0x81, 0x99, 0x42, 0x3C, 0xFF, 0x01 };
+  const u8g2_cb_t* rotations[] = { U8G2_R0, U8G2_R1, U8G2_R2, U8G2_R3, U8G2_MIRROR };
+  uint32_t sent = 0, frames = 0;
+  u8g2_SetFont(&u8g2, test_font);
+  srand(45);
+  for (const u8g2_cb_t* r : rotations) {
+    u8g2_SetDisplayRotation(&u8g2, r);
+    for (int f = 0; f < 200; f++) {
+      if (f % 10 == 0) u8g2_ClearBuffer(&u8g2);
+      u8g2_SetDrawColor(&u8g2, rand() % 3);
+      int x = rand() % 140 - 6, y = rand() % 80 - 6;
+      switch (rand() % 6) {
+        case 0: u8g2_DrawPixel(&u8g2, x, y); break;
+        case 1: u8g2_DrawBox(&u8g2, x, y, rand() % 20 + 1, rand() % 20 + 1); break;
+        case 2: u8g2_DrawLine(&u8g2, x, y, rand() % 128, rand() % 64); break;
+        case 3:
+          u8g2_SetDrawColor(&u8g2, 1);
+          u8g2_SetBitmapMode(&u8g2, rand() % 2);
+          u8g2_DrawXBM(&u8g2, x, y, 10, 8, xbm);
+          break;
+        case 4: u8g2_DrawCircle(&u8g2, x, y, rand() % 10, U8G2_DRAW_ALL); break;
+        case 5:
+          u8g2_SetFontMode(&u8g2, rand() % 2);
+          u8g2_DrawStr(&u8g2, x, y, "4:2");
+          break;
+      }
+      oled->resetCounts();
+      u8g2_SendDirty(&u8g2);
+      sent += oled->dataBytes;
+      frames++;
+      if (!sameAsBuffer()) {
+        printf("frame %d\n", f);
+        TEST_FAIL_MESSAGE("Display differs from the buffer");
+      }
+    }
+  }
+  printf("sent %u bytes, %.1f%% of sending the buffer\n", sent, 100.0 * sent / (frames * 1024));
+  TEST_ASSERT(sent < frames * 1024 / 4);
+}
+
+static void test_page_mode_sends_the_page(void)
+{
+  u8g2_t page;
+  u8g2_Setup_ssd1306_i2c_128x64_noname_1(&page, U8G2_R0, byte_cb, gpio_cb);
+  u8g2_InitDisplay(&page);
+  oled->resetCounts();
+  u8g2_FirstPage(&page);
+  u8g2_DrawBox(&page, 0, 0, 10, 10);
+  u8g2_SendDirty(&page);
+  TEST_ASSERT_EQUAL(128, oled->dataBytes);
+}
+
+int main(void)
+{
+  RUN_TEST(test_first_send_dirty_sends_everything);
+  RUN_TEST(test_unchanged_buffer_sends_nothing);
+  RUN_TEST(test_pixel_sends_one_tile);
+  RUN_TEST(test_adjacent_tiles_are_sent_together);
+  RUN_TEST(test_glyphs_and_bitmaps_mark_their_tiles);
+  RUN_TEST(test_clear_buffer_marks_only_tiles_with_pixels);
+  RUN_TEST(test_sent_areas_are_not_sent_again);
+  RUN_TEST(test_set_buffer_dirty_sends_everything);
+  RUN_TEST(test_random_drawing_in_all_rotations);
+  RUN_TEST(test_page_mode_sends_the_page);
+  return TEST_END();
+}
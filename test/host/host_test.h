@@ -0,0 +1,81 @@
+// Assertions for the host tests. The names follow Unity, which the LVGL tests use, but
+// without the runner generator: main() calls RUN_TEST() for each test function and
+// returns TEST_END().
+
+#ifndef HOST_TEST_H
+#define HOST_TEST_H
+
+#include <stdio.h>
+#include <string.h>
+
+static int host_test_failed;
+static int host_test_failures;
+static int host_test_count;
+
+#define TEST_FAIL_MESSAGE(msg)                                               \
+  do {                                                                       \
+    printf("%s:%d: FAIL: %s\n", __FILE__, __LINE__, msg);                    \
+    host_test_failed = 1;                                                    \
+    return;                                                                  \
+  } while (0)
+
+#define TEST_ASSERT_MESSAGE(cond, msg) do { if (!(cond)) TEST_FAIL_MESSAGE(msg); } while (0)
+#define TEST_ASSERT(cond)              TEST_ASSERT_MESSAGE(cond, #cond)
+#define TEST_ASSERT_TRUE(cond)         TEST_ASSERT_MESSAGE(cond, #cond " is false")
+#define TEST_ASSERT_FALSE(cond)        TEST_ASSERT_MESSAGE(!(cond), #cond " is true")
+#define TEST_ASSERT_NULL(p)            TEST_ASSERT_MESSAGE((p) == NULL, #p " is not NULL")
+#define TEST_ASSERT_NOT_NULL(p)        TEST_ASSERT_MESSAGE((p) != NULL, #p " is NULL")
+
+#define TEST_ASSERT_EQUAL(expected, actual)                                  \
+  do {                                                                       \
+    long long e_ = (long long)(expected), a_ = (long long)(actual);          \
+    if (e_ != a_) {                                                          \
+      char m_[160];                                                          \
+      snprintf(m_, sizeof(m_), "%s: expected %lld was %lld", #actual, e_, a_); \
+      TEST_FAIL_MESSAGE(m_);                                                 \
+    }                                                                        \
+  } while (0)
+
+#define TEST_ASSERT_LESS_OR_EQUAL(threshold, actual)                         \
+  do {                                                                       \
+    long long t_ = (long long)(threshold), a_ = (long long)(actual);         \
+    if (a_ > t_) {                                                           \
+      char m_[160];                                                          \
+      snprintf(m_, sizeof(m_), "%s: %lld is above %lld", #actual, a_, t_);   \
+      TEST_FAIL_MESSAGE(m_);                                                 \
+    }                                                                        \
+  } while (0)
+
+#define TEST_ASSERT_EQUAL_MEMORY(expected, actual, len)                      \
+  do {                                                                       \
+    const unsigned char* e_ = (const unsigned char*)(expected);              \
+    const unsigned char* a_ = (const unsigned char*)(actual);                \
+    for (size_t i_ = 0; i_ < (size_t)(len); i_++) {                          \
+      if (e_[i_] != a_[i_]) {                                                \
+        char m_[160];                                                        \
+        snprintf(m_, sizeof(m_), "%s: byte %zu expected 0x%02X was 0x%02X",  \
+                 #actual, i_, e_[i_], a_[i_]);                               \
+        TEST_FAIL_MESSAGE(m_);                                               \
+      }                                                                      \
+    }                                                                        \
+  } while (0)
+
+static void setUp(void);
+static void tearDown(void);
+
+#define RUN_TEST(func)                                                       \
+  do {                                                                       \
+    host_test_failed = 0;                                                    \
+    host_test_count++;                                                       \
+    setUp();                                                                 \
+    func();                                                                  \
+    tearDown();                                                              \
+    if (host_test_failed) host_test_failures++;                              \
+    printf("%s:%s\n", #func, host_test_failed ? "FAIL" : "PASS");            \
+  } while (0)
+
+#define TEST_END()                                                           \
+  (printf("\n%d Tests %d Failures\n%s\n", host_test_count, host_test_failures, \
+          host_test_failures ? "FAIL" : "OK"), fflush(stdout), host_test_failures != 0)
+
+#endif
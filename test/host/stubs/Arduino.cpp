@@ -0,0 +1,134 @@
+// Host stand-in for the Arduino ESP32 core functions
+
+#include "Arduino.h"
+#include "SPIFFS.h"
+#include "LittleFS.h"
+#include "SD.h"
+#include "hal/gpio_ll.h"
+
+static uint8_t  pinLevel[64];
+static uint64_t clockUs;
+
+HardwareSerial Serial;
+fs::SPIFFSFS   SPIFFS;
+fs::LittleFSFS LittleFS;
+fs::SDFS       SD;
+gpio_dev_t     GPIO;
+
+extern "C" {
+
+void host_pin_set(uint8_t pin, uint8_t level)
+{
+  if (pin < sizeof(pinLevel)) pinLevel[pin] = level;
+}
+
+int host_pin_get(uint8_t pin)
+{
+  return pin < sizeof(pinLevel) ? pinLevel[pin] : 0;
+}
+
+void pinMode(uint8_t pin, uint8_t mode)
+{
+  (void)pin;
+  (void)mode;
+}
+
+void digitalWrite(uint8_t pin, uint8_t val)
+{
+  host_spi_poll();
+  host_pin_set(pin, val);
+}
+
+int digitalRead(uint8_t pin)
+{
+  return host_pin_get(pin);
+}
+
+void delay(uint32_t ms)
+{
+  clockUs += ms * 1000ull;
+}
+
+void delayMicroseconds(uint32_t us)
+{
+  clockUs += us;
+}
+
+uint32_t millis(void)
+{
+  return clockUs / 1000;
+}
+
+uint32_t micros(void)
+{
+  return clockUs;
+}
+
+void yield(void)
+{
+}
+
+bool psramFound(void)
+{
+  return false;
+}
+
+void* heap_caps_malloc(size_t size, uint32_t caps)
+{
+  return malloc(size);
+}
+
+void heap_caps_free(void* ptr)
+{
+  free(ptr);
+}
+
+void* ps_malloc(size_t size)
+{
+  return malloc(size);
+}
+
+void* ps_calloc(size_t n, size_t size)
+{
+  return calloc(n, size);
+}
+
+char* ultoa(unsigned long value, char* str, int base)
+{
+  char  tmp[sizeof(long) * 8 + 1];
+  char* p = tmp;
+  do { *p++ = "0123456789abcdefghijklmnopqrstuvwxyz"[value % base]; value /= base; } while (value);
+  char* s = str;
+  while (p > tmp) *s++ = *--p;
+  *s = 0;
+  return str;
+}
+
+char* ltoa(long value, char* str, int base)
+{
+  if (value < 0 && base == 10) { *str = '-'; ultoa(-(unsigned long)value, str + 1, base); }
+  else ultoa(value, str, base);
+  return str;
+}
+
+}
+
+// Same sequence on every run
+static uint32_t randomState = 1;
+
+void randomSeed(unsigned long seed)
+{
+  if (seed) randomState = seed;
+}
+
+long random(long max)
+{
+  if (max <= 0) return 0;
+  randomState = randomState * 1103515245u + 12345u;
+  return (randomState >> 1) % max;
+}
+
+long random(long min, long max)
+{
+  return max > min ? min + random(max - min) : min;
+}
@@ -0,0 +1,99 @@
+// Host stand-in for the parts of the Arduino ESP32 core used by the libraries under test.
+// Time only advances when the code waits, so timing dependent code runs instantly.
+
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <stdio.h>
+#include <assert.h>
+
+#ifdef __cplusplus
+#include <algorithm>
+using std::min;
+using std::max;
+#endif
+
+#include "pgmspace.h"
+
+typedef bool    boolean;
+typedef uint8_t byte;
+
+#define HIGH 0x1
+#define LOW  0x0
+
+#define INPUT        0x01
+#define OUTPUT       0x03
+#define INPUT_PULLUP 0x05
+
+#define LSBFIRST 0
+#define MSBFIRST 1
+
+#define IRAM_ATTR
+
+#ifndef PI
+  #define PI 3.1415926535897932384626433832795
+#endif
+#define DEG_TO_RAD 0.017453292519943295769236907684886
+#define RAD_TO_DEG 57.295779513082320876798154814105
+
+#define bitRead(value, bit) (((value) >> (bit)) & 0x01)
+#define bitSet(value, bit) ((value) |= (1UL << (bit)))
+#define bitClear(value, bit) ((value) &= ~(1UL << (bit)))
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void     pinMode(uint8_t pin, uint8_t mode);
+void     digitalWrite(uint8_t pin, uint8_t val);
+int      digitalRead(uint8_t pin);
+void     delay(uint32_t ms);
+void     delayMicroseconds(uint32_t us);
+uint32_t millis(void);
+uint32_t micros(void);
+void     yield(void);
+
+// No PSRAM on the host, ps_malloc() and ps_calloc() use the normal heap
+bool     psramFound(void);
+void*    ps_malloc(size_t size);
+void*    ps_calloc(size_t n, size_t size);
+
+// One heap on the host, the capabilities are ignored
+#define MALLOC_CAP_DMA      (1 << 3)
+#define MALLOC_CAP_8BIT     (1 << 2)
+#define MALLOC_CAP_SPIRAM   (1 << 10)
+#define MALLOC_CAP_INTERNAL (1 << 11)
+void*    heap_caps_malloc(size_t size, uint32_t caps);
+void     heap_caps_free(void* ptr);
+
+char*    ltoa(long value, char* str, int base);
+char*    ultoa(unsigned long value, char* str, int base);
+
+#ifdef __cplusplus
+}
+
+long     random(long max);
+long     random(long min, long max);
+void     randomSeed(unsigned long seed);
+
+#include "WString.h"
+#include "Print.h"
+
+class HardwareSerial : public Print
+{
+public:
+  void   begin(unsigned long) {}
+  size_t write(uint8_t c) override { return fwrite(&c, 1, 1, stdout); }
+  using Print::write;
+};
+
+extern HardwareSerial Serial;
+#endif
+
+#endif
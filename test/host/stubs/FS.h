@@ -0,0 +1,158 @@
+// Host stand-in for the Arduino ESP32 fs::FS and fs::File classes.
+//
+// Like the real classes they share an implementation object, so copies of a FS or a File
+// refer to the same file system or open file. HostMemFS is a file system in RAM that
+// counts the calls made to it.
+
+#ifndef HOST_FS_H
+#define HOST_FS_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include "WString.h"
+
+#define FILE_READ  "r"
+#define FILE_WRITE "w"
+
+namespace fs {
+
+enum SeekMode { SeekSet = 0, SeekCur = 1, SeekEnd = 2 };
+
+class FileImpl
+{
+public:
+  virtual ~FileImpl() {}
+  virtual size_t read(uint8_t* buf, size_t size) = 0;
+  virtual bool   seek(uint32_t pos, SeekMode mode) = 0;
+  virtual size_t position() const = 0;
+  virtual size_t size() const = 0;
+};
+
+class File
+{
+public:
+  File(std::shared_ptr<FileImpl> p = nullptr) : _p(p) {}
+  size_t read(uint8_t* buf, size_t size) { return _p ? _p->read(buf, size) : 0; }
+  int    read() { uint8_t c; return read(&c, 1) == 1 ? c : -1; }
+  bool   seek(uint32_t pos, SeekMode mode = SeekSet) { return _p && _p->seek(pos, mode); }
+  size_t position() const { return _p ? _p->position() : 0; }
+  size_t size() const { return _p ? _p->size() : 0; }
+  int    available() { return _p ? (int)(_p->size() - _p->position()) : 0; }
+  void   close() { _p = nullptr; }
+  operator bool() const { return _p != nullptr; }
+
+private:
+  std::shared_ptr<FileImpl> _p;
+};
+
+class FSImpl
+{
+public:
+  virtual ~FSImpl() {}
+  virtual File open(const char* path, const char* mode) = 0;
+  virtual bool exists(const char* path) = 0;
+};
+
+class FS
+{
+public:
+  FS(std::shared_ptr<FSImpl> impl = nullptr) : _impl(impl) {}
+  File open(const char* path, const char* mode = FILE_READ) { return _impl ? _impl->open(path, mode) : File(); }
+  File open(const String& path, const char* mode = FILE_READ) { return open(path.c_str(), mode); }
+  bool exists(const char* path) { return _impl && _impl->exists(path); }
+  bool exists(const String& path) { return exists(path.c_str()); }
+
+protected:
+  std::shared_ptr<FSImpl> _impl;
+};
+
+} // namespace fs
+
+#ifndef FS_NO_GLOBALS
+using fs::FS;
+using fs::File;
+using fs::SeekMode;
+using fs::SeekSet;
+using fs::SeekCur;
+using fs::SeekEnd;
+#endif
+
+// File system in RAM, files are added with add()
+class HostMemFS : public fs::FS
+{
+public:
+  struct Stats {
+    uint32_t opens;
+    uint32_t seeks;
+    uint32_t backSeeks; // Seeks to a lower position
+    uint32_t reads;     // read() calls
+    uint64_t readBytes;
+  };
+
+  HostMemFS() : fs::FS(std::make_shared<Impl>()) {}
+
+  void add(const char* path, const uint8_t* data, size_t size)
+  {
+    impl()->files[path] = std::vector<uint8_t>(data, data + size);
+  }
+  Stats& stats() { return impl()->stats; }
+  void   resetStats() { impl()->stats = Stats(); }
+
+private:
+  struct Impl;
+
+  class MemFile : public fs::FileImpl
+  {
+  public:
+    MemFile(Impl* fs, const std::vector<uint8_t>* data) : _fs(fs), _data(data) {}
+    size_t read(uint8_t* buf, size_t size) override
+    {
+      _fs->stats.reads++;
+      if (size > _data->size() - _pos) size = _data->size() - _pos;
+      memcpy(buf, _data->data() + _pos, size);
+      _pos += size;
+      _fs->stats.readBytes += size;
+      return size;
+    }
+    bool seek(uint32_t pos, fs::SeekMode mode) override
+    {
+      _fs->stats.seeks++;
+      size_t p = (mode == fs::SeekSet) ? pos : (mode == fs::SeekCur) ? _pos + pos : _data->size() + pos;
+      if (p > _data->size()) return false;
+      if (p < _pos) _fs->stats.backSeeks++;
+      _pos = p;
+      return true;
+    }
+    size_t position() const override { return _pos; }
+    size_t size() const override { return _data->size(); }
+
+  private:
+    Impl*  _fs;
+    const std::vector<uint8_t>* _data;
+    size_t _pos = 0;
+  };
+
+  struct Impl : public fs::FSImpl
+  {
+    std::map<std::string, std::vector<uint8_t>> files;
+    Stats stats = Stats();
+
+    fs::File open(const char* path, const char* mode) override
+    {
+      auto f = files.find(path);
+      if (f == files.end() || strcmp(mode, FILE_READ)) return fs::File();
+      stats.opens++;
+      return fs::File(std::make_shared<MemFile>(this, &f->second));
+    }
+    bool exists(const char* path) override { return files.count(path) != 0; }
+  };
+
+  Impl* impl() { return static_cast<Impl*>(_impl.get()); }
+};
+
+#endif
@@ -0,0 +1,18 @@
+// Host stand-in for the ESP32 LittleFS file system, it has no files
+
+#ifndef HOST_LITTLEFS_H
+#define HOST_LITTLEFS_H
+
+#include "FS.h"
+
+namespace fs {
+class LittleFSFS : public FS
+{
+public:
+  bool begin(bool formatOnFail = false) { return false; }
+};
+} // namespace fs
+
+extern fs::LittleFSFS LittleFS;
+
+#endif
@@ -0,0 +1,18 @@
+// Host stand-in for the ESP32 SD card file system, it has no card
+
+#ifndef HOST_SD_H
+#define HOST_SD_H
+
+#include "FS.h"
+
+namespace fs {
+class SDFS : public FS
+{
+public:
+  bool begin(uint8_t ssPin = 5) { return false; }
+};
+} // namespace fs
+
+extern fs::SDFS SD;
+
+#endif
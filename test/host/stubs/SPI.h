@@ -0,0 +1,61 @@
+// Host stand-in for the Arduino ESP32 SPIClass, transfers go to the SPI recorder
+
+#ifndef HOST_SPI_CLASS_H
+#define HOST_SPI_CLASS_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "host_spi.h"
+
+#define SPI_HAS_TRANSACTION
+
+#define SPI_LSBFIRST 0
+#define SPI_MSBFIRST 1
+
+#define SPI_MODE0 0
+#define SPI_MODE1 1
+#define SPI_MODE2 2
+#define SPI_MODE3 3
+
+#define FSPI 1
+#define HSPI 2
+
+class SPISettings
+{
+public:
+  SPISettings(uint32_t clock = 1000000, uint8_t bitOrder = 1, uint8_t dataMode = SPI_MODE0)
+    : _clock(clock), _bitOrder(bitOrder), _dataMode(dataMode) {}
+  uint32_t _clock;
+  uint8_t  _bitOrder;
+  uint8_t  _dataMode;
+};
+
+class SPIClass
+{
+public:
+  SPIClass(uint8_t spi_bus = HSPI) : _bus(spi_bus) {}
+  void     begin(int8_t sck = -1, int8_t miso = -1, int8_t mosi = -1, int8_t ss = -1) {}
+  void     end() {}
+  void     setHwCs(bool) {}
+  void     setFrequency(uint32_t freq) { _freq = freq; }
+  void     beginTransaction(SPISettings settings) { _freq = settings._clock; }
+  void     endTransaction(void) {}
+  uint8_t  transfer(uint8_t data);
+  uint16_t transfer16(uint16_t data);
+  void     transfer(void* data, uint32_t size);
+  void     write(uint8_t data) { transfer(data); }
+  void     write16(uint16_t data) { transfer16(data); }
+  void     write32(uint32_t data);
+  void     writeBytes(const uint8_t* data, uint32_t size);
+  void     writePattern(const uint8_t* data, uint8_t size, uint32_t repeat);
+  void     writePixels(const void* data, uint32_t size); // 16 bit pixels, sent high byte first
+  uint32_t getFrequency() { return _freq; }
+
+private:
+  uint8_t  _bus;
+  uint32_t _freq = 1000000;
+};
+
+extern SPIClass SPI;
+
+#endif
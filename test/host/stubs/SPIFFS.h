@@ -0,0 +1,18 @@
+// Host stand-in for the ESP32 SPIFFS file system, it has no files
+
+#ifndef HOST_SPIFFS_H
+#define HOST_SPIFFS_H
+
+#include "FS.h"
+
+namespace fs {
+class SPIFFSFS : public FS
+{
+public:
+  bool begin(bool formatOnFail = false) { return false; }
+};
+} // namespace fs
+
+extern fs::SPIFFSFS SPIFFS;
+
+#endif
@@ -0,0 +1,62 @@
+// Host stand-in for the Arduino String class, only what the libraries under test use
+
+#ifndef HOST_WSTRING_H
+#define HOST_WSTRING_H
+
+#include <string>
+#include <string.h>
+
+class __FlashStringHelper;
+
+class String
+{
+public:
+  String(const char* s = "") : str(s ? s : "") {}
+  String(const std::string& s) : str(s) {}
+  String(char c) : str(1, c) {}
+  String(int v) : str(std::to_string(v)) {}
+  String(unsigned int v) : str(std::to_string(v)) {}
+  String(long v) : str(std::to_string(v)) {}
+  String(unsigned long v) : str(std::to_string(v)) {}
+
+  const char*  c_str() const { return str.c_str(); }
+  unsigned int length() const { return str.length(); }
+  char         charAt(unsigned int i) const { return i < str.length() ? str[i] : 0; }
+  char         operator[](unsigned int i) const { return charAt(i); }
+  void         toCharArray(char* buf, unsigned int size, unsigned int index = 0) const
+  {
+    if (size == 0) return;
+    std::string s = index < str.length() ? str.substr(index, size - 1) : std::string();
+    memcpy(buf, s.c_str(), s.length() + 1);
+  }
+  void         getBytes(unsigned char* buf, unsigned int size, unsigned int index = 0) const
+  {
+    toCharArray((char*)buf, size, index);
+  }
+  bool         endsWith(const String& s) const
+  {
+    return str.length() >= s.str.length() && str.compare(str.length() - s.str.length(), s.str.length(), s.str) == 0;
+  }
+  bool         startsWith(const String& s) const { return str.compare(0, s.str.length(), s.str) == 0; }
+  int          indexOf(char c) const { size_t i = str.find(c); return i == std::string::npos ? -1 : (int)i; }
+  String       substring(unsigned int from) const { return from < str.length() ? String(str.substr(from)) : String(); }
+  String       substring(unsigned int from, unsigned int to) const
+  {
+    return from < to && from < str.length() ? String(str.substr(from, to - from)) : String();
+  }
+
+  String& operator+=(const String& s) { str += s.str; return *this; }
+  String& operator+=(const char* s) { str += s; return *this; }
+  String& operator+=(char c) { str += c; return *this; }
+  friend String operator+(const String& a, const String& b) { return String(a.str + b.str); }
+  friend String operator+(const String& a, const char* b) { return String(a.str + b); }
+  friend String operator+(const char* a, const String& b) { return String(a + b.str); }
+  bool operator==(const String& s) const { return str == s.str; }
+  bool operator==(const char* s) const { return str == s; }
+  bool operator!=(const String& s) const { return str != s.str; }
+
+private:
+  std::string str;
+};
+
+#endif
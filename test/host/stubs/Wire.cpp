@@ -0,0 +1,40 @@
+// TwoWire for the host tests, transmissions go to the attached I2C device
+
+#include "Wire.h"
+
+HostI2cDevice* host_i2c_device = nullptr;
+
+TwoWire Wire;
+
+void TwoWire::beginTransmission(uint8_t address)
+{
+  _address = address;
+  _open = true;
+  _len = 0;
+}
+
+uint8_t TwoWire::endTransmission(bool sendStop)
+{
+  if (!_open) return 4;
+  _open = false;
+  transmissions++;
+  if (host_i2c_device) host_i2c_device->transmission(_address, _buffer, _len);
+  return 0;
+}
+
+size_t TwoWire::write(uint8_t data)
+{
+  if (!_open || _len >= sizeof(_buffer)) {
+    overflows++;
+    return 0;
+  }
+  _buffer[_len++] = data;
+  return 1;
+}
+
+size_t TwoWire::write(const uint8_t* data, size_t len)
+{
+  size_t n = 0;
+  while (len-- && write(*data++)) n++;
+  return n;
+}
@@ -0,0 +1,51 @@
+// Host stand-in for the Arduino ESP32 TwoWire (I2C) class.
+//
+// Each transmission, from beginTransmission() to endTransmission(), is passed to the
+// attached device with its address. Bytes beyond I2C_BUFFER_LENGTH are dropped like on
+// the ESP32.
+
+#ifndef HOST_WIRE_H
+#define HOST_WIRE_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define I2C_BUFFER_LENGTH 128
+
+struct HostI2cDevice
+{
+  virtual ~HostI2cDevice() {}
+  virtual void transmission(uint8_t address, const uint8_t* data, size_t len) = 0;
+};
+
+extern HostI2cDevice* host_i2c_device; // Receives the transmissions, may be nullptr
+
+class TwoWire
+{
+public:
+  bool     begin(int sda = -1, int scl = -1, uint32_t frequency = 0) { return true; }
+  bool     end(void) { return true; }
+  bool     setClock(uint32_t frequency) { _clock = frequency; return true; }
+  uint32_t getClock(void) { return _clock; }
+  void     beginTransmission(uint8_t address);
+  uint8_t  endTransmission(bool sendStop = true);
+  size_t   write(uint8_t data);
+  size_t   write(const uint8_t* data, size_t len);
+  uint8_t  requestFrom(uint8_t address, size_t len, bool sendStop = true) { return 0; }
+  int      available(void) { return 0; }
+  int      read(void) { return -1; }
+
+  uint32_t transmissions = 0;   // Completed transmissions
+  uint32_t overflows     = 0;   // Bytes dropped because the buffer was full
+
+private:
+  uint32_t _clock = 100000;
+  uint8_t  _address = 0;
+  bool     _open = false;
+  size_t   _len = 0;
+  uint8_t  _buffer[I2C_BUFFER_LENGTH];
+};
+
+extern TwoWire Wire;
+
+#endif
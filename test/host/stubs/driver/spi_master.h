@@ -0,0 +1,106 @@
+// Host model of the ESP-IDF SPI master driver.
+//
+// Queued transactions are sent when their result is collected, in queue order: the
+// pre_cb callback runs, the data goes to the SPI recorder and post_cb runs. Results
+// collected without waiting (ticks_to_wait = 0) are limited by host_spi_master_ready,
+// so tests can hold transfers "in flight".
+
+#ifndef HOST_DRIVER_SPI_MASTER_H
+#define HOST_DRIVER_SPI_MASTER_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "../host_spi.h"
+
+typedef int esp_err_t;
+#define ESP_OK                0
+#define ESP_FAIL              -1
+#define ESP_ERR_INVALID_STATE 0x103
+#define ESP_ERR_TIMEOUT       0x107
+
+#define ESP_ERROR_CHECK(x) do { esp_err_t err_ = (x); \
+    if (err_ != ESP_OK) { fprintf(stderr, "%s:%d: ESP_ERROR_CHECK failed\n", __FILE__, __LINE__); abort(); } } while (0)
+
+typedef uint32_t TickType_t;
+#define portMAX_DELAY ((TickType_t)0xFFFFFFFF)
+
+typedef enum { SPI1_HOST = 0, SPI2_HOST = 1, SPI3_HOST = 2 } spi_host_device_t;
+#define SPI_DMA_CH_AUTO 3
+
+#define SPI_TRANS_USE_TXDATA  (1 << 3)
+#define SPI_DEVICE_NO_DUMMY   (1 << 6)
+
+typedef struct {
+  int      mosi_io_num;
+  int      miso_io_num;
+  int      sclk_io_num;
+  int      quadwp_io_num;
+  int      quadhd_io_num;
+  int      data4_io_num;
+  int      data5_io_num;
+  int      data6_io_num;
+  int      data7_io_num;
+  int      max_transfer_sz;
+  uint32_t flags;
+  int      intr_flags;
+} spi_bus_config_t;
+
+typedef struct spi_transaction_t spi_transaction_t;
+typedef void (*transaction_cb_t)(spi_transaction_t *trans);
+
+typedef struct {
+  uint8_t  command_bits;
+  uint8_t  address_bits;
+  uint8_t  dummy_bits;
+  uint8_t  mode;
+  uint16_t duty_cycle_pos;
+  uint16_t cs_ena_pretrans;
+  uint8_t  cs_ena_posttrans;
+  int      clock_speed_hz;
+  int      input_delay_ns;
+  int      spics_io_num;
+  uint32_t flags;
+  int      queue_size;
+  transaction_cb_t pre_cb;
+  transaction_cb_t post_cb;
+} spi_device_interface_config_t;
+
+struct spi_transaction_t {
+  uint32_t flags;
+  uint16_t cmd;
+  uint64_t addr;
+  size_t   length;
+  size_t   rxlength;
+  void*    user;
+  union {
+    const void* tx_buffer;
+    uint8_t     tx_data[4];
+  };
+  union {
+    void*   rx_buffer;
+    uint8_t rx_data[4];
+  };
+};
+
+struct host_spi_master_device;
+typedef struct host_spi_master_device* spi_device_handle_t;
+
+esp_err_t spi_bus_initialize(spi_host_device_t host, const spi_bus_config_t* cfg, int dma_chan);
+esp_err_t spi_bus_free(spi_host_device_t host);
+esp_err_t spi_bus_add_device(spi_host_device_t host, const spi_device_interface_config_t* cfg,
+                             spi_device_handle_t* handle);
+esp_err_t spi_bus_remove_device(spi_device_handle_t handle);
+esp_err_t spi_device_queue_trans(spi_device_handle_t handle, spi_transaction_t* trans, TickType_t ticks_to_wait);
+esp_err_t spi_device_get_trans_result(spi_device_handle_t handle, spi_transaction_t** trans, TickType_t ticks_to_wait);
+esp_err_t spi_device_polling_transmit(spi_device_handle_t handle, spi_transaction_t* trans);
+
+// Number of queued transactions a non-blocking result check finds finished,
+// decremented for each one collected. Unlimited when negative (the default).
+extern int host_spi_master_ready;
+// Transactions queued and not collected, and the highest value seen
+extern int host_spi_master_pending;
+extern int host_spi_master_max_pending;
+
+#endif
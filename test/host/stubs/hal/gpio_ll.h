@@ -0,0 +1,45 @@
+// Host model of the ESP32 GPIO set/clear registers.
+// Writes change the levels seen by digitalRead() and by the SPI recorder (D/C pin).
+
+#ifndef HOST_HAL_GPIO_LL_H
+#define HOST_HAL_GPIO_LL_H
+
+#include <stdint.h>
+#include "../host_spi.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+void host_pin_set(uint8_t pin, uint8_t level);
+int  host_pin_get(uint8_t pin);
+#ifdef __cplusplus
+}
+#endif
+
+template <int base, uint8_t level>
+struct host_gpio_w1t_reg
+{
+  host_gpio_w1t_reg& operator=(uint32_t mask)
+  {
+    host_spi_poll(); // A transaction in progress was started with the old levels
+    for (int i = 0; i < 32; i++) if (mask & (1u << i)) host_pin_set(base + i, level);
+    return *this;
+  }
+};
+
+typedef struct {
+  host_gpio_w1t_reg<0, 1> out_w1ts;
+  host_gpio_w1t_reg<0, 0> out_w1tc;
+  struct { host_gpio_w1t_reg<32, 1> val; } out1_w1ts;
+  struct { host_gpio_w1t_reg<32, 0> val; } out1_w1tc;
+} gpio_dev_t;
+
+extern gpio_dev_t GPIO;
+
+typedef int gpio_num_t;
+typedef enum { GPIO_MODE_INPUT = 1, GPIO_MODE_OUTPUT = 2 } gpio_mode_t;
+
+static inline int gpio_set_direction(gpio_num_t, gpio_mode_t) { return 0; }
+static inline int gpio_get_level(gpio_num_t pin) { return host_pin_get(pin); }
+
+#endif
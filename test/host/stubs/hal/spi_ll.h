@@ -0,0 +1,27 @@
+// Host stand-in for the SPI low level functions used to hand the SPI peripheral back to the
+// Arduino SPI functions after SPI master driver transfers. The register writes are kept
+// so tests can check them.
+
+#ifndef HOST_HAL_SPI_LL_H
+#define HOST_HAL_SPI_LL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef struct {
+  struct {
+    uint32_t usr_miso : 1;
+  } user;
+  bool dma_tx_enabled;
+} spi_dev_t;
+
+extern spi_dev_t host_spi_ll_dev;
+
+#define SPI_LL_GET_HW(host) (&host_spi_ll_dev)
+
+static inline void spi_ll_dma_tx_enable(spi_dev_t* hw, bool enable)
+{
+  hw->dma_tx_enabled = enable;
+}
+
+#endif
@@ -0,0 +1,206 @@
+// SPI recorder, SPI register model, SPIClass and SPI master driver for the host tests
+
+#include <deque>
+#include <vector>
+#include "Arduino.h"
+#include "SPI.h"
+#include "soc/spi_reg.h"
+#include "driver/spi_master.h"
+#include "hal/spi_ll.h"
+
+HostSpiDevice* host_spi_device = nullptr;
+HostSpiStats   host_spi_stats;
+int            host_spi_dc_pin = -1;
+
+volatile uint32_t host_spi_regs[64];
+
+SPIClass SPI(FSPI);
+
+extern "C" int host_pin_get(uint8_t pin);
+
+void host_spi_reset_stats(void)
+{
+  host_spi_stats = HostSpiStats();
+}
+
+bool host_spi_dc(void)
+{
+  return host_spi_dc_pin < 0 || host_pin_get(host_spi_dc_pin);
+}
+
+void host_spi_write(bool dma, const uint8_t* data, size_t len)
+{
+  bool dc = host_spi_dc();
+  if (dma) host_spi_stats.dmaTransfers++;
+  else     host_spi_stats.transfers++;
+  if (!dc) host_spi_stats.commands++;
+  host_spi_stats.bytes += len;
+  if (host_spi_device) host_spi_device->write(dc, data, len);
+}
+
+uint8_t host_spi_read(void)
+{
+  return host_spi_device ? host_spi_device->read() : 0;
+}
+
+/***************************************************************************************
+** SPI registers
+***************************************************************************************/
+void host_spi_poll(void)
+{
+  uint32_t cmd = host_spi_regs[0];
+  if (cmd & SPI_UPDATE_BIT) cmd &= ~SPI_UPDATE_BIT;
+  if (cmd & SPI_USR_BIT) {
+    // The data buffer W0-W15 is sent lowest byte first
+    uint32_t bits = (host_spi_regs[0x1C / 4] & 0x3FFFF) + 1;
+    uint8_t  data[64];
+    uint32_t len = bits / 8;
+    if (len > sizeof(data)) len = sizeof(data);
+    for (uint32_t i = 0; i < len; i++) data[i] = host_spi_regs[0x98 / 4 + i / 4] >> (8 * (i & 3));
+    cmd &= ~SPI_USR_BIT;
+    host_spi_regs[0] = cmd;
+    host_spi_write(false, data, len);
+  }
+  host_spi_regs[0] = cmd;
+}
+
+/***************************************************************************************
+** SPIClass
+***************************************************************************************/
+uint8_t SPIClass::transfer(uint8_t data)
+{
+  host_spi_poll();
+  host_spi_write(false, &data, 1);
+  return host_spi_read();
+}
+
+uint16_t SPIClass::transfer16(uint16_t data)
+{
+  uint16_t r = transfer(data >> 8) << 8;
+  return r | transfer(data);
+}
+
+void SPIClass::transfer(void* data, uint32_t size)
+{
+  uint8_t* p = (uint8_t*)data;
+  while (size--) { *p = transfer(*p); p++; }
+}
+
+void SPIClass::write32(uint32_t data)
+{
+  uint8_t b[4] = { (uint8_t)(data >> 24), (uint8_t)(data >> 16), (uint8_t)(data >> 8), (uint8_t)data };
+  writeBytes(b, 4);
+}
+
+void SPIClass::writeBytes(const uint8_t* data, uint32_t size)
+{
+  host_spi_poll();
+  host_spi_write(false, data, size);
+}
+
+void SPIClass::writePixels(const void* data, uint32_t size)
+{
+  const uint8_t* p = (const uint8_t*)data;
+  std::vector<uint8_t> swapped(size & ~1u);
+  for (uint32_t i = 0; i + 1 < size; i += 2) {
+    swapped[i] = p[i + 1];
+    swapped[i + 1] = p[i];
+  }
+  host_spi_poll();
+  host_spi_write(false, swapped.data(), swapped.size());
+}
+
+void SPIClass::writePattern(const uint8_t* data, uint8_t size, uint32_t repeat)
+{
+  while (repeat--) writeBytes(data, size);
+}
+
+/***************************************************************************************
+** SPI master driver
+***************************************************************************************/
+struct host_spi_master_device
+{
+  spi_device_interface_config_t cfg;
+  std::deque<spi_transaction_t*> queue;
+};
+
+spi_dev_t host_spi_ll_dev;
+
+int host_spi_master_ready = -1;
+int host_spi_master_pending = 0;
+int host_spi_master_max_pending = 0;
+
+esp_err_t spi_bus_initialize(spi_host_device_t host, const spi_bus_config_t* cfg, int dma_chan)
+{
+  return ESP_OK;
+}
+
+esp_err_t spi_bus_free(spi_host_device_t host)
+{
+  return ESP_OK;
+}
+
+esp_err_t spi_bus_add_device(spi_host_device_t host, const spi_device_interface_config_t* cfg,
+                             spi_device_handle_t* handle)
+{
+  *handle = new host_spi_master_device;
+  (*handle)->cfg = *cfg;
+  host_spi_master_pending = 0;
+  host_spi_master_max_pending = 0;
+  return ESP_OK;
+}
+
+esp_err_t spi_bus_remove_device(spi_device_handle_t handle)
+{
+  if (!handle->queue.empty()) return ESP_ERR_INVALID_STATE;
+  delete handle;
+  return ESP_OK;
+}
+
+esp_err_t spi_device_queue_trans(spi_device_handle_t handle, spi_transaction_t* trans, TickType_t ticks_to_wait)
+{
+  // The real driver would block forever, nothing can complete a transfer while waiting here
+  if ((int)handle->queue.size() >= handle->cfg.queue_size) {
+    fprintf(stderr, "spi_device_queue_trans: queue of %d transactions is full\n", handle->cfg.queue_size);
+    abort();
+  }
+  handle->queue.push_back(trans);
+  host_spi_master_pending = handle->queue.size();
+  if (host_spi_master_pending > host_spi_master_max_pending) host_spi_master_max_pending = host_spi_master_pending;
+  return ESP_OK;
+}
+
+static void send(spi_device_handle_t handle, spi_transaction_t* trans)
+{
+  host_spi_poll(); // A transfer started through the registers is sent first
+  if (handle->cfg.pre_cb) handle->cfg.pre_cb(trans);
+  const uint8_t* data = (trans->flags & SPI_TRANS_USE_TXDATA) ? trans->tx_data : (const uint8_t*)trans->tx_buffer;
+  host_spi_write(true, data, trans->length / 8);
+  if (handle->cfg.post_cb) handle->cfg.post_cb(trans);
+}
+
+esp_err_t spi_device_get_trans_result(spi_device_handle_t handle, spi_transaction_t** trans, TickType_t ticks_to_wait)
+{
+  if (handle->queue.empty()) {
+    if (ticks_to_wait == portMAX_DELAY) {
+      fprintf(stderr, "spi_device_get_trans_result: waiting forever with nothing queued\n");
+      abort();
+    }
+    return ESP_ERR_TIMEOUT;
+  }
+  if (ticks_to_wait == 0 && host_spi_master_ready == 0) return ESP_ERR_TIMEOUT;
+  if (ticks_to_wait == 0 && host_spi_master_ready > 0) host_spi_master_ready--;
+
+  *trans = handle->queue.front();
+  handle->queue.pop_front();
+  host_spi_master_pending = handle->queue.size();
+  send(handle, *trans);
+  return ESP_OK;
+}
+
+esp_err_t spi_device_polling_transmit(spi_device_handle_t handle, spi_transaction_t* trans)
+{
+  if (!handle->queue.empty()) return ESP_ERR_INVALID_STATE;
+  send(handle, trans);
+  return ESP_OK;
+}
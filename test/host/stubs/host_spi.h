@@ -0,0 +1,39 @@
+// Bus recorder shared by the SPI, SPI register and SPI master driver stand-ins.
+//
+// Every transfer ends up here with the level of the D/C pin at the time it was started.
+// A display model can be attached to receive the bytes and to answer reads.
+
+#ifndef HOST_SPI_H
+#define HOST_SPI_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+struct HostSpiDevice
+{
+  virtual ~HostSpiDevice() {}
+  virtual void    write(bool dc, const uint8_t* data, size_t len) = 0;
+  virtual uint8_t read(void) { return 0; }
+};
+
+struct HostSpiStats
+{
+  uint32_t transfers;    // Transactions started by the CPU (register writes or SPIClass calls)
+  uint32_t dmaTransfers; // Transactions sent by the SPI master driver
+  uint32_t commands;     // Transactions with D/C low
+  uint64_t bytes;        // Bytes sent
+};
+
+extern HostSpiDevice* host_spi_device; // Receives the bytes, may be nullptr
+extern HostSpiStats   host_spi_stats;
+extern int            host_spi_dc_pin; // GPIO used as D/C, -1 = always data
+
+void    host_spi_reset_stats(void);
+bool    host_spi_dc(void);
+void    host_spi_write(bool dma, const uint8_t* data, size_t len);
+uint8_t host_spi_read(void);
+
+// Complete a transaction started through the SPI registers, see soc/spi_reg.h
+void    host_spi_poll(void);
+
+#endif
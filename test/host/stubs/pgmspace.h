@@ -0,0 +1,42 @@
+// FLASH and RAM are the same memory on the host
+
+#ifndef HOST_PGMSPACE_H
+#define HOST_PGMSPACE_H
+
+#include <stdint.h>
+#include <string.h>
+
+#define PROGMEM
+#define PGM_P const char *
+#define PSTR(s) (s)
+#define F(s) (s)
+
+#define pgm_read_byte(addr)  (*(const uint8_t *)(addr))
+#define pgm_read_word(addr)  (*(const uint16_t *)(addr))
+#ifdef __cplusplus
+// The libraries also read 32 bit pointers with pgm_read_dword(), so the value keeps the
+// size of what was read and converts to a pointer or to an integer
+struct host_pgm_dword
+{
+  uintptr_t v;
+  template <typename T> operator T*() const { return (T*)v; }
+  operator uint32_t() const { return (uint32_t)v; }
+};
+template <typename T> static inline host_pgm_dword pgm_read_dword(const T* addr)
+{
+  return host_pgm_dword{ sizeof(T) == sizeof(uintptr_t) ? (uintptr_t)*(const uintptr_t*)addr : *(const uint32_t*)addr };
+}
+static inline host_pgm_dword pgm_read_dword(const void* addr)
+{
+  return host_pgm_dword{ *(const uint32_t*)addr };
+}
+#else
+#define pgm_read_dword(addr) (*(const uint32_t *)(addr))
+#endif
+#define pgm_read_float(addr) (*(const float *)(addr))
+#define pgm_read_ptr(addr)   (*(void * const *)(addr))
+
+#define memcpy_P memcpy
+#define strlen_P strlen
+
+#endif
@@ -0,0 +1 @@
+// Host stand-in, nothing is needed from it
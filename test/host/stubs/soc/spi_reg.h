@@ -0,0 +1,59 @@
+// Host model of the ESP32-S3 SPI2/SPI3 registers used by TFT_eSPI.
+//
+// The registers are plain memory. A transaction is started by setting SPI_USR in the
+// command register and completes the next time SPI_USR or SPI_UPDATE is evaluated, or
+// when the D/C or CS pin changes. The drivers evaluate one of them before they touch the
+// registers again (busy checks), so each transaction is recorded with the data buffer and
+// length it was started with.
+
+#ifndef HOST_SOC_SPI_REG_H
+#define HOST_SOC_SPI_REG_H
+
+#include <stdint.h>
+#include "../host_spi.h"
+
+extern volatile uint32_t host_spi_regs[64];
+
+#define DR_REG_SPI2_BASE ((uintptr_t)host_spi_regs)
+#define DR_REG_SPI3_BASE ((uintptr_t)host_spi_regs)
+#define REG_SPI_BASE(i)  ((uintptr_t)host_spi_regs)
+
+#define SPI_CMD_REG(i)      (REG_SPI_BASE(i) + 0x0000)
+#define SPI_USER_REG(i)     (REG_SPI_BASE(i) + 0x0010)
+#define SPI_MS_DLEN_REG(i)  (REG_SPI_BASE(i) + 0x001C)
+#define SPI_DMA_CONF_REG(i) (REG_SPI_BASE(i) + 0x0030)
+#define SPI_W0_REG(i)       (REG_SPI_BASE(i) + 0x0098)
+#define SPI_W1_REG(i)       (REG_SPI_BASE(i) + 0x009C)
+#define SPI_W2_REG(i)       (REG_SPI_BASE(i) + 0x00A0)
+#define SPI_W3_REG(i)       (REG_SPI_BASE(i) + 0x00A4)
+#define SPI_W4_REG(i)       (REG_SPI_BASE(i) + 0x00A8)
+#define SPI_W5_REG(i)       (REG_SPI_BASE(i) + 0x00AC)
+#define SPI_W6_REG(i)       (REG_SPI_BASE(i) + 0x00B0)
+#define SPI_W7_REG(i)       (REG_SPI_BASE(i) + 0x00B4)
+#define SPI_W8_REG(i)       (REG_SPI_BASE(i) + 0x00B8)
+#define SPI_W9_REG(i)       (REG_SPI_BASE(i) + 0x00BC)
+#define SPI_W10_REG(i)      (REG_SPI_BASE(i) + 0x00C0)
+#define SPI_W11_REG(i)      (REG_SPI_BASE(i) + 0x00C4)
+#define SPI_W12_REG(i)      (REG_SPI_BASE(i) + 0x00C8)
+#define SPI_W13_REG(i)      (REG_SPI_BASE(i) + 0x00CC)
+#define SPI_W14_REG(i)      (REG_SPI_BASE(i) + 0x00D0)
+#define SPI_W15_REG(i)      (REG_SPI_BASE(i) + 0x00D4)
+
+#define SPI_USR_BIT    (1u << 24)
+#define SPI_UPDATE_BIT (1u << 23)
+
+// Evaluating the bits completes the transaction in progress
+#define SPI_USR    (host_spi_poll(), SPI_USR_BIT)
+#define SPI_UPDATE (host_spi_poll(), SPI_UPDATE_BIT)
+
+#define SPI_USR_MOSI    (1u << 27)
+#define SPI_USR_MISO    (1u << 28)
+#define SPI_DOUTDIN     (1u << 0)
+#define SPI_CK_OUT_EDGE (1u << 9)
+
+#define READ_PERI_REG(addr)               (*(volatile uint32_t*)(addr))
+#define WRITE_PERI_REG(addr, val)         (*(volatile uint32_t*)(addr)) = (uint32_t)(val)
+#define SET_PERI_REG_MASK(addr, mask)     WRITE_PERI_REG((addr), (READ_PERI_REG(addr) | (mask)))
+#define CLEAR_PERI_REG_MASK(addr, mask)   WRITE_PERI_REG((addr), (READ_PERI_REG(addr) & (~(mask))))
+
+#endif